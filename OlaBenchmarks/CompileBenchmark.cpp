@@ -0,0 +1,246 @@
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Core/Types.h"
+#include "Core/Macros.h"
+#include "Core/Log.h"
+#include "Frontend/SourceBuffer.h"
+#include "Frontend/Lexer.h"
+#include "Frontend/TokenStream.h"
+#include "Frontend/ImportProcessor.h"
+#include "Frontend/Parser.h"
+#include "Frontend/Diagnostics.h"
+#include "Frontend/FrontendContext.h"
+#include "Backend/Custom/IR/IRGenContext.h"
+#include "Backend/Custom/IR/IRPassManager.h"
+#include "Backend/Custom/IR/FunctionPass.h"
+#include "Backend/Custom/Codegen/MachineModule.h"
+#include "Backend/Custom/Codegen/x64/x64Target.h"
+#include "Utility/TimeReport.h"
+#include "Utility/Hash.h"
+#include "ProgramGenerator.h"
+
+using namespace ola;
+
+namespace
+{
+	struct BenchmarkOptions
+	{
+		ProgramGeneratorOptions program;
+		Uint32 iterations = 3;
+		OptimizationLevel opt_level = OptimizationLevel::O1;
+		std::string source_file;
+		std::string json_file;
+		std::string baseline_file;
+		Float64 tolerance = 10.0;
+	};
+
+	struct BenchmarkStage
+	{
+		std::string name;
+		Float64 wall_ms;
+		Float64 cpu_ms;
+	};
+
+	//Compiles the program once, every stage of the pipeline records its time in the time report. The lexer is timed on its own
+	//since the parser pulls tokens from it while parsing, the time of the later frontend stages includes lexing the tokens they consume
+	void CompileProgram(std::string const& source, OptimizationLevel opt_level)
+	{
+		{
+			OLA_TIME_REPORT_SCOPE("Lexer");
+			FrontendContext context{};
+			Diagnostics diagnostics{};
+			SourceBuffer src(source.data(), source.size(), "benchmark.ola");
+			Lexer lex(&context, diagnostics, src);
+			Token token{};
+			do
+			{
+				lex.Lex(token);
+			} while (token.IsNot(TokenKind::eof));
+		}
+
+		FrontendContext context{};
+		Diagnostics diagnostics{};
+		SourceBuffer src(source.data(), source.size(), "benchmark.ola");
+		Lexer lex(&context, diagnostics, src);
+		TokenStream tokens(lex);
+
+		ImportProcessor import_processor(&context, diagnostics);
+		{
+			OLA_TIME_REPORT_SCOPE("Import Processor");
+			import_processor.ProcessImports(tokens);
+		}
+		Parser parser(&context, diagnostics);
+		{
+			OLA_TIME_REPORT_SCOPE("Parser and Sema");
+			parser.Parse(tokens, import_processor.GetImportedModules());
+		}
+
+		IRGenContext ir_gen_ctx("benchmark");
+		{
+			OLA_TIME_REPORT_SCOPE("IR Generation");
+			ir_gen_ctx.Generate(parser.GetAST());
+		}
+
+		FunctionAnalysisManager analysis_manager;
+		IRPassManager ir_pass_manager(ir_gen_ctx.GetModule(), analysis_manager);
+		{
+			OLA_TIME_REPORT_SCOPE("IR Optimization Pipeline");
+			ir_pass_manager.Run(opt_level, IRPassOptions{});
+		}
+
+		x64Target x64_target(x64ABI::SystemV);
+		MachineModule machine_module(ir_gen_ctx.GetModule(), x64_target, analysis_manager);
+	}
+
+	std::unordered_map<std::string, Float64> ReadBaseline(std::string const& baseline_file)
+	{
+		std::ifstream baseline_stream(baseline_file);
+		std::string const json((std::istreambuf_iterator<Char>(baseline_stream)), std::istreambuf_iterator<Char>());
+
+		//Baselines are files written by WriteJSON so it is enough to pick up the name and wall time of each stage
+		std::unordered_map<std::string, Float64> wall_times;
+		constexpr std::string_view name_key = "\"name\": \"";
+		constexpr std::string_view wall_key = "\"wall_ms\": ";
+		for (Uint64 pos = json.find(name_key); pos != std::string::npos; pos = json.find(name_key, pos))
+		{
+			pos += name_key.size();
+			Uint64 const name_end = json.find('"', pos);
+			if (name_end == std::string::npos) break;
+			Uint64 const wall_pos = json.find(wall_key, name_end);
+			if (wall_pos == std::string::npos) break;
+			wall_times[json.substr(pos, name_end - pos)] = std::strtod(json.c_str() + wall_pos + wall_key.size(), nullptr);
+			pos = wall_pos;
+		}
+		return wall_times;
+	}
+
+	void WriteJSON(std::ostream& os, BenchmarkOptions const& opts, std::string const& source, std::vector<BenchmarkStage> const& stages)
+	{
+		ProgramGeneratorOptions const& program = opts.program;
+		os << "{\n";
+		os << std::format("  \"program\": {{ \"seed\": {}, \"functions\": {}, \"expression_depth\": {}, \"class_hierarchies\": {}, \"class_depth\": {}, "
+			"\"class_methods\": {}, \"overload_sets\": {}, \"overloads_per_set\": {}, \"switches\": {}, \"switch_cases\": {} }},\n",
+			program.seed, program.function_count, program.expression_depth, program.class_hierarchy_count, program.class_hierarchy_depth,
+			program.class_method_count, program.overload_set_count, program.overloads_per_set, program.switch_count, program.switch_case_count);
+		os << std::format("  \"source_bytes\": {},\n  \"source_hash\": \"{:016x}\",\n", source.size(), crc64(source.data(), source.size()));
+		os << std::format("  \"opt_level\": {},\n  \"iterations\": {},\n  \"stages\": [", static_cast<Uint32>(opts.opt_level), opts.iterations);
+		for (Uint64 i = 0; i < stages.size(); ++i)
+		{
+			os << (i == 0 ? "\n" : ",\n");
+			os << std::format("    {{ \"name\": \"{}\", \"wall_ms\": {:.3f}, \"cpu_ms\": {:.3f} }}", stages[i].name, stages[i].wall_ms, stages[i].cpu_ms);
+		}
+		os << "\n  ]\n}\n";
+	}
+
+	Bool ParseOptions(Int argc, Char** argv, BenchmarkOptions& opts)
+	{
+		ProgramGeneratorOptions& program = opts.program;
+		std::unordered_map<std::string_view, Uint32*> const count_options =
+		{
+			{ "--functions", &program.function_count },
+			{ "--expression-depth", &program.expression_depth },
+			{ "--class-hierarchies", &program.class_hierarchy_count },
+			{ "--class-depth", &program.class_hierarchy_depth },
+			{ "--class-methods", &program.class_method_count },
+			{ "--overload-sets", &program.overload_set_count },
+			{ "--overloads-per-set", &program.overloads_per_set },
+			{ "--switches", &program.switch_count },
+			{ "--switch-cases", &program.switch_case_count },
+			{ "--iterations", &opts.iterations },
+		};
+		std::unordered_map<std::string_view, std::string*> const file_options =
+		{
+			{ "--emit-source", &opts.source_file },
+			{ "--json", &opts.json_file },
+			{ "--baseline", &opts.baseline_file },
+		};
+
+		for (Int i = 1; i < argc; ++i)
+		{
+			std::string_view const arg = argv[i];
+			if (arg == "--O0") opts.opt_level = OptimizationLevel::O0;
+			else if (arg == "--O1") opts.opt_level = OptimizationLevel::O1;
+			else if (arg == "--O2") opts.opt_level = OptimizationLevel::O2;
+			else if (arg == "--O3") opts.opt_level = OptimizationLevel::O3;
+			else if (i + 1 >= argc) return false;
+			else if (auto it = count_options.find(arg); it != count_options.end()) *it->second = static_cast<Uint32>(std::strtoul(argv[++i], nullptr, 10));
+			else if (auto it = file_options.find(arg); it != file_options.end()) *it->second = argv[++i];
+			else if (arg == "--seed") program.seed = std::strtoull(argv[++i], nullptr, 10);
+			else if (arg == "--tolerance") opts.tolerance = std::strtod(argv[++i], nullptr);
+			else return false;
+		}
+		return opts.iterations > 0;
+	}
+}
+
+//Generates a large program and reports the time each stage of the custom backend pipeline spends compiling it, averaged over the iterations.
+//--json stores the results, --baseline compares them to stored results and fails if a stage got slower than the tolerance allows
+Int main(Int argc, Char** argv)
+{
+	OLA_LOG_INIT();
+	BenchmarkOptions opts{};
+	if (!ParseOptions(argc, argv, opts))
+	{
+		std::cout << "Usage: CompileBenchmark [--functions N] [--expression-depth N] [--class-hierarchies N] [--class-depth N] [--class-methods N]\n"
+					 "       [--overload-sets N] [--overloads-per-set N] [--switches N] [--switch-cases N] [--seed N] [--iterations N]\n"
+					 "       [--O0|--O1|--O2|--O3] [--emit-source file] [--json file] [--baseline file] [--tolerance percent]\n";
+		return 1;
+	}
+
+	ProgramGenerator generator(opts.program);
+	std::string const source = generator.Generate();
+	if (!opts.source_file.empty())
+	{
+		std::ofstream source_stream(opts.source_file);
+		source_stream << source;
+	}
+
+	//The first compilation warms up the caches, including the module interfaces of the imports
+	CompileProgram(source, opts.opt_level);
+	g_TimeReport.Enable();
+	for (Uint32 i = 0; i < opts.iterations; ++i) CompileProgram(source, opts.opt_level);
+
+	std::vector<BenchmarkStage> stages;
+	for (TimeReportStage const& stage : g_TimeReport.GetStages())
+	{
+		stages.push_back(BenchmarkStage{ .name = stage.name, .wall_ms = stage.wall_time * 1000.0 / opts.iterations, .cpu_ms = stage.cpu_time * 1000.0 / opts.iterations });
+	}
+
+	std::unordered_map<std::string, Float64> const baseline = opts.baseline_file.empty() ? std::unordered_map<std::string, Float64>{} : ReadBaseline(opts.baseline_file);
+	Uint64 name_width = 5;
+	for (BenchmarkStage const& stage : stages) name_width = std::max<Uint64>(name_width, stage.name.size());
+
+	std::cout << std::format("Compiled {} bytes of generated source {} times\n", source.size(), opts.iterations);
+	std::cout << std::format("{:<{}}  {:>12}  {:>12}  {:>12}  {:>8}\n", "Stage", name_width, "Wall (ms)", "CPU (ms)", "Base (ms)", "Change");
+	Bool regressed = false;
+	for (BenchmarkStage const& stage : stages)
+	{
+		auto it = baseline.find(stage.name);
+		if (it == baseline.end())
+		{
+			std::cout << std::format("{:<{}}  {:>12.3f}  {:>12.3f}\n", stage.name, name_width, stage.wall_ms, stage.cpu_ms);
+			continue;
+		}
+
+		//Stages that take a fraction of a millisecond are too noisy to fail on
+		Float64 const change = it->second > 0.0 ? (stage.wall_ms - it->second) / it->second * 100.0 : 0.0;
+		Bool const stage_regressed = change > opts.tolerance && stage.wall_ms - it->second > 0.1;
+		std::cout << std::format("{:<{}}  {:>12.3f}  {:>12.3f}  {:>12.3f}  {:>+7.1f}%{}\n", stage.name, name_width, stage.wall_ms, stage.cpu_ms,
+			it->second, change, stage_regressed ? "  REGRESSION" : "");
+		regressed |= stage_regressed;
+	}
+
+	if (!opts.json_file.empty())
+	{
+		std::ofstream json_stream(opts.json_file);
+		WriteJSON(json_stream, opts, source, stages);
+	}
+	return regressed ? 2 : 0;
+}
\ No newline at end of file
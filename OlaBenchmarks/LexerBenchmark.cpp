@@ -0,0 +1,73 @@
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "Core/Types.h"
+#include "Core/Macros.h"
+#include "Core/Log.h"
+#include "Frontend/SourceBuffer.h"
+#include "Frontend/Lexer.h"
+#include "Frontend/Diagnostics.h"
+#include "Frontend/FrontendContext.h"
+#include "autogen/OlaConfig.h"
+
+using namespace ola;
+namespace fs = std::filesystem;
+
+//Lexes the files given on the command line, or every .ola file of OlaLib and OlaTests, for at least a second and reports the throughput
+Int main(Int argc, Char** argv)
+{
+	OLA_LOG_INIT();
+	std::vector<std::unique_ptr<SourceBuffer>> source_buffers;
+	for (Int i = 1; i < argc; ++i) source_buffers.push_back(std::make_unique<SourceBuffer>(argv[i]));
+	if (source_buffers.empty())
+	{
+		for (Char const* directory : { OLA_LIB_PATH, OLA_TESTS_PATH })
+		{
+			std::error_code error;
+			for (fs::directory_entry const& entry : fs::recursive_directory_iterator(directory, error))
+			{
+				if (entry.path().extension() == ".ola") source_buffers.push_back(std::make_unique<SourceBuffer>(entry.path().string()));
+			}
+		}
+	}
+
+	Uint64 source_size = 0;
+	for (auto const& source_buffer : source_buffers) source_size += source_buffer->GetBufferSize();
+	if (source_size == 0)
+	{
+		std::cout << "Nothing to lex!\n";
+		return 1;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	Diagnostics diagnostics{};
+	FrontendContext context{};
+	Uint64 iterations = 0;
+	Uint64 token_count = 0;
+	Clock::time_point const start = Clock::now();
+	Clock::duration elapsed{};
+	do
+	{
+		for (auto const& source_buffer : source_buffers)
+		{
+			Lexer lex(&context, diagnostics, *source_buffer);
+			Token token{};
+			do
+			{
+				lex.Lex(token);
+				++token_count;
+			} while (token.IsNot(TokenKind::eof));
+		}
+		++iterations;
+		elapsed = Clock::now() - start;
+	} while (elapsed < std::chrono::seconds(1));
+
+	Float64 const seconds = std::chrono::duration<Float64>(elapsed).count();
+	Float64 const megabytes = static_cast<Float64>(source_size * iterations) / (1024.0 * 1024.0);
+	std::cout << std::format("Lexed {} files ({} bytes) {} times: {} tokens in {:.3f} s, {:.1f} MB/s, {:.1f} Mtokens/s\n",
+		source_buffers.size(), source_size, iterations, token_count, seconds, megabytes / seconds, token_count / seconds / 1e6);
+	return 0;
+}
\ No newline at end of file
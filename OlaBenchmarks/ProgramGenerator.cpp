@@ -0,0 +1,251 @@
+#include <format>
+#include <iterator>
+#include "ProgramGenerator.h"
+
+namespace ola
+{
+	namespace
+	{
+		//Parameter lists of the overloads in a set, each is called with arguments of exactly its types so calls are never ambiguous
+		struct OverloadSignature
+		{
+			Char const* params;
+			Char const* body;
+			Char const* args;
+		};
+		constexpr OverloadSignature overload_signatures[] =
+		{
+			{ "int a",				"return a + {0};",					"({1})" },
+			{ "int a, int b",		"return a * b + {0};",				"({1}, {0})" },
+			{ "float a",			"return a > 1.0 ? {0} : {0} + 1;",	"(1.5)" },
+			{ "bool a",				"return a ? {0} : -{0};",			"({1} > {0})" },
+			{ "char a",				"return a == 'x' ? {0} : {0} + 2;",	"('x')" },
+			{ "int a, float b",		"return b < 0.5 ? a : a + {0};",	"({1}, 0.25)" },
+			{ "float a, int b",		"return a > 0.5 ? b : b - {0};",	"(0.75, {1})" },
+			{ "int a, int b, int c","return a + b * c + {0};",			"({1}, 2, 3)" },
+		};
+		constexpr Uint32 OverloadSignatureCount = static_cast<Uint32>(std::size(overload_signatures));
+
+		constexpr Char const* binary_operators[] = { " + ", " - ", " * ", " & ", " | ", " ^ " };
+	}
+
+	std::string ProgramGenerator::Generate()
+	{
+		source.clear();
+		state = opts.seed;
+		source += "import std.assert;\nimport std.math;\n\n";
+		GenerateClasses();
+		GenerateOverloads();
+		GenerateSwitches();
+		GenerateFunctions();
+		GenerateMain();
+		return std::move(source);
+	}
+
+	void ProgramGenerator::GenerateClasses()
+	{
+		auto out = std::back_inserter(source);
+		for (Uint32 h = 0; h < opts.class_hierarchy_count; ++h)
+		{
+			for (Uint32 level = 0; level < opts.class_hierarchy_depth; ++level)
+			{
+				if (level == 0) std::format_to(out, "class Class{}_{}\n{{\n", h, level);
+				else std::format_to(out, "class Class{}_{} : Class{}_{}\n{{\n", h, level, h, level - 1);
+
+				//Method bodies stay away from members and method calls, the custom backend doesn't lower those yet
+				for (Uint32 m = 0; m < opts.class_method_count; ++m)
+				{
+					Uint32 const factor = Random(16) + 1;
+					Uint32 const offset = Random(1000);
+					std::format_to(out, "\tpublic int Method{}(int x) const virtual\n\t{{\n\t\treturn x * {} + {};\n\t}}\n", m, factor, offset);
+				}
+				for (Uint32 m = 0; m < opts.class_method_count; ++m)
+				{
+					std::format_to(out, "\tint field{}_{} = {};\n", level, m, Random(1000));
+				}
+				source += "};\n\n";
+			}
+		}
+	}
+
+	void ProgramGenerator::GenerateOverloads()
+	{
+		auto out = std::back_inserter(source);
+		for (Uint32 k = 0; k < opts.overload_set_count; ++k)
+		{
+			for (Uint32 i = 0; i < opts.overloads_per_set && i < OverloadSignatureCount; ++i)
+			{
+				OverloadSignature const& signature = overload_signatures[i];
+				std::format_to(out, "int Overload{}({})\n{{\n\t", k, signature.params);
+				source += std::vformat(signature.body, std::make_format_args(k));
+				source += "\n}\n";
+			}
+			source += "\n";
+		}
+	}
+
+	void ProgramGenerator::GenerateSwitches()
+	{
+		auto out = std::back_inserter(source);
+		for (Uint32 s = 0; s < opts.switch_count; ++s)
+		{
+			std::format_to(out, "int Switch{}(int x)\n{{\n\tint result = 0;\n\tswitch (x)\n\t{{\n", s);
+			for (Uint32 c = 0; c < opts.switch_case_count; ++c)
+			{
+				Uint32 const factor = Random(32) + 1;
+				Uint32 const offset = Random(1000);
+				std::format_to(out, "\t\tcase {}:\n\t\t\tresult = x * {} + {};\n", c * 3 + s, factor, offset);
+				//A few cases fall through to the next one
+				if (Random(8) != 0) source += "\t\t\tbreak;\n";
+			}
+			source += "\t\tdefault:\n\t\t\tresult = -1;\n\t}\n\treturn result;\n}\n\n";
+		}
+	}
+
+	void ProgramGenerator::GenerateFunctions()
+	{
+		auto out = std::back_inserter(source);
+		for (Uint32 i = 0; i < opts.function_count; ++i)
+		{
+			std::format_to(out, "int Function{}(int a, int b)\n{{\n\tint x = ", i);
+			GenerateExpr(opts.expression_depth, "a", "b");
+			source += ";\n\tint y = ";
+			GenerateExpr(opts.expression_depth / 2, "b", "x");
+			source += ";\n\tif (x < y)\n\t{\n\t\tx = x ^ y;\n\t}\n\telse\n\t{\n\t\ty = y - x;\n\t}\n";
+			source += "\tfor (int j = 0; j < 4; ++j)\n\t{\n\t\tx += j * y;\n\t}\n\treturn x + ";
+
+			Uint32 const call_kind = Random(4);
+			if (call_kind == 0 && i > 0)
+			{
+				std::format_to(out, "Function{}(x, y)", Random(i));
+			}
+			else if (call_kind == 1 && opts.overload_set_count > 0 && opts.overloads_per_set > 0)
+			{
+				GenerateOverloadCall(Random(opts.overload_set_count), "y");
+			}
+			else if (call_kind == 2 && opts.switch_count > 0)
+			{
+				std::format_to(out, "Switch{}(x)", Random(opts.switch_count));
+			}
+			else
+			{
+				std::format_to(out, "{}", Random(100));
+			}
+			source += ";\n}\n\n";
+		}
+	}
+
+	void ProgramGenerator::GenerateMain()
+	{
+		auto out = std::back_inserter(source);
+		source += "public int main()\n{\n\tint sum = 0;\n";
+		if (opts.class_hierarchy_depth > 0)
+		{
+			for (Uint32 h = 0; h < opts.class_hierarchy_count; ++h)
+			{
+				std::format_to(out, "\tClass{}_{} object{};\n", h, opts.class_hierarchy_depth - 1, h);
+			}
+		}
+		for (Uint32 s = 0; s < opts.switch_count; ++s)
+		{
+			std::format_to(out, "\tsum += Switch{}({});\n", s, Random(opts.switch_case_count * 3 + 1));
+		}
+		for (Uint32 k = 0; k < opts.overload_set_count; k += 16)
+		{
+			source += "\tsum += ";
+			GenerateOverloadCall(k, "sum");
+			source += ";\n";
+		}
+		for (Uint32 i = opts.function_count; i > 0 && opts.function_count - i < 16; --i)
+		{
+			std::format_to(out, "\tsum += Function{}(sum, {});\n", i - 1, i);
+		}
+		source += "\tAssert(Fabs(-2.0) > 1.0);\n\treturn sum - sum;\n}\n";
+	}
+
+	//Nests a chain of depth operators, each combines an operand or literal with the deeper part of the expression
+	void ProgramGenerator::GenerateExpr(Uint32 depth, std::string_view lhs, std::string_view rhs)
+	{
+		auto out = std::back_inserter(source);
+		auto GenerateOperand = [&]()
+			{
+				switch (Random(3))
+				{
+				case 0: source += lhs; break;
+				case 1: source += rhs; break;
+				default: std::format_to(out, "{}", Random(100)); break;
+				}
+			};
+
+		if (depth == 0)
+		{
+			GenerateOperand();
+			return;
+		}
+		Uint32 const form = Random(8);
+		switch (form)
+		{
+		case 5:
+			source += "(";
+			GenerateOperand();
+			source += " < ";
+			GenerateOperand();
+			source += " ? ";
+			GenerateExpr(depth - 1, lhs, rhs);
+			source += " : ";
+			GenerateOperand();
+			source += ")";
+			break;
+		case 6:
+			source += "(";
+			GenerateExpr(depth - 1, lhs, rhs);
+			std::format_to(out, " << {})", Random(3) + 1);
+			break;
+		case 7:
+			source += "-(";
+			GenerateExpr(depth - 1, lhs, rhs);
+			source += ")";
+			break;
+		default:
+		{
+			Char const* op = binary_operators[Random(static_cast<Uint32>(std::size(binary_operators)))];
+			source += "(";
+			if (form % 2 == 0)
+			{
+				GenerateOperand();
+				source += op;
+				GenerateExpr(depth - 1, lhs, rhs);
+			}
+			else
+			{
+				GenerateExpr(depth - 1, lhs, rhs);
+				source += op;
+				GenerateOperand();
+			}
+			source += ")";
+		}
+		}
+	}
+
+	void ProgramGenerator::GenerateOverloadCall(Uint32 overload_set, std::string_view arg)
+	{
+		Uint32 const overload_count = opts.overloads_per_set < OverloadSignatureCount ? opts.overloads_per_set : OverloadSignatureCount;
+		OverloadSignature const& signature = overload_signatures[Random(overload_count)];
+		std::format_to(std::back_inserter(source), "Overload{}", overload_set);
+		source += std::vformat(signature.args, std::make_format_args(overload_set, arg));
+	}
+
+	//splitmix64, its output is fully specified unlike the standard distributions
+	Uint64 ProgramGenerator::Random()
+	{
+		Uint64 z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	Uint32 ProgramGenerator::Random(Uint32 bound)
+	{
+		return bound ? static_cast<Uint32>(Random() % bound) : 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "Core/Types.h"
+
+namespace ola
+{
+	struct ProgramGeneratorOptions
+	{
+		Uint64 seed = 1;
+		Uint32 function_count = 10000;
+		Uint32 expression_depth = 16;
+		Uint32 class_hierarchy_count = 16;
+		Uint32 class_hierarchy_depth = 6;
+		Uint32 class_method_count = 16;
+		Uint32 overload_set_count = 256;
+		Uint32 overloads_per_set = 8;
+		Uint32 switch_count = 16;
+		Uint32 switch_case_count = 1024;
+	};
+
+	//Generates a synthetic Ola program that stresses the compiler: many functions with deeply nested expressions that call each other,
+	//class hierarchies that override every virtual method at each level, overload sets and switches with many cases.
+	//The program only depends on the options, the same seed always gives the same source on every platform.
+	class ProgramGenerator
+	{
+	public:
+		explicit ProgramGenerator(ProgramGeneratorOptions const& opts) : opts(opts), state(opts.seed) {}
+
+		std::string Generate();
+
+	private:
+		ProgramGeneratorOptions opts;
+		std::string source;
+		Uint64 state;
+
+	private:
+		void GenerateClasses();
+		void GenerateOverloads();
+		void GenerateSwitches();
+		void GenerateFunctions();
+		void GenerateMain();
+
+		void GenerateExpr(Uint32 depth, std::string_view lhs, std::string_view rhs);
+		void GenerateOverloadCall(Uint32 overload_set, std::string_view arg);
+
+		Uint64 Random();
+		Uint32 Random(Uint32 bound);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <vector>
+#include "Core/Types.h"
+#include "Core/Macros.h"
+#include "Frontend/FrontendContext.h"
+
+using namespace ola;
+
+//Creates a growing number of array and function types and reports the time it takes to look each of them up again,
+//which should not depend on the number of types in the context
+Int main()
+{
+	using Clock = std::chrono::steady_clock;
+	for (Uint32 type_count = 1024; type_count <= 128 * 1024; type_count *= 4)
+	{
+		FrontendContext context{};
+		QualType const int_type(context.GetIntType());
+		std::vector<std::vector<QualType>> param_lists(type_count);
+		for (Uint32 i = 0; i < type_count; ++i)
+		{
+			ArrayType const* array_type = context.GetArrayType(int_type, i + 1);
+			param_lists[i] = { int_type, QualType(array_type, Qualifier_Const), QualType(context.GetRefType(int_type)) };
+			context.GetFuncType(int_type, param_lists[i]);
+		}
+
+		Uint64 iterations = 0;
+		Uint64 checksum = 0;
+		Clock::time_point const start = Clock::now();
+		Clock::duration elapsed{};
+		do
+		{
+			for (Uint32 i = 0; i < type_count; ++i)
+			{
+				checksum += reinterpret_cast<Uint64>(context.GetArrayType(int_type, i + 1));
+				checksum += reinterpret_cast<Uint64>(context.GetFuncType(int_type, param_lists[i]));
+			}
+			++iterations;
+			elapsed = Clock::now() - start;
+		} while (elapsed < std::chrono::milliseconds(250));
+
+		Float64 const nanoseconds = std::chrono::duration<Float64, std::nano>(elapsed).count();
+		Float64 const lookups = static_cast<Float64>(2 * type_count * iterations);
+		std::cout << std::format("{:>7} array and function types: {:.1f} ns per lookup (checksum {:x})\n", type_count, nanoseconds / lookups, checksum & 0xfff);
+	}
+	return 0;
+}
\ No newline at end of file
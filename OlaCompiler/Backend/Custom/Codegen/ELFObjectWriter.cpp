@@ -0,0 +1,297 @@
+#include <ostream>
+#include "ELFObjectWriter.h"
+#include "ObjectFile.h"
+
+namespace ola
+{
+	namespace
+	{
+		enum ELFConstants : Uint32
+		{
+			ET_REL = 1,
+			EM_X86_64 = 62,
+			EV_CURRENT = 1,
+
+			SHT_NULL = 0,
+			SHT_PROGBITS = 1,
+			SHT_SYMTAB = 2,
+			SHT_STRTAB = 3,
+			SHT_RELA = 4,
+			SHT_NOBITS = 8,
+
+			SHF_WRITE = 0x1,
+			SHF_ALLOC = 0x2,
+			SHF_EXECINSTR = 0x4,
+			SHF_INFO_LINK = 0x40,
+
+			STB_LOCAL = 0,
+			STB_GLOBAL = 1,
+			STT_NOTYPE = 0,
+			STT_OBJECT = 1,
+			STT_FUNC = 2,
+			STT_SECTION = 3,
+
+			R_X86_64_64 = 1,
+			R_X86_64_PC32 = 2,
+			R_X86_64_PLT32 = 4,
+		};
+
+		constexpr Uint64 ELFHeaderSize = 64;
+		constexpr Uint64 ELFSectionHeaderSize = 64;
+		constexpr Uint64 ELFSymbolSize = 24;
+		constexpr Uint64 ELFRelaSize = 24;
+
+		struct ELFSectionHeader
+		{
+			Uint32 name = 0;
+			Uint32 type = SHT_NULL;
+			Uint64 flags = 0;
+			Uint64 offset = 0;
+			Uint64 size = 0;
+			Uint32 link = 0;
+			Uint32 info = 0;
+			Uint64 alignment = 0;
+			Uint64 entry_size = 0;
+		};
+
+		class ByteBuffer
+		{
+		public:
+			template<typename T>
+			void Write(T value)
+			{
+				Uint8 bytes[sizeof(T)];
+				std::memcpy(bytes, &value, sizeof(T));
+				data.insert(data.end(), bytes, bytes + sizeof(T));
+			}
+			void Write(std::vector<Uint8> const& bytes)
+			{
+				data.insert(data.end(), bytes.begin(), bytes.end());
+			}
+			void AlignTo(Uint64 alignment)
+			{
+				data.resize(OLA_ALIGN_UP(data.size(), alignment), 0);
+			}
+			Uint64 Size() const { return data.size(); }
+			std::vector<Uint8> const& Data() const { return data; }
+
+		private:
+			std::vector<Uint8> data;
+		};
+
+		class StringTable
+		{
+		public:
+			StringTable() { data.push_back('\0'); }
+
+			Uint32 Add(std::string_view str)
+			{
+				Uint32 const offset = static_cast<Uint32>(data.size());
+				data.insert(data.end(), str.begin(), str.end());
+				data.push_back('\0');
+				return offset;
+			}
+			std::vector<Uint8> const& Data() const { return data; }
+
+		private:
+			std::vector<Uint8> data;
+		};
+
+		Uint64 GetSectionFlags(ObjectSectionKind kind)
+		{
+			switch (kind)
+			{
+			case ObjectSectionKind::Text:	  return SHF_ALLOC | SHF_EXECINSTR;
+			case ObjectSectionKind::Data:	  return SHF_ALLOC | SHF_WRITE;
+			case ObjectSectionKind::ReadOnly: return SHF_ALLOC;
+			case ObjectSectionKind::BSS:	  return SHF_ALLOC | SHF_WRITE;
+			}
+			return 0;
+		}
+
+		Uint32 GetRelocationType(ObjectRelocationKind kind)
+		{
+			switch (kind)
+			{
+			case ObjectRelocationKind::Abs64:	return R_X86_64_64;
+			case ObjectRelocationKind::PCRel32: return R_X86_64_PC32;
+			case ObjectRelocationKind::Call32:	return R_X86_64_PLT32;
+			}
+			return 0;
+		}
+
+		Uint8 GetSymbolType(ObjectSymbolType type)
+		{
+			switch (type)
+			{
+			case ObjectSymbolType::Function: return STT_FUNC;
+			case ObjectSymbolType::Object:	 return STT_OBJECT;
+			case ObjectSymbolType::None:
+			default:						 return STT_NOTYPE;
+			}
+		}
+	}
+
+	void ELFObjectWriter::WriteObject(ObjectFile const& object)
+	{
+		auto const& sections = object.GetSections();
+		auto const& symbols = object.GetSymbols();
+
+		//ELF requires local symbols to precede global ones, undefined symbols are always global
+		std::vector<Uint32> symbol_order;
+		symbol_order.reserve(symbols.size());
+		for (Uint32 i = 0; i < symbols.size(); ++i)
+		{
+			if (symbols[i].IsDefined() && symbols[i].binding == ObjectSymbolBinding::Local) symbol_order.push_back(i);
+		}
+		Uint32 const first_global_symbol = 1 + static_cast<Uint32>(sections.size()) + static_cast<Uint32>(symbol_order.size());
+		for (Uint32 i = 0; i < symbols.size(); ++i)
+		{
+			if (!symbols[i].IsDefined() || symbols[i].binding == ObjectSymbolBinding::Global) symbol_order.push_back(i);
+		}
+
+		Uint32 const symbol_index_base = 1 + static_cast<Uint32>(sections.size());
+		std::vector<Uint32> elf_symbol_index(symbols.size());
+		for (Uint32 i = 0; i < symbol_order.size(); ++i) elf_symbol_index[symbol_order[i]] = symbol_index_base + i;
+
+		StringTable section_names;
+		StringTable symbol_names;
+		ByteBuffer symtab;
+		symtab.Write(std::vector<Uint8>(ELFSymbolSize, 0));
+		for (Uint32 i = 0; i < sections.size(); ++i)
+		{
+			symtab.Write<Uint32>(0);
+			symtab.Write<Uint8>(STT_SECTION | (STB_LOCAL << 4));
+			symtab.Write<Uint8>(0);
+			symtab.Write<Uint16>(static_cast<Uint16>(i + 1));
+			symtab.Write<Uint64>(0);
+			symtab.Write<Uint64>(0);
+		}
+		for (Uint32 symbol_idx : symbol_order)
+		{
+			ObjectSymbol const& symbol = symbols[symbol_idx];
+			Uint8 const binding = symbol.IsDefined() && symbol.binding == ObjectSymbolBinding::Local ? STB_LOCAL : STB_GLOBAL;
+			symtab.Write<Uint32>(symbol_names.Add(symbol.name));
+			symtab.Write<Uint8>(GetSymbolType(symbol.type) | (binding << 4));
+			symtab.Write<Uint8>(0);
+			symtab.Write<Uint16>(symbol.IsDefined() ? static_cast<Uint16>(symbol.section + 1) : 0);
+			symtab.Write<Uint64>(symbol.value);
+			symtab.Write<Uint64>(symbol.size);
+		}
+
+		ByteBuffer file;
+		file.Write(std::vector<Uint8>(ELFHeaderSize, 0));
+
+		std::vector<ELFSectionHeader> section_headers(1);
+		for (ObjectSection const& section : sections)
+		{
+			ELFSectionHeader& header = section_headers.emplace_back();
+			header.name = section_names.Add(section.name);
+			header.type = section.kind == ObjectSectionKind::BSS ? SHT_NOBITS : SHT_PROGBITS;
+			header.flags = GetSectionFlags(section.kind);
+			header.alignment = section.alignment;
+			header.size = section.GetSize();
+			file.AlignTo(section.alignment);
+			header.offset = file.Size();
+			if (section.kind != ObjectSectionKind::BSS) file.Write(section.data);
+		}
+
+		Uint32 const symtab_index = static_cast<Uint32>(section_headers.size() + std::count_if(sections.begin(), sections.end(), [](ObjectSection const& section) { return !section.relocations.empty(); }));
+		for (Uint32 i = 0; i < sections.size(); ++i)
+		{
+			ObjectSection const& section = sections[i];
+			if (section.relocations.empty()) continue;
+
+			file.AlignTo(8);
+			ELFSectionHeader& header = section_headers.emplace_back();
+			header.name = section_names.Add(".rela" + section.name);
+			header.type = SHT_RELA;
+			header.flags = SHF_INFO_LINK;
+			header.offset = file.Size();
+			header.size = section.relocations.size() * ELFRelaSize;
+			header.link = symtab_index;
+			header.info = i + 1;
+			header.alignment = 8;
+			header.entry_size = ELFRelaSize;
+			for (ObjectRelocation const& relocation : section.relocations)
+			{
+				Uint64 const symbol = elf_symbol_index[relocation.symbol];
+				file.Write<Uint64>(relocation.offset);
+				file.Write<Uint64>((symbol << 32) | GetRelocationType(relocation.kind));
+				file.Write<Int64>(relocation.addend);
+			}
+		}
+
+		file.AlignTo(8);
+		ELFSectionHeader& symtab_header = section_headers.emplace_back();
+		symtab_header.name = section_names.Add(".symtab");
+		symtab_header.type = SHT_SYMTAB;
+		symtab_header.offset = file.Size();
+		symtab_header.size = symtab.Size();
+		symtab_header.link = symtab_index + 1;
+		symtab_header.info = first_global_symbol;
+		symtab_header.alignment = 8;
+		symtab_header.entry_size = ELFSymbolSize;
+		file.Write(symtab.Data());
+
+		ELFSectionHeader& strtab_header = section_headers.emplace_back();
+		strtab_header.name = section_names.Add(".strtab");
+		strtab_header.type = SHT_STRTAB;
+		strtab_header.offset = file.Size();
+		strtab_header.size = symbol_names.Data().size();
+		strtab_header.alignment = 1;
+		file.Write(symbol_names.Data());
+
+		ELFSectionHeader& note_header = section_headers.emplace_back();
+		note_header.name = section_names.Add(".note.GNU-stack");
+		note_header.type = SHT_PROGBITS;
+		note_header.offset = file.Size();
+		note_header.alignment = 1;
+
+		ELFSectionHeader& shstrtab_header = section_headers.emplace_back();
+		shstrtab_header.name = section_names.Add(".shstrtab");
+		shstrtab_header.type = SHT_STRTAB;
+		shstrtab_header.offset = file.Size();
+		shstrtab_header.size = section_names.Data().size();
+		shstrtab_header.alignment = 1;
+		file.Write(section_names.Data());
+
+		file.AlignTo(8);
+		Uint64 const section_header_offset = file.Size();
+		for (ELFSectionHeader const& header : section_headers)
+		{
+			file.Write<Uint32>(header.name);
+			file.Write<Uint32>(header.type);
+			file.Write<Uint64>(header.flags);
+			file.Write<Uint64>(0);
+			file.Write<Uint64>(header.offset);
+			file.Write<Uint64>(header.size);
+			file.Write<Uint32>(header.link);
+			file.Write<Uint32>(header.info);
+			file.Write<Uint64>(header.alignment);
+			file.Write<Uint64>(header.entry_size);
+		}
+
+		ByteBuffer elf_header;
+		Uint8 const ident[16] = { 0x7f, 'E', 'L', 'F', 2, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+		for (Uint8 byte : ident) elf_header.Write<Uint8>(byte);
+		elf_header.Write<Uint16>(ET_REL);
+		elf_header.Write<Uint16>(EM_X86_64);
+		elf_header.Write<Uint32>(EV_CURRENT);
+		elf_header.Write<Uint64>(0);
+		elf_header.Write<Uint64>(0);
+		elf_header.Write<Uint64>(section_header_offset);
+		elf_header.Write<Uint32>(0);
+		elf_header.Write<Uint16>(static_cast<Uint16>(ELFHeaderSize));
+		elf_header.Write<Uint16>(0);
+		elf_header.Write<Uint16>(0);
+		elf_header.Write<Uint16>(static_cast<Uint16>(ELFSectionHeaderSize));
+		elf_header.Write<Uint16>(static_cast<Uint16>(section_headers.size()));
+		elf_header.Write<Uint16>(static_cast<Uint16>(section_headers.size() - 1));
+		OLA_ASSERT(elf_header.Size() == ELFHeaderSize);
+
+		std::vector<Uint8> const& bytes = file.Data();
+		os.write(reinterpret_cast<Char const*>(elf_header.Data().data()), elf_header.Size());
+		os.write(reinterpret_cast<Char const*>(bytes.data()) + ELFHeaderSize, bytes.size() - ELFHeaderSize);
+	}
+}
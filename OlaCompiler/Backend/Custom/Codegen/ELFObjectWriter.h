@@ -0,0 +1,17 @@
+#pragma once
+#include <iosfwd>
+
+namespace ola
+{
+	class ObjectFile;
+
+	class ELFObjectWriter
+	{
+	public:
+		explicit ELFObjectWriter(std::ostream& os) : os(os) {}
+		void WriteObject(ObjectFile const& object);
+
+	private:
+		std::ostream& os;
+	};
+}
@@ -0,0 +1,303 @@
+#include <cstdio>
+#include <unordered_set>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "JITModule.h"
+#include "Core/Log.h"
+
+namespace ola
+{
+	namespace
+	{
+		enum JITSegment : Uint32
+		{
+			JITSegment_Code,
+			JITSegment_ReadOnly,
+			JITSegment_Data,
+			JITSegment_Count
+		};
+
+		JITSegment GetSegment(ObjectSectionKind kind)
+		{
+			switch (kind)
+			{
+			case ObjectSectionKind::Text:		return JITSegment_Code;
+			case ObjectSectionKind::ReadOnly:	return JITSegment_ReadOnly;
+			case ObjectSectionKind::Data:
+			case ObjectSectionKind::BSS:		return JITSegment_Data;
+			}
+			OLA_UNREACHABLE();
+		}
+
+		//jmp qword ptr [rip + 0] followed by the absolute address of the target
+		constexpr Uint8 StubCode[] = { 0xFF, 0x25, 0x00, 0x00, 0x00, 0x00 };
+		constexpr Uint64 StubSize = 16;
+
+		Uint64 GetPageSize()
+		{
+#if defined(_WIN32)
+			SYSTEM_INFO system_info{};
+			GetSystemInfo(&system_info);
+			return system_info.dwPageSize;
+#else
+			return static_cast<Uint64>(sysconf(_SC_PAGESIZE));
+#endif
+		}
+
+		Uint8* AllocatePages(Uint64 size)
+		{
+#if defined(_WIN32)
+			return static_cast<Uint8*>(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+#else
+			void* pages = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return pages != MAP_FAILED ? static_cast<Uint8*>(pages) : nullptr;
+#endif
+		}
+
+		void FreePages(Uint8* pages, Uint64 size)
+		{
+#if defined(_WIN32)
+			VirtualFree(pages, 0, MEM_RELEASE);
+#else
+			munmap(pages, size);
+#endif
+		}
+
+		Bool ProtectPages(Uint8* pages, Uint64 size, Bool executable)
+		{
+			if (size == 0) return true;
+#if defined(_WIN32)
+			DWORD old_protection = 0;
+			if (!VirtualProtect(pages, size, executable ? PAGE_EXECUTE_READ : PAGE_READONLY, &old_protection)) return false;
+			if (executable) FlushInstructionCache(GetCurrentProcess(), pages, size);
+			return true;
+#else
+			return mprotect(pages, size, executable ? PROT_READ | PROT_EXEC : PROT_READ) == 0;
+#endif
+		}
+	}
+
+	JITModule::~JITModule()
+	{
+		if (memory) FreePages(memory, memory_size);
+	}
+
+	void JITModule::AddObject(ObjectFile&& object)
+	{
+		OLA_ASSERT_MSG(!memory, "Cannot add objects to a JIT module that was already linked!");
+		objects.push_back(std::move(object));
+	}
+
+	Bool JITModule::Link()
+	{
+		OLA_ASSERT_MSG(!memory, "JIT module was already linked!");
+
+		std::unordered_set<std::string_view> defined_symbols;
+		for (ObjectFile const& object : objects)
+		{
+			for (ObjectSymbol const& symbol : object.GetSymbols())
+			{
+				if (!symbol.IsDefined() || symbol.binding != ObjectSymbolBinding::Global) continue;
+				if (!defined_symbols.insert(symbol.name).second)
+				{
+					OLA_ERROR("Symbol '{}' is defined more than once!", symbol.name);
+					return false;
+				}
+			}
+		}
+
+		struct ExternalSymbol
+		{
+			void* address;
+			Uint64 stub_offset;
+		};
+		std::unordered_map<std::string_view, ExternalSymbol> external_symbols;
+
+		std::vector<std::vector<Uint64>> section_offsets(objects.size());
+		Uint64 segment_sizes[JITSegment_Count]{};
+		for (Uint64 i = 0; i < objects.size(); ++i)
+		{
+			for (ObjectSection const& section : objects[i].GetSections())
+			{
+				Uint64& segment_size = segment_sizes[GetSegment(section.kind)];
+				segment_size = OLA_ALIGN_UP(segment_size, section.alignment);
+				section_offsets[i].push_back(segment_size);
+				segment_size += section.GetSize();
+			}
+		}
+
+		//The runtime can be anywhere in the address space so 32-bit relative references to it go through a stub placed after the code
+		segment_sizes[JITSegment_Code] = OLA_ALIGN_UP(segment_sizes[JITSegment_Code], StubSize);
+		for (ObjectFile const& object : objects)
+		{
+			for (ObjectSymbol const& symbol : object.GetSymbols())
+			{
+				if (symbol.IsDefined() || defined_symbols.contains(symbol.name) || external_symbols.contains(symbol.name)) continue;
+
+				void* address = GetJITRuntimeSymbol(symbol.name, calling_convention);
+				if (!address)
+				{
+					OLA_ERROR("Unresolved external symbol '{}'!", symbol.name);
+					return false;
+				}
+				external_symbols[symbol.name] = ExternalSymbol{ .address = address, .stub_offset = segment_sizes[JITSegment_Code] };
+				segment_sizes[JITSegment_Code] += StubSize;
+			}
+		}
+
+		Uint64 const page_size = GetPageSize();
+		Uint64 segment_offsets[JITSegment_Count]{};
+		for (Uint32 segment = 0; segment < JITSegment_Count; ++segment)
+		{
+			segment_offsets[segment] = memory_size;
+			memory_size += OLA_ALIGN_UP(segment_sizes[segment], page_size);
+		}
+		if (memory_size == 0)
+		{
+			OLA_ERROR("Nothing to link in JIT module!");
+			return false;
+		}
+		memory = AllocatePages(memory_size);
+		if (!memory)
+		{
+			OLA_ERROR("Failed to allocate {} bytes of JIT memory!", memory_size);
+			memory_size = 0;
+			return false;
+		}
+
+		auto GetSectionAddress = [&](Uint64 object_idx, Uint32 section_idx)
+			{
+				ObjectSection const& section = objects[object_idx].GetSections()[section_idx];
+				return memory + segment_offsets[GetSegment(section.kind)] + section_offsets[object_idx][section_idx];
+			};
+
+		for (Uint64 i = 0; i < objects.size(); ++i)
+		{
+			std::vector<ObjectSection> const& sections = objects[i].GetSections();
+			for (Uint32 section_idx = 0; section_idx < sections.size(); ++section_idx)
+			{
+				ObjectSection const& section = sections[section_idx];
+				if (section.kind != ObjectSectionKind::BSS && !section.data.empty())
+				{
+					std::memcpy(GetSectionAddress(i, section_idx), section.data.data(), section.data.size());
+				}
+			}
+			for (ObjectSymbol const& symbol : objects[i].GetSymbols())
+			{
+				if (!symbol.IsDefined() || symbol.binding != ObjectSymbolBinding::Global) continue;
+				global_symbols[symbol.name] = GetSectionAddress(i, symbol.section) + symbol.value;
+			}
+		}
+		for (auto const& [name, external_symbol] : external_symbols)
+		{
+			Uint8* stub = memory + segment_offsets[JITSegment_Code] + external_symbol.stub_offset;
+			std::memcpy(stub, StubCode, sizeof(StubCode));
+			std::memcpy(stub + sizeof(StubCode), &external_symbol.address, sizeof(void*));
+		}
+
+		for (Uint64 i = 0; i < objects.size(); ++i)
+		{
+			std::vector<ObjectSymbol> const& symbols = objects[i].GetSymbols();
+			std::vector<ObjectSection> const& sections = objects[i].GetSections();
+			for (Uint32 section_idx = 0; section_idx < sections.size(); ++section_idx)
+			{
+				for (ObjectRelocation const& relocation : sections[section_idx].relocations)
+				{
+					ObjectSymbol const& symbol = symbols[relocation.symbol];
+					Uint8* target = nullptr;
+					if (symbol.IsDefined())
+					{
+						target = GetSectionAddress(i, symbol.section) + symbol.value;
+					}
+					else if (auto it = global_symbols.find(symbol.name); it != global_symbols.end())
+					{
+						target = it->second;
+					}
+					else
+					{
+						ExternalSymbol const& external_symbol = external_symbols[symbol.name];
+						target = relocation.kind == ObjectRelocationKind::Abs64 ? static_cast<Uint8*>(external_symbol.address)
+																				: memory + segment_offsets[JITSegment_Code] + external_symbol.stub_offset;
+					}
+
+					Uint8* location = GetSectionAddress(i, section_idx) + relocation.offset;
+					switch (relocation.kind)
+					{
+					case ObjectRelocationKind::Abs64:
+					{
+						Uint64 const value = reinterpret_cast<Uint64>(target) + relocation.addend;
+						std::memcpy(location, &value, sizeof(value));
+					}
+					break;
+					case ObjectRelocationKind::PCRel32:
+					case ObjectRelocationKind::Call32:
+					{
+						Int64 const value = reinterpret_cast<Int64>(target) + relocation.addend - reinterpret_cast<Int64>(location);
+						if (value != static_cast<Int32>(value))
+						{
+							OLA_ERROR("Relocation against '{}' is out of range!", symbol.name);
+							return false;
+						}
+						Int32 const value32 = static_cast<Int32>(value);
+						std::memcpy(location, &value32, sizeof(value32));
+					}
+					break;
+					}
+				}
+			}
+		}
+
+		if (!ProtectPages(memory + segment_offsets[JITSegment_Code], OLA_ALIGN_UP(segment_sizes[JITSegment_Code], page_size), true) ||
+			!ProtectPages(memory + segment_offsets[JITSegment_ReadOnly], OLA_ALIGN_UP(segment_sizes[JITSegment_ReadOnly], page_size), false))
+		{
+			OLA_ERROR("Failed to change the protection of JIT memory!");
+			return false;
+		}
+		return true;
+	}
+
+	void* JITModule::GetSymbolAddress(std::string_view name) const
+	{
+		auto it = global_symbols.find(std::string(name));
+		return it != global_symbols.end() ? it->second : nullptr;
+	}
+
+	Int JITModule::Run()
+	{
+		void* main_address = GetSymbolAddress("main");
+		OLA_ASSERT_MSG(main_address, "JIT module does not define main!");
+
+		Int64 result = 0;
+		switch (calling_convention)
+		{
+		case JITCallingConvention::Microsoft:
+		{
+			using MainFunction = Int64(OLA_JIT_MS_ABI*)();
+			result = reinterpret_cast<MainFunction>(main_address)();
+		}
+		break;
+		case JITCallingConvention::SystemV:
+		{
+#if defined(_WIN32)
+			OLA_ASSERT_MSG(false, "System V calling convention is not supported by the JIT on this host!");
+#else
+			using MainFunction = Int64(OLA_JIT_SYSV_ABI*)();
+			result = reinterpret_cast<MainFunction>(main_address)();
+#endif
+		}
+		break;
+		}
+		std::fflush(stdout);
+		//Report the same exit code the operating system would for an executable returning this value
+#if defined(_WIN32)
+		return static_cast<Int32>(result);
+#else
+		return static_cast<Int>(result & 0xff);
+#endif
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include "Backend/Custom/Codegen/ObjectFile.h"
+#include "Backend/Custom/Codegen/JITRuntime.h"
+
+namespace ola
+{
+	//Links object files produced by the target in memory and runs them inside the compiler process.
+	//External symbols are resolved against the OlaLib runtime that is compiled into the compiler.
+	class JITModule
+	{
+	public:
+		explicit JITModule(JITCallingConvention calling_convention) : calling_convention(calling_convention) {}
+		~JITModule();
+		OLA_NONCOPYABLE_NONMOVABLE(JITModule)
+
+		void AddObject(ObjectFile&& object);
+		Bool Link();
+		void* GetSymbolAddress(std::string_view name) const;
+		Int Run();
+
+	private:
+		JITCallingConvention calling_convention;
+		std::vector<ObjectFile> objects;
+		std::unordered_map<std::string, Uint8*> global_symbols;
+		Uint8* memory = nullptr;
+		Uint64 memory_size = 0;
+	};
+}
@@ -0,0 +1,117 @@
+#include <unordered_map>
+#include "JITRuntime.h"
+#include "olaio.h"
+#include "olaassert.h"
+#include "olamath.h"
+#include "olastring.h"
+#include "olamemory.h"
+
+//Code generated for the Microsoft ABI doesn't guarantee a 16-byte aligned stack at call sites, the thunks realign it before entering the host code
+#if defined(_WIN32)
+#define OLA_JIT_THUNK OLA_JIT_MS_ABI
+#else
+#define OLA_JIT_THUNK OLA_JIT_MS_ABI __attribute__((force_align_arg_pointer))
+#endif
+
+namespace ola
+{
+	namespace
+	{
+		//Adapts an OlaLib function compiled for the host to the calling convention of the generated code
+		template<auto F>
+		struct JITRuntimeThunk;
+
+		template<typename R, typename... Args, R(*F)(Args...)>
+		struct JITRuntimeThunk<F>
+		{
+			static R OLA_JIT_THUNK Call(Args... args)
+			{
+				return F(args...);
+			}
+		};
+	}
+
+	void* GetJITRuntimeSymbol(std::string_view name, JITCallingConvention calling_convention)
+	{
+		struct JITRuntimeSymbol
+		{
+			void* ms_abi_address;
+			void* host_address;
+		};
+#define OLA_JIT_RUNTIME_SYMBOL(symbol) { #symbol, JITRuntimeSymbol{ reinterpret_cast<void*>(&JITRuntimeThunk<&::symbol>::Call), reinterpret_cast<void*>(&::symbol) } }
+		static std::unordered_map<std::string_view, JITRuntimeSymbol> const runtime_symbols =
+		{
+			OLA_JIT_RUNTIME_SYMBOL(Assert),
+			OLA_JIT_RUNTIME_SYMBOL(AssertMsg),
+
+			OLA_JIT_RUNTIME_SYMBOL(PrintInt),
+			OLA_JIT_RUNTIME_SYMBOL(PrintFloat),
+			OLA_JIT_RUNTIME_SYMBOL(PrintChar),
+			OLA_JIT_RUNTIME_SYMBOL(PrintString),
+			OLA_JIT_RUNTIME_SYMBOL(ReadInt),
+			OLA_JIT_RUNTIME_SYMBOL(ReadFloat),
+			OLA_JIT_RUNTIME_SYMBOL(ReadChar),
+			OLA_JIT_RUNTIME_SYMBOL(ReadString),
+
+			OLA_JIT_RUNTIME_SYMBOL(Fabs),
+			OLA_JIT_RUNTIME_SYMBOL(Fmod),
+			OLA_JIT_RUNTIME_SYMBOL(Ffma),
+			OLA_JIT_RUNTIME_SYMBOL(Fmax),
+			OLA_JIT_RUNTIME_SYMBOL(Fmin),
+			OLA_JIT_RUNTIME_SYMBOL(Ceil),
+			OLA_JIT_RUNTIME_SYMBOL(Floor),
+			OLA_JIT_RUNTIME_SYMBOL(Round),
+			OLA_JIT_RUNTIME_SYMBOL(Trunc),
+			OLA_JIT_RUNTIME_SYMBOL(Sqrt),
+			OLA_JIT_RUNTIME_SYMBOL(Cbrt),
+			OLA_JIT_RUNTIME_SYMBOL(Pow),
+			OLA_JIT_RUNTIME_SYMBOL(Log),
+			OLA_JIT_RUNTIME_SYMBOL(Log2),
+			OLA_JIT_RUNTIME_SYMBOL(Log10),
+			OLA_JIT_RUNTIME_SYMBOL(Exp),
+			OLA_JIT_RUNTIME_SYMBOL(Sin),
+			OLA_JIT_RUNTIME_SYMBOL(Cos),
+			OLA_JIT_RUNTIME_SYMBOL(Tan),
+			OLA_JIT_RUNTIME_SYMBOL(Asin),
+			OLA_JIT_RUNTIME_SYMBOL(Acos),
+			OLA_JIT_RUNTIME_SYMBOL(Atan),
+			OLA_JIT_RUNTIME_SYMBOL(Atan2),
+			OLA_JIT_RUNTIME_SYMBOL(Abs),
+			OLA_JIT_RUNTIME_SYMBOL(Min),
+			OLA_JIT_RUNTIME_SYMBOL(Max),
+
+			OLA_JIT_RUNTIME_SYMBOL(IsAlnum),
+			OLA_JIT_RUNTIME_SYMBOL(IsAlpha),
+			OLA_JIT_RUNTIME_SYMBOL(IsLower),
+			OLA_JIT_RUNTIME_SYMBOL(IsUpper),
+			OLA_JIT_RUNTIME_SYMBOL(IsDigit),
+			OLA_JIT_RUNTIME_SYMBOL(IsSpace),
+			OLA_JIT_RUNTIME_SYMBOL(ToLower),
+			OLA_JIT_RUNTIME_SYMBOL(ToUpper),
+			OLA_JIT_RUNTIME_SYMBOL(StringToFloat),
+			OLA_JIT_RUNTIME_SYMBOL(StringToInt),
+			OLA_JIT_RUNTIME_SYMBOL(StringCopy),
+
+			OLA_JIT_RUNTIME_SYMBOL(AllocateInts),
+			OLA_JIT_RUNTIME_SYMBOL(FreeInts),
+			OLA_JIT_RUNTIME_SYMBOL(AllocateFloats),
+			OLA_JIT_RUNTIME_SYMBOL(FreeFloats),
+			OLA_JIT_RUNTIME_SYMBOL(AllocateChars),
+			OLA_JIT_RUNTIME_SYMBOL(FreeChars),
+			OLA_JIT_RUNTIME_SYMBOL(AllocateBools),
+			OLA_JIT_RUNTIME_SYMBOL(FreeBools),
+		};
+#undef OLA_JIT_RUNTIME_SYMBOL
+
+		auto it = runtime_symbols.find(name);
+		if (it == runtime_symbols.end()) return nullptr;
+		switch (calling_convention)
+		{
+		case JITCallingConvention::Microsoft: return it->second.ms_abi_address;
+#if !defined(_WIN32)
+		case JITCallingConvention::SystemV:	  return it->second.host_address;
+#endif
+		}
+		return nullptr;
+	}
+}
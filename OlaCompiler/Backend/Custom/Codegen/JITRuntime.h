@@ -0,0 +1,21 @@
+#pragma once
+#include <string_view>
+
+//System V calling convention is only available to the JIT on hosts where it is the native one
+#if defined(_WIN32)
+#define OLA_JIT_MS_ABI
+#else
+#define OLA_JIT_MS_ABI __attribute__((ms_abi))
+#define OLA_JIT_SYSV_ABI
+#endif
+
+namespace ola
+{
+	enum class JITCallingConvention : Uint8
+	{
+		Microsoft,
+		SystemV
+	};
+
+	void* GetJITRuntimeSymbol(std::string_view name, JITCallingConvention calling_convention);
+}
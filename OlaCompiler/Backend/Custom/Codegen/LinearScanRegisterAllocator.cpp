@@ -31,16 +31,44 @@ namespace ola
 		gp_regs = target_reg_info.GetGPCalleeSavedRegisters();
 		fp_regs = target_reg_info.GetFPCalleeSavedRegisters();
 		frame_register = target_reg_info.GetFramePointerRegister();
+
+		//caller saved xmm registers need no saving, they can hold values that are not live across a call.
+		//argument registers are excluded since they are written outside of the live intervals when calls and parameters are lowered
+		fp_caller_saved_regs.clear();
+		for (Uint32 reg : target_reg_info.GetFPCallerSavedRegisters())
+		{
+			if (reg != target_reg_info.GetFPScratchRegister() && !target_reg_info.IsArgumentRegister(reg)) fp_caller_saved_regs.push_back(reg);
+		}
+
+		std::vector<Uint64> call_positions;
+		for (auto const& [MI, position] : liveness.instruction_numbering_map)
+		{
+			if (MI->GetOpcode() == InstCall) call_positions.push_back(position);
+		}
+		std::sort(call_positions.begin(), call_positions.end());
+		auto IsLiveAcrossCall = [&call_positions](LiveInterval const& LI)
+			{
+				auto it = std::upper_bound(call_positions.begin(), call_positions.end(), LI.begin);
+				return it != call_positions.end() && *it < LI.end;
+			};
+
 		for (LiveInterval& LI : live_intervals)
 		{
 			ExpireOldIntervals(LI);
-			if ((LI.is_float && fp_regs.empty()) || (!LI.is_float && gp_regs.empty()))
+			Bool const live_across_call = IsLiveAcrossCall(LI);
+			Bool const use_caller_saved = LI.is_float && !live_across_call && !fp_caller_saved_regs.empty();
+			if ((LI.is_float && fp_regs.empty() && !use_caller_saved) || (!LI.is_float && gp_regs.empty()))
 			{
-				SpillAtInterval(LI);
+				SpillAtInterval(LI, live_across_call);
 			}
 			else
 			{
-				if (LI.is_float)
+				if (use_caller_saved)
+				{
+					LI.reg = fp_caller_saved_regs.back();
+					fp_caller_saved_regs.pop_back();
+				}
+				else if (LI.is_float)
 				{
 					Uint32 reg = fp_regs.back();
 					fp_regs.pop_back();
@@ -78,7 +106,8 @@ namespace ola
 			if (interval->end >= LI.begin) break;
 			if (interval->is_float)
 			{
-				fp_regs.push_back(interval->reg);
+				if (M.GetTarget().GetRegisterInfo().IsCallerSaved(interval->reg)) fp_caller_saved_regs.push_back(interval->reg);
+				else fp_regs.push_back(interval->reg);
 			}
 			else
 			{
@@ -97,16 +126,22 @@ namespace ola
 	//		add i to active, sorted by increasing end point
 	//	else
 	//		location[i] ← new stack location
-	void LinearScanRegisterAllocator::SpillAtInterval(LiveInterval& LI)
+	void LinearScanRegisterAllocator::SpillAtInterval(LiveInterval& LI, Bool live_across_call)
 	{
-		auto spill = active.back();
-		if (spill->end > LI.end)
+		//only an interval of the same register class can give up its register, and a caller saved one only if LI doesn't live across a call
+		TargetRegisterInfo const& target_reg_info = M.GetTarget().GetRegisterInfo();
+		auto spill_it = std::find_if(active.rbegin(), active.rend(), [&](LiveInterval* interval)
+			{
+				return interval->is_float == LI.is_float && (!live_across_call || !target_reg_info.IsCallerSaved(interval->reg));
+			});
+		if (spill_it != active.rend() && (*spill_it)->end > LI.end)
 		{
-			Uint32 vreg = LI.vreg;
+			LiveInterval* spill = *spill_it;
 			LI.reg = spill->reg;
 			vreg2reg_map[LI.vreg] = LI.reg;
 			spill->spilled = true;
 			vreg2reg_map.erase(spill->vreg);
+			active.erase(std::next(spill_it).base());
 			active.push_back(&LI);
 			sort(active.begin(), active.end(), [](LiveInterval* L, LiveInterval* R) { return L->end < R->end; });
 		}
@@ -119,7 +154,7 @@ namespace ola
 	void LinearScanRegisterAllocator::Finalize(MachineFunction& MF, std::vector<LiveInterval>& intervals)
 	{
 		TargetInstInfo const& target_inst_info = M.GetTarget().GetInstInfo();
-		std::unordered_map<Uint32, MachineOperand*> vreg_stack_map;
+		std::unordered_map<Uint32, MachineOperand> vreg_stack_map;
 		for (auto& MBB : MF.Blocks())
 		{
 			for (MachineInstruction& MI : MBB->Instructions())
@@ -138,17 +173,13 @@ namespace ola
 					}
 					else
 					{
-						MachineOperand* existing_stack_loc = vreg_stack_map[vreg_id];
-						if (existing_stack_loc != nullptr)
-						{
-							MI.SetOperand(idx, *existing_stack_loc);
-						}
-						else
+						if (!vreg_stack_map.contains(vreg_id))
 						{
-							MachineOperand& new_stack_loc = MF.AllocateLocalStack(MachineType::Int64);
-							vreg_stack_map[vreg_id] = &new_stack_loc;
-							MI.SetOperand(idx, new_stack_loc);
+							vreg_stack_map[vreg_id] = MF.AllocateSpillStack(MachineType::Int64);
 						}
+						//spilled floating point values keep their type so they are still accessed with SSE instructions
+						MachineType stack_type = MO.GetType() == MachineType::Float64 ? MachineType::Float64 : MachineType::Int64;
+						MI.SetOperand(idx, MachineOperand::StackObject(vreg_stack_map[vreg_id].GetStackOffset(), stack_type));
 					}
 				}
 			}
@@ -17,12 +17,13 @@ namespace ola
 		std::vector<LiveInterval*> active;
 		std::vector<Uint32> gp_regs;
 		std::vector<Uint32> fp_regs;
+		std::vector<Uint32> fp_caller_saved_regs;
 		Uint32 frame_register;
 		std::unordered_map<Uint32, Uint32> vreg2reg_map;
 
 	private:
 		void ExpireOldIntervals(LiveInterval& LI);
-		void SpillAtInterval(LiveInterval& LI);
+		void SpillAtInterval(LiveInterval& LI, Bool live_across_call);
 		void Finalize(MachineFunction&, std::vector<LiveInterval>&);
 	};
 }
\ No newline at end of file
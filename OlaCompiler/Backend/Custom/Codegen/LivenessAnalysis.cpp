@@ -80,6 +80,67 @@ namespace ola
 		}
 	}
 
+	struct BlockLiveness
+	{
+		std::unordered_set<Uint32> uses;
+		std::unordered_set<Uint32> defs;
+		std::unordered_set<Uint32> live_in;
+		std::unordered_set<Uint32> live_out;
+	};
+
+	//standard backward dataflow: live_in = uses U (live_out - defs), live_out = U live_in(successor)
+	static std::unordered_map<MachineBasicBlock*, BlockLiveness> ComputeBlockLiveness(MachineFunction& MF, TargetInstInfo const& target_inst_info)
+	{
+		std::unordered_map<MachineBasicBlock*, BlockLiveness> block_liveness;
+		for (auto& MBB : MF.Blocks())
+		{
+			BlockLiveness& liveness = block_liveness[MBB.get()];
+			for (MachineInstruction& MI : MBB->Instructions())
+			{
+				InstInfo const& inst_info = target_inst_info.GetInstInfo(MI);
+				for (Uint32 idx = 0; idx < inst_info.GetOperandCount(); ++idx)
+				{
+					MachineOperand& MO = MI.GetOperand(idx);
+					if (!IsOperandVReg(MO) || !inst_info.HasOpFlag(idx, OperandFlagUse)) continue;
+					Uint32 reg_id = GetRegAsUint(MO);
+					if (!liveness.defs.contains(reg_id)) liveness.uses.insert(reg_id);
+				}
+				for (Uint32 idx = 0; idx < inst_info.GetOperandCount(); ++idx)
+				{
+					MachineOperand& MO = MI.GetOperand(idx);
+					if (!IsOperandVReg(MO) || !inst_info.HasOpFlag(idx, OperandFlagDef)) continue;
+					liveness.defs.insert(GetRegAsUint(MO));
+				}
+			}
+		}
+
+		Bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (auto it = MF.Blocks().rbegin(); it != MF.Blocks().rend(); ++it)
+			{
+				MachineBasicBlock* MBB = it->get();
+				BlockLiveness& liveness = block_liveness[MBB];
+				for (MachineBasicBlock* succ : MBB->Successors())
+				{
+					for (Uint32 reg_id : block_liveness[succ].live_in) liveness.live_out.insert(reg_id);
+				}
+				std::unordered_set<Uint32> live_in = liveness.uses;
+				for (Uint32 reg_id : liveness.live_out)
+				{
+					if (!liveness.defs.contains(reg_id)) live_in.insert(reg_id);
+				}
+				if (live_in.size() != liveness.live_in.size())
+				{
+					liveness.live_in = std::move(live_in);
+					changed = true;
+				}
+			}
+		}
+		return block_liveness;
+	}
+
 	LivenessAnalysisResult DoLivenessAnalysis(MachineModule& M, MachineFunction& MF)
 	{
 		LivenessAnalysisResult result{};
@@ -131,6 +192,31 @@ namespace ola
 			}
 		}
 
+		//instruction numbers of a block are not contiguous with its successors, so a value live into or out of a block
+		//has to cover the whole numbering range of that block, otherwise a register would be reused inside a loop body
+		//while the value still flows around the back edge
+		std::unordered_map<MachineBasicBlock*, BlockLiveness> block_liveness = ComputeBlockLiveness(MF, target_inst_info);
+		for (auto& MBB : MF.Blocks())
+		{
+			if (MBB->Instructions().empty() || !result.instruction_numbering_map.contains(&MBB->Instructions().front())) continue;
+			Uint64 block_begin = UINT64_MAX, block_end = 0;
+			for (MachineInstruction& MI : MBB->Instructions())
+			{
+				Uint64 const instruction_idx = result.instruction_numbering_map[&MI];
+				block_begin = std::min(block_begin, instruction_idx);
+				block_end = std::max(block_end, instruction_idx + 1);
+			}
+			BlockLiveness const& liveness = block_liveness[MBB.get()];
+			for (Uint32 reg_id : liveness.live_in)
+			{
+				if (auto it = live_interval_map.find(reg_id); it != live_interval_map.end()) it->second.Extend(block_begin);
+			}
+			for (Uint32 reg_id : liveness.live_out)
+			{
+				if (auto it = live_interval_map.find(reg_id); it != live_interval_map.end()) it->second.Extend(block_end);
+			}
+		}
+
 		std::vector<LiveInterval> live_intervals;
 		for (auto&& [vreg, interval] : live_interval_map)
 		{
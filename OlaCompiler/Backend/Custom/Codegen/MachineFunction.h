@@ -41,14 +41,28 @@ namespace ola
 		{
 			argument_stack_offset += size;
 		}
+		//spill slots are handed out below the argument stack, the frame lowering moves them next to the locals
+		MachineOperand AllocateSpillStack(MachineType type)
+		{
+			spill_stack_offset += GetOperandSize(type);
+			return MachineOperand::StackObject(-(local_stack_offset + argument_stack_offset + spill_stack_offset), type);
+		}
 		Int32 GetStackAllocationSize() const
 		{
-			return local_stack_offset + argument_stack_offset;
+			return local_stack_offset + argument_stack_offset + spill_stack_offset;
 		}
 		Int32 GetLocalStackAllocationSize() const
 		{
 			return local_stack_offset;
 		}
+		Int32 GetArgumentStackAllocationSize() const
+		{
+			return argument_stack_offset;
+		}
+		Int32 GetSpillStackAllocationSize() const
+		{
+			return spill_stack_offset;
+		}
 		void AddCalleeSavedArg(Uint32 reg, Int32 offset, MachineType type)
 		{
 			callee_saved_args.emplace_back(reg, offset, type);
@@ -83,6 +97,7 @@ namespace ola
 		std::vector<MachineOperand> args;
 		Int32 local_stack_offset = 0;
 		Int32 argument_stack_offset = 0;
+		Int32 spill_stack_offset = 0;
 		std::vector<MachineOperand> local_stack_objects;
 		std::vector<std::tuple<Uint32, Int32, MachineType>> callee_saved_args;
 
@@ -12,12 +12,14 @@
 #include "Backend/Custom/IR/FunctionPass.h"
 #include "Backend/Custom/IR/Passes/DominatorTreeAnalysisPass.h"
 #include "Core/Log.h"
+#include "Utility/TimeReport.h"
 
 namespace ola
 {
 	MachineModule::MachineModule(IRModule& ir_module, Target const& target, FunctionAnalysisManager& FAM) 
 		: machine_ctx(*this), target(target), FAM(FAM)
 	{
+		OLA_TIME_REPORT_SCOPE("Machine Code Generation");
 		LowerModule(&ir_module);
 	}
 
@@ -30,7 +32,27 @@ namespace ola
 
 	void MachineModule::EmitAssembly(std::string_view assembly_file)
 	{
-		target.EmitAssembly(*this, assembly_file);
+		std::ofstream asm_stream(assembly_file.data());
+		EmitAssembly(asm_stream);
+	}
+
+	void MachineModule::EmitAssembly(std::ostream& os)
+	{
+		OLA_TIME_REPORT_SCOPE("Assembly Printing");
+		target.EmitAssembly(*this, os);
+	}
+
+	Bool MachineModule::EmitObject(std::string_view object_file)
+	{
+		OLA_TIME_REPORT_SCOPE("Object Emission");
+		std::ofstream object_stream(object_file.data(), std::ios::binary);
+		return target.EmitObject(*this, object_stream);
+	}
+
+	Bool MachineModule::EmitObject(ObjectFile& object)
+	{
+		OLA_TIME_REPORT_SCOPE("Object Emission");
+		return target.EmitObject(*this, object);
 	}
 
 	void MachineModule::LowerModule(IRModule* ir_module)
@@ -124,16 +146,26 @@ namespace ola
 				Function* F = cast<Function>(GV);
 				if (!F->IsDeclaration())
 				{
-					LowerFunction(F);
+					{
+						OLA_TIME_REPORT_FINE_SCOPE("Instruction Selection");
+						LowerFunction(F);
+					}
 
 					MachineGlobal* global = machine_ctx.GetGlobal(F);
 					MachineFunction& MF = *static_cast<MachineFunction*>(global->GetRelocable());
-					LegalizeInstructions(MF);
+					{
+						OLA_TIME_REPORT_FINE_SCOPE("Legalization");
+						LegalizeInstructions(MF);
+					}
 
 					LinearScanRegisterAllocator register_allocator(*this);
-					register_allocator.AssignRegisters(MF);
+					{
+						OLA_TIME_REPORT_FINE_SCOPE("Register Allocation");
+						register_allocator.AssignRegisters(MF);
+					}
 					machine_ctx.SetUsedRegistersInfo(&register_allocator.GetUsedRegistersInfo());
 
+					OLA_TIME_REPORT_FINE_SCOPE("Post-RA Lowering");
 					machine_ctx.SetCurrentBasicBlock(machine_ctx.GetBlock(&F->GetEntryBlock()));
 					frame_info.EmitProloguePostRA(MF, machine_ctx);
 					machine_ctx.SetCurrentBasicBlock(machine_ctx.GetBlock(&F->GetLastBlock()));
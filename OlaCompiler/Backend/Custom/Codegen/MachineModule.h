@@ -32,6 +32,7 @@ namespace ola
 	class MachineFunction;
 
 	class Target;
+	class ObjectFile;
 
 	class MachineModule
 	{
@@ -44,6 +45,9 @@ namespace ola
 
 		void EmitMIR(std::string_view mir_file);
 		void EmitAssembly(std::string_view assembly_file);
+		void EmitAssembly(std::ostream& os);
+		Bool EmitObject(std::string_view object_file);
+		Bool EmitObject(ObjectFile& object);
 
 	protected:
 		std::vector<MachineGlobal> globals;
@@ -0,0 +1,142 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <cstring>
+#include <algorithm>
+
+namespace ola
+{
+	enum class ObjectSectionKind : Uint8
+	{
+		Text,
+		Data,
+		ReadOnly,
+		BSS
+	};
+
+	enum class ObjectRelocationKind : Uint8
+	{
+		Abs64,
+		PCRel32,
+		Call32
+	};
+
+	struct ObjectRelocation
+	{
+		Uint64 offset;
+		Uint32 symbol;
+		ObjectRelocationKind kind;
+		Int64 addend;
+	};
+
+	struct ObjectSection
+	{
+		std::string name;
+		ObjectSectionKind kind;
+		Uint32 alignment = 1;
+		std::vector<Uint8> data;
+		Uint64 bss_size = 0;
+		std::vector<ObjectRelocation> relocations;
+
+		Uint64 GetSize() const
+		{
+			return kind == ObjectSectionKind::BSS ? bss_size : data.size();
+		}
+		void AlignTo(Uint32 align)
+		{
+			if (align <= 1) return;
+			alignment = std::max(alignment, align);
+			Uint64 const aligned_size = OLA_ALIGN_UP(GetSize(), align);
+			if (kind == ObjectSectionKind::BSS) bss_size = aligned_size;
+			else data.resize(aligned_size, 0);
+		}
+		template<typename T>
+		void Append(T value)
+		{
+			Uint8 bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+			data.insert(data.end(), bytes, bytes + sizeof(T));
+		}
+		template<typename T>
+		void Patch(Uint64 offset, T value)
+		{
+			OLA_ASSERT(offset + sizeof(T) <= data.size());
+			std::memcpy(data.data() + offset, &value, sizeof(T));
+		}
+	};
+
+	enum class ObjectSymbolBinding : Uint8
+	{
+		Local,
+		Global
+	};
+
+	enum class ObjectSymbolType : Uint8
+	{
+		None,
+		Function,
+		Object
+	};
+
+	struct ObjectSymbol
+	{
+		static constexpr Uint32 UndefinedSection = Uint32(-1);
+
+		std::string name;
+		Uint32 section = UndefinedSection;
+		Uint64 value = 0;
+		Uint64 size = 0;
+		ObjectSymbolBinding binding = ObjectSymbolBinding::Global;
+		ObjectSymbolType type = ObjectSymbolType::None;
+
+		Bool IsDefined() const { return section != UndefinedSection; }
+	};
+
+	class ObjectFile
+	{
+	public:
+		ObjectFile()
+		{
+			sections.push_back(ObjectSection{ .name = ".text",   .kind = ObjectSectionKind::Text, .alignment = 1, .data = {}, .bss_size = 0, .relocations = {} });
+			sections.push_back(ObjectSection{ .name = ".data",   .kind = ObjectSectionKind::Data, .alignment = 1, .data = {}, .bss_size = 0, .relocations = {} });
+			sections.push_back(ObjectSection{ .name = ".rodata", .kind = ObjectSectionKind::ReadOnly, .alignment = 1, .data = {}, .bss_size = 0, .relocations = {} });
+			sections.push_back(ObjectSection{ .name = ".bss",    .kind = ObjectSectionKind::BSS, .alignment = 1, .data = {}, .bss_size = 0, .relocations = {} });
+		}
+
+		ObjectSection& GetSection(ObjectSectionKind kind) { return sections[static_cast<Uint32>(kind)]; }
+		std::vector<ObjectSection> const& GetSections() const { return sections; }
+		std::vector<ObjectSymbol> const& GetSymbols() const { return symbols; }
+
+		Uint32 GetOrAddSymbol(std::string_view name)
+		{
+			std::string key(name);
+			if (auto it = symbol_index_map.find(key); it != symbol_index_map.end()) return it->second;
+			Uint32 const index = static_cast<Uint32>(symbols.size());
+			symbols.push_back(ObjectSymbol{ .name = key });
+			symbol_index_map[std::move(key)] = index;
+			return index;
+		}
+		Uint32 DefineSymbol(std::string_view name, ObjectSectionKind section, Uint64 value, ObjectSymbolBinding binding, ObjectSymbolType type)
+		{
+			Uint32 const index = GetOrAddSymbol(name);
+			ObjectSymbol& symbol = symbols[index];
+			OLA_ASSERT_MSG(!symbol.IsDefined(), "Symbol defined more than once!");
+			symbol.section = static_cast<Uint32>(section);
+			symbol.value = value;
+			symbol.binding = binding;
+			symbol.type = type;
+			return index;
+		}
+		void SetSymbolSize(Uint32 index, Uint64 size)
+		{
+			symbols[index].size = size;
+		}
+
+	private:
+		std::vector<ObjectSection> sections;
+		std::vector<ObjectSymbol> symbols;
+		std::unordered_map<std::string, Uint32> symbol_index_map;
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <list>
+#include <iosfwd>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -12,6 +13,7 @@ namespace ola
 	class ReturnInst;
 	class MachineInstruction;
 	class MachineFunction;
+	class ObjectFile;
 
 	class TargetDataLayout
 	{
@@ -94,6 +96,7 @@ namespace ola
 		virtual std::vector<Uint32> GetFPCalleeSavedRegisters() const = 0;
 		virtual Bool IsCallerSaved(Uint32) const = 0;
 		virtual Bool IsCalleeSaved(Uint32) const = 0;
+		virtual Bool IsArgumentRegister(Uint32) const = 0;
 	};
 
 	class MachineContext;
@@ -137,6 +140,9 @@ namespace ola
 		virtual TargetRegisterInfo const& GetRegisterInfo() const = 0;
 		virtual TargetISelInfo const& GetISelInfo() const = 0;
 		virtual TargetFrameInfo const& GetFrameInfo() const = 0;
-		virtual void EmitAssembly(MachineModule& M, std::string_view file) const = 0;
+		virtual void EmitAssembly(MachineModule& M, std::ostream& os) const = 0;
+		//Object emission fails if an instruction is left with operands that cannot be encoded
+		virtual Bool EmitObject(MachineModule& M, std::ostream& os) const = 0;
+		virtual Bool EmitObject(MachineModule& M, ObjectFile& object) const = 0;
 	};
 }
\ No newline at end of file
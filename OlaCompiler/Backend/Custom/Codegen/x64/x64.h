@@ -25,6 +25,26 @@ namespace ola::x64
 	{
 		return r >= FPRBegin && r <= FPREnd;
 	}
+	inline constexpr Uint8 GetRegisterEncoding(Uint32 r)
+	{
+		switch (r)
+		{
+		case RAX: return 0;
+		case RCX: return 1;
+		case RDX: return 2;
+		case RBX: return 3;
+		case RSP: return 4;
+		case RBP: return 5;
+		case RSI: return 6;
+		case RDI: return 7;
+		default:
+			if (r >= R8 && r <= R15) return static_cast<Uint8>(r - R8 + 8);
+			if (r >= XMM0 && r <= XMM15) return static_cast<Uint8>(r - XMM0);
+		}
+		OLA_ASSERT_MSG(false, "Invalid register!");
+		return 0;
+	}
+
 	inline constexpr Bool IsCallerSaved(Uint32 r)
 	{
 		switch (r)
@@ -76,6 +96,75 @@ namespace ola::x64
 		}
 	}
 
+	inline constexpr Bool IsArgumentRegister(Uint32 r)
+	{
+		switch (r)
+		{
+		case RCX:
+		case RDX:
+		case R8:
+		case R9:
+		case XMM0:
+		case XMM1:
+		case XMM2:
+		case XMM3:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline constexpr Bool IsSysVCallerSaved(Uint32 r)
+	{
+		switch (r)
+		{
+		case RAX:
+		case RCX:
+		case RDX:
+		case RSI:
+		case RDI:
+		case R8:
+		case R9:
+		case R10:
+		case R11:
+			return true;
+		default:
+			return r >= FPRBegin && r < FPREnd;
+		}
+	}
+	inline constexpr Bool IsSysVCalleeSaved(Uint32 r)
+	{
+		switch (r)
+		{
+		case RBX:
+		case RBP:
+		case RSP:
+		case R12:
+		case R13:
+		case R14:
+		case R15:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline constexpr Bool IsSysVArgumentRegister(Uint32 r)
+	{
+		switch (r)
+		{
+		case RDI:
+		case RSI:
+		case RDX:
+		case RCX:
+		case R8:
+		case R9:
+			return true;
+		default:
+			return r >= XMM0 && r <= XMM7;
+		}
+	}
+
 	enum x64Inst : Uint32
 	{
 		x64InstBegin = ISASpecificBegin,
@@ -1,4 +1,5 @@
 #pragma once
+#include <unordered_map>
 #include "Backend/Custom/Codegen/AsmPrinter.h"
 
 namespace ola
@@ -20,6 +21,10 @@ namespace ola
 		x64AsmPrinter(std::ostream& os) : AsmPrinter(os) {}
 		virtual void PrintModule(MachineModule const& M) override;
 
+	private:
+		std::unordered_map<Int64, std::string> fp_constant_pool;
+		std::unordered_map<Int64, std::string> int_constant_pool;
+
 	private:
 		virtual std::string GetSectionLabel(SectionId section) const override
 		{
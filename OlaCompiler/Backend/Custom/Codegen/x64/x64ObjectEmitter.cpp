@@ -0,0 +1,666 @@
+#include <variant>
+#include "x64ObjectEmitter.h"
+#include "x64.h"
+#include "Backend/Custom/Codegen/MachineModule.h"
+#include "Backend/Custom/Codegen/MachineBasicBlock.h"
+#include "Backend/Custom/Codegen/MachineFunction.h"
+#include "Backend/Custom/Codegen/MachineStorage.h"
+#include "Core/Log.h"
+
+namespace ola
+{
+	namespace
+	{
+		constexpr Uint8 x64PrefixOpSize = 0x66;
+		constexpr Uint8 x64PrefixRepNE = 0xF2;
+
+		enum x64ALUOpcode : Uint8
+		{
+			x64ALU_Add = 0x00,
+			x64ALU_Or  = 0x08,
+			x64ALU_And = 0x20,
+			x64ALU_Sub = 0x28,
+			x64ALU_Xor = 0x30,
+			x64ALU_Cmp = 0x38,
+		};
+
+		Bool FitsInt8(Int64 value)
+		{
+			return value >= INT8_MIN && value <= INT8_MAX;
+		}
+		Bool FitsInt32(Int64 value)
+		{
+			return value >= INT32_MIN && value <= INT32_MAX;
+		}
+
+		Uint8 GetALUExtension(Uint8 alu_opcode)
+		{
+			return alu_opcode >> 3;
+		}
+
+		Uint8 GetSetCCOpcode(Uint32 opcode)
+		{
+			switch (opcode)
+			{
+			case x64::InstSetE:  return 0x94;
+			case x64::InstSetNE: return 0x95;
+			case x64::InstSetGT: return 0x9F;
+			case x64::InstSetGE: return 0x9D;
+			case x64::InstSetLT: return 0x9C;
+			case x64::InstSetLE: return 0x9E;
+			case x64::InstSetA:  return 0x97;
+			case x64::InstSetAE: return 0x93;
+			case x64::InstSetB:  return 0x92;
+			case x64::InstSetBE: return 0x96;
+			}
+			OLA_ASSERT(false);
+			return 0;
+		}
+
+		//.string directives accept the same escape sequences as the assembler we used to go through
+		std::string UnescapeString(std::string_view str)
+		{
+			std::string result;
+			result.reserve(str.size());
+			for (Uint64 i = 0; i < str.size(); ++i)
+			{
+				Char c = str[i];
+				if (c != '\\' || i + 1 == str.size())
+				{
+					result.push_back(c);
+					continue;
+				}
+				c = str[++i];
+				switch (c)
+				{
+				case 'n': result.push_back('\n'); break;
+				case 't': result.push_back('\t'); break;
+				case 'r': result.push_back('\r'); break;
+				case 'b': result.push_back('\b'); break;
+				case 'f': result.push_back('\f'); break;
+				case '0': case '1': case '2': case '3':
+				case '4': case '5': case '6': case '7':
+				{
+					Int value = 0;
+					for (Int digits = 0; digits < 3 && i < str.size() && str[i] >= '0' && str[i] <= '7'; ++digits, ++i)
+					{
+						value = value * 8 + (str[i] - '0');
+					}
+					--i;
+					result.push_back(static_cast<Char>(value));
+				}
+				break;
+				default: result.push_back(c); break;
+				}
+			}
+			return result;
+		}
+	}
+
+	Bool x64ObjectEmitter::EmitModule(MachineModule const& M)
+	{
+		for (MachineGlobal const& global : M.GetGlobals())
+		{
+			MachineRelocable* relocable = global.GetRelocable();
+			if (relocable->IsFunction())
+			{
+				MachineFunction const& MF = *static_cast<MachineFunction*>(relocable);
+				if (MF.IsDeclaration()) continue;
+
+				ObjectSymbolBinding binding = global.GetLinkage() == Linkage::External ? ObjectSymbolBinding::Global : ObjectSymbolBinding::Local;
+				Uint64 const function_start = text.GetSize();
+				Uint32 symbol = object.DefineSymbol(MF.GetSymbol(), ObjectSectionKind::Text, function_start, binding, ObjectSymbolType::Function);
+				EmitFunction(MF);
+				object.SetSymbolSize(symbol, text.GetSize() - function_start);
+			}
+			else if (relocable->IsDataStorage())
+			{
+				MachineDataStorage const& MDS = *static_cast<MachineDataStorage*>(relocable);
+				ObjectSection& section = object.GetSection(MDS.IsReadOnly() ? ObjectSectionKind::ReadOnly : ObjectSectionKind::Data);
+				section.AlignTo(global.GetAlignment());
+
+				Uint64 const data_start = section.GetSize();
+				Uint32 symbol = object.DefineSymbol(MDS.GetSymbol(), section.kind, data_start, ObjectSymbolBinding::Local, ObjectSymbolType::Object);
+				for (auto const& element : MDS.GetStorage())
+				{
+					std::visit([&](auto&& arg)
+						{
+							using T = std::decay_t<decltype(arg)>;
+							if constexpr (std::is_same_v<T, std::string>)
+							{
+								std::string str = UnescapeString(arg);
+								section.data.insert(section.data.end(), str.begin(), str.end());
+								section.Append<Uint8>(0);
+							}
+							else section.Append<T>(arg);
+						}, element);
+				}
+				object.SetSymbolSize(symbol, section.GetSize() - data_start);
+			}
+			else if (relocable->IsZeroStorage())
+			{
+				MachineZeroStorage const& MZS = *static_cast<MachineZeroStorage*>(relocable);
+				ObjectSection& bss = object.GetSection(ObjectSectionKind::BSS);
+				bss.AlignTo(global.GetAlignment());
+
+				Uint32 symbol = object.DefineSymbol(MZS.GetSymbol(), ObjectSectionKind::BSS, bss.bss_size, ObjectSymbolBinding::Local, ObjectSymbolType::Object);
+				object.SetSymbolSize(symbol, MZS.GetSize());
+				bss.bss_size += MZS.GetSize();
+			}
+			else OLA_ASSERT_MSG(false, "Invalid relocable kind!");
+			if (encoding_failed) return false;
+		}
+		return true;
+	}
+
+	void x64ObjectEmitter::EmitFunction(MachineFunction const& MF)
+	{
+		block_offsets.clear();
+		branch_fixups.clear();
+		current_function = MF.GetSymbol();
+		for (auto const& MBB : MF.Blocks())
+		{
+			block_offsets[MBB.get()] = text.GetSize();
+			for (MachineInstruction const& MI : MBB->Instructions())
+			{
+				if (MI.IsDead()) continue;
+				EmitInstruction(MI);
+				if (encoding_failed) return;
+			}
+		}
+		for (BranchFixup const& fixup : branch_fixups)
+		{
+			OLA_ASSERT_MSG(block_offsets.contains(fixup.target), "Branch target is not a block of the current function!");
+			Int64 displacement = static_cast<Int64>(block_offsets[fixup.target]) - static_cast<Int64>(fixup.offset + sizeof(Int32));
+			text.Patch<Int32>(fixup.offset, static_cast<Int32>(displacement));
+		}
+	}
+
+	void x64ObjectEmitter::EmitInstruction(MachineInstruction const& MI)
+	{
+		Uint32 const opcode = MI.GetOpcode();
+		current_opcode = opcode;
+		switch (opcode)
+		{
+		case InstPush:
+		case InstPop:
+		{
+			Operand op = GetOperand(MI.GetOp<0>());
+			if (op.IsReg())
+			{
+				if (op.reg & 8) text.Append<Uint8>(0x41);
+				text.Append<Uint8>((opcode == InstPush ? 0x50 : 0x58) + (op.reg & 7));
+			}
+			else if (op.IsMem())
+			{
+				if (opcode == InstPush) Encode(0, { 0xFF }, 6, false, op, false);
+				else Encode(0, { 0x8F }, 0, false, op, false);
+			}
+			else if (VerifyOperands(opcode == InstPush && FitsInt32(op.imm), "only a 32-bit immediate can be pushed"))
+			{
+				text.Append<Uint8>(0x68);
+				EncodeImm(op.imm, 4);
+			}
+		}
+		break;
+		case InstCall:
+		{
+			MachineOperand const& callee = MI.GetOp<0>();
+			if (callee.IsRelocable() && callee.GetRelocable()->IsFunction())
+			{
+				text.Append<Uint8>(0xE8);
+				Uint32 symbol = object.GetOrAddSymbol(callee.GetRelocable()->GetSymbol());
+				text.relocations.push_back(ObjectRelocation{ .offset = text.GetSize(), .symbol = symbol, .kind = ObjectRelocationKind::Call32, .addend = -4 });
+				text.Append<Int32>(0);
+			}
+			else
+			{
+				Operand op = GetOperand(callee);
+				op.size = 8;
+				Encode(0, { 0xFF }, 2, false, op, false);
+			}
+		}
+		break;
+		case InstNeg:
+		case InstNot:
+		case InstSDiv:
+		{
+			Uint8 ext = opcode == InstNeg ? 3 : (opcode == InstNot ? 2 : 7);
+			Operand op = GetOperand(MI.GetOp<0>());
+			if (!VerifyOperands(!op.IsImm(), "operand cannot be an immediate")) break;
+			EmitUnaryGroup3(ext, op);
+		}
+		break;
+		case x64::InstSetE:
+		case x64::InstSetNE:
+		case x64::InstSetGT:
+		case x64::InstSetGE:
+		case x64::InstSetLT:
+		case x64::InstSetLE:
+		case x64::InstSetA:
+		case x64::InstSetAE:
+		case x64::InstSetB:
+		case x64::InstSetBE:
+		{
+			Operand op = GetOperand(MI.GetOp<0>());
+			if (!VerifyOperands(!op.IsImm(), "destination cannot be an immediate")) break;
+			op.size = 1;
+			Encode(0, { 0x0F, GetSetCCOpcode(opcode) }, 0, false, op, false);
+		}
+		break;
+		case InstJump:
+		case InstJE:
+		case InstJNE:
+		{
+			MachineOperand const& dst = MI.GetOp<0>();
+			OLA_ASSERT(dst.IsRelocable() && dst.GetRelocable()->IsBlock());
+			MachineBasicBlock const* target = static_cast<MachineBasicBlock const*>(dst.GetRelocable());
+			if (opcode == InstJump)		EncodeBranch({ 0xE9 }, target);
+			else if (opcode == InstJE)	EncodeBranch({ 0x0F, 0x84 }, target);
+			else						EncodeBranch({ 0x0F, 0x85 }, target);
+		}
+		break;
+		case InstRet:
+		{
+			text.Append<Uint8>(0xC3);
+		}
+		break;
+		case x64::InstCqo:
+		{
+			text.Append<Uint8>(0x48);
+			text.Append<Uint8>(0x99);
+		}
+		break;
+		case InstAdd:
+		case InstSub:
+		case InstAnd:
+		case InstOr:
+		case InstXor:
+		case InstICmp:
+		{
+			Uint8 alu_opcode = x64ALU_Add;
+			switch (opcode)
+			{
+			case InstSub:  alu_opcode = x64ALU_Sub; break;
+			case InstAnd:  alu_opcode = x64ALU_And; break;
+			case InstOr:   alu_opcode = x64ALU_Or;  break;
+			case InstXor:  alu_opcode = x64ALU_Xor; break;
+			case InstICmp: alu_opcode = x64ALU_Cmp; break;
+			}
+			EmitALU(alu_opcode, GetALUExtension(alu_opcode), GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>()));
+		}
+		break;
+		case InstShl:
+		case InstAShr:
+		case InstLShr:
+		{
+			Uint8 ext = opcode == InstShl ? 4 : (opcode == InstLShr ? 5 : 7);
+			EmitShift(ext, GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>()));
+		}
+		break;
+		case InstTest:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>());
+			Operand src = GetOperand(MI.GetOp<1>());
+			if (!VerifyOperands(!dst.IsImm(), "first operand cannot be an immediate")) break;
+			if (!VerifyOperands(!(dst.IsMem() && src.IsMem()), "both operands are in memory")) break;
+			Bool const is_byte = dst.size == 1;
+			if (src.IsImm())
+			{
+				Encode(0, { Uint8(is_byte ? 0xF6 : 0xF7) }, 0, false, dst, !is_byte, is_byte ? 1 : 4);
+				EncodeImm(src.imm, is_byte ? 1 : 4);
+			}
+			else if (src.IsReg())
+			{
+				Encode(0, { Uint8(is_byte ? 0x84 : 0x85) }, src.reg, is_byte, dst, !is_byte);
+			}
+			else
+			{
+				Encode(0, { Uint8(is_byte ? 0x84 : 0x85) }, dst.reg, is_byte, src, !is_byte);
+			}
+		}
+		break;
+		case InstSMul:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>());
+			Operand src = GetOperand(MI.GetOp<1>());
+			if (!VerifyOperands(dst.IsReg(), "imul destination must be a register")) break;
+			if (src.IsImm())
+			{
+				if (!VerifyOperands(FitsInt32(src.imm), "immediate does not fit in 32 bits")) break;
+				Bool const short_imm = FitsInt8(src.imm);
+				Encode(0, { Uint8(short_imm ? 0x6B : 0x69) }, dst.reg, false, dst, true, short_imm ? 1 : 4);
+				EncodeImm(src.imm, short_imm ? 1 : 4);
+			}
+			else
+			{
+				Encode(0, { 0x0F, 0xAF }, dst.reg, false, src, true);
+			}
+		}
+		break;
+		case InstStore:
+		{
+			EmitMove(GetOperand(MI.GetOp<0>(), true), GetOperand(MI.GetOp<1>()));
+		}
+		break;
+		case InstLoad:
+		{
+			EmitMove(GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>(), true));
+		}
+		break;
+		case InstMove:
+		{
+			EmitMove(GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>()));
+		}
+		break;
+		case InstCMoveEQ:
+		case InstCMoveNE:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>());
+			Operand src = GetOperand(MI.GetOp<1>());
+			if (!VerifyOperands(dst.IsReg(), "cmov destination must be a register")) break;
+			if (!VerifyOperands(!src.IsImm(), "cmov source cannot be an immediate")) break;
+			Encode(0, { 0x0F, Uint8(opcode == InstCMoveEQ ? 0x44 : 0x45) }, dst.reg, false, src, true);
+		}
+		break;
+		case InstZExt:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>());
+			Operand src = GetOperand(MI.GetOp<1>());
+			if (!VerifyOperands(dst.IsReg(), "movzx destination must be a register")) break;
+			if (!VerifyOperands(!src.IsImm(), "movzx source cannot be an immediate")) break;
+			src.size = 1;
+			Encode(0, { 0x0F, 0xB6 }, dst.reg, false, src, dst.size == 8);
+		}
+		break;
+		case InstLoadGlobalAddress:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>());
+			Operand src = GetOperand(MI.GetOp<1>());
+			if (!VerifyOperands(dst.IsReg() && src.IsMem(), "lea needs a register destination and a memory source")) break;
+			Encode(0, { 0x8D }, dst.reg, false, src, true);
+		}
+		break;
+		case x64::InstStoreFP:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>(), true);
+			Operand src = GetOperand(MI.GetOp<1>());
+			if (!VerifyOperands(dst.IsMem() && src.IsReg(), "movsd store needs a memory destination and a register source")) break;
+			Encode(x64PrefixRepNE, { 0x0F, 0x11 }, src.reg, false, dst, false);
+		}
+		break;
+		case x64::InstLoadFP:
+		{
+			EmitSSE(x64PrefixRepNE, 0x10, GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>(), true));
+		}
+		break;
+		case InstF2S:
+		case InstFCmp:
+		case x64::InstMoveFP:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>());
+			MachineOperand const& op2 = MI.GetOp<1>();
+			Operand src = op2.IsImmediate() ? GetFPConstantPoolEntry(op2.GetImmediate()) : GetOperand(op2);
+			if (opcode == InstF2S)		  EmitSSE(x64PrefixRepNE, 0x2C, dst, src, true);
+			else if (opcode == InstFCmp)  EmitSSE(x64PrefixOpSize, 0x2F, dst, src);
+			else if (dst.IsMem())
+			{
+				if (!VerifyOperands(src.IsReg(), "movsd to memory needs a register source")) break;
+				Encode(x64PrefixRepNE, { 0x0F, 0x11 }, src.reg, false, dst, false);
+			}
+			else						  EmitSSE(x64PrefixRepNE, 0x10, dst, src);
+		}
+		break;
+		case InstS2F:
+		{
+			Operand dst = GetOperand(MI.GetOp<0>());
+			MachineOperand const& op2 = MI.GetOp<1>();
+			Operand src = op2.IsImmediate() ? GetIntConstantPoolEntry(op2.GetImmediate()) : GetOperand(op2);
+			EmitSSE(x64PrefixRepNE, 0x2A, dst, src, true);
+		}
+		break;
+		case InstFAdd: EmitSSE(x64PrefixRepNE, 0x58, GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>())); break;
+		case InstFMul: EmitSSE(x64PrefixRepNE, 0x59, GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>())); break;
+		case InstFSub: EmitSSE(x64PrefixRepNE, 0x5C, GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>())); break;
+		case InstFDiv: EmitSSE(x64PrefixRepNE, 0x5E, GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>())); break;
+		case x64::InstXorFP: EmitSSE(x64PrefixOpSize, 0x57, GetOperand(MI.GetOp<0>()), GetOperand(MI.GetOp<1>())); break;
+		default:
+			VerifyOperands(false, "the instruction has no encoding");
+		}
+	}
+
+	x64ObjectEmitter::Operand x64ObjectEmitter::GetOperand(MachineOperand const& MO, Bool dereference)
+	{
+		Operand op{};
+		op.size = MO.GetType() == MachineType::Int8 ? 1 : 8;
+		if (MO.IsReg())
+		{
+			Uint32 reg = MO.GetReg().reg;
+			OLA_ASSERT_MSG(IsISAReg(reg), "Virtual register should not exist after register allocation!");
+			if (dereference)
+			{
+				op.kind = Operand::Kind::Mem;
+				op.reg = x64::GetRegisterEncoding(reg);
+			}
+			else
+			{
+				op.kind = Operand::Kind::Reg;
+				op.reg = x64::GetRegisterEncoding(reg);
+				op.xmm = x64::IsFPRReg(reg);
+			}
+		}
+		else if (MO.IsImmediate())
+		{
+			op.kind = Operand::Kind::Imm;
+			op.imm = MO.GetImmediate();
+		}
+		else if (MO.IsRelocable())
+		{
+			op.kind = Operand::Kind::Mem;
+			op.rip_relative = true;
+			op.symbol = object.GetOrAddSymbol(MO.GetRelocable()->GetSymbol());
+		}
+		else if (MO.IsStackObject())
+		{
+			op.kind = Operand::Kind::Mem;
+			op.reg = x64::GetRegisterEncoding(x64::RBP);
+			op.disp = MO.GetStackOffset();
+		}
+		else OLA_ASSERT_MSG(false, "There should be no Undef operands at this point");
+		return op;
+	}
+
+	x64ObjectEmitter::Operand x64ObjectEmitter::GetFPConstantPoolEntry(Int64 value)
+	{
+		Operand op{ .kind = Operand::Kind::Mem, .rip_relative = true };
+		op.symbol = GetConstantPoolEntry(fp_constant_pool, "_FP", value);
+		return op;
+	}
+
+	x64ObjectEmitter::Operand x64ObjectEmitter::GetIntConstantPoolEntry(Int64 value)
+	{
+		Operand op{ .kind = Operand::Kind::Mem, .rip_relative = true };
+		op.symbol = GetConstantPoolEntry(int_constant_pool, "_INT", value);
+		return op;
+	}
+
+	Uint32 x64ObjectEmitter::GetConstantPoolEntry(std::unordered_map<Int64, Uint32>& pool, Char const* prefix, Int64 value)
+	{
+		if (auto it = pool.find(value); it != pool.end()) return it->second;
+
+		ObjectSection& rodata = object.GetSection(ObjectSectionKind::ReadOnly);
+		rodata.AlignTo(8);
+		std::string entry_name = prefix + std::to_string(pool.size());
+		Uint32 symbol = object.DefineSymbol(entry_name, ObjectSectionKind::ReadOnly, rodata.GetSize(), ObjectSymbolBinding::Local, ObjectSymbolType::Object);
+		object.SetSymbolSize(symbol, sizeof(Int64));
+		rodata.Append<Int64>(value);
+		pool[value] = symbol;
+		return symbol;
+	}
+
+	void x64ObjectEmitter::Encode(Uint8 prefix, std::initializer_list<Uint8> opcode, Uint8 reg, Bool reg_is_byte, Operand const& rm, Bool rex_w, Uint32 imm_size)
+	{
+		if (!VerifyOperands(!rm.IsImm(), "immediate cannot be encoded in ModRM")) return;
+		if (prefix) text.Append<Uint8>(prefix);
+
+		Uint8 rex = 0x40;
+		if (rex_w) rex |= 0x08;
+		if (reg & 8) rex |= 0x04;
+		if (!rm.rip_relative && (rm.reg & 8)) rex |= 0x01;
+		//spl, bpl, sil and dil are only addressable with a REX prefix
+		Bool const byte_reg_needs_rex = (reg_is_byte && reg >= 4 && reg < 8) || (rm.IsReg() && !rm.xmm && rm.size == 1 && rm.reg >= 4 && rm.reg < 8);
+		if (rex != 0x40 || byte_reg_needs_rex) text.Append<Uint8>(rex);
+
+		for (Uint8 byte : opcode) text.Append<Uint8>(byte);
+
+		Uint8 const reg_bits = (reg & 7) << 3;
+		if (rm.IsReg())
+		{
+			text.Append<Uint8>(0xC0 | reg_bits | (rm.reg & 7));
+		}
+		else if (rm.rip_relative)
+		{
+			text.Append<Uint8>(0x05 | reg_bits);
+			Int64 addend = static_cast<Int64>(rm.disp) - static_cast<Int64>(sizeof(Int32) + imm_size);
+			text.relocations.push_back(ObjectRelocation{ .offset = text.GetSize(), .symbol = rm.symbol, .kind = ObjectRelocationKind::PCRel32, .addend = addend });
+			text.Append<Int32>(0);
+		}
+		else
+		{
+			Uint8 const base = rm.reg & 7;
+			Uint8 mod = 0x80;
+			if (rm.disp == 0 && base != 5) mod = 0x00;
+			else if (FitsInt8(rm.disp)) mod = 0x40;
+
+			text.Append<Uint8>(mod | reg_bits | base);
+			if (base == 4) text.Append<Uint8>(0x24);
+			if (mod == 0x40) text.Append<Int8>(static_cast<Int8>(rm.disp));
+			else if (mod == 0x80) text.Append<Int32>(rm.disp);
+		}
+	}
+
+	void x64ObjectEmitter::EncodeImm(Int64 imm, Uint32 imm_size)
+	{
+		switch (imm_size)
+		{
+		case 1: text.Append<Int8>(static_cast<Int8>(imm)); break;
+		case 4: text.Append<Int32>(static_cast<Int32>(imm)); break;
+		case 8: text.Append<Int64>(imm); break;
+		default: OLA_ASSERT(false);
+		}
+	}
+
+	void x64ObjectEmitter::EncodeBranch(std::initializer_list<Uint8> opcode, MachineBasicBlock const* target)
+	{
+		for (Uint8 byte : opcode) text.Append<Uint8>(byte);
+		branch_fixups.push_back(BranchFixup{ .offset = text.GetSize(), .target = target });
+		text.Append<Int32>(0);
+	}
+
+	void x64ObjectEmitter::EmitALU(Uint8 base_opcode, Uint8 ext, Operand const& dst, Operand const& src)
+	{
+		if (!VerifyOperands(!dst.IsImm(), "destination cannot be an immediate")) return;
+		if (!VerifyOperands(!(dst.IsMem() && src.IsMem()), "both operands are in memory")) return;
+		Uint8 const size = dst.IsReg() || !src.IsReg() ? dst.size : src.size;
+		Bool const is_byte = size == 1;
+		if (src.IsImm())
+		{
+			if (is_byte)
+			{
+				Encode(0, { 0x80 }, ext, false, dst, false, 1);
+				EncodeImm(src.imm, 1);
+			}
+			else if (FitsInt8(src.imm))
+			{
+				Encode(0, { 0x83 }, ext, false, dst, true, 1);
+				EncodeImm(src.imm, 1);
+			}
+			else if (VerifyOperands(FitsInt32(src.imm), "immediate does not fit in 32 bits"))
+			{
+				Encode(0, { 0x81 }, ext, false, dst, true, 4);
+				EncodeImm(src.imm, 4);
+			}
+		}
+		else if (src.IsReg())
+		{
+			Encode(0, { Uint8(base_opcode + (is_byte ? 0 : 1)) }, src.reg, is_byte, dst, !is_byte);
+		}
+		else
+		{
+			Encode(0, { Uint8(base_opcode + (is_byte ? 2 : 3)) }, dst.reg, is_byte, src, !is_byte);
+		}
+	}
+
+	void x64ObjectEmitter::EmitShift(Uint8 ext, Operand const& dst, Operand const& src)
+	{
+		if (!VerifyOperands(!dst.IsImm(), "destination cannot be an immediate")) return;
+		Bool const is_byte = dst.size == 1;
+		if (src.IsImm())
+		{
+			Encode(0, { Uint8(is_byte ? 0xC0 : 0xC1) }, ext, false, dst, !is_byte, 1);
+			EncodeImm(src.imm, 1);
+		}
+		else if (VerifyOperands(src.IsReg() && src.reg == x64::GetRegisterEncoding(x64::RCX), "shift amount must be an immediate or cl"))
+		{
+			Encode(0, { Uint8(is_byte ? 0xD2 : 0xD3) }, ext, false, dst, !is_byte);
+		}
+	}
+
+	void x64ObjectEmitter::EmitUnaryGroup3(Uint8 ext, Operand const& op)
+	{
+		Bool const is_byte = op.size == 1;
+		Encode(0, { Uint8(is_byte ? 0xF6 : 0xF7) }, ext, false, op, !is_byte);
+	}
+
+	void x64ObjectEmitter::EmitMove(Operand const& dst, Operand const& src)
+	{
+		if (!VerifyOperands(!dst.IsImm(), "destination cannot be an immediate")) return;
+		if (!VerifyOperands(!(dst.IsMem() && src.IsMem()), "both operands are in memory")) return;
+		if (src.IsImm())
+		{
+			Bool const is_byte = dst.size == 1;
+			if (is_byte)
+			{
+				Encode(0, { 0xC6 }, 0, false, dst, false, 1);
+				EncodeImm(src.imm, 1);
+			}
+			else if (FitsInt32(src.imm))
+			{
+				Encode(0, { 0xC7 }, 0, false, dst, true, 4);
+				EncodeImm(src.imm, 4);
+			}
+			else if (VerifyOperands(dst.IsReg(), "64-bit immediate can only be moved to a register"))
+			{
+				text.Append<Uint8>(0x48 | ((dst.reg & 8) ? 0x01 : 0x00));
+				text.Append<Uint8>(0xB8 + (dst.reg & 7));
+				EncodeImm(src.imm, 8);
+			}
+		}
+		else if (src.IsReg())
+		{
+			Uint8 const size = dst.IsReg() ? dst.size : src.size;
+			Bool const is_byte = size == 1;
+			Encode(0, { Uint8(is_byte ? 0x88 : 0x89) }, src.reg, is_byte, dst, !is_byte);
+		}
+		else
+		{
+			Bool const is_byte = dst.size == 1;
+			Encode(0, { Uint8(is_byte ? 0x8A : 0x8B) }, dst.reg, is_byte, src, !is_byte);
+		}
+	}
+
+	void x64ObjectEmitter::EmitSSE(Uint8 prefix, Uint8 opcode, Operand const& dst, Operand const& src, Bool rex_w)
+	{
+		if (!VerifyOperands(dst.IsReg(), "SSE destination must be a register")) return;
+		Encode(prefix, { 0x0F, opcode }, dst.reg, false, src, rex_w);
+	}
+
+	//Operand forms without an encoding fail the translation unit in every build, like they did when the assembler rejected them
+	Bool x64ObjectEmitter::VerifyOperands(Bool valid, Char const* reason)
+	{
+		if (valid) return true;
+		if (!encoding_failed) OLA_ERROR("Cannot encode '{}' in function '{}': {}", x64::GetOpcodeString(current_opcode), current_function, reason);
+		encoding_failed = true;
+		return false;
+	}
+}
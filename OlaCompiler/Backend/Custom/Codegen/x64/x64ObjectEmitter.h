@@ -0,0 +1,83 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Backend/Custom/Codegen/ObjectFile.h"
+
+namespace ola
+{
+	class MachineModule;
+	class MachineFunction;
+	class MachineBasicBlock;
+	class MachineInstruction;
+	class MachineOperand;
+
+	class x64ObjectEmitter
+	{
+		struct Operand
+		{
+			enum class Kind : Uint8
+			{
+				Reg,
+				Mem,
+				Imm
+			};
+
+			Kind kind;
+			Uint8 reg = 0;
+			Uint8 size = 8;
+			Bool xmm = false;
+			Bool rip_relative = false;
+			Int32 disp = 0;
+			Uint32 symbol = 0;
+			Int64 imm = 0;
+
+			Bool IsReg() const { return kind == Kind::Reg; }
+			Bool IsMem() const { return kind == Kind::Mem; }
+			Bool IsImm() const { return kind == Kind::Imm; }
+		};
+
+		struct BranchFixup
+		{
+			Uint64 offset;
+			MachineBasicBlock const* target;
+		};
+
+	public:
+		explicit x64ObjectEmitter(ObjectFile& object) : object(object), text(object.GetSection(ObjectSectionKind::Text)) {}
+		//Returns false if an instruction has operands that cannot be encoded, the object is incomplete then
+		Bool EmitModule(MachineModule const& M);
+
+	private:
+		ObjectFile& object;
+		ObjectSection& text;
+		std::unordered_map<MachineBasicBlock const*, Uint64> block_offsets;
+		std::vector<BranchFixup> branch_fixups;
+		std::unordered_map<Int64, Uint32> fp_constant_pool;
+		std::unordered_map<Int64, Uint32> int_constant_pool;
+		std::string_view current_function;
+		Uint32 current_opcode = 0;
+		Bool encoding_failed = false;
+
+	private:
+		void EmitFunction(MachineFunction const& MF);
+		void EmitInstruction(MachineInstruction const& MI);
+
+		Operand GetOperand(MachineOperand const& MO, Bool dereference = false);
+		Operand GetFPConstantPoolEntry(Int64 value);
+		Operand GetIntConstantPoolEntry(Int64 value);
+		Uint32 GetConstantPoolEntry(std::unordered_map<Int64, Uint32>& pool, Char const* prefix, Int64 value);
+
+		Bool VerifyOperands(Bool valid, Char const* reason);
+
+		void Encode(Uint8 prefix, std::initializer_list<Uint8> opcode, Uint8 reg, Bool reg_is_byte, Operand const& rm, Bool rex_w, Uint32 imm_size = 0);
+		void EncodeImm(Int64 imm, Uint32 imm_size);
+		void EncodeBranch(std::initializer_list<Uint8> opcode, MachineBasicBlock const* target);
+
+		void EmitALU(Uint8 base_opcode, Uint8 ext, Operand const& dst, Operand const& src);
+		void EmitShift(Uint8 ext, Operand const& dst, Operand const& src);
+		void EmitUnaryGroup3(Uint8 ext, Operand const& op);
+		void EmitMove(Operand const& dst, Operand const& src);
+		void EmitSSE(Uint8 prefix, Uint8 opcode, Operand const& dst, Operand const& src, Bool rex_w = false);
+	};
+}
@@ -0,0 +1,133 @@
+#include "x64.h"
+#include "x64SysVTargetFrameInfo.h"
+#include "Backend/Custom/IR/IRType.h"
+#include "Backend/Custom/IR/Instruction.h"
+#include "Backend/Custom/Codegen/MachineContext.h"
+#include "Backend/Custom/Codegen/MachineInstruction.h"
+#include "Backend/Custom/Codegen/MachineBasicBlock.h"
+#include "Backend/Custom/Codegen/MachineFunction.h"
+
+namespace ola
+{
+	//Stack layout for x64 System V ABI
+	//Higher memory addresses
+	//+ ------------------------------------ +
+	//| 8th argument etc					 | <- Stored by caller before call
+	//| 7th argument						 | <- Stored by caller before call
+	//+ ------------------------------------ +
+	//| Return Address						 | <- Pushed by CALL instruction
+	//+ ------------------------------------ +
+	//| Old RBP(if used)					 | <- Pushed by callee (if using frame pointer)
+	//| Callee - saved registers			 | <- Saved by callee(if needed)
+	//| Local variables + register spills	 | <- Allocated by callee
+	//| Outgoing stack arguments			 | <- RSP is 16-byte aligned at every call
+	//+ ------------------------------------ +
+	//| Red zone(128B)						 | <- Leaf functions keep their frame here without moving RSP
+	//+ ------------------------------------ +
+	//Lower memory addresses(stack grows downward)
+	//Integer and floating point arguments are assigned to registers independently of each other,
+	//arguments that don't fit into registers are passed on the stack in order.
+
+	namespace
+	{
+		constexpr x64::Register GPArgumentRegisters[] = { x64::RDI, x64::RSI, x64::RDX, x64::RCX, x64::R8, x64::R9 };
+		constexpr x64::Register FPArgumentRegisters[] = { x64::XMM0, x64::XMM1, x64::XMM2, x64::XMM3, x64::XMM4, x64::XMM5, x64::XMM6, x64::XMM7 };
+		constexpr Uint32 RedZoneSize = 128;
+		constexpr Uint32 StackAlignment = 16;
+
+		//A call can't pass more arguments on the stack than it has arguments beyond the integer registers
+		Uint32 GetOutgoingStackArgumentSlots(MachineFunction const& MF)
+		{
+			Uint32 const max_call_arg_count = MF.GetMaxCallArgCount();
+			return max_call_arg_count > std::size(GPArgumentRegisters) ? max_call_arg_count - std::size(GPArgumentRegisters) : 0;
+		}
+
+		template<typename F>
+		void ForEachArgumentLocation(std::vector<MachineType> const& arg_types, F&& f)
+		{
+			Uint32 gp_arg_idx = 0, fp_arg_idx = 0, stack_arg_idx = 0;
+			for (Uint32 idx = 0; idx < arg_types.size(); ++idx)
+			{
+				if (arg_types[idx] == MachineType::Float64 && fp_arg_idx < std::size(FPArgumentRegisters))
+				{
+					f(idx, MachineOperand::ISAReg(FPArgumentRegisters[fp_arg_idx++], MachineType::Float64), -1);
+				}
+				else if (arg_types[idx] != MachineType::Float64 && gp_arg_idx < std::size(GPArgumentRegisters))
+				{
+					f(idx, MachineOperand::ISAReg(GPArgumentRegisters[gp_arg_idx++], arg_types[idx]), -1);
+				}
+				else
+				{
+					f(idx, MachineOperand(), static_cast<Int32>(stack_arg_idx++));
+				}
+			}
+		}
+	}
+
+	void x64SysVTargetFrameInfo::EmitCall(CallInst* CI, MachineContext& ctx) const
+	{
+		OLA_ASSERT(CI->GetCalleeAsFunction());
+		MachineFunction* MF = ctx.GetCurrentBasicBlock()->GetFunction();
+		Uint32 const stack_arg_slots = GetOutgoingStackArgumentSlots(*MF);
+
+		std::vector<MachineOperand> arg_operands;
+		std::vector<MachineType> arg_types;
+		for (Uint32 idx = 0; idx < CI->ArgSize(); ++idx)
+		{
+			arg_operands.push_back(ctx.GetOperand(CI->GetArgOp(idx)));
+			arg_types.push_back(arg_operands.back().GetType());
+		}
+
+		ForEachArgumentLocation(arg_types, [&](Uint32 idx, MachineOperand const& arg_reg, Int32 stack_arg_idx)
+			{
+				MachineOperand const& arg_operand = arg_operands[idx];
+				Uint32 opcode = (arg_operand.IsMemoryOperand() && CI->GetArgOp(idx)->GetType()->IsPointer()) ? InstLoadGlobalAddress : InstMove;
+				MachineInstruction copy_arg(opcode);
+				if (stack_arg_idx >= 0)
+				{
+					Int32 offset = MF->GetLocalStackAllocationSize() + (stack_arg_slots - stack_arg_idx) * 8;
+					copy_arg.SetOp<0>(MachineOperand::StackObject(-offset, arg_operand.GetType()));
+				}
+				else
+				{
+					copy_arg.SetOp<0>(arg_reg);
+				}
+				copy_arg.SetOp<1>(arg_operand);
+				ctx.EmitInst(copy_arg);
+			});
+
+		EmitCallAndResult(CI, ctx);
+	}
+
+	void x64SysVTargetFrameInfo::EmitPrologue(MachineFunction& MF, MachineContext& ctx) const
+	{
+		Uint32 const stack_arg_slots = GetOutgoingStackArgumentSlots(MF);
+		if (stack_arg_slots > 0) MF.AllocateArgumentStack(stack_arg_slots * 8);
+
+		EmitFrameSetup(MF, ctx);
+
+		std::vector<MachineType> arg_types;
+		for (MachineOperand const& arg : MF.Args()) arg_types.push_back(arg.GetType());
+		ForEachArgumentLocation(arg_types, [&](Uint32 idx, MachineOperand const& arg_reg, Int32 stack_arg_idx)
+			{
+				MachineOperand const& arg = MF.Args()[idx];
+				MachineInstruction copy_arg_to_reg(InstMove);
+				if (stack_arg_idx >= 0)
+				{
+					Int32 offset = 16 + stack_arg_idx * 8;
+					copy_arg_to_reg.SetOp<1>(MachineOperand::StackObject(offset, arg.GetType()));
+				}
+				else
+				{
+					copy_arg_to_reg.SetOp<1>(arg_reg);
+				}
+				copy_arg_to_reg.SetOp<0>(arg);
+				ctx.EmitInst(copy_arg_to_reg);
+			});
+	}
+
+	void x64SysVTargetFrameInfo::EmitProloguePostRA(MachineFunction& MF, MachineContext& ctx) const
+	{
+		EmitFrameSetupPostRA(MF, ctx, StackAlignment, RedZoneSize);
+	}
+}
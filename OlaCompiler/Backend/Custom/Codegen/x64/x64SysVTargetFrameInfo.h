@@ -0,0 +1,13 @@
+#pragma once
+#include "x64TargetFrameInfo.h"
+
+namespace ola
+{
+	class x64SysVTargetFrameInfo : public x64TargetFrameInfo
+	{
+	public:
+		virtual void EmitCall(CallInst* CI, MachineContext& ctx) const override;
+		virtual void EmitPrologue(MachineFunction& MF, MachineContext& ctx) const override;
+		virtual void EmitProloguePostRA(MachineFunction& MF, MachineContext& ctx) const override;
+	};
+}
\ No newline at end of file
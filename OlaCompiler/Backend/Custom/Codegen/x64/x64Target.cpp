@@ -1,15 +1,19 @@
-#include <fstream>
+#include <ostream>
 #include "x64Target.h"
 #include "x64.h"
 #include "x64TargetFrameInfo.h"
+#include "x64SysVTargetFrameInfo.h"
 #include "x64TargetInstInfo.h"
 #include "x64AsmPrinter.h"
+#include "x64ObjectEmitter.h"
 #include "Backend/Custom/IR/IRType.h"
 #include "Backend/Custom/IR/Instruction.h"
 #include "Backend/Custom/Codegen/MachineInstruction.h"
 #include "Backend/Custom/Codegen/MachineBasicBlock.h"
 #include "Backend/Custom/Codegen/MachineFunction.h"
 #include "Backend/Custom/Codegen/MachineContext.h"
+#include "Backend/Custom/Codegen/ObjectFile.h"
+#include "Backend/Custom/Codegen/ELFObjectWriter.h"
 
 namespace ola
 {
@@ -498,7 +502,30 @@ namespace ola
 				}
 				else
 				{
-					return MachineOperand::ISAReg(legalize_ctx.target_reg_info.GetGPScratchRegister(), type);
+					//globals are untyped memory operands, they are accessed as qwords
+					return MachineOperand::ISAReg(legalize_ctx.target_reg_info.GetGPScratchRegister(), type == MachineType::Other ? MachineType::Int64 : type);
+				}
+			};
+
+			//SSE instructions need a register as their first operand, this can be violated if register spilling occurs
+			auto LegalizeSSEDestination = [&]()
+			{
+				MachineOperand dst = MI.GetOperand(0);
+				if (!dst.IsMemoryOperand()) return;
+
+				auto scratch = GetScratchReg(dst.GetType());
+				if (MI.GetOpcode() != InstS2F && MI.GetOpcode() != InstF2S)
+				{
+					MachineInstruction MI2(dst.GetType() == MachineType::Float64 ? static_cast<Uint32>(x64::InstLoadFP) : static_cast<Uint32>(InstLoad));
+					MI2.SetOp<0>(scratch).SetOp<1>(dst);
+					instructions.insert(instruction_iter, MI2);
+				}
+				MI.SetOp<0>(scratch);
+				if (MI.GetOpcode() != InstFCmp)
+				{
+					MachineInstruction MI3(dst.GetType() == MachineType::Float64 ? static_cast<Uint32>(x64::InstStoreFP) : static_cast<Uint32>(InstStore));
+					MI3.SetOp<0>(dst).SetOp<1>(scratch);
+					instructions.insert(std::next(instruction_iter), MI3);
 				}
 			};
 
@@ -518,16 +545,117 @@ namespace ola
 				}
 			}
 			break;
+			case x64::InstMoveFP:
+			{
+				MachineOperand dst = MI.GetOperand(0);
+				MachineOperand src = MI.GetOperand(1);
+				if (dst.IsMemoryOperand() && !src.IsReg()) //this can happen if register spilling occurs
+				{
+					auto scratch = GetScratchReg(MachineType::Float64);
+					MachineInstruction MI2(x64::InstMoveFP);
+					MI2.SetOp<0>(scratch).SetOp<1>(src);
+					instructions.insert(instruction_iter, MI2);
+					MI.SetOp<1>(scratch);
+				}
+			}
+			break;
+			case x64::InstXorFP:
+			{
+				//xorpd requires its memory operand to be 16-byte aligned which spill slots are not
+				MachineOperand dst = MI.GetOperand(0);
+				MachineOperand src = MI.GetOperand(1);
+				if (!src.IsMemoryOperand())
+				{
+					LegalizeSSEDestination();
+				}
+				else if (dst.IsMemoryOperand())
+				{
+					//both operands are spilled, flip the bits through the general purpose scratch register instead
+					OLA_ASSERT(dst.IsStackObject() && src.IsStackObject());
+					auto scratch = GetScratchReg(MachineType::Int64);
+					MachineInstruction MI2(InstLoad);
+					MI2.SetOp<0>(scratch).SetOp<1>(MachineOperand::StackObject(src.GetStackOffset(), MachineType::Int64));
+					instructions.insert(instruction_iter, MI2);
+					MI.SetOpcode(InstXor);
+					MI.SetOp<0>(MachineOperand::StackObject(dst.GetStackOffset(), MachineType::Int64)).SetOp<1>(scratch);
+				}
+				else
+				{
+					auto scratch = GetScratchReg(MachineType::Float64);
+					MachineInstruction MI2(x64::InstLoadFP);
+					MI2.SetOp<0>(scratch).SetOp<1>(src);
+					instructions.insert(instruction_iter, MI2);
+					MI.SetOp<1>(scratch);
+				}
+			}
+			break;
+			case InstFAdd:
+			case InstFSub:
+			case InstFMul:
+			case InstFDiv:
+			case InstS2F:
+			case InstF2S:
+			case InstFCmp:
+			{
+				LegalizeSSEDestination();
+			}
+			break;
+			//at most one operand of an instruction can be in memory, this can be violated if register spilling occurs
+			case InstAdd:
+			case InstSub:
+			case InstAnd:
+			case InstOr:
+			case InstXor:
+			case InstICmp:
+			case InstTest:
+			{
+				MachineOperand dst = MI.GetOperand(0);
+				MachineOperand src = MI.GetOperand(1);
+				if (dst.IsMemoryOperand() && src.IsMemoryOperand())
+				{
+					auto scratch = GetScratchReg(src.GetType());
+					MachineInstruction MI2(InstLoad);
+					MI2.SetOp<0>(scratch).SetOp<1>(src);
+					instructions.insert(instruction_iter, MI2);
+					MI.SetOp<1>(scratch);
+				}
+			}
+			break;
+			//imul, cmov, movzx and lea need a register destination
+			case InstSMul:
+			case InstCMoveEQ:
+			case InstCMoveNE:
+			case InstZExt:
+			case InstLoadGlobalAddress:
+			{
+				MachineOperand dst = MI.GetOperand(0);
+				if (dst.IsMemoryOperand())
+				{
+					auto scratch = GetScratchReg(dst.GetType());
+					if (MI.GetOpcode() != InstZExt && MI.GetOpcode() != InstLoadGlobalAddress)
+					{
+						MachineInstruction MI2(InstLoad);
+						MI2.SetOp<0>(scratch).SetOp<1>(dst);
+						instructions.insert(instruction_iter, MI2);
+					}
+					MI.SetOp<0>(scratch);
+					MachineInstruction MI3(InstStore);
+					MI3.SetOp<0>(dst).SetOp<1>(scratch);
+					instructions.insert(std::next(instruction_iter), MI3);
+				}
+			}
+			break;
 			}
 
 			if (MI.GetOpcode() >= InstMove && MI.GetOpcode() <= InstStore)
 			{
 				MachineOperand dst = MI.GetOperand(0);
 				MachineOperand src = MI.GetOperand(1);
-				if (dst.IsMemoryOperand() && src.IsMemoryOperand()) //this can happen if register spilling occurs
+				Bool const fp_immediate = src.IsImmediate() && dst.GetType() == MachineType::Float64;
+				if (dst.IsMemoryOperand() && (src.IsMemoryOperand() || fp_immediate)) //this can happen if register spilling occurs
 				{
 					auto scratch = GetScratchReg(dst.GetType());
-					MachineInstruction MI2(InstLoad);
+					MachineInstruction MI2(fp_immediate ? static_cast<Uint32>(x64::InstMoveFP) : (scratch.GetType() == MachineType::Float64 ? static_cast<Uint32>(x64::InstLoadFP) : static_cast<Uint32>(InstLoad)));
 					MI2.SetOp<0>(scratch).SetOp<1>(src);
 					instructions.insert(instruction_iter, MI2);
 					MI.SetOp<1>(scratch);
@@ -656,11 +784,41 @@ namespace ola
 			return x64::IsCalleeSaved(r);
 		}
 
+		virtual Bool IsArgumentRegister(Uint32 r) const override
+		{
+			return x64::IsArgumentRegister(r);
+		}
+
 	private:
 		std::vector<Uint32> gp_regs;
 		std::vector<Uint32> fp_regs;
 	};
 
+	class x64SysVTargetRegisterInfo : public x64TargetRegisterInfo
+	{
+	public:
+		//R11 is caller saved and never carries an argument, using it as scratch leaves all callee saved registers to the allocator
+		virtual Uint32 GetGPScratchRegister() const override
+		{
+			return x64::R11;
+		}
+
+		virtual Bool IsCallerSaved(Uint32 r) const override
+		{
+			return x64::IsSysVCallerSaved(r);
+		}
+
+		virtual Bool IsCalleeSaved(Uint32 r) const override
+		{
+			return x64::IsSysVCalleeSaved(r);
+		}
+
+		virtual Bool IsArgumentRegister(Uint32 r) const override
+		{
+			return x64::IsSysVArgumentRegister(r);
+		}
+	};
+
 	TargetDataLayout const& x64Target::GetDataLayout() const
 	{
 		static x64TargetDataLayout x64_target_data_layout{};
@@ -676,6 +834,8 @@ namespace ola
 	TargetRegisterInfo const& x64Target::GetRegisterInfo() const
 	{
 		static x64TargetRegisterInfo x64_target_reg_info{};
+		static x64SysVTargetRegisterInfo x64_sysv_target_reg_info{};
+		if (abi == x64ABI::SystemV) return x64_sysv_target_reg_info;
 		return x64_target_reg_info;
 	}
 
@@ -688,15 +848,32 @@ namespace ola
 	TargetFrameInfo const& x64Target::GetFrameInfo() const
 	{
 		static x64TargetFrameInfo x64_target_frame_info{};
+		static x64SysVTargetFrameInfo x64_sysv_target_frame_info{};
+		if (abi == x64ABI::SystemV) return x64_sysv_target_frame_info;
 		return x64_target_frame_info;
 	}
 
-	void x64Target::EmitAssembly(MachineModule& M, std::string_view file) const
+	void x64Target::EmitAssembly(MachineModule& M, std::ostream& os) const
 	{
-		std::ofstream asm_stream(file.data());
-		x64AsmPrinter asm_printer(asm_stream);
+		x64AsmPrinter asm_printer(os);
 		asm_printer.PrintModule(M);
 	}
 
+	Bool x64Target::EmitObject(MachineModule& M, std::ostream& os) const
+	{
+		ObjectFile object{};
+		if (!EmitObject(M, object)) return false;
+
+		ELFObjectWriter object_writer(os);
+		object_writer.WriteObject(object);
+		return true;
+	}
+
+	Bool x64Target::EmitObject(MachineModule& M, ObjectFile& object) const
+	{
+		x64ObjectEmitter object_emitter(object);
+		return object_emitter.EmitModule(M);
+	}
+
 }
 
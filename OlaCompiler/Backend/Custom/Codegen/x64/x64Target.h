@@ -3,10 +3,18 @@
 
 namespace ola
 {
+	enum class x64ABI : Uint8
+	{
+		Microsoft,
+		SystemV
+	};
+
 	class x64Target : public Target
 	{
 	public:
-		x64Target() = default;
+		explicit x64Target(x64ABI abi = x64ABI::Microsoft) : abi(abi) {}
+
+		x64ABI GetABI() const { return abi; }
 
 		virtual TargetDataLayout const& GetDataLayout() const override;
 		virtual TargetInstInfo const& GetInstInfo() const override;
@@ -14,6 +22,11 @@ namespace ola
 		virtual TargetISelInfo const& GetISelInfo() const override;
 		virtual TargetFrameInfo const& GetFrameInfo() const override;
 
-		virtual void EmitAssembly(MachineModule& M, std::string_view file) const override;
+		virtual void EmitAssembly(MachineModule& M, std::ostream& os) const override;
+		virtual Bool EmitObject(MachineModule& M, std::ostream& os) const override;
+		virtual Bool EmitObject(MachineModule& M, ObjectFile& object) const override;
+
+	private:
+		x64ABI abi;
 	};
 }
\ No newline at end of file
@@ -33,10 +33,7 @@ namespace ola
 	
 	void x64TargetFrameInfo::EmitCall(CallInst* CI, MachineContext& ctx) const
 	{
-		Function* callee = CI->GetCalleeAsFunction();
-		OLA_ASSERT(callee);
-		MachineGlobal const* global = ctx.GetGlobal(callee);
-
+		OLA_ASSERT(CI->GetCalleeAsFunction());
 		MachineFunction* MF = ctx.GetCurrentBasicBlock()->GetFunction();
 		for (Int32 idx = CI->ArgSize() - 1; idx >= 0; --idx)
 		{
@@ -69,6 +66,12 @@ namespace ola
 			}
 		}
 
+		EmitCallAndResult(CI, ctx);
+	}
+
+	void x64TargetFrameInfo::EmitCallAndResult(CallInst* CI, MachineContext& ctx) const
+	{
+		MachineGlobal const* global = ctx.GetGlobal(CI->GetCalleeAsFunction());
 		MachineInstruction call_inst(InstCall);
 		call_inst.SetOp<0>(MachineOperand::Relocable(global->GetRelocable()));
 		ctx.EmitInst(call_inst);
@@ -99,23 +102,7 @@ namespace ola
 			MF.AllocateArgumentStack((MF.GetMaxCallArgCount() - 4) * 8);
 		}
 
-		MachineOperand rbp = MachineOperand::ISAReg(x64::RBP, Int64);
-		MachineOperand rsp = MachineOperand::ISAReg(x64::RSP, Int64);
-
-		if (MF.GetStackAllocationSize() > 0)
-		{
-			MachineInstruction push_rbp(InstPush);
-			push_rbp.SetOp<0>(rbp);
-			ctx.EmitInst(push_rbp);
-
-			MachineInstruction set_rbp(InstMove);
-			set_rbp.SetOp<0>(rbp).SetOp<1>(rsp);
-			ctx.EmitInst(set_rbp);
-
-			MachineInstruction allocate_stack(InstSub);
-			allocate_stack.SetOp<0>(rsp).SetOp<1>(MachineOperand::Immediate(MF.GetStackAllocationSize(), Int64));
-			ctx.EmitInst(allocate_stack);
-		}
+		EmitFrameSetup(MF, ctx);
 
 		Uint32 arg_idx = 0;
 		for (MachineOperand const& arg : MF.Args())
@@ -150,92 +137,7 @@ namespace ola
 
 	void x64TargetFrameInfo::EmitProloguePostRA(MachineFunction& MF, MachineContext& ctx) const
 	{
-		auto const& gp_regs = ctx.GetUsedRegistersInfo()->gp_used_registers;
-		auto const& fp_regs = ctx.GetUsedRegistersInfo()->fp_used_registers;
-		Uint32 const stack_adjustment = (gp_regs.size() + fp_regs.size()) * 8;
-
-		std::list<MachineInstruction>& insert_list = ctx.GetCurrentBasicBlock()->Instructions();
-		std::list<MachineInstruction>::iterator insert_point = insert_list.begin();
-		//try to find stack allocation
-		insert_point = std::find_if(insert_list.begin(), insert_list.end(), [](MachineInstruction& MI)
-			{
-				if (MI.GetOpcode() == InstSub && MI.GetOp<0>().IsReg() && MI.GetOp<0>().GetReg().reg == x64::RSP) return true;
-				return false;
-			});
-		if (insert_point != insert_list.end())
-		{
-			MachineInstruction& MI = *insert_point;
-			OLA_ASSERT(MI.GetOp<1>().IsImmediate());
-			Int64 stack_alloc = MI.GetOp<1>().GetImmediate();
-			MI.SetOp<1>(MachineOperand::Immediate(MF.GetStackAllocationSize() + stack_adjustment, MachineType::Int64));
-			++insert_point;
-		}
-		else
-		{
-			OLA_ASSERT(MF.GetStackAllocationSize() == 0);
-			Uint32 new_stack_allocation = MF.GetStackAllocationSize() + stack_adjustment;
-			if (new_stack_allocation > 0)
-			{
-				MachineOperand rbp = MachineOperand::ISAReg(x64::RBP, MachineType::Int64);
-				MachineOperand rsp = MachineOperand::ISAReg(x64::RSP, MachineType::Int64);
-
-				MachineInstruction push_rbp(InstPush);
-				push_rbp.SetOp<0>(rbp);
-				insert_point = ctx.EmitInst(insert_list.begin(), push_rbp); ++insert_point;
-
-				MachineInstruction set_rbp(InstMove);
-				set_rbp.SetOp<0>(rbp).SetOp<1>(rsp);
-				insert_point = ctx.EmitInst(insert_point, set_rbp); ++insert_point;
-
-				MachineInstruction allocate_stack(InstSub);
-				allocate_stack.SetOp<0>(rsp).SetOp<1>(MachineOperand::Immediate(MF.GetStackAllocationSize() + stack_adjustment, MachineType::Int64));
-				insert_point = ctx.EmitInst(insert_point, allocate_stack); ++insert_point;
-			}
-		}
-		if (stack_adjustment == 0) return;
-
-		TargetInstInfo const& target_inst_info = ctx.GetModule().GetTarget().GetInstInfo();
-		for (auto const& MBB : MF.Blocks())
-		{
-			for (auto& MI : MBB->Instructions())
-			{
-				InstInfo const& inst_info = target_inst_info.GetInstInfo(MI);
-				for (Uint32 i = 0; i < inst_info.GetOperandCount(); ++i)
-				{
-					MachineOperand& MO = MI.GetOperand(i);
-					if (MO.IsStackObject())
-					{
-						Int32 operand_offset = MO.GetStackOffset();
-						if (operand_offset < 0)
-						{
-							MI.SetOperand(i, MachineOperand::StackObject(operand_offset - stack_adjustment, MO.GetType()));
-						}
-					}
-				}
-			}
-		}
-
-		Uint32 stack_offset = 0;
-		for (Uint32 gp_reg : gp_regs)
-		{
-			stack_offset += 8;
-			MachineInstruction MI(InstMove);
-			MI.SetOp<0>(MachineOperand::StackObject(-stack_offset, MachineType::Int64));
-			MI.SetOp<1>(MachineOperand::ISAReg(gp_reg, MachineType::Int64));
-			ctx.EmitInst(insert_point, MI);
-			MF.AddCalleeSavedArg(gp_reg, stack_offset, MachineType::Int64);
-		}
-		for (Uint32 fp_reg : fp_regs)
-		{
-			stack_offset += 8;
-			MachineInstruction MI(InstMove);
-			MI.SetOp<0>(MachineOperand::StackObject(-stack_offset, MachineType::Float64));
-			MI.SetOp<1>(MachineOperand::ISAReg(fp_reg, MachineType::Float64));
-			ctx.EmitInst(insert_point, MI);
-			MF.AddCalleeSavedArg(fp_reg, stack_offset, MachineType::Float64);
-		}
-		OLA_ASSERT(stack_offset == stack_adjustment);
-
+		EmitFrameSetupPostRA(MF, ctx, 1, 0);
 	}
 
 	void x64TargetFrameInfo::EmitEpilogue(MachineFunction& MF, MachineContext& ctx) const
@@ -258,7 +160,8 @@ namespace ola
 
 	void x64TargetFrameInfo::EmitEpiloguePostRA(MachineFunction& MF, MachineContext& ctx) const
 	{
-		if (!MF.GetCalleeSavedArgs().empty())
+		//the frame can also be created after register allocation if spilling needed stack space
+		if (!MF.GetCalleeSavedArgs().empty() || MF.GetStackAllocationSize() > 0)
 		{
 			std::list<MachineInstruction>& insert_list = ctx.GetCurrentBasicBlock()->Instructions();
 			std::list<MachineInstruction>::iterator insert_point = insert_list.end();
@@ -327,5 +230,132 @@ namespace ola
 		}
 	}
 
+	void x64TargetFrameInfo::EmitFrameSetup(MachineFunction& MF, MachineContext& ctx) const
+	{
+		if (MF.GetStackAllocationSize() == 0) return;
+
+		MachineOperand rbp = MachineOperand::ISAReg(x64::RBP, MachineType::Int64);
+		MachineOperand rsp = MachineOperand::ISAReg(x64::RSP, MachineType::Int64);
+
+		MachineInstruction push_rbp(InstPush);
+		push_rbp.SetOp<0>(rbp);
+		ctx.EmitInst(push_rbp);
+
+		MachineInstruction set_rbp(InstMove);
+		set_rbp.SetOp<0>(rbp).SetOp<1>(rsp);
+		ctx.EmitInst(set_rbp);
+
+		MachineInstruction allocate_stack(InstSub);
+		allocate_stack.SetOp<0>(rsp).SetOp<1>(MachineOperand::Immediate(MF.GetStackAllocationSize(), MachineType::Int64));
+		ctx.EmitInst(allocate_stack);
+	}
+
+	//Callee saved registers are stored right below the frame pointer, followed by the padding needed to keep the stack aligned.
+	//Functions that make no calls and fit into the red zone keep their frame below the stack pointer without adjusting it.
+	void x64TargetFrameInfo::EmitFrameSetupPostRA(MachineFunction& MF, MachineContext& ctx, Uint32 stack_alignment, Uint32 red_zone_size) const
+	{
+		auto const& gp_regs = ctx.GetUsedRegistersInfo()->gp_used_registers;
+		auto const& fp_regs = ctx.GetUsedRegistersInfo()->fp_used_registers;
+		Uint32 const callee_saved_size = (gp_regs.size() + fp_regs.size()) * 8;
+		Uint32 const stack_allocation = OLA_ALIGN_UP(MF.GetStackAllocationSize() + callee_saved_size, stack_alignment);
+		Uint32 const stack_adjustment = stack_allocation - MF.GetStackAllocationSize();
+		Bool const use_red_zone = !MF.HasCallInstructions() && stack_allocation <= red_zone_size;
+
+		std::list<MachineInstruction>& insert_list = ctx.GetCurrentBasicBlock()->Instructions();
+		std::list<MachineInstruction>::iterator insert_point = insert_list.begin();
+		//try to find stack allocation
+		insert_point = std::find_if(insert_list.begin(), insert_list.end(), [](MachineInstruction& MI)
+			{
+				if (MI.GetOpcode() == InstSub && MI.GetOp<0>().IsReg() && MI.GetOp<0>().GetReg().reg == x64::RSP) return true;
+				return false;
+			});
+		if (insert_point != insert_list.end())
+		{
+			MachineInstruction& MI = *insert_point;
+			OLA_ASSERT(MI.GetOp<1>().IsImmediate());
+			if (use_red_zone)
+			{
+				insert_point = insert_list.erase(insert_point);
+			}
+			else
+			{
+				MI.SetOp<1>(MachineOperand::Immediate(stack_allocation, MachineType::Int64));
+				++insert_point;
+			}
+		}
+		else
+		{
+			if (stack_allocation > 0)
+			{
+				MachineOperand rbp = MachineOperand::ISAReg(x64::RBP, MachineType::Int64);
+				MachineOperand rsp = MachineOperand::ISAReg(x64::RSP, MachineType::Int64);
+
+				MachineInstruction push_rbp(InstPush);
+				push_rbp.SetOp<0>(rbp);
+				insert_point = ctx.EmitInst(insert_list.begin(), push_rbp); ++insert_point;
+
+				MachineInstruction set_rbp(InstMove);
+				set_rbp.SetOp<0>(rbp).SetOp<1>(rsp);
+				insert_point = ctx.EmitInst(insert_point, set_rbp); ++insert_point;
+
+				if (!use_red_zone)
+				{
+					MachineInstruction allocate_stack(InstSub);
+					allocate_stack.SetOp<0>(rsp).SetOp<1>(MachineOperand::Immediate(stack_allocation, MachineType::Int64));
+					insert_point = ctx.EmitInst(insert_point, allocate_stack); ++insert_point;
+				}
+			}
+		}
+		//spill slots were allocated below the outgoing arguments, swap the two so that the arguments end up at the stack pointer
+		Int32 const local_size = MF.GetLocalStackAllocationSize();
+		Int32 const argument_size = MF.GetArgumentStackAllocationSize();
+		Int32 const spill_size = MF.GetSpillStackAllocationSize();
+		if (stack_adjustment == 0 && (argument_size == 0 || spill_size == 0)) return;
+
+		TargetInstInfo const& target_inst_info = ctx.GetModule().GetTarget().GetInstInfo();
+		for (auto const& MBB : MF.Blocks())
+		{
+			for (auto& MI : MBB->Instructions())
+			{
+				InstInfo const& inst_info = target_inst_info.GetInstInfo(MI);
+				for (Uint32 i = 0; i < inst_info.GetOperandCount(); ++i)
+				{
+					MachineOperand& MO = MI.GetOperand(i);
+					if (MO.IsStackObject())
+					{
+						Int32 operand_offset = MO.GetStackOffset();
+						if (operand_offset < 0)
+						{
+							if (operand_offset < -(local_size + argument_size))	operand_offset += argument_size;
+							else if (operand_offset < -local_size)				operand_offset -= spill_size;
+							MI.SetOperand(i, MachineOperand::StackObject(operand_offset - stack_adjustment, MO.GetType()));
+						}
+					}
+				}
+			}
+		}
+
+		Uint32 stack_offset = 0;
+		for (Uint32 gp_reg : gp_regs)
+		{
+			stack_offset += 8;
+			MachineInstruction MI(InstMove);
+			MI.SetOp<0>(MachineOperand::StackObject(-stack_offset, MachineType::Int64));
+			MI.SetOp<1>(MachineOperand::ISAReg(gp_reg, MachineType::Int64));
+			ctx.EmitInst(insert_point, MI);
+			MF.AddCalleeSavedArg(gp_reg, stack_offset, MachineType::Int64);
+		}
+		for (Uint32 fp_reg : fp_regs)
+		{
+			stack_offset += 8;
+			MachineInstruction MI(InstMove);
+			MI.SetOp<0>(MachineOperand::StackObject(-stack_offset, MachineType::Float64));
+			MI.SetOp<1>(MachineOperand::ISAReg(fp_reg, MachineType::Float64));
+			ctx.EmitInst(insert_point, MI);
+			MF.AddCalleeSavedArg(fp_reg, stack_offset, MachineType::Float64);
+		}
+		OLA_ASSERT(stack_offset == callee_saved_size);
+	}
+
 }
 
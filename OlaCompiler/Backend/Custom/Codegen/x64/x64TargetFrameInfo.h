@@ -1,3 +1,4 @@
+#pragma once
 #include "Backend/Custom/Codegen/Target.h"
 
 namespace ola
@@ -11,5 +12,10 @@ namespace ola
 		virtual void EmitEpilogue(MachineFunction& MF, MachineContext& ctx) const override;
 		virtual void EmitEpiloguePostRA(MachineFunction& MF, MachineContext& ctx) const override;
 		virtual void EmitReturn(ReturnInst* RI, MachineContext& ctx) const override;
+
+	protected:
+		void EmitCallAndResult(CallInst* CI, MachineContext& ctx) const;
+		void EmitFrameSetup(MachineFunction& MF, MachineContext& ctx) const;
+		void EmitFrameSetupPostRA(MachineFunction& MF, MachineContext& ctx, Uint32 stack_alignment, Uint32 red_zone_size) const;
 	};
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <memory>
 #include "Pass.h"
 #include "PassRegistry.h"
+#include "Utility/TimeReport.h"
 
 namespace ola
 {
@@ -58,6 +59,7 @@ namespace ola
 			if (!analysis_info.analysis_results.contains(PassT::ID()))
 			{
 				BasePassT* pass = analysis_info.analysis_passes[PassT::ID()].get();
+				OLA_TIME_REPORT_FINE_SCOPE(pass->GetPassName());
 				pass->RunOn(U, static_cast<AnalysisManagerT&>(*this));
 				analysis_info.analysis_results[PassT::ID()] = &static_cast<PassT*>(pass)->GetResult();
 			}
@@ -1,4 +1,5 @@
 #include "BasicBlock.h"
+#include "IRContext.h"
 #include "GlobalValue.h"
 #include "IRType.h"
 #include "IRBuilder.h"
@@ -15,6 +16,18 @@ namespace ola
 	{
 	}
 
+	void* BasicBlock::operator new(Uint64 size, IRContext& C)
+	{
+		return C.GetAllocator().Allocate(size);
+	}
+
+	void BasicBlock::operator delete(BasicBlock* BB, std::destroying_delete_t)
+	{
+		IRAllocator& allocator = BB->GetContext().GetAllocator();
+		BB->~BasicBlock();
+		allocator.Deallocate(BB, sizeof(BasicBlock));
+	}
+
 	BasicBlock* BasicBlock::RemoveFromParent()
 	{
 		return function->Blocks().Remove(this);
@@ -1,7 +1,9 @@
 #pragma once
 #include <string>
+#include <algorithm>
 #include "Instruction.h"
 #include "Utility/IntrusiveList.h"
+#include "Utility/IteratorRange.h"
 
 namespace ola
 {
@@ -10,6 +12,33 @@ namespace ola
 	class Instruction;
 	class CFG;
 
+	//Walks the phi nodes grouped at the start of a block, the range ends at the first instruction that isn't a phi
+	class PhiIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = PhiInst*;
+		using difference_type = std::ptrdiff_t;
+		using pointer = PhiInst**;
+		using reference = PhiInst*;
+
+		explicit PhiIterator(IListIterator<Instruction> it) : it(it) {}
+
+		PhiInst* operator*() const { return cast<PhiInst>(&*it); }
+		PhiIterator& operator++() { ++it; return *this; }
+		PhiIterator operator++(Int)
+		{
+			PhiIterator tmp = *this;
+			++it;
+			return tmp;
+		}
+		Bool operator==(PhiIterator const& other) const { return it == other.it; }
+		Bool operator!=(PhiIterator const& other) const { return it != other.it; }
+
+	private:
+		IListIterator<Instruction> it;
+	};
+
 	class BasicBlock : public TrackableValue, public IListNode<BasicBlock>
 	{
 	public:
@@ -17,6 +46,10 @@ namespace ola
 		explicit BasicBlock(IRContext& C, Function* function, Uint32 idx);
 		~BasicBlock();
 
+		void* operator new(Uint64) = delete;
+		void* operator new(Uint64 size, IRContext& C);
+		void operator delete(BasicBlock* BB, std::destroying_delete_t);
+
 		auto begin() { return instructions.begin(); }
 		auto begin() const { return instructions.begin(); }
 		auto end() { return instructions.end(); }
@@ -42,10 +75,15 @@ namespace ola
 		void AddPhiInst(PhiInst* phi)
 		{
 			phi->InsertBefore(this, instructions.begin());
-			phi_nodes.push_back(phi);
 		}
-		auto const& PhiInsts() const { return phi_nodes; }
-		Bool HasPhiInsts() const { return !phi_nodes.empty(); }
+		//the range is read from the instruction list so erased phis are never observed,
+		//callers that erase phis while iterating have to take a copy first
+		IteratorRange<PhiIterator> PhiInsts()
+		{
+			auto phi_end = std::find_if(instructions.begin(), instructions.end(), [](Instruction const& I) { return !isa<PhiInst>(&I); });
+			return MakeRange(PhiIterator(instructions.begin()), PhiIterator(phi_end));
+		}
+		Bool HasPhiInsts() const { return !instructions.Empty() && isa<PhiInst>(&instructions.Front()); }
 		
 		Instruction const* GetTerminator() const 
 		{
@@ -123,7 +161,14 @@ namespace ola
 		Function* function;
 		Uint32 block_idx;
 		IList<Instruction> instructions;
-		std::vector<PhiInst*> phi_nodes;
 		CFG* current_cfg;
 	};
+
+	//The sentinel of a block list has no type and so no context to allocate it from
+	template<>
+	struct IListTraits<BasicBlock> : public IListDefaultTraits<BasicBlock>
+	{
+		static BasicBlock* CreateSentinel() { return ::new BasicBlock(); }
+		static void DestroySentinel(BasicBlock* BB) { ::delete BB; }
+	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <span>
+#include <mutex>
 #include "Instruction.h"
 #include "IRType.h"
 #include "Compiler/RTTI.h"
@@ -27,8 +28,12 @@ namespace ola
 
 		static Constant* GetNullValue(IRType* Ty);
 
+		//Constants are shared by every function of a module and function bodies are generated concurrently
+		std::mutex& GetUsersMutex() { return users_mutex; }
+
 	protected:
 		ConstantID constant_id;
+		std::mutex users_mutex;
 
 	protected:
 		Constant(ConstantID constant_id, IRType* type) : TrackableValue(ValueKind::Constant, type), constant_id(constant_id) {}
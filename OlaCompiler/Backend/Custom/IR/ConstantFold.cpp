@@ -133,7 +133,7 @@ namespace ola
 			offset += index_value * current_type->GetSize();
 		}
 		IRType* int_type = IRIntType::Get(base->GetContext(), 8);
-		return new PtrAddInst(base, ctx.GetInt(int_type, offset), current_type);
+		return new (ctx) PtrAddInst(base, ctx.GetInt(int_type, offset), current_type);
 	}
 
 	Value* TryConstantFold_SelectInst(Value* predicate, Value* lhs, Value* rhs)
@@ -154,7 +154,7 @@ namespace ola
 		if (CI)
 		{
 			IRContext& ctx = CI->GetContext();
-			return CI->GetValue() != 0 ? new BranchInst(ctx, true_target) : new BranchInst(ctx, false_target);
+			return CI->GetValue() != 0 ? new (ctx) BranchInst(ctx, true_target) : new (ctx) BranchInst(ctx, false_target);
 		}
 		return nullptr;
 	}
@@ -1,4 +1,5 @@
 #include "GlobalValue.h"
+#include "IRContext.h"
 
 namespace ola
 {
@@ -9,13 +10,27 @@ namespace ola
 		arguments.resize(function_type->GetParamCount());
 		for (Uint32 i = 0; i < arguments.size(); ++i)
 		{
-			arguments[i] = new Argument(function_type->GetParamType(i), i);
+			arguments[i] = new (GetContext()) Argument(function_type->GetParamType(i), i);
 		}
 	}
 
 	Function::~Function()
 	{
-		arguments.clear();
+		//the instructions of the body can use the arguments so they go first
+		block_list.Clear();
+		for (Argument* arg : arguments) delete arg;
+	}
+
+	void* Argument::operator new(Uint64 size, IRContext& C)
+	{
+		return C.GetAllocator().Allocate(size);
+	}
+
+	void Argument::operator delete(Argument* A, std::destroying_delete_t)
+	{
+		IRAllocator& allocator = A->GetContext().GetAllocator();
+		A->~Argument();
+		allocator.Deallocate(A, sizeof(Argument));
 	}
 
 	Uint64 Function::GetInstructionCount() const
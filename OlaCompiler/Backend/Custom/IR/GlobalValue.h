@@ -73,6 +73,7 @@ namespace ola
 		void SetReadOnly() { attr.AddAttr(GlobalVariableAttribute::ReadOnly); }
 
 		Value* GetInitValue() const { return init; }
+		void SetInitValue(Value* _init) { init = _init; }
 
 		virtual Bool IsDeclaration() const override
 		{
@@ -92,6 +93,8 @@ namespace ola
 		friend class Function;
 	private:
 		Argument(IRType* type, Uint32 index) : Value(ValueKind::Argument, type), index(index) {}
+		void* operator new(Uint64 size, IRContext& C);
+		void operator delete(Argument* A, std::destroying_delete_t);
 		Uint32  GetIndex() const { return index; }
 		static Bool ClassOf(Value* V) { return V->GetKind() == ValueKind::Argument; }
 
@@ -104,7 +107,8 @@ namespace ola
 		Attribute_None = 0x00,
 		Attribute_NoInline = 0x01,
 		Attribute_ForceInline = 0x02,
-		Attribute_NoOptimizations = 0x04
+		Attribute_NoOptimizations = 0x04,
+		Attribute_NoMangle = 0x08
 	};
 
 	class BasicBlock;
@@ -149,7 +153,7 @@ namespace ola
 		}
 		Bool HasPhiInsts() const
 		{
-			for (auto const& BB : block_list) if (BB.PhiInsts().size() > 0) return true;
+			for (auto const& BB : block_list) if (BB.HasPhiInsts()) return true;
 			return false;
 		}
 
@@ -164,6 +168,8 @@ namespace ola
 		void SetNoInline() { attr.AddAttr(Attribute_NoInline); }
 		Bool IsNoOptimizations() const { return attr.HasAttr(Attribute_NoOptimizations); }
 		void SetNoOptimizations() { attr.AddAttr(Attribute_NoOptimizations); }
+		Bool IsNoMangle() const { return attr.HasAttr(Attribute_NoMangle); }
+		void SetNoMangle() { attr.AddAttr(Attribute_NoMangle); }
 
 		Uint64	Size() const;
 		Bool    Empty() const { return block_list.Empty(); }
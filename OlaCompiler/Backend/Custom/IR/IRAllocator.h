@@ -0,0 +1,81 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ola
+{
+	//Slab allocator for the instructions, blocks, arguments and constants of an IRContext. Objects are carved out of large slabs in the order
+	//they are created so the IR of a function stays close together in memory. Freed objects are kept on the free list of their size class
+	//and reused by the next allocation of that class, the slabs themselves are released all at once with the allocator.
+	//Function bodies are generated concurrently so allocations are serialized, allocations bigger than the largest size class go to the heap
+	class IRAllocator
+	{
+		static constexpr Uint64 SlabSize = 64 * 1024;
+		static constexpr Uint64 Granularity = 8;
+		static constexpr Uint64 MaxSizeClassSize = 1024;
+		static constexpr Uint64 SizeClassCount = MaxSizeClassSize / Granularity;
+
+	public:
+		IRAllocator() = default;
+		OLA_NONCOPYABLE_NONMOVABLE(IRAllocator)
+		~IRAllocator() = default;
+
+		void* Allocate(Uint64 size)
+		{
+			OLA_ASSERT(size > 0);
+			if (size > MaxSizeClassSize) return ::operator new(size);
+
+			Uint64 const size_class = GetSizeClass(size);
+			std::lock_guard lock(mutex);
+			if (FreeNode* node = free_lists[size_class])
+			{
+				free_lists[size_class] = node->next;
+				return node;
+			}
+			Uint64 const class_size = (size_class + 1) * Granularity;
+			if (cur_ptr + class_size > end_ptr) AllocateSlab();
+			void* ptr = reinterpret_cast<void*>(cur_ptr);
+			cur_ptr += class_size;
+			return ptr;
+		}
+
+		void Deallocate(void* ptr, Uint64 size)
+		{
+			if (size > MaxSizeClassSize)
+			{
+				::operator delete(ptr);
+				return;
+			}
+
+			Uint64 const size_class = GetSizeClass(size);
+			std::lock_guard lock(mutex);
+			free_lists[size_class] = new (ptr) FreeNode{ free_lists[size_class] };
+		}
+
+	private:
+		struct FreeNode
+		{
+			FreeNode* next;
+		};
+
+		std::vector<std::unique_ptr<Uint8[]>> slabs;
+		Uint64 cur_ptr = 0;
+		Uint64 end_ptr = 0;
+		FreeNode* free_lists[SizeClassCount] = {};
+		std::mutex mutex;
+
+	private:
+		static Uint64 GetSizeClass(Uint64 size)
+		{
+			return (size - 1) / Granularity;
+		}
+
+		void AllocateSlab()
+		{
+			Uint8* slab = slabs.emplace_back(new Uint8[SlabSize]).get();
+			cur_ptr = OLA_ALIGN_UP(reinterpret_cast<Uint64>(slab), Granularity);
+			end_ptr = reinterpret_cast<Uint64>(slab) + SlabSize;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,717 @@
+#include <ostream>
+#include <cstring>
+#include <algorithm>
+#include <span>
+#include "IRBinary.h"
+#include "IRModule.h"
+#include "IRContext.h"
+#include "IRType.h"
+#include "GlobalValue.h"
+#include "Utility/ByteStream.h"
+
+namespace ola
+{
+	namespace
+	{
+		constexpr Char IRBinaryMagic[] = { 'O', 'L', 'I', 'R' };
+		constexpr Uint32 IRBinaryVersion = 1;
+
+		enum class IRBinaryGlobalKind : Uint8
+		{
+			Variable,
+			Function
+		};
+
+		enum IRBinaryGlobalFlags : Uint8
+		{
+			IRBinaryGlobalFlag_None = 0x00,
+			IRBinaryGlobalFlag_ReadOnly = 0x01,
+			IRBinaryGlobalFlag_NoInline = 0x02,
+			IRBinaryGlobalFlag_ForceInline = 0x04,
+			IRBinaryGlobalFlag_NoOptimizations = 0x08,
+			IRBinaryGlobalFlag_NoMangle = 0x10
+		};
+
+		//Instructions whose type can't be derived from their operands
+		Bool HasTypePayload(Opcode opcode)
+		{
+			return opcode == Opcode::Load || opcode == Opcode::Alloca || opcode == Opcode::PtrAdd || opcode == Opcode::Phi || IsOpcodeCastOp(opcode);
+		}
+
+		class IRBinaryEncoder
+		{
+		public:
+			explicit IRBinaryEncoder(IRModule const& M) : M(M) {}
+
+			void Encode(std::ostream& os)
+			{
+				for (GlobalValue* GV : M.Globals())
+				{
+					value_ids[GV] = module_value_count++;
+				}
+				for (GlobalValue* GV : M.Globals()) CollectGlobal(GV);
+
+				ByteWriter header;
+				header.WriteVarint(IRBinaryVersion);
+				header.WriteVarint(types.size());
+				for (IRType* type : types) WriteType(header, type);
+
+				header.WriteVarint(M.Globals().size());
+				for (GlobalValue* GV : M.Globals()) WriteGlobal(header, GV);
+
+				header.WriteVarint(constants.size());
+				for (Constant* C : constants) WriteConstant(header, C);
+
+				for (GlobalValue* GV : M.Globals())
+				{
+					if (GlobalVariable* GVar = dyn_cast<GlobalVariable>(GV)) WriteOperand(header, GVar->GetInitValue());
+				}
+
+				ByteWriter bodies;
+				for (GlobalValue* GV : M.Globals())
+				{
+					Function* F = dyn_cast<Function>(GV);
+					if (!F) continue;
+
+					Uint64 const body_offset = bodies.GetSize();
+					if (!F->IsDeclaration()) WriteFunctionBody(bodies, *F);
+					header.WriteFixed64(body_offset);
+					header.WriteFixed64(bodies.GetSize() - body_offset);
+				}
+
+				os.write(IRBinaryMagic, sizeof(IRBinaryMagic));
+				os.write(reinterpret_cast<Char const*>(header.GetBytes().data()), header.GetSize());
+				os.write(reinterpret_cast<Char const*>(bodies.GetBytes().data()), bodies.GetSize());
+			}
+
+		private:
+			IRModule const& M;
+			std::vector<IRType*> types;
+			std::unordered_map<IRType const*, Uint64> type_ids;
+			std::vector<Constant*> constants;
+			std::unordered_map<Value const*, Uint64> value_ids;
+			Uint64 module_value_count = 0;
+			std::unordered_map<Value const*, Uint64> local_value_ids;
+			Uint64 current_local_id = 0;
+
+		private:
+			void AddType(IRType* type)
+			{
+				if (!type || type_ids.contains(type)) return;
+				switch (type->GetKind())
+				{
+				case IRTypeKind::Pointer:
+					AddType(cast<IRPtrType>(type)->GetPointeeType());
+					break;
+				case IRTypeKind::Array:
+					AddType(cast<IRArrayType>(type)->GetElementType());
+					break;
+				case IRTypeKind::Function:
+				{
+					IRFuncType* function_type = cast<IRFuncType>(type);
+					AddType(function_type->GetReturnType());
+					for (IRType* param_type : function_type->GetParamTypes()) AddType(param_type);
+				}
+				break;
+				case IRTypeKind::Struct:
+					for (IRType* member_type : cast<IRStructType>(type)->GetMemberTypes()) AddType(member_type);
+					break;
+				default:
+					break;
+				}
+				type_ids[type] = types.size();
+				types.push_back(type);
+			}
+
+			void AddConstant(Constant* C)
+			{
+				if (isa<GlobalValue>(C) || value_ids.contains(C)) return;
+				AddType(C->GetType());
+				if (ConstantAggregate* CA = dyn_cast<ConstantAggregate>(C))
+				{
+					for (Constant* element : CA->Values()) AddConstant(element);
+				}
+				value_ids[C] = module_value_count++;
+				constants.push_back(C);
+			}
+
+			void CollectGlobal(GlobalValue* GV)
+			{
+				AddType(GV->GetValueType());
+				if (GlobalVariable* GVar = dyn_cast<GlobalVariable>(GV))
+				{
+					if (Value* init = GVar->GetInitValue()) AddConstant(cast<Constant>(init));
+					return;
+				}
+				for (BasicBlock& BB : *cast<Function>(GV))
+				{
+					for (Instruction& I : BB)
+					{
+						AddType(I.GetType());
+						if (HasTypePayload(I.GetOpcode())) AddType(GetTypePayload(I));
+						for (Use const& U : I.Operands())
+						{
+							Value* V = U.GetValue();
+							if (!V) continue;
+							AddType(V->GetType());
+							if (Constant* C = dyn_cast<Constant>(V)) AddConstant(C);
+						}
+					}
+				}
+			}
+
+			static IRType* GetTypePayload(Instruction const& I)
+			{
+				switch (I.GetOpcode())
+				{
+				case Opcode::Alloca: return cast<AllocaInst>(&I)->GetAllocatedType();
+				case Opcode::PtrAdd: return cast<PtrAddInst>(&I)->GetResultElementType();
+				default:			 return I.GetType();
+				}
+			}
+
+			void WriteTypeRef(ByteWriter& writer, IRType* type)
+			{
+				writer.WriteVarint(type_ids[type]);
+			}
+
+			void WriteType(ByteWriter& writer, IRType* type)
+			{
+				writer.WriteByte(static_cast<Uint8>(type->GetKind()));
+				switch (type->GetKind())
+				{
+				case IRTypeKind::Integer:
+					writer.WriteVarint(cast<IRIntType>(type)->GetWidth());
+					break;
+				case IRTypeKind::Pointer:
+				{
+					IRType* pointee_type = cast<IRPtrType>(type)->GetPointeeType();
+					writer.WriteVarint(pointee_type ? type_ids[pointee_type] + 1 : 0);
+				}
+				break;
+				case IRTypeKind::Array:
+				{
+					IRArrayType* array_type = cast<IRArrayType>(type);
+					WriteTypeRef(writer, array_type->GetElementType());
+					writer.WriteVarint(array_type->GetArraySize());
+				}
+				break;
+				case IRTypeKind::Function:
+				{
+					IRFuncType* function_type = cast<IRFuncType>(type);
+					WriteTypeRef(writer, function_type->GetReturnType());
+					writer.WriteVarint(function_type->GetParamCount());
+					for (IRType* param_type : function_type->GetParamTypes()) WriteTypeRef(writer, param_type);
+				}
+				break;
+				case IRTypeKind::Struct:
+				{
+					IRStructType* struct_type = cast<IRStructType>(type);
+					writer.WriteString(struct_type->GetName());
+					writer.WriteVarint(struct_type->GetMemberCount());
+					for (IRType* member_type : struct_type->GetMemberTypes()) WriteTypeRef(writer, member_type);
+				}
+				break;
+				default:
+					break;
+				}
+			}
+
+			void WriteGlobal(ByteWriter& writer, GlobalValue* GV)
+			{
+				Uint8 flags = IRBinaryGlobalFlag_None;
+				if (Function* F = dyn_cast<Function>(GV))
+				{
+					if (F->IsNoInline())		  flags |= IRBinaryGlobalFlag_NoInline;
+					if (F->IsForceInline())		  flags |= IRBinaryGlobalFlag_ForceInline;
+					if (F->IsNoOptimizations())	  flags |= IRBinaryGlobalFlag_NoOptimizations;
+					if (F->IsNoMangle())		  flags |= IRBinaryGlobalFlag_NoMangle;
+				}
+				else if (cast<GlobalVariable>(GV)->IsReadOnly()) flags |= IRBinaryGlobalFlag_ReadOnly;
+
+				writer.WriteByte(static_cast<Uint8>(GV->IsFunction() ? IRBinaryGlobalKind::Function : IRBinaryGlobalKind::Variable));
+				writer.WriteString(GV->GetName());
+				WriteTypeRef(writer, GV->GetValueType());
+				writer.WriteByte(static_cast<Uint8>(GV->GetLinkage()));
+				writer.WriteByte(flags);
+			}
+
+			void WriteConstant(ByteWriter& writer, Constant* C)
+			{
+				writer.WriteByte(static_cast<Uint8>(C->GetConstantID()));
+				switch (C->GetConstantID())
+				{
+				case ConstantID::Integer:
+					WriteTypeRef(writer, C->GetType());
+					writer.WriteSignedVarint(cast<ConstantInt>(C)->GetValue());
+					break;
+				case ConstantID::Float:
+				{
+					Float64 const value = cast<ConstantFloat>(C)->GetValue();
+					Uint64 bits = 0;
+					std::memcpy(&bits, &value, sizeof(value));
+					writer.WriteFixed64(bits);
+				}
+				break;
+				case ConstantID::String:
+					writer.WriteString(cast<ConstantString>(C)->GetValue());
+					break;
+				case ConstantID::Array:
+				case ConstantID::Struct:
+				{
+					ConstantAggregate* CA = cast<ConstantAggregate>(C);
+					WriteTypeRef(writer, C->GetType());
+					writer.WriteVarint(CA->Values().size());
+					for (Constant* element : CA->Values()) WriteOperand(writer, element);
+				}
+				break;
+				case ConstantID::Undef:
+					WriteTypeRef(writer, C->GetType());
+					break;
+				default:
+					OLA_ASSERT_MSG(false, "Constant cannot be serialized!");
+				}
+			}
+
+			//Operands are written as their value id + 1, local values that are not defined yet also carry their type
+			void WriteOperand(ByteWriter& writer, Value const* V)
+			{
+				if (!V)
+				{
+					writer.WriteVarint(0);
+					return;
+				}
+				if (auto it = value_ids.find(V); it != value_ids.end())
+				{
+					writer.WriteVarint(it->second + 1);
+					return;
+				}
+				Uint64 const local_id = local_value_ids[V];
+				writer.WriteVarint(module_value_count + local_id + 1);
+				if (local_id >= current_local_id) WriteTypeRef(writer, V->GetType());
+			}
+
+			void WriteFunctionBody(ByteWriter& writer, Function const& F)
+			{
+				local_value_ids.clear();
+				Uint64 local_id = 0;
+				for (Argument* arg : F.Arguments()) local_value_ids[arg] = local_id++;
+				for (BasicBlock const& BB : F) local_value_ids[&BB] = local_id++;
+				for (BasicBlock const& BB : F)
+				{
+					for (Instruction const& I : BB) local_value_ids[&I] = local_id++;
+				}
+
+				for (Argument* arg : F.Arguments()) writer.WriteString(arg->GetName());
+				writer.WriteVarint(F.Size());
+				for (BasicBlock const& BB : F) writer.WriteString(BB.GetName());
+				for (BasicBlock const& BB : F)
+				{
+					writer.WriteVarint(BB.Instructions().Size());
+					for (Instruction const& I : BB)
+					{
+						current_local_id = local_value_ids[&I];
+						WriteInstruction(writer, I);
+					}
+				}
+			}
+
+			void WriteInstruction(ByteWriter& writer, Instruction const& I)
+			{
+				writer.WriteVarint(static_cast<Uint32>(I.GetOpcode()));
+				if (HasTypePayload(I.GetOpcode())) WriteTypeRef(writer, GetTypePayload(I));
+				writer.WriteString(I.GetName());
+				writer.WriteVarint(I.GetNumOperands());
+				for (Use const& U : I.Operands()) WriteOperand(writer, U.GetValue());
+				if (SwitchInst const* SI = dyn_cast<SwitchInst>(&I))
+				{
+					for (SwitchCase const& switch_case : SI->Cases()) writer.WriteSignedVarint(switch_case.GetCaseValue());
+				}
+			}
+		};
+	}
+
+	void IRBinaryWriter::WriteModule(IRModule const& M)
+	{
+		IRBinaryEncoder encoder(M);
+		encoder.Encode(os);
+	}
+
+	Bool IRBinaryReader::ReadModule(IRModule& M)
+	{
+		OLA_ASSERT_MSG(&M.GetContext() == &context, "Module has to be read into the context of the reader!");
+		if (buffer.size() < sizeof(IRBinaryMagic) || std::memcmp(buffer.data(), IRBinaryMagic, sizeof(IRBinaryMagic)) != 0) return false;
+
+		ByteReader reader(buffer.data() + sizeof(IRBinaryMagic), buffer.size() - sizeof(IRBinaryMagic));
+		if (reader.ReadVarint() != IRBinaryVersion) return false;
+
+		auto ReadTypeRef = [&]() -> IRType*
+			{
+				Uint64 const type_id = reader.ReadVarint();
+				return type_id < types.size() ? types[type_id] : nullptr;
+			};
+
+		Uint64 const type_count = reader.ReadVarint();
+		for (Uint64 i = 0; i < type_count && !reader.HasError(); ++i)
+		{
+			IRType* type = nullptr;
+			switch (static_cast<IRTypeKind>(reader.ReadByte()))
+			{
+			case IRTypeKind::Void:	  type = context.GetVoidType(); break;
+			case IRTypeKind::Float:	  type = context.GetFloatType(); break;
+			case IRTypeKind::Label:	  type = context.GetLabelType(); break;
+			case IRTypeKind::Integer: type = context.GetIntegerType(static_cast<Uint32>(reader.ReadVarint())); break;
+			case IRTypeKind::Pointer:
+			{
+				Uint64 const pointee_id = reader.ReadVarint();
+				if (pointee_id > types.size()) return false;
+				type = context.GetPointerType(pointee_id ? types[pointee_id - 1] : nullptr);
+			}
+			break;
+			case IRTypeKind::Array:
+			{
+				IRType* element_type = ReadTypeRef();
+				Uint32 const array_size = static_cast<Uint32>(reader.ReadVarint());
+				if (!element_type) return false;
+				type = context.GetArrayType(element_type, array_size);
+			}
+			break;
+			case IRTypeKind::Function:
+			{
+				IRType* return_type = ReadTypeRef();
+				std::vector<IRType*> param_types(reader.ReadVarint());
+				for (IRType*& param_type : param_types) param_type = ReadTypeRef();
+				if (!return_type || std::find(param_types.begin(), param_types.end(), nullptr) != param_types.end()) return false;
+				type = context.GetFunctionType(return_type, param_types);
+			}
+			break;
+			case IRTypeKind::Struct:
+			{
+				std::string_view name = reader.ReadString();
+				std::vector<IRType*> member_types(reader.ReadVarint());
+				for (IRType*& member_type : member_types) member_type = ReadTypeRef();
+				if (std::find(member_types.begin(), member_types.end(), nullptr) != member_types.end()) return false;
+				type = context.GetStructType(name, member_types);
+			}
+			break;
+			default:
+				return false;
+			}
+			types.push_back(type);
+		}
+
+		std::vector<GlobalValue*> globals(reader.ReadVarint());
+		for (GlobalValue*& GV : globals)
+		{
+			IRBinaryGlobalKind const kind = static_cast<IRBinaryGlobalKind>(reader.ReadByte());
+			std::string_view name = reader.ReadString();
+			IRType* value_type = ReadTypeRef();
+			Linkage const linkage = reader.ReadByte() ? Linkage::External : Linkage::Internal;
+			Uint8 const flags = reader.ReadByte();
+			if (reader.HasError() || !value_type) return false;
+
+			if (kind == IRBinaryGlobalKind::Function)
+			{
+				if (!isa<IRFuncType>(value_type)) return false;
+				Function* F = new Function(name, cast<IRFuncType>(value_type), linkage);
+				if (flags & IRBinaryGlobalFlag_NoInline)		F->SetNoInline();
+				if (flags & IRBinaryGlobalFlag_ForceInline)		F->SetForceInline();
+				if (flags & IRBinaryGlobalFlag_NoOptimizations) F->SetNoOptimizations();
+				if (flags & IRBinaryGlobalFlag_NoMangle)		F->SetNoMangle();
+				GV = F;
+			}
+			else
+			{
+				GlobalVariable* GVar = new GlobalVariable(name, value_type, linkage, nullptr);
+				if (flags & IRBinaryGlobalFlag_ReadOnly) GVar->SetReadOnly();
+				GV = GVar;
+			}
+			M.AddGlobal(GV);
+			module_values.push_back(GV);
+		}
+
+		auto ReadConstantRef = [&]() -> Constant*
+			{
+				Uint64 const value_id = reader.ReadVarint();
+				return value_id > 0 && value_id <= module_values.size() ? cast<Constant>(module_values[value_id - 1]) : nullptr;
+			};
+
+		Uint64 const constant_count = reader.ReadVarint();
+		for (Uint64 i = 0; i < constant_count && !reader.HasError(); ++i)
+		{
+			Constant* C = nullptr;
+			switch (static_cast<ConstantID>(reader.ReadByte()))
+			{
+			case ConstantID::Integer:
+			{
+				IRType* type = ReadTypeRef();
+				Int64 const value = reader.ReadSignedVarint();
+				if (!type || !type->IsInteger()) return false;
+				C = context.GetInt(type, value);
+			}
+			break;
+			case ConstantID::Float:
+			{
+				Uint64 const bits = reader.ReadFixed64();
+				Float64 value = 0.0;
+				std::memcpy(&value, &bits, sizeof(value));
+				C = context.GetFloat(value);
+			}
+			break;
+			case ConstantID::String:
+				C = context.GetString(reader.ReadString());
+				break;
+			case ConstantID::Array:
+			case ConstantID::Struct:
+			{
+				IRType* type = ReadTypeRef();
+				std::vector<Constant*> elements(reader.ReadVarint());
+				for (Constant*& element : elements) element = ReadConstantRef();
+				if (std::find(elements.begin(), elements.end(), nullptr) != elements.end()) return false;
+				if (!type) return false;
+				if (IRArrayType* array_type = dyn_cast<IRArrayType>(type))		   C = new ConstantArray(array_type, elements);
+				else if (IRStructType* struct_type = dyn_cast<IRStructType>(type)) C = new ConstantStruct(struct_type, elements);
+				else return false;
+			}
+			break;
+			case ConstantID::Undef:
+			{
+				IRType* type = ReadTypeRef();
+				if (!type) return false;
+				C = context.GetUndefValue(type);
+			}
+			break;
+			default:
+				return false;
+			}
+			module_values.push_back(C);
+		}
+
+		for (GlobalValue* GV : globals)
+		{
+			if (GlobalVariable* GVar = dyn_cast<GlobalVariable>(GV))
+			{
+				Uint64 const init_id = reader.ReadVarint();
+				if (init_id > module_values.size()) return false;
+				if (init_id) GVar->SetInitValue(module_values[init_id - 1]);
+			}
+		}
+
+		std::vector<std::pair<Function*, FunctionBody>> bodies;
+		for (GlobalValue* GV : globals)
+		{
+			if (Function* F = dyn_cast<Function>(GV))
+			{
+				Uint64 const offset = reader.ReadFixed64();
+				Uint64 const size = reader.ReadFixed64();
+				if (size > 0) bodies.emplace_back(F, FunctionBody{ .offset = offset, .size = size });
+			}
+		}
+		if (reader.HasError()) return false;
+
+		Uint64 const bodies_offset = reader.GetPosition() - buffer.data();
+		for (auto& [F, body] : bodies)
+		{
+			body.offset += bodies_offset;
+			if (body.offset + body.size > buffer.size()) return false;
+			function_bodies[F] = body;
+		}
+		return true;
+	}
+
+	Bool IRBinaryReader::Materialize(Function* F)
+	{
+		auto it = function_bodies.find(F);
+		if (it == function_bodies.end()) return false;
+		FunctionBody const body = it->second;
+		function_bodies.erase(it);
+
+		std::unordered_map<Uint64, UndefValue*> forward_references;
+		Bool const materialized = ReadFunctionBody(F, body, forward_references);
+		//a body that can't be decoded is dropped so the function stays a declaration, its instructions go first since they can use the placeholders
+		if (!materialized) F->Blocks().Clear();
+		for (auto& [local_id, placeholder] : forward_references) delete placeholder;
+		return materialized;
+	}
+
+	Bool IRBinaryReader::ReadFunctionBody(Function* F, FunctionBody const& body, std::unordered_map<Uint64, UndefValue*>& forward_references)
+	{
+		ByteReader reader(buffer.data() + body.offset, body.size);
+		std::vector<Value*> local_values;
+
+		auto ReadTypeRef = [&]() -> IRType*
+			{
+				Uint64 const type_id = reader.ReadVarint();
+				return type_id < types.size() ? types[type_id] : nullptr;
+			};
+		auto ReadOperand = [&]() -> Value*
+			{
+				Uint64 const value_id = reader.ReadVarint();
+				if (value_id == 0) return nullptr;
+				if (value_id <= module_values.size()) return module_values[value_id - 1];
+				Uint64 const local_id = value_id - module_values.size() - 1;
+				if (local_id < local_values.size()) return local_values[local_id];
+
+				//the value is defined later in the function, use a placeholder until then
+				IRType* type = ReadTypeRef();
+				if (!type) return nullptr;
+				UndefValue*& placeholder = forward_references[local_id];
+				if (!placeholder) placeholder = new UndefValue(type);
+				return placeholder;
+			};
+
+		for (Argument* arg : F->Arguments())
+		{
+			arg->SetName(reader.ReadString());
+			local_values.push_back(arg);
+		}
+
+		std::vector<BasicBlock*> blocks(reader.ReadVarint());
+		for (Uint32 i = 0; i < blocks.size() && !reader.HasError(); ++i)
+		{
+			blocks[i] = new (context) BasicBlock(context, F, i);
+			blocks[i]->SetName(reader.ReadString());
+			F->Insert(blocks[i]);
+			local_values.push_back(blocks[i]);
+		}
+
+		for (BasicBlock* BB : blocks)
+		{
+			Uint64 const instruction_count = reader.ReadVarint();
+			for (Uint64 i = 0; i < instruction_count && !reader.HasError(); ++i)
+			{
+				Opcode const opcode = static_cast<Opcode>(reader.ReadVarint());
+				IRType* type = HasTypePayload(opcode) ? ReadTypeRef() : nullptr;
+				std::string_view name = reader.ReadString();
+				std::vector<Value*> operands(reader.ReadVarint());
+				for (Value*& operand : operands) operand = ReadOperand();
+				if (reader.HasError() || (HasTypePayload(opcode) && !type)) return false;
+
+				auto HasOperands = [&](Uint64 count)
+					{
+						return operands.size() == count && std::find(operands.begin(), operands.end(), nullptr) == operands.end();
+					};
+
+				Instruction* I = nullptr;
+				if (IsOpcodeBinaryOp(opcode))
+				{
+					if (!HasOperands(2)) return false;
+					I = new (context) BinaryInst(opcode, operands[0], operands[1]);
+				}
+				else if (IsOpcodeUnaryOp(opcode))
+				{
+					if (!HasOperands(1)) return false;
+					I = new (context) UnaryInst(opcode, operands[0]);
+				}
+				else if (IsOpcodeCompareOp(opcode))
+				{
+					if (!HasOperands(2)) return false;
+					I = new (context) CompareInst(opcode, operands[0], operands[1]);
+				}
+				else if (IsOpcodeCastOp(opcode))
+				{
+					if (!HasOperands(1)) return false;
+					I = new (context) CastInst(opcode, type, operands[0]);
+				}
+				else
+				{
+					switch (opcode)
+					{
+					case Opcode::Ret:
+						if (operands.size() > 1) return false;
+						I = operands.empty() ? new (context) ReturnInst(context) : new (context) ReturnInst(operands[0]);
+						break;
+					case Opcode::Branch:
+						//a branch whose condition was cleared keeps its operand slots but is unconditional
+						if (operands.size() == 3 && operands[2] && isa<BasicBlock>(operands[0]) && isa<BasicBlock>(operands[1]))
+						{
+							I = new (context) BranchInst(operands[2], cast<BasicBlock>(operands[0]), cast<BasicBlock>(operands[1]));
+						}
+						else if ((operands.size() == 1 || operands.size() == 3) && isa<BasicBlock>(operands[0]))
+						{
+							I = new (context) BranchInst(context, cast<BasicBlock>(operands[0]));
+						}
+						else return false;
+						break;
+					case Opcode::Switch:
+					{
+						if (operands.size() < 2 || !operands[0]) return false;
+						for (Uint64 j = 1; j < operands.size(); ++j)
+						{
+							//the default block is optional
+							if (!(j == 1 && !operands[j]) && !isa<BasicBlock>(operands[j])) return false;
+						}
+						SwitchInst* SI = new (context) SwitchInst(operands[0], operands[1] ? cast<BasicBlock>(operands[1]) : nullptr);
+						for (Uint64 j = 2; j < operands.size(); ++j) SI->AddCase(reader.ReadSignedVarint(), cast<BasicBlock>(operands[j]));
+						I = SI;
+					}
+					break;
+					case Opcode::Load:
+						if (!HasOperands(1)) return false;
+						I = new (context) LoadInst(operands[0], type);
+						break;
+					case Opcode::Store:
+						if (!HasOperands(2)) return false;
+						I = new (context) StoreInst(operands[0], operands[1]);
+						break;
+					case Opcode::Alloca:
+						if (!HasOperands(0)) return false;
+						I = new (context) AllocaInst(type);
+						break;
+					case Opcode::GetElementPtr:
+						if (operands.empty() || !HasOperands(operands.size())) return false;
+						I = new (context) GetElementPtrInst(operands[0], std::span<Value*>(operands).subspan(1));
+						break;
+					case Opcode::PtrAdd:
+						if (!HasOperands(2)) return false;
+						I = new (context) PtrAddInst(operands[0], operands[1], type);
+						break;
+					case Opcode::Select:
+						if (!HasOperands(3)) return false;
+						I = new (context) SelectInst(operands[0], operands[1], operands[2]);
+						break;
+					case Opcode::Call:
+						if (operands.empty() || !HasOperands(operands.size()) || !isa<Function>(operands.back())) return false;
+						I = new (context) CallInst(operands.back(), std::span<Value*>(operands).first(operands.size() - 1));
+						break;
+					case Opcode::Phi:
+					{
+						if (operands.size() % 2 != 0 || !HasOperands(operands.size())) return false;
+						for (Uint64 j = 1; j < operands.size(); j += 2)
+						{
+							if (!isa<BasicBlock>(operands[j])) return false;
+						}
+						PhiInst* Phi = new (context) PhiInst(type);
+						for (Uint64 j = 0; j < operands.size(); j += 2) Phi->AddIncoming(operands[j], cast<BasicBlock>(operands[j + 1]));
+						I = Phi;
+					}
+					break;
+					default:
+						return false;
+					}
+				}
+
+				I->SetName(name);
+				I->InsertBefore(BB, BB->Instructions().end());
+				if (auto forward_it = forward_references.find(local_values.size()); forward_it != forward_references.end())
+				{
+					forward_it->second->ReplaceAllUsesWith(I);
+					delete forward_it->second;
+					forward_references.erase(forward_it);
+				}
+				local_values.push_back(I);
+			}
+		}
+		return !reader.HasError() && forward_references.empty();
+	}
+
+	Bool IRBinaryReader::MaterializeAll()
+	{
+		for (Value* V : module_values)
+		{
+			Function* F = dyn_cast<Function>(V);
+			if (F && IsMaterializable(F) && !Materialize(F)) return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <iosfwd>
+#include <vector>
+#include <unordered_map>
+
+namespace ola
+{
+	class IRContext;
+	class IRModule;
+	class IRType;
+	class Value;
+	class Function;
+	class UndefValue;
+
+	//Binary encoding of an IRModule, a header with types, globals and constants is followed by an index of function bodies
+	//so that a reader can materialize functions individually instead of decoding the whole module.
+	class IRBinaryWriter
+	{
+	public:
+		explicit IRBinaryWriter(std::ostream& os) : os(os) {}
+		void WriteModule(IRModule const& M);
+
+	private:
+		std::ostream& os;
+	};
+
+	class IRBinaryReader
+	{
+		struct FunctionBody
+		{
+			Uint64 offset;
+			Uint64 size;
+		};
+
+	public:
+		IRBinaryReader(IRContext& context, std::vector<Uint8>&& buffer) : context(context), buffer(std::move(buffer)) {}
+		OLA_NONCOPYABLE_NONMOVABLE(IRBinaryReader)
+		~IRBinaryReader() = default;
+
+		//Reads everything except function bodies, functions with a body stay declarations until they are materialized
+		Bool ReadModule(IRModule& M);
+		Bool IsMaterializable(Function const* F) const { return function_bodies.contains(F); }
+		Bool Materialize(Function* F);
+		Bool MaterializeAll();
+
+	private:
+		IRContext& context;
+		std::vector<Uint8> buffer;
+		std::vector<IRType*> types;
+		std::vector<Value*> module_values;
+		std::unordered_map<Function const*, FunctionBody> function_bodies;
+
+	private:
+		Bool ReadFunctionBody(Function* F, FunctionBody const& body, std::unordered_map<Uint64, UndefValue*>& forward_references);
+	};
+}
@@ -42,7 +42,7 @@ namespace ola
 	BasicBlock* IRBuilder::AddBlock(Function* F, std::string_view name)
 	{
 		auto& blocks = F->Blocks();
-		BasicBlock* block = new BasicBlock(ctx, F, blocks.Size());
+		BasicBlock* block = new (ctx) BasicBlock(ctx, F, blocks.Size());
 		if (name.empty())
 		{
 			std::string label = "BB" + std::to_string(bb_label_counter++);
@@ -61,7 +61,7 @@ namespace ola
 	{
 		OLA_ASSERT(!before || before->GetFunction() == F);
 		auto& blocks = F->Blocks();
-		BasicBlock* block = new BasicBlock(ctx, F, blocks.Size());
+		BasicBlock* block = new (ctx) BasicBlock(ctx, F, blocks.Size());
 		if (name.empty())
 		{
 			std::string label = "BB" + std::to_string(bb_label_counter++);
@@ -50,7 +50,7 @@ namespace ola
 				}
 				return V;
 			}
-			InstructionT* I = new InstructionT(std::forward<Args>(args)...);
+			InstructionT* I = new (ctx) InstructionT(std::forward<Args>(args)...);
 			I->InsertBefore(current_block, insert_point);
 			return I;
 		}
@@ -1,3 +1,4 @@
+#include <memory>
 #include "IRContext.h"
 #include "IRType.h"
 #include "Constant.h"
@@ -13,9 +14,9 @@ namespace ola
 		float_type = new(this) IRFloatType(*this);
 		label_type = new(this) IRLabelType(*this);
 
-		true_value = new ConstantInt(int1_type, 1);
-		false_value = new ConstantInt(int1_type, 0);
-		zero_float = new ConstantFloat(float_type, 0.0);
+		true_value = NewConstant<ConstantInt>(int1_type, 1);
+		false_value = NewConstant<ConstantInt>(int1_type, 0);
+		zero_float = NewConstant<ConstantFloat>(float_type, 0.0);
 	}
 
 	IRContext::~IRContext()
@@ -25,14 +26,16 @@ namespace ola
 		for (IRPtrType* ref_type : pointer_types)			delete ref_type;
 		for (IRFuncType* function_type : function_types)	delete function_type;
 
-		for (auto& [_, v] : undef_values) delete v;
-		for (auto& [_, v] : constant_strings) delete v;
-		for (auto& [_, v] : constant_ints64) delete v;
-		for (auto& [_, v] : constant_ints8) delete v;
+		for (auto& [_, v] : constant_null_arrays) std::destroy_at(v);
+		for (auto& [_, v] : undef_values) std::destroy_at(v);
+		for (auto& [_, v] : constant_strings) std::destroy_at(v);
+		for (auto& [_, v] : constant_floats) std::destroy_at(v);
+		for (auto& [_, v] : constant_ints64) std::destroy_at(v);
+		for (auto& [_, v] : constant_ints8) std::destroy_at(v);
 
-		delete zero_float;
-		delete false_value;
-		delete true_value;
+		std::destroy_at(zero_float);
+		std::destroy_at(false_value);
+		std::destroy_at(true_value);
 
 		delete label_type;
 		delete float_type;
@@ -55,6 +58,7 @@ namespace ola
 
 	IRPtrType* IRContext::GetPointerType(IRType* pointee_type)
 	{
+		std::lock_guard lock(mutex);
 		for (auto const& pointer_type : pointer_types)
 		{
 			if (pointer_type->GetPointeeType() == pointee_type) return pointer_type;
@@ -66,6 +70,7 @@ namespace ola
 
 	IRArrayType* IRContext::GetArrayType(IRType* base_type, Uint32 array_size)
 	{
+		std::lock_guard lock(mutex);
 		for (auto const& array_type : array_types)
 		{
 			if (array_type->GetElementType() == base_type && array_type->GetArraySize() == array_size) return array_type;
@@ -77,6 +82,7 @@ namespace ola
 
 	IRFuncType* IRContext::GetFunctionType(IRType* ret_type, std::vector<IRType*> const& param_types)
 	{
+		std::lock_guard lock(mutex);
 		for (auto const& function_type : function_types)
 		{
 			if (function_type->GetReturnType() != ret_type) continue;
@@ -99,6 +105,7 @@ namespace ola
 
 	IRStructType* IRContext::GetStructType(std::string_view name, std::vector<IRType*> const& member_types)
 	{
+		std::lock_guard lock(mutex);
 		for (auto const& struct_type : struct_types)
 		{
 			if (struct_type->GetName() != name) continue;
@@ -121,22 +128,25 @@ namespace ola
 
 	ConstantString* IRContext::GetString(std::string_view str)
 	{
+		std::lock_guard lock(mutex);
 		if (constant_strings.contains(str)) return constant_strings[str];
-		constant_strings[str] = new ConstantString(*this, str);
+		constant_strings[str] = NewConstant<ConstantString>(*this, str);
 		return constant_strings[str];
 	}
 
 	ConstantInt* IRContext::GetInt64(Int64 value)
 	{
+		std::lock_guard lock(mutex);
 		if (constant_ints64.contains(value)) return constant_ints64[value];
-		constant_ints64[value] = new ConstantInt(int8_type, value);
+		constant_ints64[value] = NewConstant<ConstantInt>(int8_type, value);
 		return constant_ints64[value];
 	}
 
 	ConstantInt* IRContext::GetInt8(Int8 value)
 	{
+		std::lock_guard lock(mutex);
 		if (constant_ints8.contains(value)) return constant_ints8[value];
-		constant_ints8[value] = new ConstantInt(int1_type, value);
+		constant_ints8[value] = NewConstant<ConstantInt>(int1_type, value);
 		return constant_ints8[value];
 	}
 
@@ -151,13 +161,15 @@ namespace ola
 
 	ConstantFloat* IRContext::GetFloat(Float64 value)
 	{
+		std::lock_guard lock(mutex);
 		if (constant_floats.contains(value)) return constant_floats[value];
-		constant_floats[value] = new ConstantFloat(float_type, value);
+		constant_floats[value] = NewConstant<ConstantFloat>(float_type, value);
 		return constant_floats[value];
 	}
 
 	ConstantArray* IRContext::GetNullArray(IRArrayType* array_type)
 	{
+		std::lock_guard lock(mutex);
 		if (!constant_null_arrays.contains(array_type))
 		{
 			IRType* element_type = array_type->GetElementType();
@@ -166,7 +178,7 @@ namespace ola
 			Constant* element_null_value = Constant::GetNullValue(element_type);
 			std::vector<Constant*> elements(array_size, element_null_value);
 
-			constant_null_arrays[array_type] = new ConstantArray(array_type, elements);
+			constant_null_arrays[array_type] = NewConstant<ConstantArray>(array_type, elements);
 		}
 		return constant_null_arrays[array_type];
 	}
@@ -192,9 +204,10 @@ namespace ola
 
 	UndefValue* IRContext::GetUndefValue(IRType* type)
 	{
+		std::lock_guard lock(mutex);
 		if (!undef_values.contains(type))
 		{
-			undef_values[type] = new UndefValue(type);
+			undef_values[type] = NewConstant<UndefValue>(type);
 		}
 		return undef_values[type];
 	}
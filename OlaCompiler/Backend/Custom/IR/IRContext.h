@@ -2,6 +2,8 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <mutex>
+#include "IRAllocator.h"
 
 namespace ola
 {
@@ -53,7 +55,11 @@ namespace ola
 		Constant* GetNullValue(IRType* type);
 		UndefValue* GetUndefValue(IRType* type);
 
+		IRAllocator& GetAllocator() { return allocator; }
+
 	private:
+		IRAllocator		allocator;
+
 		IRVoidType*		void_type;
 		IRIntType*		int1_type;
 		IRIntType*		int8_type;
@@ -74,6 +80,18 @@ namespace ola
 		std::unordered_map<Float64, ConstantFloat*> constant_floats;
 		std::unordered_map<IRArrayType*, ConstantArray*> constant_null_arrays;
 		std::unordered_map<IRType*, UndefValue*> undef_values;
+
+		//Function bodies are generated concurrently so uniquing is serialized,
+		//the lock is recursive since constants unique their own types while they are constructed
+		std::recursive_mutex mutex;
+
+	private:
+		//Uniqued constants live in the slabs of the context, they are destroyed with it and never returned to the free lists
+		template<typename T, typename... Args>
+		T* NewConstant(Args&&... args)
+		{
+			return new (allocator.Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+		}
 	};
 }
 
@@ -3,15 +3,18 @@
 
 namespace ola
 {
-	IRGenContext::IRGenContext(std::string_view filename) : context(), module(context, filename)
+	IRGenContext::IRGenContext(std::string_view filename) : owned_context(std::make_unique<IRContext>()), module(*owned_context, filename)
+	{}
+
+	IRGenContext::IRGenContext(IRContext& context, std::string_view filename) : module(context, filename)
 	{}
 
 	IRGenContext::~IRGenContext() = default;
 
-	void IRGenContext::Generate(AST const* ast)
+	void IRGenContext::Generate(AST const* ast, Uint32 thread_count)
 	{
-		IRVisitor ir_visitor(context, module);
-		ir_visitor.VisitAST(ast);
+		IRVisitor ir_visitor(module.GetContext(), module);
+		ir_visitor.VisitAST(ast, thread_count);
 	}
 }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include "IRContext.h"
 #include "IRModule.h"
 
@@ -10,13 +11,15 @@ namespace ola
 	{
 	public:
 		explicit IRGenContext(std::string_view filename);
+		IRGenContext(IRContext& context, std::string_view filename);
 		~IRGenContext();
 
-		void Generate(AST const* ast);
+		//Function bodies are generated on thread_count threads, 0 uses all hardware threads
+		void Generate(AST const* ast, Uint32 thread_count = 1);
 		IRModule& GetModule() { return module; }
 
 	private:
-		IRContext context;
+		std::unique_ptr<IRContext> owned_context;
 		IRModule  module;
 	};
 }
\ No newline at end of file
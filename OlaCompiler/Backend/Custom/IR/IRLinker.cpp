@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <unordered_set>
+#include <format>
+#include "IRLinker.h"
+#include "IRModule.h"
+#include "GlobalValue.h"
+#include "Core/Log.h"
+
+namespace ola
+{
+	IRLinker::~IRLinker()
+	{
+		for (GlobalValue* GV : globals) delete GV;
+	}
+
+	Bool IRLinker::Link(IRModule& src)
+	{
+		OLA_ASSERT_MSG(&src.GetContext() == &module.GetContext(), "Linked modules have to share the IR context!");
+		Bool success = true;
+		for (GlobalValue* GV : src.ReleaseGlobals())
+		{
+			//internal definitions are private to their translation unit, they are never resolved by name
+			if (IsPrivate(GV))
+			{
+				globals.push_back(GV);
+				continue;
+			}
+
+			std::string name(GV->GetName());
+			auto it = symbols.find(name);
+			if (it == symbols.end())
+			{
+				globals.push_back(GV);
+				symbols[name] = GV;
+				continue;
+			}
+
+			GlobalValue* existing_GV = it->second;
+			if (GV->IsFunction() != existing_GV->IsFunction() || GV->GetValueType() != existing_GV->GetValueType())
+			{
+				OLA_ERROR("Symbol '{}' is declared with different types in different translation units!", name);
+				globals.push_back(GV);
+				success = false;
+				continue;
+			}
+			if (!GV->IsDeclaration() && !existing_GV->IsDeclaration())
+			{
+				OLA_ERROR("Symbol '{}' is defined more than once!", name);
+				globals.push_back(GV);
+				success = false;
+				continue;
+			}
+
+			if (GV->IsDeclaration())
+			{
+				GV->ReplaceAllUsesWith(existing_GV);
+				delete GV;
+			}
+			else
+			{
+				existing_GV->ReplaceAllUsesWith(GV);
+				std::replace(globals.begin(), globals.end(), existing_GV, GV);
+				it->second = GV;
+				delete existing_GV;
+			}
+		}
+		return success;
+	}
+
+	void IRLinker::Finalize()
+	{
+		//private definitions take a new name if theirs is already used, symbols resolved by name keep theirs
+		std::unordered_set<std::string> used_names;
+		for (auto const& [name, GV] : symbols) used_names.insert(name);
+		Uint32 renamed_symbol_count = 0;
+		for (GlobalValue* GV : globals)
+		{
+			if (IsPrivate(GV) && !used_names.insert(std::string(GV->GetName())).second)
+			{
+				std::string name;
+				do
+				{
+					name = std::format("{}.{}", GV->GetName(), renamed_symbol_count++);
+				} while (!used_names.insert(name).second);
+				GV->SetName(name);
+			}
+
+			//nothing outside of the program can reference its definitions, except for the entry point and nomangle exports
+			if (GV->GetLinkage() == Linkage::External && !GV->IsDeclaration())
+			{
+				Function* F = dyn_cast<Function>(GV);
+				Bool const is_exported = F && (F->GetName() == "main" || F->IsNoMangle());
+				if (!is_exported) GV->SetLinkage(Linkage::Internal);
+			}
+			module.AddGlobal(GV);
+		}
+		globals.clear();
+		symbols.clear();
+	}
+
+	Bool IRLinker::IsPrivate(GlobalValue const* GV)
+	{
+		return GV->GetLinkage() == Linkage::Internal && !GV->IsDeclaration();
+	}
+}
\ No newline at end of file
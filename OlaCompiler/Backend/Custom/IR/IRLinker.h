@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace ola
+{
+	class IRModule;
+	class GlobalValue;
+
+	//Links the modules of separate translation units into a single module so the whole program can be optimized at once.
+	//All linked modules have to share the IR context of the destination module.
+	class IRLinker
+	{
+	public:
+		explicit IRLinker(IRModule& module) : module(module) {}
+		OLA_NONCOPYABLE_NONMOVABLE(IRLinker)
+		~IRLinker();
+
+		Bool Link(IRModule& src);
+		void Finalize();
+
+	private:
+		IRModule& module;
+		std::vector<GlobalValue*> globals;
+		std::unordered_map<std::string, GlobalValue*> symbols;
+
+	private:
+		static Bool IsPrivate(GlobalValue const* GV);
+	};
+}
\ No newline at end of file
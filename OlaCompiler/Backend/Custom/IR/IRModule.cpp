@@ -1,8 +1,11 @@
 #include <fstream>
+#include <sstream>
+#include <utility>
 #include "IRModule.h"
 #include "IRType.h"
 #include "GlobalValue.h"
 #include "IRPrinter.h"
+#include "IRBinary.h"
 
 namespace ola
 {
@@ -31,11 +34,39 @@ namespace ola
 		globals.erase(std::remove(std::begin(globals), std::end(globals), GV), std::end(globals));
 	}
 
+	std::vector<GlobalValue*> IRModule::ReleaseGlobals()
+	{
+		function_map.clear();
+		return std::exchange(globals, {});
+	}
+
 	void IRModule::Print(std::string_view filename) const
 	{
 		std::ofstream ir_stream(filename.data());
 		IRPrinter ir_printer(ir_stream);
 		ir_printer.PrintModule(*this);
 	}
+
+	void IRModule::WriteBinary(std::string_view filename) const
+	{
+		std::ofstream ir_stream(filename.data(), std::ios::binary);
+		IRBinaryWriter ir_writer(ir_stream);
+		ir_writer.WriteModule(*this);
+	}
+
+	std::vector<Uint8> IRModule::WriteBinary() const
+	{
+		std::ostringstream ir_stream(std::ios::binary);
+		IRBinaryWriter ir_writer(ir_stream);
+		ir_writer.WriteModule(*this);
+		std::string const ir_binary = std::move(ir_stream).str();
+		return std::vector<Uint8>(ir_binary.begin(), ir_binary.end());
+	}
+
+	Bool IRModule::ReadBinary(std::vector<Uint8>&& buffer)
+	{
+		IRBinaryReader ir_reader(context, std::move(buffer));
+		return ir_reader.ReadModule(*this) && ir_reader.MaterializeAll();
+	}
 }
 
@@ -24,15 +24,21 @@ namespace ola
 			return module_id;
 		}
 
-		Function* GetFunctionByName(std::string_view name)
+		Function* GetFunctionByName(std::string_view name) const
 		{
-			return function_map[name];
+			auto it = function_map.find(name);
+			return it != function_map.end() ? it->second : nullptr;
 		}
 		void AddGlobal(GlobalValue* GV);
 		void RemoveGlobal(GlobalValue* GV);
+		std::vector<GlobalValue*> ReleaseGlobals();
 		std::vector<GlobalValue*> const& Globals() const { return globals; }
 
 		void Print(std::string_view filename) const;
+		void WriteBinary(std::string_view filename) const;
+		std::vector<Uint8> WriteBinary() const;
+		//Reads a module written by WriteBinary into this module, the module has to be empty
+		Bool ReadBinary(std::vector<Uint8>&& buffer);
 
 	private:
 		IRContext& context;
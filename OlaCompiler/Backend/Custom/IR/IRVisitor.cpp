@@ -11,6 +11,7 @@
 #include "Frontend/AST/Decl.h"
 #include "Frontend/AST/Stmt.h"
 #include "Frontend/AST/Expr.h"
+#include "Utility/ThreadPool.h"
 
 namespace ola
 {
@@ -26,13 +27,50 @@ namespace ola
 		float_type = IRFloatType::Get(context);
 	}
 
+	IRVisitor::IRVisitor(IRVisitor const* module_visitor) : IRVisitor(module_visitor->context, module_visitor->module)
+	{
+		this->module_visitor = module_visitor;
+	}
+
 	IRVisitor::~IRVisitor()
 	{
 	}
 
-	void IRVisitor::VisitAST(AST const* ast)
+	void IRVisitor::VisitAST(AST const* ast, Uint32 thread_count)
 	{
 		ast->translation_unit->Accept(*this);
+
+		//All globals and functions are declared at this point so function bodies are independent of each other
+		std::vector<std::vector<GlobalVariable*>> body_string_literals(function_bodies.size());
+		auto GenerateFunctionBody = [this, &body_string_literals](Uint64 i)
+			{
+				IRVisitor body_visitor(this);
+				auto [function_decl, function] = function_bodies[i];
+				body_visitor.VisitFunctionDeclCommon(*function_decl, function);
+				body_string_literals[i] = std::move(body_visitor.string_literals);
+			};
+		if (thread_count == 1 || function_bodies.size() < 2)
+		{
+			for (Uint64 i = 0; i < function_bodies.size(); ++i) GenerateFunctionBody(i);
+		}
+		else
+		{
+			ThreadPool thread_pool(thread_count);
+			std::vector<std::future<void>> function_body_tasks;
+			function_body_tasks.reserve(function_bodies.size());
+			for (Uint64 i = 0; i < function_bodies.size(); ++i)
+			{
+				function_body_tasks.push_back(thread_pool.Submit([&GenerateFunctionBody, i]() { GenerateFunctionBody(i); }));
+			}
+			for (std::future<void>& function_body_task : function_body_tasks) function_body_task.get();
+		}
+
+		//String literals are added in function order so the module doesn't depend on how the bodies were scheduled
+		for (std::vector<GlobalVariable*> const& function_string_literals : body_string_literals)
+		{
+			for (GlobalVariable* string_literal : function_string_literals) AddStringLiteral(string_literal);
+		}
+		function_bodies.clear();
 	}
 
 	void IRVisitor::Visit(ASTNode const&, Uint32)
@@ -58,25 +96,14 @@ namespace ola
 		Function* ir_function = new Function(function_decl.GetMangledName(), function_type, linkage);
 		module.AddGlobal(ir_function);
 
-		Uint32 arg_index = 0;
-		Argument* param_arg = ir_function->GetArg(arg_index);
-		if (isa<ClassType>(type->GetReturnType()))
-		{
-			Value* sret_value = param_arg;
-			++param_arg;
-			return_value = sret_value;
-		}
+		Uint32 arg_index = isa<ClassType>(type->GetReturnType()) ? 1 : 0;
 		for (auto& param : function_decl.GetParamDecls())
 		{
-			Value* ir_param = param_arg;
-			ir_param->SetName(param->GetName());
-			value_map[param.get()] = ir_param;
-			param_arg = ir_function->GetArg(++arg_index);
+			ir_function->GetArg(arg_index++)->SetName(param->GetName());
 		}
+		value_map[&function_decl] = ir_function;
 
-		if (!function_decl.HasDefinition()) return;
-
-		VisitFunctionDeclCommon(function_decl, ir_function);
+		if (function_decl.HasDefinition()) function_bodies.emplace_back(&function_decl, ir_function);
 	}
 
 	void IRVisitor::Visit(MethodDecl const&, Uint32)
@@ -174,7 +201,7 @@ namespace ola
 				ClassType const* class_type = cast<ClassType>(var_type);
 				ClassDecl const* class_decl = class_type->GetClassDecl();
 
-				UniqueFieldDeclPtrList const& fields = class_decl->GetFields();
+				ASTSpan<FieldDecl> fields = class_decl->GetFields();
 				std::vector<Constant*> initializers;
 				if (class_decl->IsPolymorphic())
 				{
@@ -186,13 +213,13 @@ namespace ola
 				{
 					for (auto const& base_field : base_class_decl->GetFields())
 					{
-						initializers.push_back(cast<Constant>(value_map[base_field.get()]));
+						initializers.push_back(cast<Constant>(value_map[base_field]));
 					}
 					curr_class_decl = base_class_decl;
 				}
 				for (Uint64 i = 0; i < fields.size(); ++i)
 				{
-					initializers.push_back(cast<Constant>(value_map[fields[i].get()]));
+					initializers.push_back(cast<Constant>(value_map[fields[i]]));
 				}
 
 				IRStructType* llvm_struct_type = cast<IRStructType>(ir_type);
@@ -229,14 +256,14 @@ namespace ola
 					if (InitializerListExpr const* init_list_expr = dyn_cast<InitializerListExpr>(init_expr))
 					{
 						Value* alloc = builder->MakeInst<AllocaInst>(ir_type);
-						UniqueExprPtrList const& init_list = init_list_expr->GetInitList();
+						ASTSpan<Expr> init_list = init_list_expr->GetInitList();
 
 						for (Uint64 i = 0; i < init_list.size(); ++i)
 						{
 							ConstantInt* index = context.GetInt64(i);
 							Value* indices[] = { zero, index };
 							Value* ptr = builder->MakeInst<GetElementPtrInst>(alloc, indices);
-							Store(value_map[init_list[i].get()], ptr);
+							Store(value_map[init_list[i]], ptr);
 						}
 						for (Uint64 i = init_list.size(); i < array_type->GetArraySize(); ++i)
 						{
@@ -345,7 +372,7 @@ namespace ola
 
 		if (class_decl.IsPolymorphic())
 		{
-			std::vector<MethodDecl const*> const& vtable = class_decl.GetVTable();
+			ASTSpan<MethodDecl const> vtable = class_decl.GetVTable();
 			IRArrayType* vtable_type = context.GetArrayType(GetPointerType(void_type), vtable.size()); 
 			std::vector<Constant*> vtable_function_ptrs;
 
@@ -609,7 +636,8 @@ namespace ola
 		cond_expr->Accept(*this);
 		Value* condition_value = value_map[cond_expr];
 		OLA_ASSERT(condition_value);
-		Value* condition = Load(int_type, condition_value);
+		Value* condition = Load(cond_expr->GetType(), condition_value);
+		if (condition->GetType() != int_type) condition = builder->MakeInst<CastInst>(Opcode::ZExt, int_type, condition);
 		SwitchInst* switch_inst = static_cast<SwitchInst*>(builder->MakeInst<SwitchInst>(condition, default_block));
 
 		switch_instructions.push_back(switch_inst);
@@ -635,6 +663,11 @@ namespace ola
 				builder->MakeInst<BranchInst>(context, dest_block);
 			}
 		}
+		if (!default_block->GetTerminator())
+		{
+			builder->SetCurrentBlock(default_block);
+			builder->MakeInst<BranchInst>(context, end_block);
+		}
 		builder->SetCurrentBlock(end_block);
 		empty_block_successors[end_block] = end_blocks.empty() ? exit_block : end_blocks.back();
 	}
@@ -924,7 +957,7 @@ namespace ola
 
 	void IRVisitor::Visit(DeclRefExpr const& decl_ref, Uint32)
 	{
-		Value* value = value_map[decl_ref.GetDecl()];
+		Value* value = GetDeclValue(decl_ref.GetDecl());
 		OLA_ASSERT(value);
 		value_map[&decl_ref] = value;
 	}
@@ -947,13 +980,11 @@ namespace ola
 
 		Constant* constant = context.GetString(string_constant.GetString());
 
-		static Uint32 counter = 0;
-		std::string name = "__StringLiteral"; name += std::to_string(counter++);
-
 		Linkage linkage = Linkage::Internal;
-		GlobalVariable* global_string = new GlobalVariable(name, ConvertToIRType(string_constant.GetType()), linkage, constant);
+		GlobalVariable* global_string = new GlobalVariable("", ConvertToIRType(string_constant.GetType()), linkage, constant);
 		global_string->SetReadOnly();
-		module.AddGlobal(global_string);
+		if (module_visitor) string_literals.push_back(global_string);
+		else AddStringLiteral(global_string);
 		value_map[&string_constant] = global_string;
 	}
 
@@ -1066,7 +1097,7 @@ namespace ola
 		for (auto const& arg_expr : call_expr.GetArgs())
 		{
 			arg_expr->Accept(*this);
-			Value* arg_value = value_map[arg_expr.get()];
+			Value* arg_value = value_map[arg_expr];
 			OLA_ASSERT(arg_value);
 			IRType* arg_type = called_function->GetArg(arg_index)->GetType();
 			if (arg_type->IsPointer()) args.push_back(arg_value);
@@ -1081,7 +1112,7 @@ namespace ola
 
 	void IRVisitor::Visit(InitializerListExpr const& initializer_list_expr, Uint32)
 	{
-		UniqueExprPtrList const& init_expr_list = initializer_list_expr.GetInitList();
+		ASTSpan<Expr> init_expr_list = initializer_list_expr.GetInitList();
 		for (auto const& element_expr : init_expr_list) element_expr->Accept(*this);
 		if (initializer_list_expr.IsConstexpr())
 		{
@@ -1093,7 +1124,7 @@ namespace ola
 			std::vector<Constant*> array_init_list(array_type->GetArraySize());
 			for (Uint64 i = 0; i < array_type->GetArraySize(); ++i)
 			{
-				if (i < init_expr_list.size())  array_init_list[i] = dyn_cast<Constant>(value_map[init_expr_list[i].get()]);
+				if (i < init_expr_list.size())  array_init_list[i] = dyn_cast<Constant>(value_map[init_expr_list[i]]);
 				else array_init_list[i] = context.GetNullValue(ir_element_type); 
 			}
 			Constant* constant_array = new ConstantArray(cast<IRArrayType>(ir_array_type), array_init_list);
@@ -1173,24 +1204,27 @@ namespace ola
 		if (func_decl.IsInline()) func->SetForceInline();
 		else if (func_decl.IsNoInline()) func->SetNoInline();
 		if (func_decl.IsNoOpt()) func->SetNoOptimizations();
+		if (func_decl.IsNoMangle()) func->SetNoMangle();
 
 		BasicBlock* entry_block = builder->AddBlock(func, "entry");
 		builder->SetCurrentBlock(entry_block);
 
+		Uint32 arg_index = 0;
+		if (isa<ClassType>(func_decl.GetFuncType()->GetReturnType())) return_value = func->GetArg(arg_index++);
 		for (auto& param : func_decl.GetParamDecls())
 		{
-			Value* arg_value = value_map[param.get()];
+			Value* arg_value = func->GetArg(arg_index++);
 			Value* arg_alloc = builder->MakeInst<AllocaInst>(arg_value->GetType());
 
 			builder->MakeInst<StoreInst>(arg_value, arg_alloc);
 			if (isa<RefType>(param->GetType()))
 			{
 				Value* arg_ref = builder->MakeInst<LoadInst>(arg_alloc, arg_value->GetType());
-				value_map[param.get()] = arg_ref;
+				value_map[param] = arg_ref;
 			}
 			else
 			{
-				value_map[param.get()] = arg_alloc;
+				value_map[param] = arg_alloc;
 			}
 		}
 		if (!func->GetReturnType()->IsVoid()) return_value = builder->MakeInst<AllocaInst>(func->GetReturnType());
@@ -1236,7 +1270,20 @@ namespace ola
 		label_blocks.clear();
 		exit_block = nullptr;
 		return_value = nullptr;
-		value_map[&func_decl] = func;
+	}
+
+	void IRVisitor::AddStringLiteral(GlobalVariable* string_literal)
+	{
+		std::string name = "__StringLiteral"; name += std::to_string(string_literal_count++);
+		string_literal->SetName(name);
+		module.AddGlobal(string_literal);
+	}
+
+	Value* IRVisitor::GetDeclValue(Decl const* decl) const
+	{
+		if (auto it = value_map.find(decl); it != value_map.end() && it->second) return it->second;
+		if (module_visitor) return module_visitor->GetDeclValue(decl);
+		return nullptr;
 	}
 
 	void IRVisitor::ConditionalBranch(Value* condition_value, BasicBlock* true_block, BasicBlock* false_block)
@@ -1334,12 +1381,13 @@ namespace ola
 
 	IRType* IRVisitor::ConvertClassDecl(ClassDecl const* class_decl)
 	{
-		using LLVMStructTypeMap = std::unordered_map<ClassDecl const*, IRStructType*>;
-		static LLVMStructTypeMap struct_type_map;
-
+		if (module_visitor)
+		{
+			if (auto it = module_visitor->struct_type_map.find(class_decl); it != module_visitor->struct_type_map.end()) return it->second;
+		}
 		if (struct_type_map.contains(class_decl)) return struct_type_map[class_decl];
 
-		UniqueFieldDeclPtrList const& fields = class_decl->GetFields();
+		ASTSpan<FieldDecl> fields = class_decl->GetFields();
 		std::vector<IRType*> llvm_member_types;
 		if (class_decl->IsPolymorphic())
 		{
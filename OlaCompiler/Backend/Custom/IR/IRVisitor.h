@@ -15,6 +15,7 @@ namespace ola
 	class IRIntType;
 	class IRFloatType;
 	class IRPtrType;
+	class IRStructType;
 	class IRFuncType;
 	class Function;
 	class Type;
@@ -35,12 +36,13 @@ namespace ola
 		using ValueMap = VoidPointerMap<Value*>;
 		using VTableMap = VoidPointerMap<GlobalVariable*>;
 		using EmptyBlockSuccessorMap = std::unordered_map<BasicBlock*, BasicBlock*>;
+		using StructTypeMap = std::unordered_map<ClassDecl const*, IRStructType*>;
 
 	public:
 
 		IRVisitor(IRContext& context, IRModule& module);
 		~IRVisitor();
-		void VisitAST(AST const* ast);
+		void VisitAST(AST const* ast, Uint32 thread_count = 1);
 
 		virtual void Visit(ASTNode const&, Uint32) override;
 		virtual void Visit(TranslationUnit const&, Uint32) override;
@@ -98,9 +100,14 @@ namespace ola
 		IRContext& context;
 		IRModule& module;
 		std::unique_ptr<IRBuilder> builder;
+		//Set for visitors that generate a single function body, the module level maps are only read while bodies are generated
+		IRVisitor const* module_visitor = nullptr;
+		std::vector<std::pair<FunctionDecl const*, Function*>> function_bodies;
+		std::vector<GlobalVariable*> string_literals;
 
 		ValueMap value_map;
 		VTableMap vtable_map;
+		StructTypeMap struct_type_map;
 
 		IRType* this_struct_type = nullptr;
 		Value* this_value = nullptr;
@@ -113,6 +120,7 @@ namespace ola
 		std::vector<BasicBlock*> end_blocks;
 		std::unordered_map<std::string, BasicBlock*> label_blocks;
 		EmptyBlockSuccessorMap empty_block_successors;
+		Uint32 string_literal_count = 0;
 
 		IRType* void_type = nullptr;
 		IRFloatType* float_type = nullptr;
@@ -121,7 +129,11 @@ namespace ola
 		IRIntType* char_type = nullptr;
 
 	private:
+		explicit IRVisitor(IRVisitor const* module_visitor);
+
 		void VisitFunctionDeclCommon(FunctionDecl const& decl, Function* func);
+		void AddStringLiteral(GlobalVariable* string_literal);
+		Value* GetDeclValue(Decl const* decl) const;
 		void ConditionalBranch(Value*, BasicBlock*, BasicBlock*);
 
 		IRType* ConvertToIRType(Type const*);
@@ -1,3 +1,4 @@
+#include "IRContext.h"
 #include "IRType.h"
 #include "Instruction.h"
 #include "BasicBlock.h"
@@ -78,7 +79,7 @@ namespace ola
 	};
 	static_assert((Uint32)Opcode::Count == std::size(OpcodeNames));
 
-	Use::Use(Value* val, Instruction* user) : value(val), user(user)
+	Use::Use(Value* val, Instruction* user) : value(val), user(user), next(nullptr), prev(nullptr)
 	{
 		if (TrackableValue* trackable_value = dyn_cast<TrackableValue>(value))
 		{
@@ -112,30 +113,151 @@ namespace ola
 		ReplaceAllUsesWith(nullptr);
 	}
 
+	void TrackableValue::AddUse(Use* u)
+	{
+		std::unique_lock<std::mutex> lock;
+		if (Constant* constant = dyn_cast<Constant>(this)) lock = std::unique_lock(constant->GetUsersMutex());
+		u->next = use_list;
+		if (use_list) use_list->prev = &u->next;
+		u->prev = &use_list;
+		use_list = u;
+	}
+
+	void TrackableValue::RemoveUse(Use* u)
+	{
+		std::unique_lock<std::mutex> lock;
+		if (Constant* constant = dyn_cast<Constant>(this)) lock = std::unique_lock(constant->GetUsersMutex());
+		*u->prev = u->next;
+		if (u->next) u->next->prev = u->prev;
+		u->next = nullptr;
+		u->prev = nullptr;
+	}
+
 	Bool TrackableValue::ReplaceAllUsesWith(Value* V)
 	{
-		Bool changed = !users.empty();
-		std::vector<Use*> UsersVector(users.begin(), users.end());
-		for (Use* U : UsersVector)
+		if (V == this) return false;
+		Bool changed = use_list != nullptr;
+		while (use_list)
 		{
-			U->Set(V);
+			use_list->Set(V);
 		}
 		return changed;
 	}
 
+	Bool TrackableValue::HasNUses(Uint32 N) const
+	{
+		Use const* U = use_list;
+		for (; U && N > 0; U = U->GetNext()) --N;
+		return !U && N == 0;
+	}
+
+	Bool TrackableValue::HasNUsesOrMore(Uint32 N) const
+	{
+		for (Use const* U = use_list; U && N > 0; U = U->GetNext()) --N;
+		return N == 0;
+	}
 
-	Instruction::Instruction(Opcode opcode, IRType* type, std::vector<Value*> const& ops /*= {}*/) : TrackableValue(ValueKind::Instruction, type),
-		opcode(opcode), basic_block(nullptr)
+	Instruction::Instruction(Opcode opcode, IRType* type) : TrackableValue(ValueKind::Instruction, type),
+		opcode(opcode), num_operands(0), reserved_operands(0), hung_off_operands(true), operands(nullptr), basic_block(nullptr)
 	{
-		operands.reserve(8);
-		for (Value* op : ops)
+	}
+
+	Instruction::Instruction(Opcode opcode, IRType* type, Uint32 op_count, std::initializer_list<Value*> ops) : TrackableValue(ValueKind::Instruction, type),
+		opcode(opcode), num_operands((Uint32)ops.size()), reserved_operands(op_count), hung_off_operands(false), 
+		operands(reinterpret_cast<Use*>(this) - op_count), basic_block(nullptr)
+	{
+		OLA_ASSERT(ops.size() <= op_count);
+		Uint32 i = 0;
+		for (Value* op : ops) new (operands + i++) Use(op, this);
+		for (; i < op_count; ++i) new (operands + i) Use(nullptr, this);
+	}
+
+	Instruction::~Instruction()
+	{
+		if (hung_off_operands)
 		{
-			operands.emplace_back(op, this);
+			for (Uint32 i = 0; i < num_operands; ++i) operands[i].~Use();
+			if (reserved_operands > 0) GetContext().GetAllocator().Deallocate(operands, reserved_operands * sizeof(Use));
+		}
+		else
+		{
+			for (Uint32 i = 0; i < reserved_operands; ++i) operands[i].~Use();
 		}
 	}
 
-	Instruction::~Instruction()
+	void* Instruction::Allocate(IRContext& C, Uint64 size, Uint32 op_count)
+	{
+		Char* storage = static_cast<Char*>(C.GetAllocator().Allocate(size + op_count * sizeof(Use)));
+		return storage + op_count * sizeof(Use);
+	}
+
+	void Instruction::operator delete(Instruction* I, std::destroying_delete_t)
+	{
+		IRAllocator& allocator = I->GetContext().GetAllocator();
+		Uint32 const fixed_operands = I->hung_off_operands ? 0 : I->reserved_operands;
+		void* storage = reinterpret_cast<Use*>(I) - fixed_operands;
+		Uint64 const size = I->GetObjectSize() + fixed_operands * sizeof(Use);
+		I->~Instruction();
+		allocator.Deallocate(storage, size);
+	}
+
+	//Size the instruction was allocated with, every instruction class is final and is identified by its opcode
+	Uint64 Instruction::GetObjectSize() const
+	{
+		if (isa<BinaryInst>(this))			return sizeof(BinaryInst);
+		if (isa<UnaryInst>(this))			return sizeof(UnaryInst);
+		if (isa<CompareInst>(this))			return sizeof(CompareInst);
+		if (isa<CastInst>(this))			return sizeof(CastInst);
+		if (isa<LoadInst>(this))			return sizeof(LoadInst);
+		if (isa<StoreInst>(this))			return sizeof(StoreInst);
+		if (isa<BranchInst>(this))			return sizeof(BranchInst);
+		if (isa<ReturnInst>(this))			return sizeof(ReturnInst);
+		if (isa<SwitchInst>(this))			return sizeof(SwitchInst);
+		if (isa<CallInst>(this))			return sizeof(CallInst);
+		if (isa<SelectInst>(this))			return sizeof(SelectInst);
+		if (isa<AllocaInst>(this))			return sizeof(AllocaInst);
+		if (isa<GetElementPtrInst>(this))	return sizeof(GetElementPtrInst);
+		if (isa<PtrAddInst>(this))			return sizeof(PtrAddInst);
+		if (isa<PhiInst>(this))				return sizeof(PhiInst);
+		OLA_ASSERT_MSG(false, "Unknown instruction class!");
+		return sizeof(Instruction);
+	}
+
+	void Instruction::ReserveOperands(Uint32 op_count)
+	{
+		OLA_ASSERT(hung_off_operands);
+		if (op_count <= reserved_operands) return;
+
+		IRAllocator& allocator = GetContext().GetAllocator();
+		Use* new_operands = static_cast<Use*>(allocator.Allocate(op_count * sizeof(Use)));
+		for (Uint32 i = 0; i < num_operands; ++i)
+		{
+			new (new_operands + i) Use(operands[i].GetValue(), this);
+			operands[i].~Use();
+		}
+		if (reserved_operands > 0) allocator.Deallocate(operands, reserved_operands * sizeof(Use));
+		operands = new_operands;
+		reserved_operands = op_count;
+	}
+
+	void Instruction::AddOperand(Value* op)
+	{
+		if (!hung_off_operands)
+		{
+			OLA_ASSERT_MSG(num_operands < reserved_operands, "Instruction has no free operand slot!");
+			operands[num_operands++].Set(op);
+			return;
+		}
+		if (num_operands == reserved_operands) ReserveOperands(reserved_operands ? 2 * reserved_operands : 4);
+		new (operands + num_operands++) Use(op, this);
+	}
+
+	void Instruction::RemoveLastOperand()
 	{
+		OLA_ASSERT(num_operands > 0);
+		Use& U = operands[--num_operands];
+		if (hung_off_operands) U.~Use();
+		else U.Set(nullptr);
 	}
 
 	Char const* Instruction::GetOpcodeName() const
@@ -200,26 +322,26 @@ namespace ola
 	}
 
 	LoadInst::LoadInst(Value* address)
-		: Instruction( Opcode::Load, cast<IRPtrType>(address->GetType())->GetPointeeType(), {address})
+		: FixedOperandInstruction(Opcode::Load, cast<IRPtrType>(address->GetType())->GetPointeeType(), { address })
 	{
 		OLA_ASSERT(isa<IRPtrType>(address->GetType()));
 	}
 	LoadInst::LoadInst(Value* address, IRType* type)
-		: Instruction(Opcode::Load, type, { address })
+		: FixedOperandInstruction(Opcode::Load, type, { address })
 	{
 		OLA_ASSERT(isa<IRPtrType>(address->GetType()));
 	}
 
-	StoreInst::StoreInst(Value* value, Value* address) : Instruction(Opcode::Store, IRVoidType::Get(value->GetContext()), { value, address })
+	StoreInst::StoreInst(Value* value, Value* address) : FixedOperandInstruction(Opcode::Store, IRVoidType::Get(value->GetContext()), { value, address })
 	{
 	}
 
 	BranchInst::BranchInst(IRContext& C, BasicBlock* target) 
-		: Instruction(Opcode::Branch, IRVoidType::Get(C), { target }), is_conditional(false)
+		: FixedOperandInstruction(Opcode::Branch, IRVoidType::Get(C), { target }), is_conditional(false)
 	{
 	}
 	BranchInst::BranchInst(Value* condition, BasicBlock* true_target, BasicBlock* false_target) 
-		: Instruction(Opcode::Branch, IRVoidType::Get(condition->GetContext()), { true_target, false_target, condition }), is_conditional(true)
+		: FixedOperandInstruction(Opcode::Branch, IRVoidType::Get(condition->GetContext()), { true_target, false_target, condition }), is_conditional(true)
 	{
 	}
 
@@ -240,16 +362,18 @@ namespace ola
 		SetOperand(1, bb);
 	}
 
-	ReturnInst::ReturnInst(IRContext& C) : Instruction(Opcode::Ret, IRVoidType::Get(C), {})
+	ReturnInst::ReturnInst(IRContext& C) : FixedOperandInstruction(Opcode::Ret, IRVoidType::Get(C))
 	{
 	}
-	ReturnInst::ReturnInst(Value* ret_value) : Instruction(Opcode::Ret, IRVoidType::Get(ret_value->GetContext()), { ret_value })
+	ReturnInst::ReturnInst(Value* ret_value) : FixedOperandInstruction(Opcode::Ret, IRVoidType::Get(ret_value->GetContext()), { ret_value })
 	{
 	}
 
 	SwitchInst::SwitchInst(Value* val, BasicBlock* default_block) 
-		: Instruction{ Opcode::Switch, IRVoidType::Get(val->GetContext()), { val, default_block } }
+		: Instruction(Opcode::Switch, IRVoidType::Get(val->GetContext()))
 	{
+		AddOperand(val);
+		AddOperand(default_block);
 	}
 	void SwitchInst::AddCase(Int64 key, BasicBlock* label)
 	{
@@ -267,8 +391,9 @@ namespace ola
 		return case_values[case_idx].GetCaseBlock();
 	}
 
-	CallInst::CallInst(Value* callee, std::span<Value*> args) : Instruction(Opcode::Call, cast<Function>(callee)->GetReturnType(), {})
+	CallInst::CallInst(Value* callee, std::span<Value*> args) : Instruction(Opcode::Call, cast<Function>(callee)->GetReturnType())
 	{
+		ReserveOperands((Uint32)args.size() + 1);
 		for (Value* arg : args) AddOperand(arg);
 		AddOperand(callee);
 	}
@@ -283,7 +408,7 @@ namespace ola
 		return GetBasicBlock()->GetFunction();
 	}
 
-	AllocaInst::AllocaInst(IRType* type) : Instruction(Opcode::Alloca, IRPtrType::Get(type), {}), allocated_type(type)
+	AllocaInst::AllocaInst(IRType* type) : FixedOperandInstruction(Opcode::Alloca, IRPtrType::Get(type)), allocated_type(type)
 	{
 	}
 	IRPtrType* AllocaInst::GetPtrType() const
@@ -314,24 +439,25 @@ namespace ola
 		return current_type;
 	}
 	GetElementPtrInst::GetElementPtrInst(Value* base, std::span<Value*> indices)
-		: Instruction{ Opcode::GetElementPtr, base->GetType(), {} },
+		: Instruction(Opcode::GetElementPtr, base->GetType()),
 		result_element_type(GetValueType(base, indices))
 	{
 		OLA_ASSERT(base->GetType()->IsPointer());
 		source_element_type = cast<IRPtrType>(base->GetType())->GetPointeeType(); 
 
+		ReserveOperands((Uint32)indices.size() + 1);
 		AddOperand(base);
 		for (Value* index : indices) AddOperand(index);
 	}
 
-	CompareInst::CompareInst(Opcode id, Value* lhs, Value* rhs) : Instruction(id, IRIntType::Get(lhs->GetContext(), 1), {lhs, rhs})
+	CompareInst::CompareInst(Opcode id, Value* lhs, Value* rhs) : FixedOperandInstruction(id, IRIntType::Get(lhs->GetContext(), 1), {lhs, rhs})
 	{
 		Uint32 id_int = (Uint32)id;
 		OLA_ASSERT(id_int >= (Uint32)Opcode::CompareOpBegin && id_int <= (Uint32)Opcode::CompareOpEnd);
 		cmp = (CompareOp)(id_int - (Uint32)Opcode::CompareOpBegin);
 	}
 
-	PtrAddInst::PtrAddInst(Value* base, Value* offset, IRType* result_element_type) : Instruction(Opcode::PtrAdd, base->GetType(), { base, offset }),
+	PtrAddInst::PtrAddInst(Value* base, Value* offset, IRType* result_element_type) : FixedOperandInstruction(Opcode::PtrAdd, base->GetType(), { base, offset }),
 		result_element_type(result_element_type)
 	{
 		OLA_ASSERT(base->GetType()->IsPointer());
@@ -350,7 +476,7 @@ namespace ola
 
 	Instruction* PhiInst::Clone() const
 	{
-		PhiInst* NewPhi = new PhiInst(GetType());
+		PhiInst* NewPhi = new (GetContext()) PhiInst(GetType());
 		for (Uint i = 0; i < GetNumOperands() / 2; ++i)
 		{
 			NewPhi->AddIncoming(GetOperand(GetValueOpIndex(i)), cast<BasicBlock>(GetOperand(GetBlockOpIndex(i))));
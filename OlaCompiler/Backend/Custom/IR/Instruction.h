@@ -1,6 +1,9 @@
 #pragma once
+#include <new>
 #include <vector>
 #include <span>
+#include <iterator>
+#include <initializer_list>
 #include <unordered_map>
 #include <unordered_set>
 #include "Value.h"
@@ -161,11 +164,13 @@ namespace ola
 		}
 	}
 
+	//A use of a value by an instruction operand. Uses are linked into an intrusive list of their value so users can be walked without lookups
 	class Use
 	{
+		friend class TrackableValue;
 	public:
-		Use() : value(nullptr), user(nullptr) {}
 		Use(Value* val, Instruction* user);
+		OLA_NONCOPYABLE(Use)
 		~Use();
 
 		Value* operator=(Value* rhs)
@@ -174,9 +179,9 @@ namespace ola
 			return rhs;
 		}
 
-		void SetValue(Value* V) { value = V; }
 		Value* GetValue() const { return value; }
 		Instruction* GetUser() const { return user; }
+		Use* GetNext() const { return next; }
 
 		operator Value* () const { return value; }
 		Value* Get() const { return value; }
@@ -188,42 +193,69 @@ namespace ola
 	private:
 		Value* value;
 		Instruction* user;
+		Use* next;
+		Use** prev;
 	};
 
-	class TrackableValue : public Value
+	template<typename UseT>
+	class UseIterator
 	{
-		using UserSet = std::unordered_set<Use*>;
 	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = UseT*;
+		using difference_type = std::ptrdiff_t;
+		using pointer = UseT**;
+		using reference = UseT*;
 
-		~TrackableValue();
+		UseIterator() : use(nullptr) {}
+		explicit UseIterator(UseT* use) : use(use) {}
 
-		void AddUse(Use* u)
+		UseT* operator*() const { return use; }
+		UseIterator& operator++()
 		{
-			users.insert(u);
+			use = use->GetNext();
+			return *this;
 		}
-		void RemoveUse(Use* u)
+		UseIterator operator++(int)
 		{
-			users.erase(u);
+			UseIterator tmp = *this;
+			++(*this);
+			return tmp;
 		}
+		Bool operator==(UseIterator const& other) const { return use == other.use; }
+		Bool operator!=(UseIterator const& other) const { return use != other.use; }
+
+	private:
+		UseT* use;
+	};
+
+	class TrackableValue : public Value
+	{
+	public:
+
+		~TrackableValue();
+
+		void AddUse(Use* u);
+		void RemoveUse(Use* u);
 		OLA_MAYBE_UNUSED Bool ReplaceAllUsesWith(Value* V);
 
 		Bool IsUsed() const
 		{
-			return !users.empty();
+			return use_list != nullptr;
 		}
-		Bool HasOneUse() const { return users.size() == 1; }
-		Bool HasNUses(Uint32 N) const { return users.size() == N; }
-		Bool HasNUsesOrMore(Uint32 N) const { return users.size() >= N; }
+		Bool HasOneUse() const { return use_list && !use_list->GetNext(); }
+		Bool HasNUses(Uint32 N) const;
+		Bool HasNUsesOrMore(Uint32 N) const;
 
-		using UserIterator = UserSet::iterator;
-		using ConstUserIterator = UserSet::const_iterator;
+		using UserIterator = UseIterator<Use>;
+		using ConstUserIterator = UseIterator<Use const>;
 		using UserRange = IteratorRange<UserIterator>;
 		using ConstUserRange = IteratorRange<ConstUserIterator>;
 
-		UserIterator	  UserBegin() { return users.begin(); }
-		ConstUserIterator UserBegin() const { return users.begin(); }
-		UserIterator      UserEnd() { return users.end(); }
-		ConstUserIterator UserEnd() const { return users.end(); }
+		UserIterator	  UserBegin() { return UserIterator(use_list); }
+		ConstUserIterator UserBegin() const { return ConstUserIterator(use_list); }
+		UserIterator      UserEnd() { return UserIterator(); }
+		ConstUserIterator UserEnd() const { return ConstUserIterator(); }
 		UserRange		  Users() { return UserRange(UserBegin(), UserEnd()); }
 		ConstUserRange	  Users() const { return ConstUserRange(UserBegin(), UserEnd()); }
 
@@ -232,7 +264,7 @@ namespace ola
 			return V->GetKind() == ValueKind::Instruction || V->GetKind() == ValueKind::Constant || V->GetKind() == ValueKind::BasicBlock;
 		}
 	private:
-		UserSet users;
+		Use* use_list = nullptr;
 
 	protected:
 		TrackableValue(ValueKind kind, IRType* type) : Value(kind, type) {}
@@ -241,9 +273,14 @@ namespace ola
 	class Instruction : public TrackableValue, public IListNode<Instruction>
 	{
 	public:
-		Instruction() : TrackableValue(ValueKind::Instruction, nullptr), opcode(Opcode::None), basic_block(nullptr) {}
+		Instruction() : TrackableValue(ValueKind::Instruction, nullptr), opcode(Opcode::None), num_operands(0), reserved_operands(0), 
+			hung_off_operands(true), operands(nullptr), basic_block(nullptr) {}
 		~Instruction();
 
+		void* operator new(Uint64) = delete;
+		void* operator new(Uint64 size, IRContext& C) { return Allocate(C, size, 0); }
+		void operator delete(Instruction* I, std::destroying_delete_t);
+
 		Opcode GetOpcode() const
 		{
 			return opcode;
@@ -306,15 +343,15 @@ namespace ola
 
 		Use const* GetOperandList() const
 		{
-			return operands.data();
+			return operands;
 		}
 		Use* GetOperandList()
 		{
-			return operands.data();
+			return operands;
 		}
 		Uint32 GetNumOperands() const
 		{
-			return (Uint32)operands.size();
+			return num_operands;
 		}
 		Value* GetOperand(Uint32 i) const
 		{
@@ -334,7 +371,7 @@ namespace ola
 		}
 		void ClearOperands()
 		{
-			operands.clear();
+			while (num_operands > 0) RemoveLastOperand();
 		}
 		void SwapOperands(Uint32 i, Uint32 j);
 
@@ -358,20 +395,27 @@ namespace ola
 
 	private:
 		Opcode opcode;
-		std::vector<Use> operands;
+		Uint32 num_operands;
+		Uint32 reserved_operands;
+		Bool hung_off_operands;
+		Use* operands;
 		BasicBlock* basic_block;
 
+	private:
+		Uint64 GetObjectSize() const;
+
 	protected:
-		Instruction(Opcode opcode, IRType* type, std::vector<Value*> const& ops = {});
+		//Instructions with a variable number of operands keep them in a separately allocated array that grows as operands are added
+		Instruction(Opcode opcode, IRType* type);
+		//Instructions with a fixed number of operands keep op_count uses in front of the object, see FixedOperandInstruction
+		Instruction(Opcode opcode, IRType* type, Uint32 op_count, std::initializer_list<Value*> ops);
 
-		void AddOperand(Value* op)
-		{
-			operands.emplace_back(op, this);
-		}
-		void RemoveLastOperand()
-		{
-			operands.pop_back();
-		}
+		//Instructions are allocated from the slabs of their context, op_count uses are placed in front of the object
+		static void* Allocate(IRContext& C, Uint64 size, Uint32 op_count);
+
+		void ReserveOperands(Uint32 op_count);
+		void AddOperand(Value* op);
+		void RemoveLastOperand();
 
 		template <Uint32 Idx>
 		Use& Op()
@@ -385,10 +429,28 @@ namespace ola
 		}
 	};
 
-	class BinaryInst final : public Instruction
+	//The sentinel of an instruction list has no type and so no context to allocate it from
+	template<>
+	struct IListTraits<Instruction> : public IListDefaultTraits<Instruction>
+	{
+		static Instruction* CreateSentinel() { return ::new Instruction(); }
+		static void DestroySentinel(Instruction* I) { ::delete I; }
+	};
+
+	template<Uint32 OperandCount>
+	class FixedOperandInstruction : public Instruction
+	{
+	public:
+		void* operator new(Uint64 size, IRContext& C) { return Allocate(C, size, OperandCount); }
+
+	protected:
+		FixedOperandInstruction(Opcode opcode, IRType* type, std::initializer_list<Value*> ops = {}) : Instruction(opcode, type, OperandCount, ops) {}
+	};
+
+	class BinaryInst final : public FixedOperandInstruction<2>
 	{
 	public:
-		BinaryInst(Opcode opcode, Value* lhs, Value* rhs) : Instruction{ opcode, lhs->GetType(), { lhs, rhs } }
+		BinaryInst(Opcode opcode, Value* lhs, Value* rhs) : FixedOperandInstruction{ opcode, lhs->GetType(), { lhs, rhs } }
 		{
 			OLA_ASSERT(lhs->GetType() == rhs->GetType());
 		}
@@ -404,7 +466,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new BinaryInst(GetOpcode(), GetLHS(), GetRHS());
+			return new (GetContext()) BinaryInst(GetOpcode(), GetLHS(), GetRHS());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -416,10 +478,10 @@ namespace ola
 		}
 	};
 
-	class UnaryInst final : public Instruction
+	class UnaryInst final : public FixedOperandInstruction<1>
 	{
 	public:
-		UnaryInst(Opcode opcode, Value* val) : Instruction(opcode, val->GetType(), { val }) {}
+		UnaryInst(Opcode opcode, Value* val) : FixedOperandInstruction(opcode, val->GetType(), { val }) {}
 
 		Value* GetOperand() const
 		{
@@ -428,7 +490,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new UnaryInst(GetOpcode(), GetOperand());
+			return new (GetContext()) UnaryInst(GetOpcode(), GetOperand());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -467,7 +529,7 @@ namespace ola
 		FCmpUGE
 	};
 
-	class CompareInst final : public Instruction
+	class CompareInst final : public FixedOperandInstruction<2>
 	{
 	public:
 		CompareInst(Opcode id, Value* lhs, Value* rhs);
@@ -485,7 +547,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new CompareInst(GetOpcode(), GetLHS(), GetRHS());
+			return new (GetContext()) CompareInst(GetOpcode(), GetLHS(), GetRHS());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -500,11 +562,11 @@ namespace ola
 		CompareOp cmp;
 	};
 
-	class CastInst final : public Instruction
+	class CastInst final : public FixedOperandInstruction<1>
 	{
 	public:
 		CastInst(Opcode opcode, IRType* cast_type, Value* src_value)
-			: Instruction(opcode, cast_type, { src_value }) {}
+			: FixedOperandInstruction(opcode, cast_type, { src_value }) {}
 
 		Value* GetSrc() const { return Op<0>(); }
 		IRType* GetSrcType() const { return Op<0>()->GetType(); }
@@ -512,7 +574,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new CastInst(GetOpcode(), GetDestType(), GetSrc());
+			return new (GetContext()) CastInst(GetOpcode(), GetDestType(), GetSrc());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -524,7 +586,7 @@ namespace ola
 		}
 	};
 
-	class LoadInst final : public Instruction
+	class LoadInst final : public FixedOperandInstruction<1>
 	{
 	public:
 		explicit LoadInst(Value* address);
@@ -534,7 +596,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new LoadInst(GetAddressOp(), GetType());
+			return new (GetContext()) LoadInst(GetAddressOp(), GetType());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -546,7 +608,7 @@ namespace ola
 		}
 	};
 
-	class StoreInst final : public Instruction
+	class StoreInst final : public FixedOperandInstruction<2>
 	{
 	public:
 		StoreInst(Value* value, Value* address);
@@ -556,7 +618,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new StoreInst(GetValueOp(), GetAddressOp());
+			return new (GetContext()) StoreInst(GetValueOp(), GetAddressOp());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -568,7 +630,7 @@ namespace ola
 		}
 	};
 
-	class BranchInst final : public Instruction
+	class BranchInst final : public FixedOperandInstruction<3>
 	{
 	public:
 		BranchInst(IRContext& C, BasicBlock* target);
@@ -585,7 +647,7 @@ namespace ola
 
 		Value* GetCondition() const
 		{
-			return IsConditional() ? Op<2>() : nullptr;
+			return IsConditional() ? static_cast<Value*>(Op<2>()) : nullptr;
 		}
 		void SetCondition(Value* C)
 		{
@@ -596,8 +658,8 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return IsConditional() ? new BranchInst(GetCondition(), GetTrueTarget(), GetFalseTarget())
-								   : new BranchInst(GetContext(), GetTrueTarget());
+			return IsConditional() ? new (GetContext()) BranchInst(GetCondition(), GetTrueTarget(), GetFalseTarget())
+								   : new (GetContext()) BranchInst(GetContext(), GetTrueTarget());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -612,7 +674,7 @@ namespace ola
 		Bool is_conditional;
 	};
 
-	class ReturnInst final : public Instruction
+	class ReturnInst final : public FixedOperandInstruction<1>
 	{
 	public:
 		explicit ReturnInst(IRContext& C);
@@ -626,8 +688,8 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return IsVoid() ? new ReturnInst(GetContext())
-				: new ReturnInst(GetReturnValue());
+			return IsVoid() ? new (GetContext()) ReturnInst(GetContext())
+				: new (GetContext()) ReturnInst(GetReturnValue());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -759,7 +821,7 @@ namespace ola
 				Args.push_back(GetOperand(i));
 			}
 			Value* Callee = GetOperand(OpCount - 1);
-			return new CallInst(Callee, Args);
+			return new (GetContext()) CallInst(Callee, Args);
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -771,10 +833,10 @@ namespace ola
 		}
 	};
 
-	class SelectInst final : public Instruction
+	class SelectInst final : public FixedOperandInstruction<3>
 	{
 	public:
-		SelectInst(Value* predicate, Value* lhs, Value* rhs) : Instruction(Opcode::Select, lhs->GetType(), { predicate, lhs, rhs })
+		SelectInst(Value* predicate, Value* lhs, Value* rhs) : FixedOperandInstruction(Opcode::Select, lhs->GetType(), { predicate, lhs, rhs })
 		{
 			OLA_ASSERT(lhs->GetType() == rhs->GetType());
 		}
@@ -788,7 +850,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new SelectInst(GetPredicate(), GetTrueValue(), GetFalseValue());
+			return new (GetContext()) SelectInst(GetPredicate(), GetTrueValue(), GetFalseValue());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -800,7 +862,7 @@ namespace ola
 		}
 	};
 
-	class AllocaInst final : public Instruction
+	class AllocaInst final : public FixedOperandInstruction<0>
 	{
 	public:
 		explicit AllocaInst(IRType* type);
@@ -810,7 +872,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new AllocaInst(GetAllocatedType());
+			return new (GetContext()) AllocaInst(GetAllocatedType());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -860,7 +922,7 @@ namespace ola
 			{
 				indices.push_back(GetIndex(i));
 			}
-			return new GetElementPtrInst(base, indices);
+			return new (GetContext()) GetElementPtrInst(base, indices);
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -876,7 +938,7 @@ namespace ola
 		IRType* result_element_type;
 	};
 
-	class PtrAddInst final : public Instruction
+	class PtrAddInst final : public FixedOperandInstruction<2>
 	{
 	public:
 		explicit PtrAddInst(Value* base, Value* offset, IRType* result_element_type);
@@ -887,7 +949,7 @@ namespace ola
 
 		OLA_NODISCARD Instruction* Clone() const
 		{
-			return new PtrAddInst(GetBase(), GetOffset(), GetResultElementType());
+			return new (GetContext()) PtrAddInst(GetBase(), GetOffset(), GetResultElementType());
 		}
 		static Bool ClassOf(Instruction const* I)
 		{
@@ -905,7 +967,7 @@ namespace ola
 	class PhiInst final : public Instruction
 	{
 	public:
-		explicit PhiInst(IRType* type) : Instruction(Opcode::Phi, type, {}), alloca_inst(nullptr) {}
+		explicit PhiInst(IRType* type) : Instruction(Opcode::Phi, type), alloca_inst(nullptr) {}
 
 		void SetAlloca(AllocaInst* AI)
 		{
@@ -4,6 +4,7 @@
 #include <memory>
 #include "PassRegistry.h"
 #include "Pass.h"
+#include "Utility/TimeReport.h"
 
 namespace ola
 {
@@ -38,6 +39,7 @@ namespace ola
 			Bool changed = false;
 			for (auto& pass : passes)
 			{
+				OLA_TIME_REPORT_FINE_SCOPE(pass->GetPassName());
 				changed |= pass->RunOn(U, AM);
 			}
 			return changed;
@@ -51,6 +53,7 @@ namespace ola
 			}
 			for (auto& pass : passes)
 			{
+				OLA_TIME_REPORT_FINE_SCOPE(pass->GetPassName());
 				changed |= pass->RunOn(U, AM);
 			}
 			for (auto& pass : passes)
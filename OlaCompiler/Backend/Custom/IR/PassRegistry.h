@@ -37,13 +37,15 @@ namespace ola
 			id_info_map[info.GetID()] = &info;
 		}
 
-		PassInfo const* GetInfo(std::string_view name)
+		PassInfo const* GetInfo(std::string_view name) const
 		{
-			return name_info_map[name];
+			auto it = name_info_map.find(name);
+			return it != name_info_map.end() ? it->second : nullptr;
 		}
-		PassInfo const* GetInfo(void const* id)
+		PassInfo const* GetInfo(void const* id) const
 		{
-			return id_info_map[id];
+			auto it = id_info_map.find(id);
+			return it != id_info_map.end() ? it->second : nullptr;
 		}
 
 	private:
@@ -118,7 +118,7 @@ namespace ola
 				if (CI)
 				{
 					IRContext& ctx = CI->GetContext();
-					return CI->GetValue() != 0 ? new BranchInst(ctx, BI->GetTrueTarget()) : new BranchInst(ctx, BI->GetFalseTarget());
+					return CI->GetValue() != 0 ? new (ctx) BranchInst(ctx, BI->GetTrueTarget()) : new (ctx) BranchInst(ctx, BI->GetFalseTarget());
 				}
 			}
 			return nullptr;
@@ -1,52 +1,43 @@
-#include <list>
 #include "GlobalAttributeInferPass.h"
 #include "Backend/Custom/IR/IRModule.h"
 #include "Backend/Custom/IR/GlobalValue.h"
 
 namespace ola
 {
-	Bool GlobalAttributeInferPass::RunOn(IRModule& Module, IRModuleAnalysisManager& MAM)
+	namespace
 	{
-		std::list<GlobalVariable*> Worklist;
-		for (GlobalValue* G : Module.Globals())
+		//a global can only be read-only if it is loaded from and its address never escapes,
+		//otherwise it can be written through a reference or a pointer that is not visible here
+		Bool IsOnlyLoadedFrom(TrackableValue const* V)
 		{
-			if (GlobalVariable* GV = dyn_cast<GlobalVariable>(G))
+			for (Use const* U : V->Users())
 			{
-				if (!GV->IsReadOnly() && GV->GetLinkage() == Linkage::Internal) 
+				Instruction const* User = U->GetUser();
+				if (isa<LoadInst>(User)) continue;
+				if (GetElementPtrInst const* GEPI = dyn_cast<GetElementPtrInst>(User))
 				{
-					Worklist.push_back(GV);
+					if (GEPI->GetBaseOperand() == V && IsOnlyLoadedFrom(GEPI)) continue;
 				}
+				return false;
 			}
+			return true;
 		}
+	}
 
-		if (Worklist.empty())
-		{
-			return false;
-		}
-
+	Bool GlobalAttributeInferPass::RunOn(IRModule& Module, IRModuleAnalysisManager&)
+	{
+		Bool Changed = false;
 		for (GlobalValue* G : Module.Globals())
 		{
-			if (Function* F = dyn_cast<Function>(G))
+			if (GlobalVariable* GV = dyn_cast<GlobalVariable>(G))
 			{
-				for (BasicBlock& BB : *F)
+				if (!GV->IsReadOnly() && GV->GetLinkage() == Linkage::Internal && IsOnlyLoadedFrom(GV))
 				{
-					for (Instruction& I : BB)
-					{
-						if (StoreInst* SI = dyn_cast<StoreInst>(&I))
-						{
-							Value* AddressOperand = SI->GetAddressOp();
-							Worklist.remove_if([&](GlobalVariable* GV) { return GV == AddressOperand; });
-						}
-					}
+					GV->SetReadOnly();
+					Changed = true;
 				}
 			}
 		}
-
-		for (GlobalVariable* GV : Worklist)
-		{
-			GV->SetReadOnly();
-		}
-		return !Worklist.empty();
+		return Changed;
 	}
 }
-
@@ -126,7 +126,7 @@ namespace ola
 		{
 			for (BasicBlock* BB : Blocks)
 			{
-				PhiInst* Phi = new PhiInst(AI->GetAllocatedType());
+				PhiInst* Phi = new (AI->GetContext()) PhiInst(AI->GetAllocatedType());
 				BB->AddPhiInst(Phi);
 				Phi->SetAlloca(AI);
 			}
@@ -59,7 +59,7 @@ namespace ola
 		{
 			llvm::Value* llvm_param = param_arg;
 			llvm_param->setName(param->GetName());
-			value_map[param.get()] = llvm_param;
+			value_map[param] = llvm_param;
 			++param_arg;
 		}
 
@@ -97,7 +97,7 @@ namespace ola
 		{
 			llvm::Value* llvm_param = &*param_arg;
 			llvm_param->setName(param->GetName());
-			value_map[param.get()] = llvm_param;
+			value_map[param] = llvm_param;
 			++param_arg;
 		}
 
@@ -169,7 +169,7 @@ namespace ola
 				ClassType const* class_type = cast<ClassType>(var_type);
 				ClassDecl const* class_decl = class_type->GetClassDecl();
 
-				UniqueFieldDeclPtrList const& fields = class_decl->GetFields();
+				ASTSpan<FieldDecl> fields = class_decl->GetFields();
 				std::vector<llvm::Constant*> initializers;
 				if (class_decl->IsPolymorphic())
 				{
@@ -181,13 +181,13 @@ namespace ola
 				{
 					for (auto const& base_field : base_class_decl->GetFields())
 					{
-						initializers.push_back(cast<llvm::Constant>(value_map[base_field.get()]));
+						initializers.push_back(cast<llvm::Constant>(value_map[base_field]));
 					}
 					curr_class_decl = base_class_decl;
 				}
 				for (Uint64 i = 0; i < fields.size(); ++i)
 				{
-					initializers.push_back(cast<llvm::Constant>(value_map[fields[i].get()]));
+					initializers.push_back(cast<llvm::Constant>(value_map[fields[i]]));
 				}
 
 				llvm::GlobalValue::LinkageTypes linkage = var_decl.IsPublic() || var_decl.IsExtern() ? llvm::GlobalValue::ExternalLinkage : llvm::GlobalValue::InternalLinkage;
@@ -220,13 +220,13 @@ namespace ola
 					if (InitializerListExpr const* init_list_expr = dyn_cast<InitializerListExpr>(init_expr))
 					{
 						llvm::AllocaInst* alloc = builder.CreateAlloca(llvm_type, nullptr);
-						UniqueExprPtrList const& init_list = init_list_expr->GetInitList();
+						ASTSpan<Expr> init_list = init_list_expr->GetInitList();
 
 						for (Uint64 i = 0; i < init_list.size(); ++i)
 						{
 							llvm::ConstantInt* index = builder.getInt64(i); 
 							llvm::Value* ptr = builder.CreateGEP(llvm_type, alloc, { zero, index });
-							Store(value_map[init_list[i].get()], ptr);
+							Store(value_map[init_list[i]], ptr);
 						}
 						for (Uint64 i = init_list.size(); i < array_type->GetArraySize(); ++i)
 						{
@@ -336,19 +336,19 @@ namespace ola
 					ClassDecl const* curr_class_decl = class_decl;
 					while (ClassDecl const* base_class_decl = curr_class_decl->GetBaseClass())
 					{
-						UniqueFieldDeclPtrList const& base_fields = base_class_decl->GetFields();
+						ASTSpan<FieldDecl> base_fields = base_class_decl->GetFields();
 						for (auto const& base_field : base_fields)
 						{
 							llvm::Value* field_ptr = builder.CreateStructGEP(llvm_type, struct_alloc, is_polymorphic + base_field->GetFieldIndex());
-							Store(value_map[base_field.get()], field_ptr);
+							Store(value_map[base_field], field_ptr);
 						}
 						curr_class_decl = base_class_decl;
 					}
-					UniqueFieldDeclPtrList const& fields = class_decl->GetFields();
+					ASTSpan<FieldDecl> fields = class_decl->GetFields();
 					for (auto const& field : fields)
 					{
 						llvm::Value* field_ptr = builder.CreateStructGEP(llvm_type, struct_alloc, is_polymorphic + field->GetFieldIndex());
-						Store(value_map[field.get()], field_ptr);
+						Store(value_map[field], field_ptr);
 					}
 
 					if (init_expr && isa<ConstructorExpr>(init_expr))
@@ -365,7 +365,7 @@ namespace ola
 						for (auto const& arg_expr : ctor_expr->GetArgs())
 						{
 							arg_expr->Accept(*this);
-							llvm::Value* arg_value = value_map[arg_expr.get()];
+							llvm::Value* arg_value = value_map[arg_expr];
 							OLA_ASSERT(arg_value);
 							args.push_back(Load(called_ctor->getArg(arg_index++)->getType(), arg_value));
 						}
@@ -430,7 +430,7 @@ namespace ola
 
 		if (class_decl.IsPolymorphic())
 		{
-			std::vector<MethodDecl const*> const& vtable = class_decl.GetVTable();
+			ASTSpan<MethodDecl const> vtable = class_decl.GetVTable();
 			llvm::ArrayType* vtable_type = llvm::ArrayType::get(GetPointerType(void_type), vtable.size());
 			std::vector<llvm::Constant*> vtable_function_ptrs;
 
@@ -1002,8 +1002,7 @@ namespace ola
 	{
 		llvm::Constant* constant = llvm::ConstantDataArray::getString(context, string_constant.GetString());
 		
-		static Uint32 counter = 0;
-		std::string name = "__StringLiteral"; name += std::to_string(counter++);
+		std::string name = "__StringLiteral"; name += std::to_string(string_literal_count++);
 
 		llvm::GlobalValue::LinkageTypes linkage = llvm::Function::InternalLinkage;
 		llvm::GlobalVariable* global_string = new llvm::GlobalVariable(module, ConvertToIRType(string_constant.GetType()), true, linkage, constant, name);
@@ -1119,7 +1118,7 @@ namespace ola
 		for (auto const& arg_expr : call_expr.GetArgs())
 		{
 			arg_expr->Accept(*this);
-			llvm::Value* arg_value = value_map[arg_expr.get()];
+			llvm::Value* arg_value = value_map[arg_expr];
 			OLA_ASSERT(arg_value);
 			llvm::Type* arg_type = called_function->getArg(arg_index)->getType();
 			if (arg_type->isPointerTy()) args.push_back(arg_value);
@@ -1134,7 +1133,7 @@ namespace ola
 
 	void LLVMIRVisitor::Visit(InitializerListExpr const& initializer_list_expr, Uint32)
 	{
-		UniqueExprPtrList const& init_expr_list = initializer_list_expr.GetInitList();
+		ASTSpan<Expr> init_expr_list = initializer_list_expr.GetInitList();
 		for (auto const& element_expr : init_expr_list) element_expr->Accept(*this);
 		if (initializer_list_expr.IsConstexpr())
 		{
@@ -1145,7 +1144,7 @@ namespace ola
 			std::vector<llvm::Constant*> array_init_list(array_type->GetArraySize());
 			for (Uint64 i = 0; i < array_type->GetArraySize(); ++i)
 			{
-				if (i < init_expr_list.size())  array_init_list[i] = llvm::dyn_cast<llvm::Constant>(value_map[init_expr_list[i].get()]);
+				if (i < init_expr_list.size())  array_init_list[i] = llvm::dyn_cast<llvm::Constant>(value_map[init_expr_list[i]]);
 				else array_init_list[i] = llvm::Constant::getNullValue(llvm_element_type);
 			}
 			llvm::Constant* constant_array = llvm::ConstantArray::get(llvm::dyn_cast<llvm::ArrayType>(llvm_array_type), array_init_list);
@@ -1261,7 +1260,7 @@ namespace ola
 			for (auto const& arg_expr : member_call_expr.GetArgs())
 			{
 				arg_expr->Accept(*this);
-				llvm::Value* arg_value = value_map[arg_expr.get()];
+				llvm::Value* arg_value = value_map[arg_expr];
 				OLA_ASSERT(arg_value);
 				args.push_back(Load(function_type->getParamType(arg_index++), arg_value));
 			}
@@ -1293,7 +1292,7 @@ namespace ola
 			for (auto const& arg_expr : member_call_expr.GetArgs())
 			{
 				arg_expr->Accept(*this);
-				llvm::Value* arg_value = value_map[arg_expr.get()];
+				llvm::Value* arg_value = value_map[arg_expr];
 				OLA_ASSERT(arg_value);
 				args.push_back(Load(called_function->getArg(arg_index++)->getType(), arg_value));
 			}
@@ -1324,17 +1323,17 @@ namespace ola
 
 		for (auto& param : func_decl.GetParamDecls())
 		{
-			llvm::Value* arg_value = value_map[param.get()];
+			llvm::Value* arg_value = value_map[param];
 			llvm::AllocaInst* arg_alloc = builder.CreateAlloca(arg_value->getType(), nullptr);
 			builder.CreateStore(arg_value, arg_alloc);
 			if (isa<RefType>(param->GetType()))
 			{
 				llvm::Value* arg_ref = builder.CreateLoad(arg_value->getType(), arg_alloc);
-				value_map[param.get()] = arg_ref;
+				value_map[param] = arg_ref;
 			}
 			else
 			{
-				value_map[param.get()] = arg_alloc;
+				value_map[param] = arg_alloc;
 			}
 		}
 
@@ -1475,14 +1474,11 @@ namespace ola
 
 	llvm::Type* LLVMIRVisitor::ConvertClassDecl(ClassDecl const* class_decl)
 	{
-		using LLVMStructTypeMap = std::unordered_map<ClassDecl const*, llvm::StructType*>;
-		static LLVMStructTypeMap struct_type_map;
-
 		if (struct_type_map.contains(class_decl)) return struct_type_map[class_decl];
 
 		llvm::StructType* llvm_class_type = llvm::StructType::create(context, class_decl->GetName());
 
-		UniqueFieldDeclPtrList const& fields = class_decl->GetFields();
+		ASTSpan<FieldDecl> fields = class_decl->GetFields();
 		std::vector<llvm::Type*> llvm_member_types;
 		if (class_decl->IsPolymorphic())
 		{
@@ -34,6 +34,7 @@ namespace ola
 		using LLVMValueMap = VoidPointerMap<llvm::Value*>;
 		using LLVMVTableMap = VoidPointerMap<llvm::GlobalVariable*>;
 		using LLVMEmptyBlockSuccessorMap = std::unordered_map<llvm::BasicBlock*, llvm::BasicBlock*>;
+		using LLVMStructTypeMap = std::unordered_map<ClassDecl const*, llvm::StructType*>;
 	private:
 		LLVMIRVisitor(llvm::LLVMContext& context, llvm::Module& module);
 
@@ -98,6 +99,7 @@ namespace ola
 
 		LLVMValueMap value_map;
 		LLVMVTableMap vtable_map;
+		LLVMStructTypeMap struct_type_map;
 
 		llvm::Type* this_struct_type = nullptr;
 		llvm::Value* this_value = nullptr;
@@ -110,6 +112,7 @@ namespace ola
 		std::vector<llvm::BasicBlock*> end_blocks;
 		std::unordered_map<std::string, llvm::BasicBlock*> label_blocks;
 		LLVMEmptyBlockSuccessorMap empty_block_successors;
+		Uint32 string_literal_count = 0;
 
 		llvm::Type* void_type			= nullptr;
 		llvm::Type* float_type			= nullptr;
@@ -0,0 +1,277 @@
+#include <fstream>
+#include <sstream>
+#include <format>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+#include "CompilationCache.h"
+#include "Utility/Hash.h"
+
+namespace fs = std::filesystem;
+
+namespace ola
+{
+	namespace
+	{
+		constexpr Char const* ManifestHeader = "ola-cache-manifest 1";
+
+		Bool ReadFile(fs::path const& path, std::string& contents)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file) return false;
+			std::ostringstream stream;
+			stream << file.rdbuf();
+			contents = std::move(stream).str();
+			return true;
+		}
+
+		Bool HashFile(fs::path const& path, Uint64& hash)
+		{
+			std::string contents;
+			if (!ReadFile(path, contents)) return false;
+			hash = crc64(contents.data(), contents.size());
+			return true;
+		}
+
+		fs::path GetCompilerExecutablePath()
+		{
+#if _WIN32
+			Char path[MAX_PATH]{};
+			GetModuleFileNameA(nullptr, path, MAX_PATH);
+			return fs::path(path);
+#else
+			std::error_code error;
+			return fs::read_symlink("/proc/self/exe", error);
+#endif
+		}
+
+		//Identifies the compiler binary, rebuilding the compiler invalidates the whole cache
+		Uint64 ComputeBuildId()
+		{
+			HashState build_id;
+			fs::path compiler_path = GetCompilerExecutablePath();
+			std::error_code error;
+			if (!compiler_path.empty() && fs::exists(compiler_path, error))
+			{
+				build_id.Combine(compiler_path.string());
+				build_id.Combine(static_cast<Uint64>(fs::file_size(compiler_path, error)));
+				build_id.Combine(static_cast<Uint64>(fs::last_write_time(compiler_path, error).time_since_epoch().count()));
+			}
+			return build_id;
+		}
+
+		fs::path GetTemporaryPath(fs::path const& path)
+		{
+			Uint64 const thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+			Uint64 const tick = static_cast<Uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+			fs::path temporary_path = path;
+			temporary_path += std::format(".{:x}{:x}.tmp", thread_hash, tick);
+			return temporary_path;
+		}
+	}
+
+	CompilationCache::CompilationCache(std::string_view cache_directory, Uint64 max_size)
+		: cache_directory(cache_directory), max_size(max_size), build_id(ComputeBuildId())
+	{
+		std::error_code error;
+		fs::create_directories(this->cache_directory, error);
+		this->cache_directory = fs::absolute(this->cache_directory, error);
+	}
+
+	Uint64 CompilationCache::ComputeKey(std::string_view source_file, Uint64 options_hash) const
+	{
+		std::error_code error;
+		HashState key;
+		key.Combine(fs::absolute(source_file, error).lexically_normal().string());
+		key.Combine(options_hash);
+		key.Combine(build_id);
+		return key;
+	}
+
+	Bool CompilationCache::Lookup(Uint64 key, std::string_view object_file)
+	{
+		auto Miss = [this]()
+			{
+				++misses;
+				return false;
+			};
+
+		std::ifstream manifest(GetManifestPath(key));
+		if (!manifest) return Miss();
+
+		std::string line;
+		if (!std::getline(manifest, line) || line != ManifestHeader) return Miss();
+		while (std::getline(manifest, line))
+		{
+			if (line.empty()) continue;
+			Uint64 const separator = line.find(' ');
+			if (separator == std::string::npos) return Miss();
+
+			Uint64 const expected_hash = std::strtoull(line.c_str(), nullptr, 16);
+			Uint64 dependency_hash = 0;
+			if (!HashFile(line.substr(separator + 1), dependency_hash) || dependency_hash != expected_hash) return Miss();
+		}
+
+		std::error_code error;
+		fs::path const cached_object = GetObjectPath(key);
+		fs::copy_file(cached_object, object_file, fs::copy_options::overwrite_existing, error);
+		if (error) return Miss();
+
+		fs::last_write_time(cached_object, fs::file_time_type::clock::now(), error);
+		++hits;
+		return true;
+	}
+
+	void CompilationCache::Store(Uint64 key, std::vector<std::string> const& dependencies, std::string_view object_file)
+	{
+		std::string manifest_contents = ManifestHeader;
+		manifest_contents += '\n';
+		for (std::string const& dependency : dependencies)
+		{
+			Uint64 dependency_hash = 0;
+			if (!HashFile(dependency, dependency_hash)) return;
+
+			std::error_code error;
+			manifest_contents += std::format("{:016x} {}\n", dependency_hash, fs::absolute(dependency, error).lexically_normal().string());
+		}
+
+		//Write to temporary files first so that concurrent compilations never observe a partially written entry
+		std::error_code error;
+		fs::path const cached_object = GetObjectPath(key);
+		fs::path const temporary_object = GetTemporaryPath(cached_object);
+		fs::copy_file(object_file, temporary_object, fs::copy_options::overwrite_existing, error);
+		if (error) return;
+		fs::rename(temporary_object, cached_object, error);
+		if (error)
+		{
+			fs::remove(temporary_object, error);
+			return;
+		}
+
+		fs::path const manifest = GetManifestPath(key);
+		fs::path const temporary_manifest = GetTemporaryPath(manifest);
+		{
+			std::ofstream manifest_stream(temporary_manifest, std::ios::binary);
+			manifest_stream << manifest_contents;
+		}
+		fs::rename(temporary_manifest, manifest, error);
+		if (error)
+		{
+			fs::remove(temporary_manifest, error);
+			return;
+		}
+		++stores;
+	}
+
+	void CompilationCache::Evict()
+	{
+		struct CacheEntry
+		{
+			fs::path object;
+			Uint64 size;
+			fs::file_time_type last_use;
+		};
+		std::vector<CacheEntry> entries;
+		Uint64 total_size = 0;
+
+		std::error_code error;
+		for (fs::directory_entry const& entry : fs::directory_iterator(cache_directory, error))
+		{
+			if (entry.path().extension() != ".obj") continue;
+			Uint64 const size = entry.file_size(error);
+			if (error) continue;
+			entries.push_back(CacheEntry{ .object = entry.path(), .size = size, .last_use = entry.last_write_time(error) });
+			total_size += size;
+		}
+		if (total_size <= max_size) return;
+
+		//Least recently used entries go first, trim a bit below the limit so that eviction doesn't run on every store
+		Uint64 const target_size = max_size - max_size / 4;
+		std::sort(entries.begin(), entries.end(), [](CacheEntry const& a, CacheEntry const& b) { return a.last_use < b.last_use; });
+		for (CacheEntry const& entry : entries)
+		{
+			if (total_size <= target_size) break;
+			fs::path manifest = entry.object;
+			manifest.replace_extension(".manifest");
+			fs::remove(manifest, error);
+			fs::remove(entry.object, error);
+			total_size -= entry.size;
+			++evictions;
+		}
+	}
+
+	CompilationCacheStats CompilationCache::GetStats() const
+	{
+		return CompilationCacheStats{ .hits = hits, .misses = misses, .stores = stores, .evictions = evictions };
+	}
+
+	void CompilationCache::SaveStats() const
+	{
+		CompilationCacheStats total = LoadStats();
+		CompilationCacheStats const current = GetStats();
+		total.hits += current.hits;
+		total.misses += current.misses;
+		total.stores += current.stores;
+		total.evictions += current.evictions;
+
+		std::error_code error;
+		fs::path const stats_path = GetStatsPath();
+		fs::path const temporary_stats = GetTemporaryPath(stats_path);
+		{
+			std::ofstream stats_stream(temporary_stats);
+			stats_stream << total.hits << ' ' << total.misses << ' ' << total.stores << ' ' << total.evictions << '\n';
+		}
+		fs::rename(temporary_stats, stats_path, error);
+		if (error) fs::remove(temporary_stats, error);
+	}
+
+	void CompilationCache::PrintStats(std::ostream& os) const
+	{
+		CompilationCacheStats const current = GetStats();
+		CompilationCacheStats const total = LoadStats();
+
+		Uint64 entry_count = 0;
+		Uint64 total_size = 0;
+		std::error_code error;
+		for (fs::directory_entry const& entry : fs::directory_iterator(cache_directory, error))
+		{
+			if (entry.path().extension() != ".obj") continue;
+			++entry_count;
+			total_size += entry.file_size(error);
+		}
+
+		os << "===== Compilation Cache =====\n";
+		os << std::format("Directory: {}\n", cache_directory.string());
+		os << std::format("Entries: {} ({:.2f} MB of {:.2f} MB)\n", entry_count, total_size / (1024.0 * 1024.0), max_size / (1024.0 * 1024.0));
+		os << std::format("This run: {} hits, {} misses, {} stores, {} evictions\n", current.hits, current.misses, current.stores, current.evictions);
+		os << std::format("All runs: {} hits, {} misses, {} stores, {} evictions\n", total.hits, total.misses, total.stores, total.evictions);
+	}
+
+	fs::path CompilationCache::GetObjectPath(Uint64 key) const
+	{
+		return cache_directory / std::format("{:016x}.obj", key);
+	}
+
+	fs::path CompilationCache::GetManifestPath(Uint64 key) const
+	{
+		return cache_directory / std::format("{:016x}.manifest", key);
+	}
+
+	fs::path CompilationCache::GetStatsPath() const
+	{
+		return cache_directory / "stats";
+	}
+
+	CompilationCacheStats CompilationCache::LoadStats() const
+	{
+		CompilationCacheStats stats{};
+		std::ifstream stats_stream(GetStatsPath());
+		if (stats_stream) stats_stream >> stats.hits >> stats.misses >> stats.stores >> stats.evictions;
+		return stats;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <filesystem>
+#include <iosfwd>
+
+namespace ola
+{
+	struct CompilationCacheStats
+	{
+		Uint64 hits = 0;
+		Uint64 misses = 0;
+		Uint64 stores = 0;
+		Uint64 evictions = 0;
+	};
+
+	//Each entry is keyed by the source file, the compilation options and the compiler build.
+	//The entry's manifest records the content hash of every file the translation unit was built from,
+	//a lookup only hits if none of them changed since the entry was stored.
+	class CompilationCache
+	{
+	public:
+		CompilationCache(std::string_view cache_directory, Uint64 max_size);
+		OLA_NONCOPYABLE_NONMOVABLE(CompilationCache)
+
+		Uint64 ComputeKey(std::string_view source_file, Uint64 options_hash) const;
+		Bool Lookup(Uint64 key, std::string_view object_file);
+		void Store(Uint64 key, std::vector<std::string> const& dependencies, std::string_view object_file);
+		void Evict();
+
+		CompilationCacheStats GetStats() const;
+		void SaveStats() const;
+		void PrintStats(std::ostream& os) const;
+
+	private:
+		std::filesystem::path cache_directory;
+		Uint64 max_size;
+		Uint64 build_id;
+		std::atomic<Uint64> hits = 0;
+		std::atomic<Uint64> misses = 0;
+		std::atomic<Uint64> stores = 0;
+		std::atomic<Uint64> evictions = 0;
+
+	private:
+		std::filesystem::path GetObjectPath(Uint64 key) const;
+		std::filesystem::path GetManifestPath(Uint64 key) const;
+		std::filesystem::path GetStatsPath() const;
+		CompilationCacheStats LoadStats() const;
+	};
+}
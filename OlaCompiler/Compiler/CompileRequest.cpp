@@ -1,3 +1,4 @@
+#include <filesystem>
 #include "CompileRequest.h"
 #include "Core/Log.h"
 #include "Utility/CLIParser.h"
@@ -15,11 +16,14 @@ namespace ola
 			cli_parser.AddArg(false, "--domtree");
 			cli_parser.AddArg(false, "--domfrontier");
 			cli_parser.AddArg(false, "--emit-ir");
+			cli_parser.AddArg(false, "--emit-ir-binary");
 			cli_parser.AddArg(false, "--emit-mir");
 			cli_parser.AddArg(false, "--emit-asm");
 			cli_parser.AddArg(false, "--nollvm");
 			cli_parser.AddArg(false, "--test");
 			cli_parser.AddArg(false, "--timeout");
+			cli_parser.AddArg(false, "--time-report");
+			cli_parser.AddArg(false, "--time-report=json");
 			cli_parser.AddArg(false, "--Od");
 			cli_parser.AddArg(false, "--O0");
 			cli_parser.AddArg(false, "--O1");
@@ -28,12 +32,37 @@ namespace ola
 			cli_parser.AddArg(true, "-i", "--input");
 			cli_parser.AddArg(true, "--directory");
 			cli_parser.AddArg(true, "-o", "--output");
+			cli_parser.AddArg(true, "-j", "--jobs");
+			cli_parser.AddArg(true, "--target");
+			cli_parser.AddArg(false, "--cache");
+			cli_parser.AddArg(true, "--cache-dir");
+			cli_parser.AddArg(true, "--cache-size");
+			cli_parser.AddArg(false, "--cache-stats");
+			cli_parser.AddArg(false, "--run-jit");
+			cli_parser.AddArg(false, "--lto");
+			cli_parser.AddArg(false, "--serve");
+			cli_parser.AddArg(false, "--connect");
+			cli_parser.AddArg(true, "--socket");
 		}
 		CLIParseResult cli_result = cli_parser.Parse(argc, argv);
 
+		socket_path = cli_result["--socket"].AsStringOr((std::filesystem::temp_directory_path() / "ola-compile-server.sock").string());
+		if (cli_result["--serve"])
+		{
+			mode = CompilerMode::Serve;
+			return true;
+		}
+		if (cli_result["--connect"]) mode = CompilerMode::Connect;
+
 		input_files = cli_result["-i"].AsStrings();
 		output_file = cli_result["-o"].AsStringOr("");
 		input_directory = cli_result["--directory"].AsStringOr("");
+		Int const jobs = cli_result["-j"].AsIntOr(1);
+		job_count = jobs > 0 ? static_cast<Uint32>(jobs) : 0;
+		if (cli_result["--cache-dir"])	cache_directory = std::filesystem::absolute(cli_result["--cache-dir"].AsString()).string();
+		else if (cli_result["--cache"]) cache_directory = ".olacache";
+		Int const cache_size_mb = cli_result["--cache-size"].AsIntOr(512);
+		cache_size = static_cast<Uint64>(cache_size_mb > 0 ? cache_size_mb : 512) * 1024 * 1024;
 		if (cli_result["--test"])
 		{
 			if (!input_files.empty())
@@ -62,10 +91,35 @@ namespace ola
 		if (cli_result["--callgraph"])			compiler_flags |= CompilerFlag_DumpCallGraph;
 		if (cli_result["--domtree"])			compiler_flags |= CompilerFlag_DumpDomTree;
 		if (cli_result["--emit-ir"])			compiler_flags |= CompilerFlag_EmitIR;
+		if (cli_result["--emit-ir-binary"])		compiler_flags |= CompilerFlag_EmitIRBinary | CompilerFlag_NoLLVM;
 		if (cli_result["--emit-mir"])			compiler_flags |= CompilerFlag_EmitMIR;
 		if (cli_result["--emit-asm"])			compiler_flags |= CompilerFlag_EmitASM;
 		if (cli_result["--domfrontier"])		compiler_flags |= CompilerFlag_PrintDomFrontier;
 		if (cli_result["--timeout"])			compiler_flags |= CompilerFlag_TimeoutDetection;
+		if (cli_result["--time-report"] || cli_result["--time-report=json"]) compiler_flags |= CompilerFlag_TimeReport;
+		if (cli_result["--time-report=json"])	time_report_format = TimeReportFormat::JSON;
+		if (cli_result["--cache-stats"])		compiler_flags |= CompilerFlag_CacheStats;
+		if (cli_result["--run-jit"])			compiler_flags |= CompilerFlag_RunJIT | CompilerFlag_NoLLVM;
+		if (cli_result["--lto"])				compiler_flags |= CompilerFlag_LTO | CompilerFlag_NoLLVM;
+
+		if (cli_result["--target"])
+		{
+			std::string target_name = cli_result["--target"].AsString();
+			if (target_name == "x64-win64")		target = CompilerTarget::x64_Win64;
+			else if (target_name == "x64-sysv")	target = CompilerTarget::x64_SysV;
+			else
+			{
+				OLA_WARN("Unknown target '{}', expected x64-win64 or x64-sysv!", target_name);
+				return false;
+			}
+		}
+#if defined(_WIN32)
+		if ((compiler_flags & CompilerFlag_RunJIT) && target == CompilerTarget::x64_SysV)
+		{
+			OLA_WARN("--run-jit is not supported for the x64-sysv target on this host!");
+			return false;
+		}
+#endif
 
 		if (cli_result["--O0"] || cli_result["--Od"]) opt_level = OptimizationLevel::O0;
 		if (cli_result["--O1"]) opt_level = OptimizationLevel::O1;
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include "CompilerOptions.h"
+#include "Utility/TimeReport.h"
 
 namespace ola
 {
@@ -17,16 +18,30 @@ namespace ola
 		CompilerFlags GetCompilerFlags() const { return compiler_flags; }
 		OptimizationLevel GetOptimizationLevel() const { return opt_level; }
 		CompilerOutput GetOutputType() const { return output_type; }
+		CompilerTarget GetTarget() const { return target; }
 		std::string_view GetInputDirectory() const { return input_directory; }
 		std::string const& GetOutputFile() const { return output_file; }
 		std::vector<std::string> const& GetSourceFiles() const { return input_files; }
+		Uint32 GetJobCount() const { return job_count; }
+		TimeReportFormat GetTimeReportFormat() const { return time_report_format; }
+		std::string const& GetCacheDirectory() const { return cache_directory; }
+		Uint64 GetCacheSize() const { return cache_size; }
+		CompilerMode GetMode() const { return mode; }
+		std::string const& GetSocketPath() const { return socket_path; }
 
 	private:
 		CompilerFlags compiler_flags = CompilerFlag_None;
 		OptimizationLevel opt_level = OptimizationLevel::O0;
 		CompilerOutput output_type = CompilerOutput::Exe;
+		CompilerTarget target = CompilerTarget::Host;
 		std::string input_directory;
 		std::vector<std::string> input_files;
 		std::string output_file;
+		Uint32 job_count = 1;
+		TimeReportFormat time_report_format = TimeReportFormat::Text;
+		std::string cache_directory;
+		Uint64 cache_size = 0;
+		CompilerMode mode = CompilerMode::Compile;
+		std::string socket_path;
 	};
 }
\ No newline at end of file
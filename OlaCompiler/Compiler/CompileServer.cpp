@@ -0,0 +1,313 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <filesystem>
+#include <cstring>
+#include <csignal>
+#if !_WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#include "CompileServer.h"
+#include "CompileRequest.h"
+#include "Compiler.h"
+#include "Core/Log.h"
+#include "Frontend/ImportProcessor.h"
+#include "autogen/OlaConfig.h"
+
+namespace fs = std::filesystem;
+
+namespace ola
+{
+#if !_WIN32
+	namespace
+	{
+		constexpr Uint32 MaxRequestSize = 1 << 20;
+		volatile std::sig_atomic_t stop_requested = 0;
+
+		void OnStopSignal(Int)
+		{
+			stop_requested = 1;
+		}
+
+		Bool WriteAll(Int fd, void const* data, Uint64 size)
+		{
+			Char const* bytes = static_cast<Char const*>(data);
+			while (size > 0)
+			{
+				ssize_t written = write(fd, bytes, size);
+				if (written <= 0) return false;
+				bytes += written;
+				size -= written;
+			}
+			return true;
+		}
+
+		Bool ReadAll(Int fd, void* data, Uint64 size)
+		{
+			Char* bytes = static_cast<Char*>(data);
+			while (size > 0)
+			{
+				ssize_t read_count = read(fd, bytes, size);
+				if (read_count <= 0) return false;
+				bytes += read_count;
+				size -= read_count;
+			}
+			return true;
+		}
+
+		Bool GetSocketAddress(std::string_view socket_path, sockaddr_un& address)
+		{
+			address = {};
+			address.sun_family = AF_UNIX;
+			if (socket_path.size() >= sizeof(address.sun_path))
+			{
+				OLA_ERROR("Socket path is too long: {}", socket_path);
+				return false;
+			}
+			std::memcpy(address.sun_path, socket_path.data(), socket_path.size());
+			return true;
+		}
+
+		//A request is the client's working directory followed by its command line, each as a length-prefixed string.
+		//The client's stdout and stderr travel along with the request size so that the compilation writes straight to them.
+		Bool SendRequest(Int socket_fd, std::vector<std::string> const& request)
+		{
+			std::string payload;
+			for (std::string const& str : request)
+			{
+				Uint32 const length = static_cast<Uint32>(str.size());
+				payload.append(reinterpret_cast<Char const*>(&length), sizeof(length));
+				payload += str;
+			}
+			Uint32 payload_size = static_cast<Uint32>(payload.size());
+
+			iovec iov{ .iov_base = &payload_size, .iov_len = sizeof(payload_size) };
+			alignas(cmsghdr) Char control[CMSG_SPACE(sizeof(Int) * 2)]{};
+			msghdr message{};
+			message.msg_iov = &iov;
+			message.msg_iovlen = 1;
+			message.msg_control = control;
+			message.msg_controllen = sizeof(control);
+
+			cmsghdr* control_message = CMSG_FIRSTHDR(&message);
+			control_message->cmsg_level = SOL_SOCKET;
+			control_message->cmsg_type = SCM_RIGHTS;
+			control_message->cmsg_len = CMSG_LEN(sizeof(Int) * 2);
+			Int const output_fds[2] = { STDOUT_FILENO, STDERR_FILENO };
+			std::memcpy(CMSG_DATA(control_message), output_fds, sizeof(output_fds));
+
+			if (sendmsg(socket_fd, &message, 0) != sizeof(payload_size)) return false;
+			return WriteAll(socket_fd, payload.data(), payload.size());
+		}
+
+		Bool ReceiveRequest(Int connection_fd, std::vector<std::string>& request, Int(&output_fds)[2])
+		{
+			Uint32 payload_size = 0;
+			iovec iov{ .iov_base = &payload_size, .iov_len = sizeof(payload_size) };
+			alignas(cmsghdr) Char control[CMSG_SPACE(sizeof(Int) * 2)]{};
+			msghdr message{};
+			message.msg_iov = &iov;
+			message.msg_iovlen = 1;
+			message.msg_control = control;
+			message.msg_controllen = sizeof(control);
+
+			if (recvmsg(connection_fd, &message, 0) != sizeof(payload_size)) return false;
+			cmsghdr* control_message = CMSG_FIRSTHDR(&message);
+			if (!control_message || control_message->cmsg_type != SCM_RIGHTS || control_message->cmsg_len != CMSG_LEN(sizeof(Int) * 2)) return false;
+			std::memcpy(output_fds, CMSG_DATA(control_message), sizeof(output_fds));
+
+			if (payload_size > MaxRequestSize) return false;
+			std::string payload(payload_size, '\0');
+			if (!ReadAll(connection_fd, payload.data(), payload.size())) return false;
+
+			Uint64 offset = 0;
+			while (offset + sizeof(Uint32) <= payload.size())
+			{
+				Uint32 length = 0;
+				std::memcpy(&length, payload.data() + offset, sizeof(length));
+				offset += sizeof(length);
+				if (offset + length > payload.size()) return false;
+				request.emplace_back(payload.data() + offset, length);
+				offset += length;
+			}
+			return offset == payload.size() && request.size() >= 2;
+		}
+
+		OLA_NORETURN void ServeRequest(std::vector<std::string>& request, Int output_fds[2])
+		{
+			dup2(output_fds[0], STDOUT_FILENO);
+			dup2(output_fds[1], STDERR_FILENO);
+			close(output_fds[0]);
+			close(output_fds[1]);
+
+			std::error_code error;
+			fs::current_path(request[0], error);
+			if (error)
+			{
+				OLA_ERROR("Invalid working directory: {}", request[0]);
+				std::exit(1);
+			}
+
+			std::vector<Char*> argv;
+			for (Uint64 i = 1; i < request.size(); ++i) argv.push_back(request[i].data());
+			CompileRequest compile_request{};
+			Int result = 0;
+			if (compile_request.Parse(static_cast<Int>(argv.size()), argv.data()))
+			{
+				result = Compile(compile_request);
+			}
+			std::exit(result);
+		}
+
+		void ReplyToFinishedRequests(std::unordered_map<pid_t, Int>& pending_requests, Bool wait)
+		{
+			Int status = 0;
+			pid_t pid;
+			while (!pending_requests.empty() && (pid = waitpid(-1, &status, wait ? 0 : WNOHANG)) > 0)
+			{
+				auto it = pending_requests.find(pid);
+				if (it == pending_requests.end()) continue;
+
+				Int32 const exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+				WriteAll(it->second, &exit_code, sizeof(exit_code));
+				close(it->second);
+				pending_requests.erase(it);
+			}
+		}
+	}
+
+	Int RunCompileServer(std::string_view socket_path)
+	{
+		sockaddr_un address{};
+		if (!GetSocketAddress(socket_path, address)) return 1;
+
+		Int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listen_fd < 0)
+		{
+			OLA_ERROR("Failed to create compile server socket: {}", std::strerror(errno));
+			return 1;
+		}
+		unlink(address.sun_path);
+		if (bind(listen_fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 || listen(listen_fd, SOMAXCONN) != 0)
+		{
+			OLA_ERROR("Failed to listen on {}: {}", socket_path, std::strerror(errno));
+			close(listen_fd);
+			return 1;
+		}
+
+		std::signal(SIGINT, OnStopSignal);
+		std::signal(SIGTERM, OnStopSignal);
+		std::signal(SIGPIPE, SIG_IGN);
+
+		//Everything loaded here is inherited by the process forked for each request
+		ImportProcessor::PreloadImports(OLA_LIB_PATH);
+
+		std::unordered_map<pid_t, Int> pending_requests;
+		while (!stop_requested)
+		{
+			pollfd listen_poll{ .fd = listen_fd, .events = POLLIN, .revents = 0 };
+			if (poll(&listen_poll, 1, 100) > 0 && (listen_poll.revents & POLLIN))
+			{
+				Int connection_fd = accept(listen_fd, nullptr, nullptr);
+				if (connection_fd >= 0)
+				{
+					std::vector<std::string> request;
+					Int output_fds[2] = { -1, -1 };
+					if (ReceiveRequest(connection_fd, request, output_fds))
+					{
+						pid_t pid = fork();
+						if (pid == 0)
+						{
+							close(listen_fd);
+							close(connection_fd);
+							for (auto const& [_, pending_fd] : pending_requests) close(pending_fd);
+							std::signal(SIGINT, SIG_DFL);
+							std::signal(SIGTERM, SIG_DFL);
+							std::signal(SIGPIPE, SIG_DFL);
+							ServeRequest(request, output_fds);
+						}
+						close(output_fds[0]);
+						close(output_fds[1]);
+						if (pid > 0)
+						{
+							pending_requests[pid] = connection_fd;
+						}
+						else
+						{
+							OLA_ERROR("Failed to fork compile server worker: {}", std::strerror(errno));
+							close(connection_fd);
+						}
+					}
+					else
+					{
+						if (output_fds[0] >= 0) close(output_fds[0]);
+						if (output_fds[1] >= 0) close(output_fds[1]);
+						close(connection_fd);
+					}
+				}
+			}
+			ReplyToFinishedRequests(pending_requests, false);
+		}
+
+		ReplyToFinishedRequests(pending_requests, true);
+		close(listen_fd);
+		unlink(address.sun_path);
+		return 0;
+	}
+
+	Int RunCompileClient(std::string_view socket_path, Int argc, Char** argv)
+	{
+		sockaddr_un address{};
+		if (!GetSocketAddress(socket_path, address)) return 1;
+
+		Int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (socket_fd < 0 || connect(socket_fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0)
+		{
+			OLA_ERROR("Could not connect to the compile server at {}: {}", socket_path, std::strerror(errno));
+			if (socket_fd >= 0) close(socket_fd);
+			return 1;
+		}
+
+		std::vector<std::string> request;
+		request.push_back(fs::current_path().string());
+		for (Int i = 0; i < argc; ++i)
+		{
+			std::string_view arg = argv[i];
+			if (arg == "--connect") continue;
+			if (arg == "--socket")
+			{
+				++i;
+				continue;
+			}
+			request.emplace_back(arg);
+		}
+
+		std::fflush(stdout);
+		std::fflush(stderr);
+		Int32 exit_code = 1;
+		if (!SendRequest(socket_fd, request) || !ReadAll(socket_fd, &exit_code, sizeof(exit_code)))
+		{
+			OLA_ERROR("Lost connection to the compile server at {}", socket_path);
+			exit_code = 1;
+		}
+		close(socket_fd);
+		return exit_code;
+	}
+#else
+	Int RunCompileServer(std::string_view socket_path)
+	{
+		OLA_ERROR("Compile server mode is only supported on POSIX systems");
+		return 1;
+	}
+
+	Int RunCompileClient(std::string_view socket_path, Int argc, Char** argv)
+	{
+		OLA_ERROR("Compile server mode is only supported on POSIX systems");
+		return 1;
+	}
+#endif
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <string_view>
+
+namespace ola
+{
+	Int RunCompileServer(std::string_view socket_path);
+	Int RunCompileClient(std::string_view socket_path, Int argc, Char** argv);
+}
@@ -1,23 +1,35 @@
 #include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iostream>
 #include <format>
+#include <mutex>
+#include <atomic>
 #include "Compiler.h"
 #include "CompilerMacros.h"
 #include "CompileRequest.h"
+#include "CompilationCache.h"
 #include "Core/Log.h"
 #include "Frontend/FrontendContext.h"
 #include "Frontend/Diagnostics.h"
 #include "Frontend/SourceBuffer.h"
 #include "Frontend/Lexer.h"
+#include "Frontend/TokenStream.h"
 #include "Frontend/ImportProcessor.h"
 #include "Frontend/Parser.h"
 #include "Frontend/Sema.h"
 #include "Backend/Custom/IR/IRGenContext.h"
+#include "Backend/Custom/IR/IRLinker.h"
 #include "Backend/Custom/IR/IRPassManager.h"
 #include "Backend/Custom/IR/FunctionPass.h"
 #include "Backend/Custom/Codegen/MachineModule.h"
 #include "Backend/Custom/Codegen/x64/x64Target.h"
+#include "Backend/Custom/Codegen/JITModule.h"
 #include "Utility/DebugVisitor.h"
 #include "Utility/Command.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/TimeReport.h"
+#include "Utility/Hash.h"
 #include "autogen/OlaConfig.h"
 #if HAS_LLVM
 #include "Backend/LLVM/LLVMIRGenContext.h"
@@ -46,31 +58,123 @@ namespace ola
 			}
 		}
 
+#if defined(_WIN32)
+		constexpr Bool HostUsesELFObjects = false;
+#else
+		constexpr Bool HostUsesELFObjects = true;
+#endif
+
 		struct TUCompilationOptions
 		{
 			OptimizationLevel opt_level;
+			CompilerTarget target;
 			Bool use_llvm_backend;
+			Bool emit_object;
+			Bool emit_ir;
+			Bool emit_ir_binary;
+			Bool emit_mir;
+			Bool emit_asm;
 			Bool dump_ast;
 			Bool dump_cfg;
 			Bool dump_callgraph;
 			Bool dump_domtree;
 			Bool print_domfrontier;
+			Uint32 ir_gen_thread_count;
+			std::string interface_directory;
+		};
+
+		//With --lto translation units are generated into a shared context and linked into a single module that is optimized and lowered once
+		struct LTOModule
+		{
+			explicit LTOModule(std::string_view module_id) : ir_module(ir_context, module_id), ir_linker(ir_module) {}
+
+			IRContext ir_context;
+			IRModule ir_module;
+			IRLinker ir_linker;
+			std::mutex mutex;
 		};
 
-		void CompileTranslationUnit(FrontendContext& context, 
+		Int CompileIRModule(IRModule& ir_module, std::string_view ir_file, std::string_view mir_file, std::string_view assembly_file,
+			std::string_view object_file, ObjectFile* jit_object, TUCompilationOptions const& opts)
+		{
+			FunctionAnalysisManager analysis_manager;
+			IRPassManager ir_pass_manager(ir_module, analysis_manager);
+			IRPassOptions pass_opts
+			{
+				.cfg_print = opts.dump_cfg,
+				.domtree_print = opts.dump_domtree,
+				.domfrontier_print = opts.print_domfrontier
+			};
+			{
+				OLA_TIME_REPORT_SCOPE("IR Optimization Pipeline");
+				ir_pass_manager.Run(opts.opt_level, pass_opts);
+			}
+
+			if (opts.emit_ir)
+			{
+				OLA_TIME_REPORT_SCOPE("IR Printing");
+				ir_module.Print(ir_file);
+			}
+			if (opts.emit_ir_binary)
+			{
+				OLA_TIME_REPORT_SCOPE("IR Binary Writing");
+				ir_module.WriteBinary(fs::path(ir_file).replace_extension(".olb").string());
+			}
+
+			x64Target x64_target(opts.target == CompilerTarget::x64_SysV ? x64ABI::SystemV : x64ABI::Microsoft);
+			MachineModule machine_module(ir_module, x64_target, analysis_manager);
+			if (opts.emit_mir)
+			{
+				OLA_TIME_REPORT_SCOPE("MIR Printing");
+				machine_module.EmitMIR(mir_file);
+			}
+
+			if (jit_object)
+			{
+				if (opts.emit_asm) machine_module.EmitAssembly(assembly_file);
+				return machine_module.EmitObject(*jit_object) ? 0 : -1;
+			}
+			if (opts.emit_object)
+			{
+				if (opts.emit_asm) machine_module.EmitAssembly(assembly_file);
+				return machine_module.EmitObject(object_file) ? 0 : -1;
+			}
+
+			std::ostringstream assembly_stream;
+			machine_module.EmitAssembly(assembly_stream);
+			std::string assembly = std::move(assembly_stream).str();
+			if (opts.emit_asm)
+			{
+				std::ofstream assembly_file_stream(assembly_file.data());
+				assembly_file_stream << assembly;
+			}
+			OLA_TIME_REPORT_COMMAND_SCOPE("Assemble (clang)");
+			std::string assembly_cmd = std::format("clang -c -x assembler - -o {}", object_file);
+			return ExecuteCommand(assembly_cmd.c_str(), assembly);
+		}
+
+		Int CompileTranslationUnit(FrontendContext& context, 
 			std::string_view source_file, std::string_view ir_file, std::string_view mir_file, std::string_view assembly_file,
-			TUCompilationOptions const& opts)
+			std::string_view object_file, ObjectFile* jit_object, LTOModule* lto_module, TUCompilationOptions const& opts, std::vector<std::string>& dependencies)
 		{
 			Diagnostics diagnostics{};
 			SourceBuffer src(source_file);
-			Lexer lex(diagnostics);
-			lex.Lex(src);
+			Lexer lex(&context, diagnostics, src);
+			TokenStream tokens(lex);
 
-			ImportProcessor import_processor(&context, diagnostics);
-			import_processor.ProcessImports(lex.GetTokens());
+			ImportProcessor import_processor(&context, diagnostics, opts.interface_directory);
+			{
+				OLA_TIME_REPORT_SCOPE("Import Processor");
+				import_processor.ProcessImports(tokens);
+			}
+			std::vector<std::string> const& import_closure = import_processor.GetImportClosure();
+			dependencies.insert(dependencies.end(), import_closure.begin(), import_closure.end());
 
 			Parser parser(&context, diagnostics);
-			parser.Parse(import_processor.GetProcessedTokens());
+			{
+				OLA_TIME_REPORT_SCOPE("Parser and Sema");
+				parser.Parse(tokens, import_processor.GetImportedModules());
+			}
 			AST const* ast = parser.GetAST();
 			if (opts.dump_ast) DebugVisitor debug_ast(ast);
 
@@ -78,13 +182,36 @@ namespace ola
 			{
 #if HAS_LLVM
 				LLVMIRGenContext llvmir_gen_ctx(source_file);
-				llvmir_gen_ctx.Generate(ast);
+				{
+					OLA_TIME_REPORT_SCOPE("IR Generation");
+					llvmir_gen_ctx.Generate(ast);
+				}
 
 				llvm::Module& llvm_module = llvmir_gen_ctx.GetModule();
 				LLVMIRPassManager llvmir_pass_manager(llvm_module);
 				LLVMIRPassOptions pass_opts{ .domfrontier_print = opts.print_domfrontier };
-				llvmir_pass_manager.Run(opts.opt_level, pass_opts);
+				{
+					OLA_TIME_REPORT_SCOPE("LLVM Optimization Pipeline");
+					llvmir_pass_manager.Run(opts.opt_level, pass_opts);
+				}
 
+				std::string llvm_ir;
+				llvm::raw_string_ostream llvm_ir_stream(llvm_ir);
+				llvm_module.print(llvm_ir_stream, nullptr);
+				llvm_ir_stream.flush();
+
+				Bool const dump_graphs = opts.dump_cfg || opts.dump_callgraph || opts.dump_domtree;
+				if (opts.emit_ir || dump_graphs)
+				{
+					std::error_code error;
+					llvm::raw_fd_ostream llvm_ir_file_stream(ir_file, error, llvm::sys::fs::OF_None);
+					if (error)
+					{
+						OLA_ERROR("Error when creating llvm::raw_fd_ostream: {}", error.message());
+						return -1;
+					}
+					llvm_ir_file_stream << llvm_ir;
+				}
 				if (opts.dump_cfg)
 				{
 					std::string dot_cfg_cmd = std::format("opt -passes=dot-cfg -disable-output {}", ir_file);
@@ -100,47 +227,58 @@ namespace ola
 					std::string dot_domtree_cmd = std::format("opt -passes=dot-dom-only -disable-output {}", ir_file);
 					ExecuteCommand(dot_domtree_cmd.c_str());
 				}
+				if (!opts.emit_ir && dump_graphs) fs::remove(ir_file);
 
-				std::error_code error;
-				llvm::raw_fd_ostream llvm_ir_stream(ir_file, error, llvm::sys::fs::OF_None);
-				if (error)
+				if (opts.emit_asm)
 				{
-					OLA_ERROR("Error when creating llvm::raw_fd_ostream: {}", error.message());
-					return;
+					OLA_TIME_REPORT_COMMAND_SCOPE("Compile LLVM IR To Assembly (clang)");
+					std::string compile_cmd = std::format("clang -S -x ir - -o {} -masm=intel", assembly_file);
+					ExecuteCommand(compile_cmd.c_str(), llvm_ir);
 				}
-				llvm_module.print(llvm_ir_stream, nullptr);
-
-				std::string compile_cmd = std::format("clang -S {} -o {} -masm=intel", ir_file, assembly_file);
-				ExecuteCommand(compile_cmd.c_str());
+				OLA_TIME_REPORT_COMMAND_SCOPE("Compile LLVM IR To Object (clang)");
+				std::string assembly_cmd = std::format("clang -c -x ir - -o {}", object_file);
+				return ExecuteCommand(assembly_cmd.c_str(), llvm_ir);
 #else
 				OLA_ASSERT_MSG(false, "LLVM backend is disabled. Use --nollvm or generate project with -DENABLE_LLVM=ON assuming you have LLVM 17.0 installed");
+				return -1;
 #endif
 			}
-			else
+			else if (lto_module)
 			{
-				IRGenContext ir_gen_ctx(source_file);
-				ir_gen_ctx.Generate(ast);
-				IRModule& ir_module = ir_gen_ctx.GetModule();
-
-				FunctionAnalysisManager analysis_manager;
-				IRPassManager ir_pass_manager(ir_module, analysis_manager);
-				IRPassOptions pass_opts
+				//translation units are generated in their own context and handed over in the binary IR format,
+				//only reading them into the shared context, which isn't thread safe, and linking happen one at a time
+				std::vector<Uint8> ir_binary;
 				{
-					.cfg_print = opts.dump_cfg,
-					.domtree_print = opts.dump_domtree,
-					.domfrontier_print = opts.print_domfrontier
-				};
-				ir_pass_manager.Run(opts.opt_level, pass_opts);
-
-				ir_module.Print(ir_file);
+					IRGenContext ir_gen_ctx(source_file);
+					{
+						OLA_TIME_REPORT_SCOPE("IR Generation");
+						ir_gen_ctx.Generate(ast, opts.ir_gen_thread_count);
+					}
+					OLA_TIME_REPORT_SCOPE("IR Binary Writing");
+					ir_binary = ir_gen_ctx.GetModule().WriteBinary();
+				}
 
-				x64Target x64_target{};
-				MachineModule machine_module(ir_module, x64_target, analysis_manager);
-				if(!mir_file.empty())
+				std::lock_guard lock(lto_module->mutex);
+				IRModule ir_module(lto_module->ir_context, source_file);
+				{
+					OLA_TIME_REPORT_SCOPE("IR Binary Reading");
+					if (!ir_module.ReadBinary(std::move(ir_binary)))
+					{
+						OLA_ERROR("Failed to read the IR of {} for link time optimization!", source_file);
+						return -1;
+					}
+				}
+				OLA_TIME_REPORT_SCOPE("IR Linking");
+				return lto_module->ir_linker.Link(ir_module) ? 0 : -1;
+			}
+			else
+			{
+				IRGenContext ir_gen_ctx(source_file);
 				{
-					machine_module.EmitMIR(mir_file);
+					OLA_TIME_REPORT_SCOPE("IR Generation");
+					ir_gen_ctx.Generate(ast, opts.ir_gen_thread_count);
 				}
-				machine_module.EmitAssembly(assembly_file);
+				return CompileIRModule(ir_gen_ctx.GetModule(), ir_file, mir_file, assembly_file, object_file, jit_object, opts);
 			}
 		}
 	}
@@ -153,10 +291,16 @@ namespace ola
 		Bool const domtree_dump = compile_request.GetCompilerFlags() & CompilerFlag_DumpDomTree;
 		Bool const no_llvm = compile_request.GetCompilerFlags() & CompilerFlag_NoLLVM;
 		Bool const emit_ir = compile_request.GetCompilerFlags() & CompilerFlag_EmitIR;
+		Bool const emit_ir_binary = compile_request.GetCompilerFlags() & CompilerFlag_EmitIRBinary;
 		Bool const emit_mir = compile_request.GetCompilerFlags() & CompilerFlag_EmitMIR;
 		Bool const emit_asm = compile_request.GetCompilerFlags() & CompilerFlag_EmitASM;
 		Bool const print_domfrontier = compile_request.GetCompilerFlags() & CompilerFlag_PrintDomFrontier;
 		Bool const timeout_detection = compile_request.GetCompilerFlags() & CompilerFlag_TimeoutDetection;
+		Bool const time_report = compile_request.GetCompilerFlags() & CompilerFlag_TimeReport;
+		Bool const cache_stats = compile_request.GetCompilerFlags() & CompilerFlag_CacheStats;
+		Bool const run_jit = compile_request.GetCompilerFlags() & CompilerFlag_RunJIT;
+		Bool const lto = compile_request.GetCompilerFlags() & CompilerFlag_LTO;
+		if (time_report) g_TimeReport.Enable();
 		OptimizationLevel opt_level = compile_request.GetOptimizationLevel();
 
 		fs::path cur_path = fs::current_path();
@@ -165,7 +309,9 @@ namespace ola
 
 		std::vector<std::string> const& source_files = compile_request.GetSourceFiles();
 		std::vector<std::string> object_files(source_files.size());
+		std::vector<ObjectFile> jit_objects(run_jit ? (lto ? 1 : source_files.size()) : 0);
 		std::string output_file = compile_request.GetOutputFile();
+		std::unique_ptr<LTOModule> lto_module = lto ? std::make_unique<LTOModule>(output_file) : nullptr;
 		
 		switch (compile_request.GetOutputType())
 		{
@@ -175,48 +321,144 @@ namespace ola
 			OLA_ASSERT_MSG(false, "DLL and LIB outputs are not yet supported!");
 		}
 
-		FrontendContext context{};
-		for (Uint64 i = 0; i < source_files.size(); ++i)
+		//Module interfaces are kept in the cache directory, without one next to the output
+		fs::path interface_directory = compile_request.GetCacheDirectory().empty() ? fs::path(output_file).parent_path() : fs::path(compile_request.GetCacheDirectory());
+		interface_directory = interface_directory.empty() ? fs::current_path() : fs::absolute(interface_directory);
+
+		TUCompilationOptions tu_comp_opts
 		{
-			std::string file_name = fs::path(source_files[i]).stem().string();
-			std::string file_ext = fs::path(source_files[i]).extension().string();
-
-			std::string source_file = source_files[i]; source_file += ".ola";
-			std::string ir_file;
-			if (no_llvm) ir_file = file_name + ".oll";
-			else		 ir_file = file_name + ".ll";
-			std::string assembly_file = file_name + ".s";
-			std::string mir_file = emit_asm ? file_name + ".omll" : "";
-
-			TUCompilationOptions tu_comp_opts
-			{
-				.opt_level = opt_level,
-				.use_llvm_backend = !no_llvm,
-				.dump_ast = ast_dump,
-				.dump_cfg = cfg_dump,
-				.dump_callgraph = callgraph_dump,
-				.dump_domtree = domtree_dump,
-				.print_domfrontier = print_domfrontier,
+			.opt_level = opt_level,
+			.target = compile_request.GetTarget(),
+			.use_llvm_backend = !no_llvm,
+			.emit_object = no_llvm && HostUsesELFObjects,
+			.emit_ir = emit_ir,
+			.emit_ir_binary = emit_ir_binary,
+			.emit_mir = emit_mir,
+			.emit_asm = emit_asm,
+			.dump_ast = ast_dump,
+			.dump_cfg = cfg_dump,
+			.dump_callgraph = callgraph_dump,
+			.dump_domtree = domtree_dump,
+			.print_domfrontier = print_domfrontier,
+			//Jobs go to translation units when there are several of them, otherwise to the function bodies of the only one
+			.ir_gen_thread_count = source_files.size() == 1 ? compile_request.GetJobCount() : 1,
+			.interface_directory = interface_directory.string(),
+		};
+
+		//Cached entries only contain the object file of a single translation unit so requests for any other output always compile
+		std::unique_ptr<CompilationCache> compilation_cache;
+		Uint64 cache_options_hash = 0;
+		Bool const needs_side_outputs = emit_ir || emit_ir_binary || emit_mir || emit_asm || ast_dump || cfg_dump || callgraph_dump || domtree_dump || print_domfrontier;
+		if (!compile_request.GetCacheDirectory().empty() && !needs_side_outputs && !run_jit && !lto)
+		{
+			compilation_cache = std::make_unique<CompilationCache>(compile_request.GetCacheDirectory(), compile_request.GetCacheSize());
+			HashState options_hash;
+			options_hash.Combine(static_cast<Uint64>(opt_level));
+			options_hash.Combine(static_cast<Uint64>(tu_comp_opts.target));
+			options_hash.Combine(tu_comp_opts.use_llvm_backend);
+			options_hash.Combine(tu_comp_opts.emit_object);
+			cache_options_hash = options_hash;
+		}
+		auto CompileAndAssemble = [&](Uint64 i) -> Int
+			{
+				std::string file_name = fs::path(source_files[i]).stem().string();
+
+				std::string source_file = source_files[i]; source_file += ".ola";
+				std::string ir_file;
+				if (no_llvm) ir_file = file_name + ".oll";
+				else		 ir_file = file_name + ".ll";
+				std::string assembly_file = file_name + ".s";
+				std::string mir_file = file_name + ".omll";
+
+				OLA_TIME_REPORT_SCOPE("Translation Unit");
+				Uint64 cache_key = 0;
+				if (compilation_cache)
+				{
+					OLA_TIME_REPORT_SCOPE("Cache Lookup");
+					cache_key = compilation_cache->ComputeKey(source_file, cache_options_hash);
+					if (compilation_cache->Lookup(cache_key, object_files[i])) return 0;
+				}
+
+				FrontendContext context{};
+				std::vector<std::string> dependencies{ source_file };
+				ObjectFile* jit_object = run_jit && !lto ? &jit_objects[i] : nullptr;
+				Int exit_code = 0;
+				try
+				{
+					exit_code = CompileTranslationUnit(context, source_file, ir_file, mir_file, assembly_file, object_files[i], jit_object, lto_module.get(), tu_comp_opts, dependencies);
+				}
+				catch (CompilationAborted const&)
+				{
+					exit_code = OLA_INVALID_SOURCE_CODE;
+				}
+				if (compilation_cache && exit_code == 0)
+				{
+					OLA_TIME_REPORT_SCOPE("Cache Store");
+					compilation_cache->Store(cache_key, dependencies, object_files[i]);
+				}
+				return exit_code;
 			};
-			CompileTranslationUnit(context, source_file, ir_file, mir_file, assembly_file, tu_comp_opts);
 
-			std::string object_file = file_name + ".obj";  
-			object_files[i] = object_file;
-			std::string assembly_cmd = std::format("clang -c {} -o {}", assembly_file, object_file);
-			Int assembly_exit_code = ExecuteCommand(assembly_cmd.c_str());
+		for (Uint64 i = 0; i < source_files.size(); ++i)
+		{
+			object_files[i] = fs::path(source_files[i]).stem().string() + ".obj";
+		}
 
-			if (!emit_ir)
+		//Errors are only recorded by the workers, the first failing translation unit stops the ones that haven't started yet
+		Int compile_exit_code = 0;
+		if (compile_request.GetJobCount() == 1 || source_files.size() == 1)
+		{
+			for (Uint64 i = 0; i < source_files.size() && compile_exit_code == 0; ++i)
 			{
-				Bool deleted = fs::remove(ir_file);
-				OLA_ASSERT(deleted);
+				compile_exit_code = CompileAndAssemble(i);
 			}
-			if (!emit_asm)
+		}
+		else
+		{
+			std::atomic<Bool> compilation_failed = false;
+			ThreadPool thread_pool(compile_request.GetJobCount());
+			std::vector<std::future<Int>> tu_exit_codes;
+			tu_exit_codes.reserve(source_files.size());
+			for (Uint64 i = 0; i < source_files.size(); ++i)
 			{
-				Bool deleted = fs::remove(assembly_file);
-				OLA_ASSERT(deleted);
+				tu_exit_codes.push_back(thread_pool.Submit([&CompileAndAssemble, &compilation_failed, i]() -> Int
+					{
+						if (compilation_failed) return 0;
+						Int exit_code = CompileAndAssemble(i);
+						if (exit_code != 0) compilation_failed = true;
+						return exit_code;
+					}));
 			}
+			for (std::future<Int>& tu_exit_code : tu_exit_codes)
+			{
+				Int exit_code = tu_exit_code.get();
+				if (compile_exit_code == 0) compile_exit_code = exit_code;
+			}
+		}
+		if (compilation_cache)
+		{
+			compilation_cache->Evict();
+			compilation_cache->SaveStats();
+			if (cache_stats) compilation_cache->PrintStats(std::cout);
+		}
+		if (compile_exit_code == OLA_INVALID_SOURCE_CODE)
+		{
+			return OLA_INVALID_SOURCE_CODE;
+		}
+		if (compile_exit_code != 0)
+		{
+			return OLA_INVALID_ASSEMBLY_CODE;
+		}
+
+		if (lto_module)
+		{
+			OLA_TIME_REPORT_SCOPE("Link Time Optimization");
+			lto_module->ir_linker.Finalize();
 
-			if (assembly_exit_code != 0)
+			std::string file_name = fs::path(compile_request.GetOutputFile()).stem().string();
+			object_files = { file_name + ".obj" };
+			ObjectFile* jit_object = run_jit ? &jit_objects[0] : nullptr;
+			if (CompileIRModule(lto_module->ir_module, file_name + ".oll", file_name + ".omll", file_name + ".s", object_files[0], jit_object, tu_comp_opts) != 0)
 			{
 				return OLA_INVALID_ASSEMBLY_CODE;
 			}
@@ -227,15 +469,56 @@ namespace ola
 			GenerateGraphVizImages(input_directory, !no_llvm);
 		}
 		
-		std::string link_cmd = "clang "; 
-		for (auto const& obj_file : object_files) link_cmd += obj_file + " ";
-		link_cmd += OLA_STATIC_LIB_PATH;
-		link_cmd += " -o " + output_file;
-		link_cmd += " -Xlinker /SUBSYSTEM:CONSOLE";
-		ExecuteCommand(link_cmd.c_str());
-
-		std::string const& exe_cmd = output_file;
-		Int res = timeout_detection ? ExecuteCommand_NonBlocking(exe_cmd.c_str(), 1.0f) : ExecuteCommand(exe_cmd.c_str());
+		Int res = 0;
+		if (run_jit)
+		{
+			JITModule jit_module(tu_comp_opts.target == CompilerTarget::x64_SysV ? JITCallingConvention::SystemV : JITCallingConvention::Microsoft);
+			for (ObjectFile& jit_object : jit_objects) jit_module.AddObject(std::move(jit_object));
+			{
+				OLA_TIME_REPORT_SCOPE("JIT Linking");
+				if (!jit_module.Link()) return OLA_INVALID_ASSEMBLY_CODE;
+			}
+			if (!jit_module.GetSymbolAddress("main"))
+			{
+				OLA_ERROR("No main function to run!");
+				return OLA_INVALID_ASSEMBLY_CODE;
+			}
+			OLA_TIME_REPORT_SCOPE("Run (JIT)");
+			res = jit_module.Run();
+		}
+		else
+		{
+			std::string link_cmd = "clang ";
+			for (auto const& obj_file : object_files) link_cmd += obj_file + " ";
+			link_cmd += OLA_STATIC_LIB_PATH;
+			link_cmd += " -o " + output_file;
+			if (tu_comp_opts.target == CompilerTarget::x64_Win64) link_cmd += " -Xlinker /SUBSYSTEM:CONSOLE";
+			else												  link_cmd += " -lm";
+			{
+				OLA_TIME_REPORT_COMMAND_SCOPE("Link (clang)");
+				ExecuteCommand(link_cmd.c_str());
+			}
+
+			std::string exe_cmd = output_file;
+#if !defined(_WIN32)
+			if (fs::path(exe_cmd).is_relative()) exe_cmd = "./" + exe_cmd;
+#endif
+			OLA_TIME_REPORT_COMMAND_SCOPE("Run");
+			res = timeout_detection ? ExecuteCommand_NonBlocking(exe_cmd.c_str(), 1.0f) : ExecuteCommand(exe_cmd.c_str());
+		}
+		if (time_report)
+		{
+			if (compile_request.GetTimeReportFormat() == TimeReportFormat::JSON)
+			{
+				std::string time_report_file = compile_request.GetOutputFile() + ".time-report.json";
+				std::ofstream time_report_stream(time_report_file);
+				g_TimeReport.Print(time_report_stream, TimeReportFormat::JSON);
+			}
+			else
+			{
+				g_TimeReport.Print(std::cout, TimeReportFormat::Text);
+			}
+		}
 		fs::current_path(cur_path);
 		return res;
 
@@ -28,7 +28,9 @@
 
 #endif
 
-#if DEBUG
+#if !defined(_WIN32)
+#define OLA_STATIC_LIB_PATH OLA_BINARY_PATH "libOlaLib.a"
+#elif DEBUG
 #define OLA_STATIC_LIB_PATH OLA_CONCAT(OLA_BINARY_PATH, "Debug/olalib.lib")
 #else 
 #define OLA_STATIC_LIB_PATH OLA_CONCAT(OLA_BINARY_PATH, "Release/olalib.lib")
@@ -15,7 +15,12 @@ namespace ola
 		CompilerFlag_EmitASM = 0x40,
 		CompilerFlag_EmitIR = 0x80,
 		CompilerFlag_EmitMIR = 0x100,
-		CompilerFlag_TimeoutDetection = 0x200
+		CompilerFlag_TimeoutDetection = 0x200,
+		CompilerFlag_TimeReport = 0x400,
+		CompilerFlag_CacheStats = 0x800,
+		CompilerFlag_RunJIT = 0x1000,
+		CompilerFlag_LTO = 0x2000,
+		CompilerFlag_EmitIRBinary = 0x4000
 	};
 	template<>
 	struct EnumBitmaskOperators<CompilerFlags>
@@ -39,4 +44,22 @@ namespace ola
 		Lib
 	};
 
+	enum class CompilerTarget : Uint8
+	{
+		x64_Win64,
+		x64_SysV,
+#if defined(_WIN32)
+		Host = x64_Win64
+#else
+		Host = x64_SysV
+#endif
+	};
+
+	enum class CompilerMode : Uint8
+	{
+		Compile,
+		Serve,
+		Connect
+	};
+
 }
\ No newline at end of file
@@ -9,21 +9,23 @@ namespace ola
 	public:
 		TranslationUnit() = default;
 
-		void AddDecl(UniqueDeclPtr&& declaration)
+		void AddDecl(Decl* declaration)
 		{
-			declarations.push_back(std::move(declaration));
+			declarations.push_back(declaration);
 		}
-		UniqueDeclPtrList const& GetDecls() const { return declarations; }
+		DeclPtrList const& GetDecls() const { return declarations; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 	private:
-		UniqueDeclPtrList declarations;
+		DeclPtrList declarations;
 	};
 	struct AST
 	{
 		AST() { translation_unit = std::make_unique<TranslationUnit>(); }
+		//Owns the memory of every node in the tree
+		ASTContext context;
 		std::unique_ptr<TranslationUnit> translation_unit;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <memory>
+#include <new>
+#include <vector>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+
+namespace ola
+{
+	template<typename T>
+	using ASTSpan = std::span<T* const>;
+
+	//Bump allocator owning the nodes of an AST together with their child lists and names. Nodes are never destroyed
+	//one by one, the memory is released all at once with the context, so nodes can only have trivially destructible members
+	class ASTContext
+	{
+		static constexpr Uint64 SlabSize = 64 * 1024;
+
+	public:
+		ASTContext() = default;
+		OLA_NONCOPYABLE_NONMOVABLE(ASTContext)
+		~ASTContext() = default;
+
+		void* Allocate(Uint64 size, Uint64 alignment)
+		{
+			Uint64 const ptr = OLA_ALIGN_UP(cur_ptr, alignment);
+			if (ptr + size > end_ptr) return AllocateSlow(size, alignment);
+			cur_ptr = ptr + size;
+			return reinterpret_cast<void*>(ptr);
+		}
+
+		template<typename T, typename... Args>
+		T* New(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "AST nodes are not destroyed, they cannot own memory outside of the context!");
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		ASTSpan<T> NewArray(std::vector<T*> const& elements)
+		{
+			if (elements.empty()) return {};
+			T** array = static_cast<T**>(Allocate(elements.size() * sizeof(T*), alignof(T*)));
+			std::copy(elements.begin(), elements.end(), array);
+			return ASTSpan<T>(array, elements.size());
+		}
+
+		std::string_view NewString(std::string_view str)
+		{
+			if (str.empty()) return {};
+			Char* copy = static_cast<Char*>(Allocate(str.size(), alignof(Char)));
+			std::copy(str.begin(), str.end(), copy);
+			return std::string_view(copy, str.size());
+		}
+
+	private:
+		std::vector<std::unique_ptr<Uint8[]>> slabs;
+		Uint64 cur_ptr = 0;
+		Uint64 end_ptr = 0;
+
+	private:
+		void* AllocateSlow(Uint64 size, Uint64 alignment)
+		{
+			Uint64 const slab_size = std::max(SlabSize, size + alignment);
+			Uint8* slab = slabs.emplace_back(new Uint8[slab_size]).get();
+			cur_ptr = reinterpret_cast<Uint64>(slab);
+			end_ptr = cur_ptr + slab_size;
+			return Allocate(size, alignment);
+		}
+	};
+}
\ No newline at end of file
@@ -5,13 +5,14 @@ namespace ola
 {
 	class ASTVisitor;
 
+	//Nodes live in the ASTContext arena and are never destroyed one by one, hence no virtual destructor
 	class ASTNode
 	{
 	public:
-		virtual ~ASTNode() = default;
 		virtual void Accept(ASTVisitor& visitor, Uint32 depth) const {};
 		virtual void Accept(ASTVisitor& visitor) const {}
 	protected:
 		ASTNode() = default;
+		~ASTNode() = default;
 	};
 }
\ No newline at end of file
@@ -32,34 +32,42 @@ namespace ola
 		QualType this_type;
 	};
 
-	void FunctionDecl::SetParamDecls(UniqueParamVarDeclPtrList&& _param_decls)
+	void FunctionDecl::SetParamDecls(ASTSpan<ParamVarDecl> _param_decls)
 	{
-		param_decls = std::move(_param_decls);
-		for (auto& param_decl : param_decls) param_decl->SetParentDecl(this);
+		param_decls = _param_decls;
+		for (ParamVarDecl* param_decl : param_decls) param_decl->SetParentDecl(this);
 	}
-	void FunctionDecl::SetBodyStmt(UniqueCompoundStmtPtr&& _body_stmt)
+	void FunctionDecl::SetBodyStmt(CompoundStmt* _body_stmt)
 	{
-		body_stmt = std::move(_body_stmt);
-		LabelVisitor label_visitor(labels);
-		body_stmt->Accept(label_visitor, 0);
+		body_stmt = _body_stmt;
+	}
+	std::vector<LabelStmt const*> FunctionDecl::GetLabels() const
+	{
+		std::vector<LabelStmt const*> labels;
+		if (body_stmt)
+		{
+			LabelVisitor label_visitor(labels);
+			body_stmt->Accept(label_visitor, 0);
+		}
+		return labels;
 	}
 
-	void ClassDecl::SetFields(UniqueFieldDeclPtrList&& _fields)
+	void ClassDecl::SetFields(ASTSpan<FieldDecl> _fields)
 	{
-		fields = std::move(_fields);
+		fields = _fields;
 		Uint64 field_index_offset = base_class ? base_class->GetFieldCount() : 0;
 		for (Uint32 i = 0; i < fields.size(); ++i)
 		{
-			auto& field = fields[i];
+			FieldDecl* field = fields[i];
 			field->SetParentDecl(this);
 			field->SetFieldIndex(field_index_offset + i);
 		}
 	}
-	void ClassDecl::SetMethods(UniqueMethodDeclPtrList&& _methods)
+	void ClassDecl::SetMethods(ASTSpan<MethodDecl> _methods)
 	{
-		methods = std::move(_methods);
+		methods = _methods;
 		ThisVisitor this_visitor(GetType());
-		for (auto& method : methods)
+		for (MethodDecl* method : methods)
 		{
 			method->SetParentDecl(this);
 			method->Accept(this_visitor, 0);
@@ -72,56 +80,57 @@ namespace ola
 		{
 			if (methods[i]->IsConstructor())
 			{
-				found_decls.push_back(cast<ConstructorDecl>(methods[i].get()));
+				found_decls.push_back(cast<ConstructorDecl>(methods[i]));
 			}
 		}
 		return found_decls;
 	}
-	std::vector<MethodDecl const*> ClassDecl::FindMethodDecls(std::string_view name) const
+	std::vector<MethodDecl const*> ClassDecl::FindMethodDecls(Identifier name) const
 	{
 		std::vector<MethodDecl const*> found_decls;
 		for (Uint32 i = 0; i < methods.size(); ++i)
 		{
-			if (methods[i]->GetName().compare(name) == 0)
+			if (methods[i]->GetIdentifier() == name)
 			{
-				found_decls.push_back(methods[i].get());
+				found_decls.push_back(methods[i]);
 			}
 		}
 		if (found_decls.empty()) return base_class ? base_class->FindMethodDecls(name) : std::vector<MethodDecl const*>{};
 		else return found_decls;
 	}
-	FieldDecl* ClassDecl::FindFieldDecl(std::string_view name) const
+	FieldDecl* ClassDecl::FindFieldDecl(Identifier name) const
 	{
 		for (Uint32 i = 0; i < fields.size(); ++i)
 		{
-			if (fields[i]->GetName().compare(name) == 0)
+			if (fields[i]->GetIdentifier() == name)
 			{
-				return fields[i].get();
+				return fields[i];
 			}
 		}
 		return base_class ? base_class->FindFieldDecl(name) : nullptr;
 	}
 
-	BuildVTableResult ClassDecl::BuildVTable(MethodDecl const*& error_decl)
+	BuildVTableResult ClassDecl::BuildVTable(ASTContext* ast_ctx, MethodDecl const*& error_decl)
 	{
 		polymorphic = IsPolymorphicImpl();
 		if (!polymorphic) return BuildVTableResult::Success;
 		
+		std::vector<MethodDecl const*> vtable_methods;
 		if (base_class)
 		{
-			std::vector<MethodDecl const*> base_vtable = base_class->GetVTable();
-			vtable.reserve(base_vtable.size());
+			ASTSpan<MethodDecl const> base_vtable = base_class->GetVTable();
+			vtable_methods.reserve(base_vtable.size());
 			for (Uint64 i = 0; i < base_vtable.size(); ++i)
 			{
-				base_vtable[i]->SetVTableIndex(vtable.size());
-				vtable.push_back(base_vtable[i]);
+				base_vtable[i]->SetVTableIndex(vtable_methods.size());
+				vtable_methods.push_back(base_vtable[i]);
 			}
 		}
 		for (auto const& method : methods)
 		{
 			if (method->IsVirtual())
 			{
-				auto it = std::find_if(vtable.begin(), vtable.end(),
+				auto it = std::find_if(vtable_methods.begin(), vtable_methods.end(),
 					[&method](MethodDecl const* entry)
 					{
 						if (entry->GetName() != method->GetName()) return false;
@@ -137,24 +146,24 @@ namespace ola
 						return true;
 					});
 
-				if (it != vtable.end())
+				if (it != vtable_methods.end())
 				{
 					if ((*it)->IsFinal())
 					{
-						error_decl = method.get();
+						error_decl = method;
 						return BuildVTableResult::Error_OverrideFinal;
 					}
 					method->SetVTableIndex((*it)->GetVTableIndex());
-					*it = method.get();
+					*it = method;
 				}
 				else
 				{
-					method->SetVTableIndex(vtable.size());
-					vtable.push_back(method.get());
+					method->SetVTableIndex(vtable_methods.size());
+					vtable_methods.push_back(method);
 				}
 			}
 		}
-		for (MethodDecl const* vtable_entry : vtable)
+		for (MethodDecl const* vtable_entry : vtable_methods)
 		{
 			if (vtable_entry->IsPure())
 			{
@@ -162,10 +171,11 @@ namespace ola
 				break;
 			}
 		}
+		vtable = ast_ctx->NewArray(vtable_methods);
 
 		return BuildVTableResult::Success;
 	}
-	std::vector<MethodDecl const*> const& ClassDecl::GetVTable() const
+	ASTSpan<MethodDecl const> ClassDecl::GetVTable() const
 	{
 		OLA_ASSERT(IsPolymorphic());
 		return vtable;
@@ -4,6 +4,7 @@
 #include "Stmt.h"
 #include "Type.h"
 #include "Frontend/SourceLocation.h"
+#include "Frontend/Identifier.h"
 #include "Compiler/RTTI.h"
 
 namespace ola
@@ -35,6 +36,7 @@ namespace ola
 		DeclKind GetDeclKind() const { return decl_kind; }
 		SourceLocation GetLocation() const { return source_loc; }
 		std::string_view GetName() const { return name; }
+		Identifier GetIdentifier() const { return name; }
 
 		void SetType(QualType const& _type) { type = _type; }
 		QualType const& GetType() const { return type; }
@@ -43,6 +45,7 @@ namespace ola
 		{
 			visibility = _visibility;
 		}
+		DeclVisibility GetVisibility() const { return visibility; }
 		Bool IsPublic()  const { return  visibility == DeclVisibility::Public; }
 		Bool IsPrivate() const { return visibility == DeclVisibility::Private; }
 		Bool IsExtern()  const { return  visibility == DeclVisibility::Extern; }
@@ -57,20 +60,20 @@ namespace ola
 
 	private:
 		DeclKind const decl_kind;
-		std::string name;
+		Identifier name;
 		SourceLocation source_loc;
 		QualType type;
 		DeclVisibility visibility = DeclVisibility::None;
 
 	protected:
-		Decl(DeclKind decl_kind, std::string_view name, SourceLocation const& loc)
+		Decl(DeclKind decl_kind, Identifier name, SourceLocation const& loc)
 			: decl_kind(decl_kind), name(name), source_loc(loc) {}
 	};
 
 	class VarDecl : public Decl
 	{
 	public:
-		VarDecl(std::string_view name, SourceLocation const& loc) : Decl(DeclKind::Var, name, loc) {}
+		VarDecl(Identifier name, SourceLocation const& loc) : Decl(DeclKind::Var, name, loc) {}
 
 		void SetGlobal(Bool _is_global)
 		{
@@ -78,11 +81,11 @@ namespace ola
 		}
 		Bool IsGlobal() const { return is_global; }
 
-		void SetInitExpr(UniqueExprPtr&& expr)
+		void SetInitExpr(Expr* expr)
 		{
-			init_expr = std::move(expr);
+			init_expr = expr;
 		}
-		Expr const* GetInitExpr() const { return init_expr.get(); }
+		Expr const* GetInitExpr() const { return init_expr; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
@@ -99,17 +102,17 @@ namespace ola
 			return false;
 		}
 	private:
-		UniqueExprPtr init_expr = nullptr;
+		Expr* init_expr = nullptr;
 		Bool is_global = false;
 
 	protected:
-		VarDecl(DeclKind kind, std::string_view name, SourceLocation const& loc) : Decl(kind, name, loc) {}
+		VarDecl(DeclKind kind, Identifier name, SourceLocation const& loc) : Decl(kind, name, loc) {}
 	};
 
 	class ParamVarDecl final : public VarDecl
 	{
 	public:
-		ParamVarDecl(std::string_view name, SourceLocation const& loc) : VarDecl(DeclKind::ParamVar, name, loc) {}
+		ParamVarDecl(Identifier name, SourceLocation const& loc) : VarDecl(DeclKind::ParamVar, name, loc) {}
 
 		void SetParentDecl(FunctionDecl const* _parent)
 		{
@@ -128,7 +131,7 @@ namespace ola
 	class FieldDecl final : public VarDecl
 	{
 	public:
-		FieldDecl(std::string_view name, SourceLocation const& loc) : VarDecl(DeclKind::Field, name, loc) {}
+		FieldDecl(Identifier name, SourceLocation const& loc) : VarDecl(DeclKind::Field, name, loc) {}
 
 		void SetParentDecl(ClassDecl const* _parent)
 		{
@@ -163,7 +166,8 @@ namespace ola
 		FuncAttribute_NoInline = 0x01,
 		FuncAttribute_Inline = 0x02,
 		FuncAttribute_NoMangle = 0x04,
-		FuncAttribute_NoOpt = 0x08
+		FuncAttribute_NoOpt = 0x08,
+		FuncAttribute_ConstExpr = 0x10
 	};
 	using FuncAttributes = Uint8;
 
@@ -173,14 +177,15 @@ namespace ola
 		static std::string GetTypeMangledName(QualType const&);
 
 	public:
-		FunctionDecl(std::string_view name, SourceLocation const& loc) : Decl(DeclKind::Function, name, loc) {}
+		FunctionDecl(Identifier name, SourceLocation const& loc) : Decl(DeclKind::Function, name, loc) {}
 
-		void SetParamDecls(UniqueParamVarDeclPtrList&& param_decls);
-		void SetBodyStmt(UniqueCompoundStmtPtr&& _body_stmt);
+		void SetParamDecls(ASTSpan<ParamVarDecl> param_decls);
+		void SetBodyStmt(CompoundStmt* _body_stmt);
 		void SetFuncAttributes(FuncAttributes attrs)
 		{
 			func_attributes = attrs;
 		}
+		FuncAttributes GetFuncAttributes() const { return func_attributes; }
 		Bool HasFuncAttribute(FuncAttribute attr) const
 		{
 			return HasAttribute(func_attributes, attr);
@@ -189,13 +194,11 @@ namespace ola
 		Bool IsNoInline() const { return HasFuncAttribute(FuncAttribute_NoInline); }
 		Bool IsNoMangle() const { return HasFuncAttribute(FuncAttribute_NoMangle); }
 		Bool IsNoOpt()    const { return HasFuncAttribute(FuncAttribute_NoOpt); }
+		Bool IsConstexpr() const { return HasFuncAttribute(FuncAttribute_ConstExpr); }
 
-		UniqueParamVarDeclPtrList const& GetParamDecls() const { return param_decls; }
-		CompoundStmt const* GetBodyStmt() const { return body_stmt.get(); }
-		std::vector<LabelStmt const*> const& GetLabels() const
-		{
-			return labels;
-		}
+		ASTSpan<ParamVarDecl> GetParamDecls() const { return param_decls; }
+		CompoundStmt const* GetBodyStmt() const { return body_stmt; }
+		std::vector<LabelStmt const*> GetLabels() const;
 
 		FuncType const* GetFuncType() const
 		{
@@ -224,13 +227,12 @@ namespace ola
 		}
 
 	protected:
-		UniqueParamVarDeclPtrList param_decls;
-		UniqueCompoundStmtPtr body_stmt;
+		ASTSpan<ParamVarDecl> param_decls;
+		CompoundStmt* body_stmt = nullptr;
 		FuncAttributes func_attributes = FuncAttribute_None;
-		std::vector<LabelStmt const*> labels;
 
 	protected:
-		FunctionDecl(DeclKind kind, std::string_view name, SourceLocation const& loc) : Decl(kind, name, loc) {}
+		FunctionDecl(DeclKind kind, Identifier name, SourceLocation const& loc) : Decl(kind, name, loc) {}
 	};
 
 	enum MethodAttribute : Uint8
@@ -246,7 +248,7 @@ namespace ola
 	class MethodDecl : public FunctionDecl
 	{
 	public:
-		MethodDecl(std::string_view name, SourceLocation const& loc) : FunctionDecl(DeclKind::Method, name, loc) {}
+		MethodDecl(Identifier name, SourceLocation const& loc) : FunctionDecl(DeclKind::Method, name, loc) {}
 
 		void SetParentDecl(ClassDecl const* _parent)
 		{
@@ -258,6 +260,7 @@ namespace ola
 		{
 			method_attrs = attrs;
 		}
+		MethodAttributes GetMethodAttributes() const { return method_attrs; }
 		Bool HasMethodAttribute(MethodAttribute attr) const
 		{
 			return HasAttribute(method_attrs, attr);
@@ -292,14 +295,14 @@ namespace ola
 		mutable Uint32 vtable_index = -1;
 
 	protected:
-		MethodDecl(DeclKind kind, std::string_view name, SourceLocation const& loc) : FunctionDecl(kind, name, loc) {}
+		MethodDecl(DeclKind kind, Identifier name, SourceLocation const& loc) : FunctionDecl(kind, name, loc) {}
 
 	};
 
 	class ConstructorDecl final : public MethodDecl
 	{
 	public:
-		ConstructorDecl(std::string_view name, SourceLocation const& loc) : MethodDecl(DeclKind::Constructor, name, loc) {}
+		ConstructorDecl(Identifier name, SourceLocation const& loc) : MethodDecl(DeclKind::Constructor, name, loc) {}
 
 		virtual Bool IsConstructor() const { return true; }
 
@@ -326,19 +329,19 @@ namespace ola
 		}
 
 	protected:
-		TagDecl(DeclKind decl_kind, std::string_view name, SourceLocation const& loc) : Decl(decl_kind, name, loc) {}
+		TagDecl(DeclKind decl_kind, Identifier name, SourceLocation const& loc) : Decl(decl_kind, name, loc) {}
 	};
 
 	class EnumDecl final : public TagDecl
 	{
 	public:
-		EnumDecl(std::string_view name, SourceLocation const& loc) : TagDecl(DeclKind::Enum, name, loc) {}
+		EnumDecl(Identifier name, SourceLocation const& loc) : TagDecl(DeclKind::Enum, name, loc) {}
 
-		void SetEnumMembers(UniqueEnumMemberDeclPtrList&& _enum_members)
+		void SetEnumMembers(ASTSpan<EnumMemberDecl> _enum_members)
 		{
-			enum_members = std::move(_enum_members);
+			enum_members = _enum_members;
 		}
-		UniqueEnumMemberDeclPtrList const& GetEnumMembers() const { return enum_members; }
+		ASTSpan<EnumMemberDecl> GetEnumMembers() const { return enum_members; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
@@ -346,13 +349,13 @@ namespace ola
 		static Bool ClassOf(Decl const* decl) { return decl->GetDeclKind() == DeclKind::Enum; }
 
 	private:
-		UniqueEnumMemberDeclPtrList enum_members;
+		ASTSpan<EnumMemberDecl> enum_members;
 	};
 
 	class EnumMemberDecl final : public Decl
 	{
 	public:
-		EnumMemberDecl(std::string_view name, SourceLocation const& loc) : Decl(DeclKind::EnumMember, name, loc)
+		EnumMemberDecl(Identifier name, SourceLocation const& loc) : Decl(DeclKind::EnumMember, name, loc)
 		{}
 
 		void SetValue(Int64 _value)
@@ -372,7 +375,7 @@ namespace ola
 	class AliasDecl final : public TagDecl
 	{
 	public:
-		AliasDecl(std::string_view name, SourceLocation const& loc, QualType const& aliased_type) : TagDecl(DeclKind::Alias, name, loc)
+		AliasDecl(Identifier name, SourceLocation const& loc, QualType const& aliased_type) : TagDecl(DeclKind::Alias, name, loc)
 		{
 			SetType(aliased_type);
 			SetVisibility(DeclVisibility::Public);
@@ -392,12 +395,12 @@ namespace ola
 	class ClassDecl final : public TagDecl
 	{
 	public:
-		ClassDecl(std::string_view name, SourceLocation const& loc) : TagDecl(DeclKind::Class, name, loc) {}
+		ClassDecl(Identifier name, SourceLocation const& loc) : TagDecl(DeclKind::Class, name, loc) {}
 
-		void SetFields(UniqueFieldDeclPtrList&& _fields);
-		UniqueFieldDeclPtrList const& GetFields() const { return fields; }
-		void SetMethods(UniqueMethodDeclPtrList&& _methods);
-		UniqueMethodDeclPtrList const& GetMethods() const { return methods; }
+		void SetFields(ASTSpan<FieldDecl> _fields);
+		ASTSpan<FieldDecl> GetFields() const { return fields; }
+		void SetMethods(ASTSpan<MethodDecl> _methods);
+		ASTSpan<MethodDecl> GetMethods() const { return methods; }
 		void SetBaseClass(ClassDecl const* _base_class) 
 		{ 
 			base_class  = _base_class;
@@ -405,8 +408,8 @@ namespace ola
 		ClassDecl const* GetBaseClass() const { return base_class; }
 
 		std::vector<ConstructorDecl const*> FindConstructors() const;
-		std::vector<MethodDecl const*> FindMethodDecls(std::string_view name) const;
-		FieldDecl* FindFieldDecl(std::string_view name) const;
+		std::vector<MethodDecl const*> FindMethodDecls(Identifier name) const;
+		FieldDecl* FindFieldDecl(Identifier name) const;
 
 		Uint64 GetFieldCount() const
 		{
@@ -433,8 +436,8 @@ namespace ola
 		Bool IsFinal() const { return final; }
 		void SetFinal(Bool _final) { final = _final; }
 
-		BuildVTableResult BuildVTable(MethodDecl const*& error_decl);
-		std::vector<MethodDecl const*> const& GetVTable() const;
+		BuildVTableResult BuildVTable(ASTContext* ast_ctx, MethodDecl const*& error_decl);
+		ASTSpan<MethodDecl const> GetVTable() const;
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
@@ -443,9 +446,9 @@ namespace ola
 
 	private:
 		ClassDecl const* base_class = nullptr;
-		UniqueFieldDeclPtrList fields;
-		UniqueMethodDeclPtrList methods;
-		std::vector<MethodDecl const*> vtable;
+		ASTSpan<FieldDecl> fields;
+		ASTSpan<MethodDecl> methods;
+		ASTSpan<MethodDecl const> vtable;
 		Bool abstract = false;
 		Bool polymorphic = false;
 		Bool final = false;
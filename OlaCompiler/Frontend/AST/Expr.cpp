@@ -4,7 +4,7 @@
 
 namespace ola
 {
-	DeclRefExpr::DeclRefExpr(Decl const* decl, SourceLocation const& loc) : IdentifierExpr(ExprKind::DeclRef, decl->GetName(), loc), decl(decl)
+	DeclRefExpr::DeclRefExpr(Decl const* decl, SourceLocation const& loc) : IdentifierExpr(ExprKind::DeclRef, decl->GetIdentifier(), loc), decl(decl)
 	{
 		SetType(decl->GetType());
 	}
@@ -3,6 +3,7 @@
 #include "ASTAliases.h"
 #include "Type.h"
 #include "Frontend/SourceLocation.h"
+#include "Frontend/Identifier.h"
 #include "Compiler/RTTI.h"
 
 namespace ola
@@ -88,12 +89,12 @@ namespace ola
 	{
 	public:
 		UnaryExpr(UnaryExprKind op, SourceLocation const& loc) : Expr(ExprKind::Unary, loc), op(op), operand(nullptr) {}
-		void SetOperand(UniqueExprPtr&& _operand)
+		void SetOperand(Expr* _operand)
 		{
-			operand = std::move(_operand);
+			operand = _operand;
 		}
 		UnaryExprKind GetUnaryKind() const { return op; }
-		Expr const* GetOperand() const { return operand.get(); }
+		Expr const* GetOperand() const { return operand; }
 
 		virtual Bool IsConstexpr() const override
 		{ 
@@ -106,19 +107,19 @@ namespace ola
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::Unary; }
 	private:
 		UnaryExprKind op;
-		UniqueExprPtr operand;
+		Expr* operand = nullptr;
 	};
 
 	class BinaryExpr final : public Expr
 	{
 	public:
 		BinaryExpr(BinaryExprKind op, SourceLocation const& loc) : Expr(ExprKind::Binary, loc), op(op) {}
-		void SetLHS(UniqueExprPtr&& _lhs) { lhs = std::move(_lhs); }
-		void SetRHS(UniqueExprPtr&& _rhs) { rhs = std::move(_rhs); }
+		void SetLHS(Expr* _lhs) { lhs = _lhs; }
+		void SetRHS(Expr* _rhs) { rhs = _rhs; }
 
 		BinaryExprKind GetBinaryKind() const { return op; }
-		Expr const* GetLHS() const { return lhs.get(); }
-		Expr const* GetRHS() const { return rhs.get(); }
+		Expr const* GetLHS() const { return lhs; }
+		Expr const* GetRHS() const { return rhs; }
 
 		virtual Bool IsConstexpr() const
 		{
@@ -159,7 +160,8 @@ namespace ola
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::Binary; }
 	private:
-		UniqueExprPtr lhs, rhs;
+		Expr* lhs = nullptr;
+		Expr* rhs = nullptr;
 		BinaryExprKind op;
 	};
 
@@ -169,42 +171,43 @@ namespace ola
 		explicit TernaryExpr(SourceLocation const& loc) : Expr(ExprKind::Ternary, loc)
 		{}
 
-		void SetCondExpr(UniqueExprPtr&& expr) { cond_expr = std::move(expr); }
-		void SetTrueExpr(UniqueExprPtr&& expr) { true_expr = std::move(expr); }
-		void SetFalseExpr(UniqueExprPtr&& expr) { false_expr = std::move(expr); }
+		void SetCondExpr(Expr* expr) { cond_expr = expr; }
+		void SetTrueExpr(Expr* expr) { true_expr = expr; }
+		void SetFalseExpr(Expr* expr) { false_expr = expr; }
 
-		Expr const* GetCondExpr() const { return cond_expr.get(); }
-		Expr const* GetTrueExpr() const { return true_expr.get(); }
-		Expr const* GetFalseExpr() const { return false_expr.get(); }
+		Expr const* GetCondExpr() const { return cond_expr; }
+		Expr const* GetTrueExpr() const { return true_expr; }
+		Expr const* GetFalseExpr() const { return false_expr; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::Ternary; }
 	private:
-		UniqueExprPtr cond_expr;
-		UniqueExprPtr true_expr;
-		UniqueExprPtr false_expr;
+		Expr* cond_expr = nullptr;
+		Expr* true_expr = nullptr;
+		Expr* false_expr = nullptr;
 	};
 
 	class IdentifierExpr : public Expr
 	{
 	public:
-		IdentifierExpr(std::string_view name, SourceLocation const& loc) : Expr(ExprKind::Identifier, loc), name(name)
+		IdentifierExpr(Identifier name, SourceLocation const& loc) : Expr(ExprKind::Identifier, loc), name(name)
 		{
 			SetValueCategory(ExprValueCategory::LValue);
 		}
 		std::string_view GetName() const { return name; }
+		Identifier GetIdentifier() const { return name; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::Identifier || expr->GetExprKind() == ExprKind::DeclRef; }
 	private:
-		std::string name;
+		Identifier name;
 
 	protected:
-		IdentifierExpr(ExprKind kind, std::string_view name, SourceLocation const& loc) : Expr(kind, loc), name(name)
+		IdentifierExpr(ExprKind kind, Identifier name, SourceLocation const& loc) : Expr(kind, loc), name(name)
 		{
 			OLA_ASSERT(kind == ExprKind::DeclRef);
 			SetValueCategory(ExprValueCategory::LValue);
@@ -284,7 +287,7 @@ namespace ola
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::StringLiteral; }
 	private:
-		std::string str;
+		std::string_view str;
 	};
 
 	class BoolLiteral final : public Expr
@@ -331,18 +334,18 @@ namespace ola
 			SetValueCategory(ExprValueCategory::RValue);
 		}
 
-		void SetOperand(UniqueExprPtr&& _operand)
+		void SetOperand(Expr* _operand)
 		{
-			operand = std::move(_operand);
+			operand = _operand;
 		}
-		Expr const* GetOperand() const { return operand.get(); }
+		Expr const* GetOperand() const { return operand; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::ImplicitCast; }
 	private:
-		UniqueExprPtr operand;
+		Expr* operand = nullptr;
 	};
 
 	class CallExpr : public Expr
@@ -351,16 +354,16 @@ namespace ola
 		CallExpr(SourceLocation const& loc, FunctionDecl const* func_decl)
 			: Expr(ExprKind::Call, loc), func_decl(func_decl) {}
 
-		void SetArgs(UniqueExprPtrList&& args)
+		void SetArgs(ASTSpan<Expr> args)
 		{
-			func_args = std::move(args);
+			func_args = args;
 		}
-		UniqueExprPtrList const& GetArgs() const { return func_args; }
-		void SetCallee(UniqueExprPtr&& _callee)
+		ASTSpan<Expr> GetArgs() const { return func_args; }
+		void SetCallee(Expr* _callee)
 		{
-			callee = std::move(_callee);
+			callee = _callee;
 		}
-		Expr const* GetCallee() const { return callee.get(); }
+		Expr const* GetCallee() const { return callee; }
 		FuncType const* GetCalleeType() const
 		{
 			OLA_ASSERT(isa<FuncType>(GetCallee()->GetType()));
@@ -374,8 +377,8 @@ namespace ola
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::Call || expr->GetExprKind() == ExprKind::MethodCall; }
 	protected:
 		FunctionDecl const* func_decl;
-		UniqueExprPtr callee;
-		UniqueExprPtrList func_args;
+		Expr* callee = nullptr;
+		ASTSpan<Expr> func_args;
 
 	protected:
 		CallExpr(ExprKind kind, SourceLocation const& loc, FunctionDecl const* func_decl)
@@ -387,11 +390,11 @@ namespace ola
 	public:
 		explicit InitializerListExpr(SourceLocation const& loc) : Expr(ExprKind::InitializerList, loc) {}
 
-		void SetInitList(UniqueExprPtrList&& _init_list)
+		void SetInitList(ASTSpan<Expr> _init_list)
 		{
-			init_list = std::move(_init_list);
+			init_list = _init_list;
 		}
-		UniqueExprPtrList const& GetInitList() const { return init_list; }
+		ASTSpan<Expr> GetInitList() const { return init_list; }
 		virtual Bool IsConstexpr() const
 		{
 			Bool is_constexpr = true;
@@ -404,7 +407,7 @@ namespace ola
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::InitializerList; }
 	private:
-		UniqueExprPtrList init_list;
+		ASTSpan<Expr> init_list;
 	};
 
 	class ArrayAccessExpr final : public Expr
@@ -415,25 +418,25 @@ namespace ola
 			SetValueCategory(ExprValueCategory::LValue);
 		}
 
-		void SetArrayExpr(UniqueExprPtr&& _array_expr)
+		void SetArrayExpr(Expr* _array_expr)
 		{
-			array_expr = std::move(_array_expr);
+			array_expr = _array_expr;
 		}
-		void SetIndexExpr(UniqueExprPtr&& _bracket_expr)
+		void SetIndexExpr(Expr* _bracket_expr)
 		{
-			bracket_expr = std::move(_bracket_expr);
+			bracket_expr = _bracket_expr;
 		}
 
-		Expr const* GetArrayExpr() const { return array_expr.get(); }
-		Expr const* GetIndexExpr() const { return bracket_expr.get(); }
+		Expr const* GetArrayExpr() const { return array_expr; }
+		Expr const* GetIndexExpr() const { return bracket_expr; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::ArrayAccess; }
 	private:
-		UniqueExprPtr array_expr;
-		UniqueExprPtr bracket_expr;
+		Expr* array_expr = nullptr;
+		Expr* bracket_expr = nullptr;
 	};
 
 	class MemberExpr final : public Expr
@@ -444,11 +447,11 @@ namespace ola
 			SetValueCategory(ExprValueCategory::LValue);
 		}
 
-		void SetClassExpr(UniqueExprPtr&& _class_expr)
+		void SetClassExpr(Expr* _class_expr)
 		{
-			class_expr = std::move(_class_expr);
+			class_expr = _class_expr;
 		}
-		Expr const* GetClassExpr() const { return class_expr.get(); }
+		Expr const* GetClassExpr() const { return class_expr; }
 
 		void SetMemberDecl(Decl const* _decl)
 		{
@@ -461,7 +464,7 @@ namespace ola
 
 		static Bool ClassOf(Expr const* expr) { return expr->GetExprKind() == ExprKind::Member; }
 	private:
-		UniqueExprPtr class_expr;
+		Expr* class_expr = nullptr;
 		Decl const* decl;
 	};
 
@@ -519,11 +522,11 @@ namespace ola
 	public:
 		ConstructorExpr(SourceLocation const& loc, ConstructorDecl const* ctor_decl) : Expr(ExprKind::Ctor, loc), ctor_decl(ctor_decl) {}
 
-		void SetArgs(UniqueExprPtrList&& args)
+		void SetArgs(ASTSpan<Expr> args)
 		{
-			ctor_args = std::move(args);
+			ctor_args = args;
 		}
-		UniqueExprPtrList const& GetArgs() const { return ctor_args; }
+		ASTSpan<Expr> GetArgs() const { return ctor_args; }
 		ConstructorDecl const* GetCtorDecl() const { return ctor_decl; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
@@ -533,6 +536,6 @@ namespace ola
 
 	private:
 		ConstructorDecl const* ctor_decl;
-		UniqueExprPtrList ctor_args;
+		ASTSpan<Expr> ctor_args;
 	};
 }
\ No newline at end of file
@@ -50,32 +50,28 @@ namespace ola
 	class CompoundStmt final : public Stmt
 	{
 	public:
-		CompoundStmt(UniqueStmtPtrList&& stmts) : Stmt(StmtKind::Compound), statements(std::move(stmts)) {}
-		UniqueStmtPtrList const& GetStmts() const { return statements; }
+		explicit CompoundStmt(ASTSpan<Stmt> stmts) : Stmt(StmtKind::Compound), statements(stmts) {}
 
-		void AddBeginStmt(UniqueStmtPtr&& stmt)
+		void SetStmts(ASTSpan<Stmt> stmts)
 		{
-			statements.insert(std::begin(statements), std::move(stmt));
+			statements = stmts;
 		}
+		ASTSpan<Stmt> GetStmts() const { return statements; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::Compound; }
 	private:
-		UniqueStmtPtrList statements;
+		ASTSpan<Stmt> statements;
 	};
 
 	class DeclStmt final : public Stmt
 	{
 	public:
-		DeclStmt(UniqueDeclPtr&& decl) : Stmt(StmtKind::Decl), declarations{}
-		{
-			declarations.push_back(std::move(decl));
-		}
-		DeclStmt(UniqueDeclPtrList&& decls) : Stmt(StmtKind::Decl), declarations(std::move(decls)) {}
+		explicit DeclStmt(ASTSpan<Decl> decls) : Stmt(StmtKind::Decl), declarations(decls) {}
 
-		UniqueDeclPtrList const& GetDecls() const { return declarations; }
+		ASTSpan<Decl> GetDecls() const { return declarations; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
@@ -83,23 +79,22 @@ namespace ola
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::Decl; }
 
 	private:
-		UniqueDeclPtrList declarations;
+		ASTSpan<Decl> declarations;
 	};
 
 	class ExprStmt : public Stmt
 	{
 	public:
 
-		ExprStmt(UniqueExprPtr&& expr) : Stmt(expr ? StmtKind::Expr : StmtKind::Null), expr(std::move(expr)) {}
+		ExprStmt(Expr* expr) : Stmt(expr ? StmtKind::Expr : StmtKind::Null), expr(expr) {}
 
 		Expr const* GetExpr() const
 		{
-			return expr.get();
+			return expr;
 		}
-
-		Expr* ReleaseExpr()
+		Expr* GetExpr()
 		{
-			return expr.release();
+			return expr;
 		}
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
@@ -107,7 +102,7 @@ namespace ola
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::Expr || stmt->GetStmtKind() == StmtKind::Null; }
 	private:
-		UniqueExprPtr expr;
+		Expr* expr = nullptr;
 	};
 
 	class NullStmt final : public ExprStmt
@@ -124,17 +119,17 @@ namespace ola
 	class ReturnStmt final : public Stmt
 	{
 	public:
-		explicit ReturnStmt(std::unique_ptr<ExprStmt>&& ret_expr)
-			: Stmt(StmtKind::Return), ret_expr(std::move(ret_expr)) {}
+		explicit ReturnStmt(ExprStmt* ret_expr)
+			: Stmt(StmtKind::Return), ret_expr(ret_expr) {}
 
-		ExprStmt const* GetExprStmt() const { return ret_expr.get(); }
+		ExprStmt const* GetExprStmt() const { return ret_expr; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::Return; }
 	private:
-		UniqueExprStmtPtr ret_expr;
+		ExprStmt* ret_expr = nullptr;
 	};
 
 	class IfStmt final : public Stmt
@@ -142,31 +137,31 @@ namespace ola
 	public:
 		IfStmt() : Stmt(StmtKind::If) {}
 
-		void SetConditionExpr(UniqueExprPtr&& _condition)
+		void SetConditionExpr(Expr* _condition)
 		{
-			cond_expr = std::move(_condition);
+			cond_expr = _condition;
 		}
-		void SetThenStmt(UniqueStmtPtr&& _then_stmt)
+		void SetThenStmt(Stmt* _then_stmt)
 		{
-			then_stmt = std::move(_then_stmt);
+			then_stmt = _then_stmt;
 		}
-		void SetElseStmt(UniqueStmtPtr&& _else_stmt)
+		void SetElseStmt(Stmt* _else_stmt)
 		{
-			else_stmt = std::move(_else_stmt);
+			else_stmt = _else_stmt;
 		}
 
-		Expr const* GetCondExpr() const { return cond_expr.get(); }
-		Stmt const* GetThenStmt() const { return then_stmt.get(); }
-		Stmt const* GetElseStmt() const { return else_stmt.get(); }
+		Expr const* GetCondExpr() const { return cond_expr; }
+		Stmt const* GetThenStmt() const { return then_stmt; }
+		Stmt const* GetElseStmt() const { return else_stmt; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::If; }
 	private:
-		UniqueExprPtr cond_expr;
-		UniqueStmtPtr then_stmt;
-		UniqueStmtPtr else_stmt;
+		Expr* cond_expr = nullptr;
+		Stmt* then_stmt = nullptr;
+		Stmt* else_stmt = nullptr;
 	};
 
 	class BreakStmt final : public Stmt
@@ -196,37 +191,37 @@ namespace ola
 	public:
 		ForStmt() : Stmt(StmtKind::For) {}
 
-		void SetInitStmt(UniqueStmtPtr&& _init_stmt)
+		void SetInitStmt(Stmt* _init_stmt)
 		{
-			init_stmt = std::move(_init_stmt);
+			init_stmt = _init_stmt;
 		}
-		void SetCondExpr(UniqueExprPtr&& _cond_expr)
+		void SetCondExpr(Expr* _cond_expr)
 		{
-			cond_expr = std::move(_cond_expr);
+			cond_expr = _cond_expr;
 		}
-		void SetIterExpr(UniqueExprPtr&& _iter_expr)
+		void SetIterExpr(Expr* _iter_expr)
 		{
-			iter_expr = std::move(_iter_expr);
+			iter_expr = _iter_expr;
 		}
-		void SetBodyStmt(UniqueStmtPtr&& _body_stmt)
+		void SetBodyStmt(Stmt* _body_stmt)
 		{
-			body_stmt = std::move(_body_stmt);
+			body_stmt = _body_stmt;
 		}
 
-		Stmt const* GetInitStmt() const { return init_stmt.get(); }
-		Expr const* GetCondExpr() const { return cond_expr.get(); }
-		Expr const* GetIterExpr() const { return iter_expr.get(); }
-		Stmt const* GetBodyStmt() const { return body_stmt.get(); }
+		Stmt const* GetInitStmt() const { return init_stmt; }
+		Expr const* GetCondExpr() const { return cond_expr; }
+		Expr const* GetIterExpr() const { return iter_expr; }
+		Stmt const* GetBodyStmt() const { return body_stmt; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::For; }
 	private:
-		UniqueStmtPtr init_stmt;
-		UniqueExprPtr cond_expr;
-		UniqueExprPtr iter_expr;
-		UniqueStmtPtr body_stmt;
+		Stmt* init_stmt = nullptr;
+		Expr* cond_expr = nullptr;
+		Expr* iter_expr = nullptr;
+		Stmt* body_stmt = nullptr;
 	};
 
 	class WhileStmt final : public Stmt
@@ -234,25 +229,25 @@ namespace ola
 	public:
 		WhileStmt() : Stmt(StmtKind::While) {}
 
-		void SetCondExpr(UniqueExprPtr&& _cond_expr)
+		void SetCondExpr(Expr* _cond_expr)
 		{
-			cond_expr = std::move(_cond_expr);
+			cond_expr = _cond_expr;
 		}
-		void SetBodyStmt(UniqueStmtPtr&& _body_stmt)
+		void SetBodyStmt(Stmt* _body_stmt)
 		{
-			body_stmt = std::move(_body_stmt);
+			body_stmt = _body_stmt;
 		}
 
-		Expr const* GetCondExpr() const { return cond_expr.get(); }
-		Stmt const* GetBodyStmt() const { return body_stmt.get(); }
+		Expr const* GetCondExpr() const { return cond_expr; }
+		Stmt const* GetBodyStmt() const { return body_stmt; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::While; }
 	private:
-		UniqueExprPtr cond_expr;
-		UniqueStmtPtr body_stmt;
+		Expr* cond_expr = nullptr;
+		Stmt* body_stmt = nullptr;
 	};
 
 	class DoWhileStmt final : public Stmt
@@ -260,25 +255,25 @@ namespace ola
 	public:
 		DoWhileStmt() : Stmt(StmtKind::DoWhile) {}
 
-		void SetCondExpr(UniqueExprPtr&& _cond_expr)
+		void SetCondExpr(Expr* _cond_expr)
 		{
-			cond_expr = std::move(_cond_expr);
+			cond_expr = _cond_expr;
 		}
-		void SetBodyStmt(UniqueStmtPtr&& _body_stmt)
+		void SetBodyStmt(Stmt* _body_stmt)
 		{
-			body_stmt = std::move(_body_stmt);
+			body_stmt = _body_stmt;
 		}
 
-		Expr const* GetCondExpr() const { return cond_expr.get(); }
-		Stmt const* GetBodyStmt() const { return body_stmt.get(); }
+		Expr const* GetCondExpr() const { return cond_expr; }
+		Stmt const* GetBodyStmt() const { return body_stmt; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::DoWhile; }
 	private:
-		UniqueExprPtr cond_expr;
-		UniqueStmtPtr body_stmt;
+		Expr* cond_expr = nullptr;
+		Stmt* body_stmt = nullptr;
 	};
 
 	class CaseStmt final : public Stmt
@@ -304,25 +299,25 @@ namespace ola
 	public:
 		SwitchStmt() : Stmt(StmtKind::Switch) {}
 
-		void SetCondExpr(UniqueExprPtr&& _cond_expr)
+		void SetCondExpr(Expr* _cond_expr)
 		{
-			cond_expr = std::move(_cond_expr);
+			cond_expr = _cond_expr;
 		}
-		void SetBodyStmt(UniqueStmtPtr&& _body_stmt)
+		void SetBodyStmt(Stmt* _body_stmt)
 		{
-			body_stmt = std::move(_body_stmt);
+			body_stmt = _body_stmt;
 		}
 
-		Expr const* GetCondExpr() const { return cond_expr.get(); }
-		Stmt const* GetBodyStmt() const { return body_stmt.get(); }
+		Expr const* GetCondExpr() const { return cond_expr; }
+		Stmt const* GetBodyStmt() const { return body_stmt; }
 
 		virtual void Accept(ASTVisitor&, Uint32) const override;
 		virtual void Accept(ASTVisitor&) const override;
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::Switch; }
 	private:
-		UniqueExprPtr cond_expr;
-		UniqueStmtPtr body_stmt;
+		Expr* cond_expr = nullptr;
+		Stmt* body_stmt = nullptr;
 	};
 
 	class LabelStmt final : public Stmt
@@ -336,7 +331,7 @@ namespace ola
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::Label; }
 	private:
-		std::string label_name;
+		std::string_view label_name;
 	};
 
 	class GotoStmt final : public Stmt
@@ -350,6 +345,6 @@ namespace ola
 
 		static Bool ClassOf(Stmt const* stmt) { return stmt->GetStmtKind() == StmtKind::Goto; }
 	private:
-		std::string label_name;
+		std::string_view label_name;
 	};
 }
\ No newline at end of file
@@ -4,11 +4,6 @@
 
 namespace ola
 {
-	Bool QualType::operator==(QualType const& o) const
-	{
-		return type == o.type && qualifiers == o.qualifiers;
-	}
-
 	Bool RefType::IsAssignableFrom(Type const* other) const
 	{
 		return this == other || type->IsAssignableFrom(other);
@@ -51,7 +51,13 @@ namespace ola
 			type = _type;
 		}
 
-		Bool operator==(QualType const& o) const;
+		Qualifiers GetQualifiers() const { return qualifiers; }
+
+		//Types are unique, comparing them never needs to look past the pointer
+		Bool operator==(QualType const& o) const
+		{
+			return type == o.type && qualifiers == o.qualifiers;
+		}
 		Bool operator!=(QualType const& o) const
 		{
 			return !(*this == o);
@@ -0,0 +1,434 @@
+#include <cmath>
+#include <limits>
+#include "ConstantEvaluator.h"
+#include "AST/Decl.h"
+#include "AST/Stmt.h"
+#include "AST/Expr.h"
+
+namespace ola
+{
+	namespace
+	{
+		ConstantValue MakeIntegral(TypeKind kind, Int64 value)
+		{
+			return ConstantValue{ .kind = kind, .int_value = value };
+		}
+		ConstantValue MakeFloat(Float64 value)
+		{
+			return ConstantValue{ .kind = TypeKind::Float, .float_value = value };
+		}
+		Bool IsTrue(ConstantValue const& value)
+		{
+			return value.IsFloat() ? value.float_value != 0.0 : value.int_value != 0;
+		}
+		Float64 AsFloat(ConstantValue const& value)
+		{
+			return value.IsFloat() ? value.float_value : static_cast<Float64>(value.int_value);
+		}
+		//Integer arithmetic wraps like it does at runtime
+		Int64 WrappingAdd(Int64 lhs, Int64 rhs) { return static_cast<Int64>(static_cast<Uint64>(lhs) + static_cast<Uint64>(rhs)); }
+		Int64 WrappingSub(Int64 lhs, Int64 rhs) { return static_cast<Int64>(static_cast<Uint64>(lhs) - static_cast<Uint64>(rhs)); }
+		Int64 WrappingMul(Int64 lhs, Int64 rhs) { return static_cast<Int64>(static_cast<Uint64>(lhs) * static_cast<Uint64>(rhs)); }
+	}
+
+	std::optional<ConstantValue> ConstantEvaluator::Evaluate(Expr const* expr)
+	{
+		OLA_ASSERT(frames.empty());
+		steps = 0;
+		return EvaluateExpr(expr);
+	}
+
+	std::optional<Int64> ConstantEvaluator::EvaluateIntegral(Expr const* expr)
+	{
+		std::optional<ConstantValue> value = Evaluate(expr);
+		if (!value || !value->IsIntegral()) return std::nullopt;
+		return value->int_value;
+	}
+
+	std::optional<ConstantValue> ConstantEvaluator::EvaluateExpr(Expr const* expr)
+	{
+		if (!expr || ++steps > MaxSteps) return std::nullopt;
+		switch (expr->GetExprKind())
+		{
+		case ExprKind::IntLiteral:
+			return MakeIntegral(TypeKind::Int, cast<IntLiteral>(expr)->GetValue());
+		case ExprKind::CharLiteral:
+			return MakeIntegral(TypeKind::Char, cast<CharLiteral>(expr)->GetChar());
+		case ExprKind::BoolLiteral:
+			return MakeIntegral(TypeKind::Bool, cast<BoolLiteral>(expr)->GetValue());
+		case ExprKind::FloatLiteral:
+			return MakeFloat(cast<FloatLiteral>(expr)->GetValue());
+		case ExprKind::DeclRef:
+			return EvaluateDecl(cast<DeclRefExpr>(expr)->GetDecl());
+		case ExprKind::ImplicitCast:
+		{
+			std::optional<ConstantValue> operand = EvaluateExpr(cast<ImplicitCastExpr>(expr)->GetOperand());
+			if (!operand) return std::nullopt;
+			return Convert(*operand, expr->GetType());
+		}
+		case ExprKind::Unary:
+			return EvaluateUnaryExpr(cast<UnaryExpr>(expr));
+		case ExprKind::Binary:
+			return EvaluateBinaryExpr(cast<BinaryExpr>(expr));
+		case ExprKind::Ternary:
+		{
+			TernaryExpr const* ternary_expr = cast<TernaryExpr>(expr);
+			std::optional<ConstantValue> condition = EvaluateExpr(ternary_expr->GetCondExpr());
+			if (!condition) return std::nullopt;
+			std::optional<ConstantValue> result = EvaluateExpr(IsTrue(*condition) ? ternary_expr->GetTrueExpr() : ternary_expr->GetFalseExpr());
+			if (!result) return std::nullopt;
+			return Convert(*result, expr->GetType());
+		}
+		case ExprKind::Call:
+			return EvaluateCallExpr(cast<CallExpr>(expr));
+		default:
+			return std::nullopt;
+		}
+	}
+
+	std::optional<ConstantValue> ConstantEvaluator::EvaluateUnaryExpr(UnaryExpr const* unary_expr)
+	{
+		QualType const& type = unary_expr->GetType();
+		UnaryExprKind const op = unary_expr->GetUnaryKind();
+		switch (op)
+		{
+		case UnaryExprKind::PreIncrement:
+		case UnaryExprKind::PreDecrement:
+		case UnaryExprKind::PostIncrement:
+		case UnaryExprKind::PostDecrement:
+		{
+			ConstantValue* variable = FindVariable(unary_expr->GetOperand());
+			if (!variable) return std::nullopt;
+
+			Bool const increment = op == UnaryExprKind::PreIncrement || op == UnaryExprKind::PostIncrement;
+			ConstantValue const old_value = *variable;
+			ConstantValue new_value = old_value;
+			if (new_value.IsFloat()) new_value.float_value += increment ? 1.0 : -1.0;
+			else new_value.int_value = WrappingAdd(new_value.int_value, increment ? 1 : -1);
+
+			std::optional<ConstantValue> converted_value = Convert(new_value, type);
+			if (!converted_value) return std::nullopt;
+			*variable = *converted_value;
+			Bool const prefix = op == UnaryExprKind::PreIncrement || op == UnaryExprKind::PreDecrement;
+			return prefix ? *converted_value : old_value;
+		}
+		default:
+			break;
+		}
+
+		std::optional<ConstantValue> operand = EvaluateExpr(unary_expr->GetOperand());
+		if (!operand) return std::nullopt;
+		ConstantValue result = *operand;
+		switch (op)
+		{
+		case UnaryExprKind::Plus:
+			break;
+		case UnaryExprKind::Minus:
+			if (result.IsFloat()) result.float_value = -result.float_value;
+			else result.int_value = WrappingSub(0, result.int_value);
+			break;
+		case UnaryExprKind::BitNot:
+			if (result.IsFloat()) return std::nullopt;
+			result.int_value = ~result.int_value;
+			break;
+		case UnaryExprKind::LogicalNot:
+			result = MakeIntegral(TypeKind::Bool, !IsTrue(result));
+			break;
+		default:
+			return std::nullopt;
+		}
+		return Convert(result, type);
+	}
+
+	std::optional<ConstantValue> ConstantEvaluator::EvaluateBinaryExpr(BinaryExpr const* binary_expr)
+	{
+		QualType const& type = binary_expr->GetType();
+		BinaryExprKind const op = binary_expr->GetBinaryKind();
+		switch (op)
+		{
+		case BinaryExprKind::Assign:
+		{
+			ConstantValue* variable = FindVariable(binary_expr->GetLHS());
+			if (!variable) return std::nullopt;
+			std::optional<ConstantValue> value = EvaluateExpr(binary_expr->GetRHS());
+			if (!value) return std::nullopt;
+			std::optional<ConstantValue> converted_value = Convert(*value, binary_expr->GetLHS()->GetType());
+			if (!converted_value) return std::nullopt;
+			*variable = *converted_value;
+			return converted_value;
+		}
+		case BinaryExprKind::Comma:
+		{
+			if (!EvaluateExpr(binary_expr->GetLHS())) return std::nullopt;
+			return EvaluateExpr(binary_expr->GetRHS());
+		}
+		case BinaryExprKind::LogicalAnd:
+		case BinaryExprKind::LogicalOr:
+		{
+			std::optional<ConstantValue> lhs = EvaluateExpr(binary_expr->GetLHS());
+			if (!lhs) return std::nullopt;
+			Bool const lhs_true = IsTrue(*lhs);
+			if (op == BinaryExprKind::LogicalAnd && !lhs_true) return MakeIntegral(TypeKind::Bool, false);
+			if (op == BinaryExprKind::LogicalOr && lhs_true) return MakeIntegral(TypeKind::Bool, true);
+			std::optional<ConstantValue> rhs = EvaluateExpr(binary_expr->GetRHS());
+			if (!rhs) return std::nullopt;
+			return MakeIntegral(TypeKind::Bool, IsTrue(*rhs));
+		}
+		default:
+			break;
+		}
+
+		std::optional<ConstantValue> lhs = EvaluateExpr(binary_expr->GetLHS());
+		if (!lhs) return std::nullopt;
+		std::optional<ConstantValue> rhs = EvaluateExpr(binary_expr->GetRHS());
+		if (!rhs) return std::nullopt;
+
+		Bool const is_float = lhs->IsFloat() || rhs->IsFloat();
+		switch (op)
+		{
+		case BinaryExprKind::Equal:			return MakeIntegral(TypeKind::Bool, is_float ? AsFloat(*lhs) == AsFloat(*rhs) : lhs->int_value == rhs->int_value);
+		case BinaryExprKind::NotEqual:		return MakeIntegral(TypeKind::Bool, is_float ? AsFloat(*lhs) != AsFloat(*rhs) : lhs->int_value != rhs->int_value);
+		case BinaryExprKind::Less:			return MakeIntegral(TypeKind::Bool, is_float ? AsFloat(*lhs) <  AsFloat(*rhs) : lhs->int_value <  rhs->int_value);
+		case BinaryExprKind::Greater:		return MakeIntegral(TypeKind::Bool, is_float ? AsFloat(*lhs) >  AsFloat(*rhs) : lhs->int_value >  rhs->int_value);
+		case BinaryExprKind::LessEqual:		return MakeIntegral(TypeKind::Bool, is_float ? AsFloat(*lhs) <= AsFloat(*rhs) : lhs->int_value <= rhs->int_value);
+		case BinaryExprKind::GreaterEqual:	return MakeIntegral(TypeKind::Bool, is_float ? AsFloat(*lhs) >= AsFloat(*rhs) : lhs->int_value >= rhs->int_value);
+		default:
+			break;
+		}
+
+		//Arithmetic on bools has no well defined result to fold to
+		if (type.IsNull() || isa<BoolType>(type)) return std::nullopt;
+		if (is_float)
+		{
+			Float64 const lhs_value = AsFloat(*lhs);
+			Float64 const rhs_value = AsFloat(*rhs);
+			switch (op)
+			{
+			case BinaryExprKind::Add:		return Convert(MakeFloat(lhs_value + rhs_value), type);
+			case BinaryExprKind::Subtract:	return Convert(MakeFloat(lhs_value - rhs_value), type);
+			case BinaryExprKind::Multiply:	return Convert(MakeFloat(lhs_value * rhs_value), type);
+			case BinaryExprKind::Divide:	return Convert(MakeFloat(lhs_value / rhs_value), type);
+			default:
+				return std::nullopt;
+			}
+		}
+
+		Int64 const lhs_value = lhs->int_value;
+		Int64 const rhs_value = rhs->int_value;
+		Int64 result = 0;
+		switch (op)
+		{
+		case BinaryExprKind::Add:		result = WrappingAdd(lhs_value, rhs_value); break;
+		case BinaryExprKind::Subtract:	result = WrappingSub(lhs_value, rhs_value); break;
+		case BinaryExprKind::Multiply:	result = WrappingMul(lhs_value, rhs_value); break;
+		case BinaryExprKind::Divide:
+		case BinaryExprKind::Modulo:
+			if (rhs_value == 0 || (lhs_value == std::numeric_limits<Int64>::min() && rhs_value == -1)) return std::nullopt;
+			result = op == BinaryExprKind::Divide ? lhs_value / rhs_value : lhs_value % rhs_value;
+			break;
+		case BinaryExprKind::ShiftLeft:
+		case BinaryExprKind::ShiftRight:
+			if (rhs_value < 0 || rhs_value >= 64) return std::nullopt;
+			result = op == BinaryExprKind::ShiftLeft ? static_cast<Int64>(static_cast<Uint64>(lhs_value) << rhs_value) : lhs_value >> rhs_value;
+			break;
+		case BinaryExprKind::BitAnd:	result = lhs_value & rhs_value; break;
+		case BinaryExprKind::BitOr:		result = lhs_value | rhs_value; break;
+		case BinaryExprKind::BitXor:	result = lhs_value ^ rhs_value; break;
+		default:
+			return std::nullopt;
+		}
+		return Convert(MakeIntegral(TypeKind::Int, result), type);
+	}
+
+	std::optional<ConstantValue> ConstantEvaluator::EvaluateCallExpr(CallExpr const* call_expr)
+	{
+		FunctionDecl const* function_decl = call_expr->GetFunctionDecl();
+		if (!function_decl || !function_decl->IsConstexpr() || !function_decl->HasDefinition()) return std::nullopt;
+		if (frames.size() >= MaxCallDepth) return std::nullopt;
+
+		ASTSpan<ParamVarDecl> param_decls = function_decl->GetParamDecls();
+		ASTSpan<Expr> args = call_expr->GetArgs();
+		if (param_decls.size() != args.size()) return std::nullopt;
+
+		Frame frame;
+		for (Uint64 i = 0; i < args.size(); ++i)
+		{
+			std::optional<ConstantValue> arg = EvaluateExpr(args[i]);
+			if (!arg) return std::nullopt;
+			std::optional<ConstantValue> param = Convert(*arg, param_decls[i]->GetType());
+			if (!param) return std::nullopt;
+			frame[param_decls[i]] = *param;
+		}
+
+		frames.push_back(std::move(frame));
+		ExecResult const result = Execute(function_decl->GetBodyStmt());
+		frames.pop_back();
+		if (result != ExecResult::Return) return std::nullopt;
+		return Convert(return_value, call_expr->GetType());
+	}
+
+	std::optional<ConstantValue> ConstantEvaluator::EvaluateDecl(Decl const* decl)
+	{
+		if (!frames.empty())
+		{
+			if (auto it = frames.back().find(decl); it != frames.back().end()) return it->second;
+		}
+		if (EnumMemberDecl const* enum_member_decl = dyn_cast<EnumMemberDecl>(decl))
+		{
+			return MakeIntegral(TypeKind::Int, enum_member_decl->GetValue());
+		}
+		if (decl->GetDeclKind() == DeclKind::Var && decl->GetType().IsConst())
+		{
+			VarDecl const* var_decl = cast<VarDecl>(decl);
+			std::optional<ConstantValue> init_value = EvaluateExpr(var_decl->GetInitExpr());
+			if (!init_value) return std::nullopt;
+			return Convert(*init_value, var_decl->GetType());
+		}
+		return std::nullopt;
+	}
+
+	ConstantEvaluator::ExecResult ConstantEvaluator::Execute(Stmt const* stmt)
+	{
+		if (!stmt || ++steps > MaxSteps) return ExecResult::Failure;
+		switch (stmt->GetStmtKind())
+		{
+		case StmtKind::Compound:
+		{
+			for (Stmt const* child_stmt : cast<CompoundStmt>(stmt)->GetStmts())
+			{
+				ExecResult const result = Execute(child_stmt);
+				if (result != ExecResult::Normal) return result;
+			}
+			return ExecResult::Normal;
+		}
+		case StmtKind::Null:
+		case StmtKind::Expr:
+		{
+			Expr const* expr = cast<ExprStmt>(stmt)->GetExpr();
+			if (expr && !EvaluateExpr(expr)) return ExecResult::Failure;
+			return ExecResult::Normal;
+		}
+		case StmtKind::Decl:
+		{
+			for (Decl const* decl : cast<DeclStmt>(stmt)->GetDecls())
+			{
+				if (decl->GetDeclKind() != DeclKind::Var) return ExecResult::Failure;
+				VarDecl const* var_decl = cast<VarDecl>(decl);
+
+				std::optional<ConstantValue> init_value = MakeIntegral(TypeKind::Int, 0);
+				if (Expr const* init_expr = var_decl->GetInitExpr()) init_value = EvaluateExpr(init_expr);
+				if (!init_value) return ExecResult::Failure;
+				std::optional<ConstantValue> value = Convert(*init_value, var_decl->GetType());
+				if (!value) return ExecResult::Failure;
+				frames.back()[var_decl] = *value;
+			}
+			return ExecResult::Normal;
+		}
+		case StmtKind::Return:
+		{
+			ExprStmt const* return_expr_stmt = cast<ReturnStmt>(stmt)->GetExprStmt();
+			std::optional<ConstantValue> value = EvaluateExpr(return_expr_stmt ? return_expr_stmt->GetExpr() : nullptr);
+			if (!value) return ExecResult::Failure;
+			return_value = *value;
+			return ExecResult::Return;
+		}
+		case StmtKind::If:
+		{
+			IfStmt const* if_stmt = cast<IfStmt>(stmt);
+			std::optional<ConstantValue> condition = EvaluateExpr(if_stmt->GetCondExpr());
+			if (!condition) return ExecResult::Failure;
+			if (IsTrue(*condition)) return Execute(if_stmt->GetThenStmt());
+			return if_stmt->GetElseStmt() ? Execute(if_stmt->GetElseStmt()) : ExecResult::Normal;
+		}
+		case StmtKind::While:
+		{
+			WhileStmt const* while_stmt = cast<WhileStmt>(stmt);
+			while (true)
+			{
+				std::optional<ConstantValue> condition = EvaluateExpr(while_stmt->GetCondExpr());
+				if (!condition) return ExecResult::Failure;
+				if (!IsTrue(*condition)) break;
+
+				ExecResult const result = Execute(while_stmt->GetBodyStmt());
+				if (result == ExecResult::Break) break;
+				if (result == ExecResult::Return || result == ExecResult::Failure) return result;
+			}
+			return ExecResult::Normal;
+		}
+		case StmtKind::DoWhile:
+		{
+			DoWhileStmt const* do_while_stmt = cast<DoWhileStmt>(stmt);
+			while (true)
+			{
+				ExecResult const result = Execute(do_while_stmt->GetBodyStmt());
+				if (result == ExecResult::Break) break;
+				if (result == ExecResult::Return || result == ExecResult::Failure) return result;
+
+				std::optional<ConstantValue> condition = EvaluateExpr(do_while_stmt->GetCondExpr());
+				if (!condition) return ExecResult::Failure;
+				if (!IsTrue(*condition)) break;
+			}
+			return ExecResult::Normal;
+		}
+		case StmtKind::For:
+		{
+			ForStmt const* for_stmt = cast<ForStmt>(stmt);
+			if (for_stmt->GetInitStmt() && Execute(for_stmt->GetInitStmt()) != ExecResult::Normal) return ExecResult::Failure;
+			while (true)
+			{
+				if (Expr const* cond_expr = for_stmt->GetCondExpr())
+				{
+					std::optional<ConstantValue> condition = EvaluateExpr(cond_expr);
+					if (!condition) return ExecResult::Failure;
+					if (!IsTrue(*condition)) break;
+				}
+
+				ExecResult const result = Execute(for_stmt->GetBodyStmt());
+				if (result == ExecResult::Break) break;
+				if (result == ExecResult::Return || result == ExecResult::Failure) return result;
+
+				if (Expr const* iter_expr = for_stmt->GetIterExpr(); iter_expr && !EvaluateExpr(iter_expr)) return ExecResult::Failure;
+			}
+			return ExecResult::Normal;
+		}
+		case StmtKind::Break:
+			return ExecResult::Break;
+		case StmtKind::Continue:
+			return ExecResult::Continue;
+		default:
+			return ExecResult::Failure;
+		}
+	}
+
+	ConstantValue* ConstantEvaluator::FindVariable(Expr const* expr)
+	{
+		if (frames.empty() || !isa<DeclRefExpr>(expr)) return nullptr;
+		Frame& frame = frames.back();
+		auto it = frame.find(cast<DeclRefExpr>(expr)->GetDecl());
+		return it != frame.end() ? &it->second : nullptr;
+	}
+
+	std::optional<ConstantValue> ConstantEvaluator::Convert(ConstantValue value, QualType const& type)
+	{
+		if (type.IsNull()) return std::nullopt;
+		if (value.IsFloat() && isoneof<CharType, IntType>(type))
+		{
+			//Out of range conversions trap or give an unspecified value at runtime
+			constexpr Float64 Int64Bound = 9223372036854775808.0;
+			if (!std::isfinite(value.float_value) || value.float_value >= Int64Bound || value.float_value < -Int64Bound) return std::nullopt;
+		}
+		switch (type->GetKind())
+		{
+		case TypeKind::Bool:
+			return MakeIntegral(TypeKind::Bool, IsTrue(value));
+		case TypeKind::Char:
+			return MakeIntegral(TypeKind::Char, static_cast<Int8>(value.IsFloat() ? static_cast<Int64>(value.float_value) : value.int_value));
+		case TypeKind::Int:
+			return MakeIntegral(TypeKind::Int, value.IsFloat() ? static_cast<Int64>(value.float_value) : value.int_value);
+		case TypeKind::Float:
+			return MakeFloat(AsFloat(value));
+		default:
+			return std::nullopt;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include <optional>
+#include <vector>
+#include <unordered_map>
+#include "AST/Type.h"
+
+namespace ola
+{
+	class Decl;
+	class Expr;
+	class Stmt;
+	class CallExpr;
+	class UnaryExpr;
+	class BinaryExpr;
+
+	//Value of a bool, char or int expression is kept in int_value, the value of a float expression in float_value
+	struct ConstantValue
+	{
+		TypeKind kind = TypeKind::Invalid;
+		union
+		{
+			Int64 int_value = 0;
+			Float64 float_value;
+		};
+
+		Bool IsFloat() const { return kind == TypeKind::Float; }
+		Bool IsIntegral() const { return kind == TypeKind::Bool || kind == TypeKind::Char || kind == TypeKind::Int; }
+	};
+
+	//Evaluates bool, char, int and float expressions at compile time. Besides literals and operators it looks through implicit casts,
+	//enum members, const variables with constant initializers and calls to constexpr functions, whose bodies are interpreted.
+	//Anything else, including evaluation that would trap at runtime, makes the expression non-constant.
+	class ConstantEvaluator
+	{
+		enum class ExecResult : Uint8
+		{
+			Normal,
+			Break,
+			Continue,
+			Return,
+			Failure
+		};
+		using Frame = std::unordered_map<Decl const*, ConstantValue>;
+
+		static constexpr Uint32 MaxCallDepth = 256;
+		static constexpr Uint64 MaxSteps = 1 << 20;
+
+	public:
+		std::optional<ConstantValue> Evaluate(Expr const* expr);
+		std::optional<Int64> EvaluateIntegral(Expr const* expr);
+
+	private:
+		std::vector<Frame> frames;
+		ConstantValue return_value;
+		Uint64 steps = 0;
+
+	private:
+		std::optional<ConstantValue> EvaluateExpr(Expr const* expr);
+		std::optional<ConstantValue> EvaluateUnaryExpr(UnaryExpr const* unary_expr);
+		std::optional<ConstantValue> EvaluateBinaryExpr(BinaryExpr const* binary_expr);
+		std::optional<ConstantValue> EvaluateCallExpr(CallExpr const* call_expr);
+		std::optional<ConstantValue> EvaluateDecl(Decl const* decl);
+		ExecResult Execute(Stmt const* stmt);
+
+		ConstantValue* FindVariable(Expr const* expr);
+		static std::optional<ConstantValue> Convert(ConstantValue value, QualType const& type);
+	};
+}
\ No newline at end of file
@@ -42,10 +42,10 @@ namespace ola
 		}
 	}
 
-	Diagnostics::Diagnostics(Bool _warnings_as_errors, Bool _exit_on_error)
+	Diagnostics::Diagnostics(Bool _warnings_as_errors, Bool _abort_on_error)
 	{
 		warnings_as_errors = _warnings_as_errors;
-		exit_on_error = _exit_on_error;
+		abort_on_error = _abort_on_error;
 	}
 
 	void Diagnostics::SetDefaultLocation(SourceLocation const& _loc)
@@ -59,10 +59,28 @@ namespace ola
 	void Diagnostics::Report(SourceLocation const& loc, DiagCode code)
 	{
 		DiagKind diag_kind = diag_kinds[code];
+		PresumedLocation presumed_loc = SourceManager::Get().GetPresumedLocation(loc);
 		std::string output = std::format("[Diagnostics][{}]: {} in file {} at line: {}, col: {}\n",
-			ToString(diag_kind), diag_msgs[code], loc.filename, loc.line, loc.column);
-		PrintMessage(diag_kind, output);
-		if (exit_on_error && diag_kind == DiagKind::error) 
-			std::exit(OLA_INVALID_SOURCE_CODE);
+			ToString(diag_kind), diag_msgs[code], presumed_loc.filename, presumed_loc.line, presumed_loc.column);
+		Emit(diag_kind, std::move(output));
+		if (diag_kind == DiagKind::error) OnError();
+	}
+
+	void Diagnostics::Replay(Diagnostics& diagnostics) const
+	{
+		for (auto const& [diag_kind, msg] : deferred_messages) PrintMessage(diag_kind, msg);
+		if (error_reported) diagnostics.OnError();
+	}
+
+	void Diagnostics::Emit(DiagKind diag_kind, std::string&& msg)
+	{
+		if (defer_messages) deferred_messages.emplace_back(diag_kind, std::move(msg));
+		else PrintMessage(diag_kind, msg);
+	}
+
+	void Diagnostics::OnError()
+	{
+		error_reported = true;
+		if (abort_on_error) throw CompilationAborted{};
 	}
 }
@@ -1,8 +1,9 @@
 #pragma once
 #include <unordered_map>
+#include <vector>
 #include <format>
 #include "Compiler/CompilerMacros.h"
-#include "SourceLocation.h"
+#include "SourceManager.h"
 
 
 namespace ola
@@ -13,6 +14,10 @@ namespace ola
 		#include "Diagnostics.def"
 	};
 
+	//Thrown when an error is reported, it unwinds the compilation of the current translation unit instead of exiting
+	//the process so that the thread that started the compilation decides how to stop
+	struct CompilationAborted {};
+
 	class Diagnostics
 	{
 		enum class DiagKind : Uint32
@@ -27,7 +32,7 @@ namespace ola
 		static void PrintMessage(DiagKind diag_kind, std::string const& msg);
 
 	public:
-		explicit Diagnostics(Bool warnings_as_errors = false, Bool exit_on_error = true);
+		explicit Diagnostics(Bool warnings_as_errors = false, Bool abort_on_error = true);
 
 		void SetDefaultLocation(SourceLocation const& loc);
 		void Report(DiagCode code);
@@ -38,18 +43,31 @@ namespace ola
 			DiagKind diag_kind = diag_kinds[code];
 			std::string_view fmt = diag_msgs[code];
 			std::string diag_msg = std::vformat(fmt, std::make_format_args(args...));
+			PresumedLocation presumed_loc = SourceManager::Get().GetPresumedLocation(loc);
 			std::string output = std::format("[Diagnostics][{}]: {} in file {} at line: {}, col: {}\n",
-											  ToString(diag_kind), diag_msg, loc.filename, loc.line, loc.column);
+											  ToString(diag_kind), diag_msg, presumed_loc.filename, presumed_loc.line, presumed_loc.column);
 			output += "\n";
 
-			PrintMessage(diag_kind, output);
-			if (exit_on_error && diag_kind == DiagKind::error) std::exit(OLA_INVALID_SOURCE_CODE);
+			Emit(diag_kind, std::move(output));
+			if (diag_kind == DiagKind::error) OnError();
 		}
 
+		//Messages are kept instead of printed until they are replayed into the diagnostics of the thread that owns the compilation
+		void DeferMessages() { defer_messages = true; }
+		void Replay(Diagnostics& diagnostics) const;
+
+		Bool HasErrors() const { return error_reported; }
+
 	private:
 		Bool warnings_as_errors = false;
-		Bool exit_on_error = false;
+		Bool abort_on_error = false;
 		SourceLocation loc;
 		Bool error_reported = false;
+		Bool defer_messages = false;
+		std::vector<std::pair<DiagKind, std::string>> deferred_messages;
+
+	private:
+		void Emit(DiagKind diag_kind, std::string&& msg);
+		void OnError();
 	};
 }
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "FrontendContext.h"
-#include "Frontend/AST/Type.h"
 
 namespace ola
 {
@@ -14,10 +13,10 @@ namespace ola
 
 	FrontendContext::~FrontendContext()
 	{
-		for (ArrayType* array_type	 : array_types)		delete array_type;
-		for (ClassType* class_type	 : class_types)		delete class_type;
-		for (RefType* ref_type		 : ref_types)		delete ref_type;
-		for (FuncType* function_type : function_types)	delete function_type;
+		for (auto const& [key, array_type]		: array_types)		delete array_type;
+		for (auto const& [key, class_type]		: class_types)		delete class_type;
+		for (auto const& [key, ref_type]		: ref_types)		delete ref_type;
+		for (auto const& [key, function_type]	: function_types)	delete function_type;
 
 		delete float_type;
 		delete int_type;
@@ -28,56 +27,49 @@ namespace ola
 
 	ArrayType* FrontendContext::GetArrayType(QualType const& type, Uint32 array_size)
 	{
-		for (auto const& array_type : array_types)
-		{
-			if (array_type->GetElementType() == type && array_type->GetArraySize() == array_size) return array_type;
-		}
-		ArrayType* new_type = new(this) ArrayType(type, array_size);
-		array_types.push_back(new_type);
-		return new_type;
+		ArrayType*& array_type = array_types[ArrayTypeKey{ type, array_size }];
+		if (!array_type) array_type = new(this) ArrayType(type, array_size);
+		return array_type;
 	}
 
 	RefType* FrontendContext::GetRefType(QualType const& type)
 	{
-		for (auto const& ref_type : ref_types)
-		{
-			if (ref_type->GetReferredType() == (type)) return ref_type;
-		}
-		ref_types.push_back(new(this) RefType(type));
-		return ref_types.back();
+		RefType*& ref_type = ref_types[type];
+		if (!ref_type) ref_type = new(this) RefType(type);
+		return ref_type;
 	}
 
 	FuncType* FrontendContext::GetFuncType(QualType const& return_type, std::vector<QualType> const& param_types)
 	{
-		for (auto const& function_type : function_types)
-		{
-			if (function_type->GetReturnType() != return_type) continue;
-			if (function_type->GetParamCount() != param_types.size()) continue;
-			Uint64 const param_count = function_type->GetParamCount();
-			Bool incompatible = false;
-			for (Uint64 i = 0; i < param_count; ++i)
-			{
-				if (function_type->GetParamType(i) != param_types[i])
-				{
-					incompatible = true;
-					break;
-				}
-			}
-			if (!incompatible) return function_type;
-		}
-		function_types.push_back(new(this) FuncType(return_type, param_types));
-		return function_types.back();
+		auto it = function_types.find(FuncTypeKey{ return_type, param_types });
+		if (it != function_types.end()) return it->second;
+
+		FuncType* function_type = new(this) FuncType(return_type, param_types);
+		function_types.emplace(FuncTypeKey{ function_type->GetReturnType(), function_type->GetParams() }, function_type);
+		return function_type;
 	}
 
 	ClassType* FrontendContext::GetClassType(ClassDecl const* class_decl)
 	{
-		for (auto const& class_type : class_types)
-		{
-			if (class_type->GetClassDecl() == class_decl) return class_type;
-		}
-		class_types.push_back(new(this) ClassType(class_decl));
-		return class_types.back();
+		ClassType*& class_type = class_types[class_decl];
+		if (!class_type) class_type = new(this) ClassType(class_decl);
+		return class_type;
+	}
+
+	Uint64 FrontendContext::TypeKeyHash::operator()(QualType const& type) const
+	{
+		return std::hash<Type const*>{}(type.GetTypePtr()) ^ type.GetQualifiers();
 	}
 
-}
+	Uint64 FrontendContext::TypeKeyHash::operator()(ArrayTypeKey const& key) const
+	{
+		return (*this)(key.element_type) * 31 + key.array_size;
+	}
 
+	Uint64 FrontendContext::TypeKeyHash::operator()(FuncTypeKey const& key) const
+	{
+		Uint64 hash = (*this)(key.return_type);
+		for (QualType const& param_type : key.param_types) hash = hash * 31 + (*this)(param_type);
+		return hash;
+	}
+}
\ No newline at end of file
@@ -1,23 +1,40 @@
 #pragma once
 #include <vector>
+#include <span>
+#include <algorithm>
+#include <unordered_map>
+#include "Identifier.h"
+#include "AST/Type.h"
 
 namespace ola
 {
-	class Type;
-	class QualType;
-	class ArrayType;
-	class ClassType;
-	class RefType;
-	class FuncType;
-	class VoidType;
-	class BoolType;
-	class CharType;
-	class IntType;
-	class FloatType;
 	class ClassDecl;
 
 	class FrontendContext
 	{
+		//Types are uniqued by their structure, the key of a function type refers to the parameters stored in the type itself
+		struct ArrayTypeKey
+		{
+			QualType element_type;
+			Uint32 array_size;
+			Bool operator==(ArrayTypeKey const&) const = default;
+		};
+		struct FuncTypeKey
+		{
+			QualType return_type;
+			std::span<QualType const> param_types;
+			Bool operator==(FuncTypeKey const& o) const
+			{
+				return return_type == o.return_type && std::ranges::equal(param_types, o.param_types);
+			}
+		};
+		struct TypeKeyHash
+		{
+			Uint64 operator()(QualType const& type) const;
+			Uint64 operator()(ArrayTypeKey const& key) const;
+			Uint64 operator()(FuncTypeKey const& key) const;
+		};
+
 	public:
 
 		FrontendContext();
@@ -34,6 +51,8 @@ namespace ola
 		FuncType* GetFuncType(QualType const& return_type, std::vector<QualType> const& param_types);
 		ClassType* GetClassType(ClassDecl const* class_decl);
 
+		Identifier GetIdentifier(std::string_view name) { return identifiers.Get(name); }
+
 	private:
 
 		VoidType* void_type;
@@ -41,10 +60,11 @@ namespace ola
 		CharType* char_type;
 		IntType*   int_type;
 		FloatType* float_type;
+		IdentifierTable identifiers;
 
-		std::vector<ArrayType*> array_types;
-		std::vector<ClassType*> class_types;
-		std::vector<RefType*>   ref_types;
-		std::vector<FuncType*>  function_types;
+		std::unordered_map<ArrayTypeKey, ArrayType*, TypeKeyHash>	array_types;
+		std::unordered_map<ClassDecl const*, ClassType*>			class_types;
+		std::unordered_map<QualType, RefType*, TypeKeyHash>			ref_types;
+		std::unordered_map<FuncTypeKey, FuncType*, TypeKeyHash>		function_types;
 	};
 }
\ No newline at end of file
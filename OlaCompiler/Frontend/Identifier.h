@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+
+namespace ola
+{
+	//Name interned in an IdentifierTable. Identifiers with the same spelling share their id and their storage,
+	//the empty identifier has the id 0
+	class Identifier
+	{
+		friend class IdentifierTable;
+		friend class Token;
+	public:
+		Identifier() = default;
+
+		Uint32 GetId() const { return id; }
+		std::string_view GetName() const { return std::string_view(name, size); }
+		operator std::string_view() const { return GetName(); }
+		Bool IsEmpty() const { return id == 0; }
+
+		Bool operator==(Identifier const& o) const { return id == o.id; }
+		Bool operator!=(Identifier const& o) const { return id != o.id; }
+
+	private:
+		Char const* name = "";
+		Uint32 size = 0;
+		Uint32 id = 0;
+
+	private:
+		Identifier(std::string_view name, Uint32 id) : name(name.data()), size(static_cast<Uint32>(name.size())), id(id) {}
+	};
+
+	//Identifiers are interned once when they are lexed, later stages compare and look them up by id
+	class IdentifierTable
+	{
+	public:
+		IdentifierTable() = default;
+		OLA_NONCOPYABLE_NONMOVABLE(IdentifierTable)
+		~IdentifierTable() = default;
+
+		Identifier Get(std::string_view name)
+		{
+			if (name.empty()) return Identifier{};
+			if (auto it = identifiers.find(name); it != identifiers.end()) return it->second;
+
+			std::string const& spelling = spellings.emplace_back(name);
+			Identifier identifier(spelling, static_cast<Uint32>(spellings.size()));
+			identifiers.emplace(identifier.GetName(), identifier);
+			return identifier;
+		}
+		//Every id handed out so far is smaller than the count
+		Uint32 GetCount() const { return static_cast<Uint32>(spellings.size() + 1); }
+
+	private:
+		std::unordered_map<std::string_view, Identifier> identifiers;
+		std::deque<std::string> spellings;
+	};
+}
\ No newline at end of file
@@ -1,11 +1,22 @@
 #include <filesystem>
+#include <fstream>
+#include <format>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include "ImportProcessor.h"
 #include "Diagnostics.h"
+#include "FrontendContext.h"
 #include "SourceBuffer.h"
 #include "Lexer.h"
 #include "Parser.h"
 #include "AST/AST.h"
+#include "Utility/Hash.h"
 #include "autogen/OlaConfig.h"
 
 
@@ -16,16 +27,132 @@ namespace ola
 	static constexpr Char const* ola_extension = ".ola";
 	static constexpr Char const* ola_lib_path = OLA_LIB_PATH;
 
-	ImportProcessor::ImportProcessor(FrontendContext* context, Diagnostics& diagnostics) : context(context), diagnostics(diagnostics) {}
+	namespace
+	{
+		constexpr Char const* ola_interface_extension = ".olam";
+
+		//Interfaces of imported modules are kept for the lifetime of the process, which is what keeps the
+		//standard library warm between requests in compile server mode and between TUs compiled in parallel
+		class ModuleInterfaceCache
+		{
+			struct Entry
+			{
+				fs::file_time_type last_write_time;
+				Uint64 file_size;
+				std::shared_ptr<ModuleInterface const> module;
+			};
+
+		public:
+			static ModuleInterfaceCache& Get()
+			{
+				static ModuleInterfaceCache instance;
+				return instance;
+			}
+
+			std::shared_ptr<ModuleInterface const> Find(std::string const& import_path) const
+			{
+				std::error_code error;
+				fs::file_time_type const last_write_time = fs::last_write_time(import_path, error);
+				if (error) return nullptr;
+				Uint64 const file_size = fs::file_size(import_path, error);
+				if (error) return nullptr;
+
+				std::lock_guard lock(cache_mutex);
+				auto it = entries.find(import_path);
+				if (it == entries.end()) return nullptr;
+				Entry const& entry = it->second;
+				if (entry.last_write_time != last_write_time || entry.file_size != file_size) return nullptr;
+				return entry.module;
+			}
+
+			void Insert(std::string const& import_path, std::shared_ptr<ModuleInterface const> const& module)
+			{
+				std::error_code error;
+				fs::file_time_type const last_write_time = fs::last_write_time(import_path, error);
+				if (error) return;
+				Uint64 const file_size = fs::file_size(import_path, error);
+				if (error) return;
+
+				std::lock_guard lock(cache_mutex);
+				entries[import_path] = Entry{ .last_write_time = last_write_time, .file_size = file_size, .module = module };
+			}
+
+		private:
+			mutable std::mutex cache_mutex;
+			std::unordered_map<std::string, Entry> entries;
+		};
+
+		std::shared_ptr<ModuleInterface const> ReadInterfaceFile(fs::path const& interface_path)
+		{
+			std::ifstream interface_stream(interface_path, std::ios::binary | std::ios::ate);
+			if (!interface_stream) return nullptr;
+			std::vector<Uint8> buffer(static_cast<Uint64>(interface_stream.tellg()));
+			interface_stream.seekg(0);
+			if (!interface_stream.read(reinterpret_cast<Char*>(buffer.data()), buffer.size())) return nullptr;
+			return ModuleInterface::Read(std::move(buffer));
+		}
+
+		//The interface is written to a temporary file first so that concurrent compilations never read a partially written interface
+		Bool WriteInterfaceFile(fs::path const& interface_path, std::vector<Uint8> const& buffer)
+		{
+			std::error_code error;
+			fs::create_directories(interface_path.parent_path(), error);
+			if (error) return false;
+
+			Uint64 const thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+			fs::path temporary_path = interface_path;
+			temporary_path += std::format(".{:x}.tmp", thread_hash);
+			{
+				std::ofstream interface_stream(temporary_path, std::ios::binary);
+				if (!interface_stream) return false;
+				interface_stream.write(reinterpret_cast<Char const*>(buffer.data()), buffer.size());
+				if (!interface_stream)
+				{
+					interface_stream.close();
+					fs::remove(temporary_path, error);
+					return false;
+				}
+			}
+			fs::rename(temporary_path, interface_path, error);
+			if (error)
+			{
+				fs::remove(temporary_path, error);
+				return false;
+			}
+			return true;
+		}
+
+		//Modules with the same name in different directories get different interface files
+		fs::path GetInterfacePath(std::string_view interface_directory, std::string const& module_path)
+		{
+			Uint64 const path_hash = crc64(module_path.data(), module_path.size());
+			return fs::path(interface_directory) / std::format("{}.{:016x}{}", fs::path(module_path).stem().string(), path_hash, ola_interface_extension);
+		}
+
+		struct PendingImport
+		{
+			std::string path;
+			SourceLocation loc;
+		};
+
+		struct LoadedModule
+		{
+			std::shared_ptr<ModuleInterface const> module;
+			Diagnostics diagnostics;
+		};
+	}
+
+	ImportProcessor::ImportProcessor(FrontendContext* context, Diagnostics& diagnostics, std::string_view interface_directory)
+		: context(context), diagnostics(diagnostics), interface_directory(interface_directory) {}
 
-	void ImportProcessor::ProcessImports(std::vector<Token>&& _tokens)
+	void ImportProcessor::ProcessImports(TokenStream& tokens)
 	{
-		tokens = std::move(_tokens);
-		PreFilterTokens();
-		current_token = tokens.begin();
+		current_token = tokens.Begin();
+		std::unordered_set<std::string> included_files;
+		std::vector<PendingImport> pending_imports;
 		while (Consume(TokenKind::KW_import))
 		{
-			TokenPtr start_token = current_token;
+			SourceLocation const import_loc = current_token->GetLocation();
 			fs::path import_path = "";
 			do 
 			{
@@ -35,42 +162,59 @@ namespace ola
 				++current_token;
 			} while (Consume(TokenKind::period));
 			Expect(TokenKind::semicolon);
-			TokenPtr end_token = current_token;
-			for (; start_token != end_token; ++start_token) start_token->SetFlag(TokenFlag_PartOfImportDirective);
 
 			import_path += ola_extension;
 			if (!fs::exists(import_path))
 			{
 				import_path = fs::path(ola_lib_path) / import_path;
-				if (!fs::exists(import_path)) diagnostics.Report(current_token->GetLocation(), invalid_import_path);
+				if (!fs::exists(import_path)) diagnostics.Report(import_loc, invalid_import_path);
 			}
-			
-			std::vector<Token> import_tokens = GetImportTokens(import_path.string());
 
-			TokenPtr first_inserted = tokens.insert(current_token, import_tokens.begin(), import_tokens.end());
-			current_token = first_inserted + import_tokens.size();
+			std::error_code error;
+			std::string canonical_path = fs::weakly_canonical(import_path, error).string();
+			if (std::find(import_chain.begin(), import_chain.end(), canonical_path) != import_chain.end()) diagnostics.Report(import_loc, circular_import);
+			if (!included_files.insert(std::move(canonical_path)).second) continue;
+			imported_files.push_back(import_path.string());
+			pending_imports.push_back(PendingImport{ .path = import_path.string(), .loc = import_loc });
 		}
-		PostFilterTokens();
-	}
+		tokens.Release(current_token);
 
-	void ImportProcessor::RemoveImports(std::vector<Token>&& _tokens)
-	{
-		tokens = std::move(_tokens);
-		PreFilterTokens();
-		current_token = tokens.begin();
-		while (Consume(TokenKind::KW_import))
+		//Interfaces that are not cached yet are loaded or built concurrently. Each worker reports into diagnostics of its own
+		//that are replayed here in import order, so messages don't interleave and errors abort the compilation on this thread
+		std::vector<std::future<LoadedModule>> pending_modules;
+		for (Uint64 i = 1; i < pending_imports.size(); ++i)
 		{
-			TokenPtr start_token = current_token;
-			do
-			{
-				if (current_token->IsNot(TokenKind::identifier)) diagnostics.Report(current_token->GetLocation(), unexpected_token);
-				++current_token;
-			} while (Consume(TokenKind::period));
-			Expect(TokenKind::semicolon);
-			TokenPtr end_token = current_token;
-			for (; start_token != end_token; ++start_token) start_token->SetFlag(TokenFlag_PartOfImportDirective);
+			pending_modules.push_back(std::async(std::launch::async, [this, &pending_imports, i]()
+				{
+					LoadedModule loaded_module{};
+					loaded_module.diagnostics.DeferMessages();
+					ImportProcessor import_processor(context, loaded_module.diagnostics, interface_directory);
+					import_processor.import_chain = import_chain;
+					try
+					{
+						loaded_module.module = import_processor.GetModuleInterface(pending_imports[i].path, pending_imports[i].loc);
+					}
+					catch (CompilationAborted const&)
+					{
+						//the error is reported when the diagnostics are replayed
+					}
+					return loaded_module;
+				}));
+		}
+		if (!pending_imports.empty()) imported_modules.push_back(GetModuleInterface(pending_imports[0].path, pending_imports[0].loc));
+		for (auto& pending_module : pending_modules)
+		{
+			LoadedModule loaded_module = pending_module.get();
+			loaded_module.diagnostics.Replay(diagnostics);
+			imported_modules.push_back(std::move(loaded_module.module));
+		}
+
+		//A change anywhere in the import closure can change the declarations this translation unit sees
+		import_closure = imported_files;
+		for (Uint64 i = 0; i < imported_modules.size(); ++i)
+		{
+			if (imported_modules[i]) CollectImportClosure(*imported_modules[i], pending_imports[i].loc, included_files);
 		}
-		PostFilterTokens();
 	}
 
 	Bool ImportProcessor::Consume(TokenKind k)
@@ -92,44 +236,96 @@ namespace ola
 		return true;
 	}
 
-	void ImportProcessor::PreFilterTokens()
+	void ImportProcessor::PreloadImports(std::string_view directory)
 	{
-		std::vector<Token> preprocessed_tokens{};
-		for (auto const& token : tokens)
+		std::error_code error;
+		for (fs::directory_entry const& entry : fs::recursive_directory_iterator(directory, error))
 		{
-			if (!token.IsOneOf(TokenKind::comment, TokenKind::newline))
-				preprocessed_tokens.push_back(token);
+			if (entry.path().extension() != ola_extension) continue;
+
+			Diagnostics diagnostics{};
+			ImportProcessor import_processor(nullptr, diagnostics);
+			try
+			{
+				import_processor.GetModuleInterface(entry.path().string(), SourceLocation{});
+			}
+			catch (CompilationAborted const&)
+			{
+				//modules with errors are reported again when a translation unit imports them
+			}
 		}
-		std::swap(preprocessed_tokens, tokens);
 	}
 
-	void ImportProcessor::PostFilterTokens()
+	//An interface is reused as long as the module's source and the interfaces of its own imports are unchanged,
+	//otherwise the module is parsed on its own and its interface is written to the interface directory
+	std::shared_ptr<ModuleInterface const> ImportProcessor::GetModuleInterface(std::string const& import_path, SourceLocation const& import_loc)
 	{
-		std::vector<Token> preprocessed_tokens{};
-		for (auto const& token : tokens)
+		std::error_code error;
+		std::string const cache_key = fs::weakly_canonical(import_path, error).string();
+		if (std::find(import_chain.begin(), import_chain.end(), cache_key) != import_chain.end()) diagnostics.Report(import_loc, circular_import);
+		if (std::shared_ptr<ModuleInterface const> module = ModuleInterfaceCache::Get().Find(cache_key); module && AreImportsUpToDate(*module, import_loc))
 		{
-			if (!token.IsOneOf(TokenKind::comment, TokenKind::newline, TokenKind::KW_import) 
-			 && !token.HasFlag(TokenFlag_PartOfImportDirective))
-				preprocessed_tokens.push_back(token);
+			return module;
 		}
-		std::swap(preprocessed_tokens, tokens);
+
+		SourceBuffer src(import_path);
+		Uint64 const source_hash = crc64(src.GetBufferStart(), src.GetBufferSize());
+		fs::path const interface_path = interface_directory.empty() ? fs::path{} : GetInterfacePath(interface_directory, cache_key);
+		if (std::shared_ptr<ModuleInterface const> module = interface_path.empty() ? nullptr : ReadInterfaceFile(interface_path);
+			module && module->GetSourceHash() == source_hash && AreImportsUpToDate(*module, import_loc))
+		{
+			ModuleInterfaceCache::Get().Insert(cache_key, module);
+			return module;
+		}
+
+		FrontendContext module_context;
+		Lexer lex(&module_context, diagnostics, src);
+		TokenStream tokens(lex);
+		ImportProcessor import_processor(&module_context, diagnostics, interface_directory);
+		import_processor.import_chain = import_chain;
+		import_processor.import_chain.push_back(cache_key);
+		import_processor.ProcessImports(tokens);
+
+		std::vector<ModuleImport> module_imports;
+		std::vector<std::string> const& module_import_paths = import_processor.GetImportedFiles();
+		std::vector<std::shared_ptr<ModuleInterface const>> const& modules = import_processor.GetImportedModules();
+		for (Uint64 i = 0; i < modules.size(); ++i)
+		{
+			module_imports.push_back(ModuleImport{ .path = module_import_paths[i], .interface_hash = modules[i]->GetHash() });
+		}
+
+		Parser parser(&module_context, diagnostics);
+		parser.Parse(tokens, modules);
+		std::vector<Uint8> interface_buffer = ModuleInterface::Write(parser.GetAST(), source_hash, module_imports);
+		if (!interface_path.empty() && !WriteInterfaceFile(interface_path, interface_buffer))
+		{
+			diagnostics.Report(import_loc, module_interface_write_failed, interface_path.string());
+		}
+
+		std::shared_ptr<ModuleInterface const> module = ModuleInterface::Read(std::move(interface_buffer));
+		OLA_ASSERT(module);
+		ModuleInterfaceCache::Get().Insert(cache_key, module);
+		return module;
 	}
 
-	std::vector<Token> ImportProcessor::GetImportTokens(std::string_view import_path)
+	Bool ImportProcessor::AreImportsUpToDate(ModuleInterface const& module, SourceLocation const& import_loc)
 	{
-		SourceBuffer import_src_buffer(import_path);
-		Lexer lex(diagnostics);
-		lex.Lex(import_src_buffer);
-		std::vector<Token> imported_tokens = lex.GetTokens();
-
-		ImportProcessor import_processor(context, diagnostics);
-		import_processor.RemoveImports(std::move(imported_tokens));
-		imported_tokens = import_processor.GetProcessedTokens();
-		if (imported_tokens.back().GetKind() == TokenKind::eof)
+		for (ModuleImport const& module_import : module.GetImports())
 		{
-			imported_tokens.pop_back();
+			if (!fs::exists(module_import.path)) return false;
+			if (GetModuleInterface(module_import.path, import_loc)->GetHash() != module_import.interface_hash) return false;
 		}
-		return imported_tokens;
+		return true;
 	}
-}
 
+	void ImportProcessor::CollectImportClosure(ModuleInterface const& module, SourceLocation const& import_loc, std::unordered_set<std::string>& visited)
+	{
+		for (ModuleImport const& module_import : module.GetImports())
+		{
+			std::error_code error;
+			if (!visited.insert(fs::weakly_canonical(module_import.path, error).string()).second) continue;
+			import_closure.push_back(module_import.path);
+			CollectImportClosure(*GetModuleInterface(module_import.path, import_loc), import_loc, visited);
+		}
+	}
+}
\ No newline at end of file
@@ -1,39 +1,59 @@
 #pragma once
 #include <vector>
-#include "Token.h"
+#include <string>
+#include <memory>
+#include <unordered_set>
+#include "TokenStream.h"
 
 
 namespace ola
 {
 	class FrontendContext;
 	class Diagnostics;
+	class ModuleInterface;
 
+	//Imports are resolved to module interfaces, the declarations of an imported module are declared in the
+	//importing translation unit when their name is first looked up instead of parsing the module again.
+	//Interfaces are persisted in the interface directory, without one they are only kept in memory.
 	class ImportProcessor
 	{
-		using TokenPtr = std::vector<Token>::iterator;
+		using TokenPtr = TokenStream::Iterator;
 	public:
-		ImportProcessor(FrontendContext* context, Diagnostics& diagnostics);
-		void ProcessImports(std::vector<Token>&& tokens);
-		void RemoveImports(std::vector<Token>&& tokens);
-		std::vector<Token>&& GetProcessedTokens()  
+		ImportProcessor(FrontendContext* context, Diagnostics& diagnostics, std::string_view interface_directory = "");
+		//Consumes the import directives at the start of the stream, the parser continues from the first declaration
+		void ProcessImports(TokenStream& tokens);
+		std::vector<std::string> const& GetImportedFiles() const
 		{
-			return std::move(tokens);
+			return imported_files;
+		}
+		std::vector<std::shared_ptr<ModuleInterface const>> const& GetImportedModules() const
+		{
+			return imported_modules;
+		}
+		//Source files of the direct imports and of everything they import in turn
+		std::vector<std::string> const& GetImportClosure() const
+		{
+			return import_closure;
 		}
 
+		static void PreloadImports(std::string_view directory);
+
 	private:
 		FrontendContext* context;
 		Diagnostics& diagnostics;
-		std::vector<Token> tokens;
+		std::string interface_directory;
 		TokenPtr current_token;
+		std::vector<std::string> imported_files;
+		std::vector<std::shared_ptr<ModuleInterface const>> imported_modules;
+		std::vector<std::string> import_closure;
+		std::vector<std::string> import_chain;
 
 	private:
 		Bool Consume(TokenKind k);
 		Bool Expect(TokenKind k);
 
-		void PreFilterTokens();
-		void PostFilterTokens();
-
-		std::vector<Token> GetImportTokens(std::string_view import_path);
-
+		std::shared_ptr<ModuleInterface const> GetModuleInterface(std::string const& import_path, SourceLocation const& import_loc);
+		Bool AreImportsUpToDate(ModuleInterface const& module, SourceLocation const& import_loc);
+		void CollectImportClosure(ModuleInterface const& module, SourceLocation const& import_loc, std::unordered_set<std::string>& visited);
 	};
 }
\ No newline at end of file
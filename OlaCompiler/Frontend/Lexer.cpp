@@ -1,76 +1,167 @@
+#include <bit>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OLA_LEXER_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OLA_LEXER_SIMD 1
+#else
+#define OLA_LEXER_SIMD 0
+#endif
 #include "Lexer.h"
 #include "SourceBuffer.h"
 #include "Diagnostics.h"
+#include "FrontendContext.h"
 
 
 namespace ola
 {
-
-	Lexer::Lexer(Diagnostics& diagnostics) : diagnostics(diagnostics) {}
-
-	void Lexer::Lex(SourceBuffer const& source)
+	namespace
 	{
-		buf_ptr = source.GetBufferStart(); 
-		cur_ptr = buf_ptr; 
-		loc = SourceLocation{ .filename = std::string(source.GetRefName().data(), source.GetRefName().size()) };
-		Token current_token{};
-		do
-		{
-			current_token.Reset();
-			Bool result = LexToken(current_token);
+#if defined(__AVX2__)
+		using Block = __m256i;
+		constexpr Uint64 BlockSize = 32;
+		constexpr Uint32 BlockMask = 0xffffffff;
+		Block LoadBlock(Char const* ptr) { return _mm256_loadu_si256(reinterpret_cast<Block const*>(ptr)); }
+		Block Splat(Char c) { return _mm256_set1_epi8(c); }
+		Block Equal(Block a, Block b) { return _mm256_cmpeq_epi8(a, b); }
+		Block Greater(Block a, Block b) { return _mm256_cmpgt_epi8(a, b); }
+		Block And(Block a, Block b) { return _mm256_and_si256(a, b); }
+		Block Or(Block a, Block b) { return _mm256_or_si256(a, b); }
+		Uint32 MoveMask(Block b) { return static_cast<Uint32>(_mm256_movemask_epi8(b)); }
+#elif OLA_LEXER_SIMD
+		using Block = __m128i;
+		constexpr Uint64 BlockSize = 16;
+		constexpr Uint32 BlockMask = 0xffff;
+		Block LoadBlock(Char const* ptr) { return _mm_loadu_si128(reinterpret_cast<Block const*>(ptr)); }
+		Block Splat(Char c) { return _mm_set1_epi8(c); }
+		Block Equal(Block a, Block b) { return _mm_cmpeq_epi8(a, b); }
+		Block Greater(Block a, Block b) { return _mm_cmpgt_epi8(a, b); }
+		Block And(Block a, Block b) { return _mm_and_si128(a, b); }
+		Block Or(Block a, Block b) { return _mm_or_si128(a, b); }
+		Uint32 MoveMask(Block b) { return static_cast<Uint32>(_mm_movemask_epi8(b)); }
+#endif
 
-			if (!result)
+		//Each scanner describes where a run of characters stops, the '\0' sentinel always stops it.
+		//StopMask has a bit set for every byte of a block that stops the run.
+		struct WhitespaceScanner
+		{
+			static Bool Continues(Char c) { return c == ' ' || c == '\t' || c == '\r'; }
+#if OLA_LEXER_SIMD
+			static Uint32 StopMask(Block b)
+			{
+				return ~MoveMask(Or(Or(Equal(b, Splat(' ')), Equal(b, Splat('\t'))), Equal(b, Splat('\r')))) & BlockMask;
+			}
+#endif
+		};
+		struct IdentifierScanner
+		{
+			static Bool Continues(Char c) { return std::isalnum(static_cast<Uint8>(c)) || c == '_'; }
+#if OLA_LEXER_SIMD
+			static Uint32 StopMask(Block b)
+			{
+				Block const lower = Or(b, Splat(0x20));
+				Block const alpha = And(Greater(lower, Splat('a' - 1)), Greater(Splat('z' + 1), lower));
+				Block const digit = And(Greater(b, Splat('0' - 1)), Greater(Splat('9' + 1), b));
+				return ~MoveMask(Or(Or(alpha, digit), Equal(b, Splat('_')))) & BlockMask;
+			}
+#endif
+		};
+		template<Char Terminator>
+		struct DelimitedScanner
+		{
+			static Bool Continues(Char c) { return c != Terminator && c != '\0'; }
+#if OLA_LEXER_SIMD
+			static Uint32 StopMask(Block b)
 			{
-				return;
+				return MoveMask(Or(Equal(b, Splat(Terminator)), Equal(b, Splat('\0'))));
 			}
-			if (!tokens.empty())
+#endif
+		};
+		using CommentScanner = DelimitedScanner<'\n'>;
+		using StringScanner = DelimitedScanner<'"'>;
+		using CharScanner = DelimitedScanner<'\''>;
+
+		//Blocks are loaded unaligned from the scan position, the sentinel always stops the scan
+		//so a load never reads past the tail padding of the source buffer
+		template<typename ScannerT>
+		Char const* Scan(Char const* ptr)
+		{
+#if OLA_LEXER_SIMD
+			static_assert(BlockSize <= SourceBuffer::TailPadding);
+			while (true)
 			{
-				auto const& prev_token = tokens.back();
-				if (prev_token.Is(TokenKind::newline)) current_token.SetFlag(TokenFlag_BeginningOfLine);
+				Uint32 const stop_mask = ScannerT::StopMask(LoadBlock(ptr));
+				if (stop_mask) return ptr + std::countr_zero(stop_mask);
+				ptr += BlockSize;
 			}
-			else current_token.SetFlag(TokenFlag_BeginningOfLine);
+#else
+			while (ScannerT::Continues(*ptr)) ++ptr;
+			return ptr;
+#endif
+		}
+	}
 
-			tokens.push_back(current_token);
-		} while (current_token.IsNot(TokenKind::eof));
+	Lexer::Lexer(FrontendContext* context, Diagnostics& diagnostics, SourceBuffer const& source) : context(context), diagnostics(diagnostics), source(source)
+	{
+		start_loc = source.GetStartLocation();
+		if (!source.GetPrefix().empty()) SetBuffer(source.GetPrefix().data(), true);
+		else SetBuffer(source.GetBufferStart(), false);
 	}
 
-	Bool Lexer::LexToken(Token& token)
+	void Lexer::Lex(Token& token)
 	{
-		UpdatePointersAndLocation();
-		if ((*cur_ptr == ' ') || (*cur_ptr == '\t'))
+		token.Reset();
+		if (failed || !LexToken(token))
 		{
-			++cur_ptr;
-			while ((*cur_ptr == ' ') || (*cur_ptr == '\t')) ++cur_ptr;
-			token.SetFlag(TokenFlag_LeadingSpace);
-			UpdatePointersAndLocation();
+			failed = true;
+			token.Reset();
+			token.SetKind(TokenKind::eof);
+			token.SetLocation(loc);
+			return;
 		}
-
-		Char c = *cur_ptr++;
-		switch (c)
-		{
-		case '\0':
-			return LexEndOfFile(token);
-		case '\n':
+		if (lexing_prefix && token.Is(TokenKind::eof))
 		{
-			Bool ret = LexNewLine(token);
-			loc.NewLine();
-			buf_ptr = cur_ptr;
-			token.ClearFlag(TokenFlag_LeadingSpace);
-			return ret;
+			SetBuffer(source.GetBufferStart(), false);
+			Lex(token);
 		}
-		case '/':
+	}
+
+	void Lexer::SetBuffer(Char const* buffer, Bool is_prefix)
+	{
+		buf_ptr = buffer;
+		cur_ptr = buf_ptr;
+		lexing_prefix = is_prefix;
+	}
+
+	Bool Lexer::LexToken(Token& token)
+	{
+		if (cur_ptr == buf_ptr) token.SetFlag(TokenFlag_BeginningOfLine);
+		while (true)
 		{
-			if (*cur_ptr == '/') 
+			if (WhitespaceScanner::Continues(*cur_ptr))
+			{
+				cur_ptr = Scan<WhitespaceScanner>(cur_ptr + 1);
+				token.SetFlag(TokenFlag_LeadingSpace);
+			}
+			if (*cur_ptr == '\n')
 			{
 				++cur_ptr;
-				return LexComment(token);
+				token.SetFlags(TokenFlag_BeginningOfLine);
 			}
-			else
+			else if (cur_ptr[0] == '/' && cur_ptr[1] == '/')
 			{
-				--cur_ptr;
-				return LexPunctuator(token);
+				cur_ptr = Scan<CommentScanner>(cur_ptr + 2);
 			}
+			else break;
 		}
+		UpdateLocation();
+
+		Char c = *cur_ptr++;
+		switch (c)
+		{
+		case '\0':
+			return LexEndOfFile(token);
 		case '"':
 		{
 			return LexString(token);
@@ -108,7 +199,7 @@ namespace ola
 			return LexIdentifier(token);
 		}
 		case '[': case ']': case '(': case ')': case '{': case '}': /*case '.': */
-		case '&': case '*': case '+': case '-': case '~': case '!': /*case '/':*/
+		case '&': case '*': case '+': case '-': case '~': case '!': case '/':
 		case '%': case '<': case '>': case '^': case '|': case '?': case ':':
 		case ';': case '=': case ',': case '#':
 		{
@@ -130,19 +221,19 @@ namespace ola
 			Consume(tmp_ptr, [](Char c) -> Bool { return std::isdigit(c); });
 			if (std::isalpha(*tmp_ptr)) return false;
 			FillToken(t, TokenKind::float_number, tmp_ptr);
-			UpdatePointersAndLocation();
+			UpdateLocation();
 			return true;
 		}
 		else if (std::isalpha(*tmp_ptr))
 		{
-			UpdatePointersAndLocation();
+			UpdateLocation();
 			diagnostics.Report(loc, invalid_number_literal);
 			return false;
 		}
 		else
 		{
 			FillToken(t, TokenKind::int_number, tmp_ptr);
-			UpdatePointersAndLocation();
+			UpdateLocation();
 			return true;
 		}
 		return true;
@@ -150,53 +241,42 @@ namespace ola
 
 	Bool Lexer::LexIdentifier(Token& t)
 	{
-		FillToken(t, TokenKind::identifier, [](Char c) -> Bool { return std::isalnum(c) || c == '_'; });
-		std::string_view identifier = t.GetData();
-		if (IsKeyword(identifier))
+		FillToken(t, TokenKind::identifier, Scan<IdentifierScanner>(cur_ptr));
+		TokenKind keyword_kind = GetKeywordType(t.GetData());
+		if (keyword_kind != TokenKind::unknown)
 		{
-			t.SetKind(GetKeywordType(identifier));
+			t.SetKind(keyword_kind);
 		}
-		UpdatePointersAndLocation();
+		else t.SetIdentifier(context->GetIdentifier(t.GetData()));
+		UpdateLocation();
 		return true;
 	}
 
 	Bool Lexer::LexChar(Token& t)
 	{
-		FillToken(t, TokenKind::char_literal, [](Char c) -> Bool { return c != '\''; });
-		++cur_ptr;
-		UpdatePointersAndLocation();
+		FillToken(t, TokenKind::char_literal, Scan<CharScanner>(cur_ptr));
+		if (*cur_ptr) ++cur_ptr;
+		UpdateLocation();
 		return true;
 	}
 
 	Bool Lexer::LexString(Token& t)
 	{
-		FillToken(t, TokenKind::string_literal, [](Char c) -> Bool { return c != '"'; });
-		++cur_ptr;
-		UpdatePointersAndLocation();
+		FillToken(t, TokenKind::string_literal, Scan<StringScanner>(cur_ptr));
+		if (*cur_ptr) ++cur_ptr;
+		UpdateLocation();
 		return true;
 	}
 
 	Bool Lexer::LexEndOfFile(Token& t)
 	{
+		//Stay on the sentinel, lexing past the end keeps returning eof
+		--cur_ptr;
 		t.SetKind(TokenKind::eof);
 		t.SetLocation(loc);
 		return true;
 	}
 
-	Bool Lexer::LexNewLine(Token& t)
-	{
-		t.SetKind(TokenKind::newline);
-		t.SetLocation(loc);
-		return true;
-	}
-
-	Bool Lexer::LexComment(Token& t)
-	{
-		FillToken(t, TokenKind::comment, [](Char c) -> Bool { return c != '\n' && c != '\0'; });
-		UpdatePointersAndLocation();
-		return true;
-	}
-
 	Bool Lexer::LexPunctuator(Token& t)
 	{
 		Char c = *cur_ptr++;
@@ -397,7 +477,7 @@ namespace ola
 			break;
 		}
 		t.SetLocation(loc);
-		UpdatePointersAndLocation();
+		UpdateLocation();
 		return true;
 	}
 
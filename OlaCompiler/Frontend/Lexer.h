@@ -1,5 +1,4 @@
 #pragma once
-#include <vector>
 #include <string>
 #include "Token.h"
 
@@ -7,6 +6,7 @@ namespace ola
 {
 	class SourceBuffer;
 	class Diagnostics;
+	class FrontendContext;
 
 	template<typename P>
 	concept CharPredicate = requires(P p, Char a)
@@ -14,39 +14,43 @@ namespace ola
 		{ p(a) } -> std::convertible_to<Bool>;
 	};
 
+	//Tokens are lexed one at a time as they are requested, whitespace, newlines and comments are skipped without creating tokens for them
 	class Lexer
 	{
 	public:
-		explicit Lexer(Diagnostics& diagnostics);
+		Lexer(FrontendContext* context, Diagnostics& diagnostics, SourceBuffer const& source);
 		OLA_NONCOPYABLE_NONMOVABLE(Lexer)
 		~Lexer() = default;
 
-		void Lex(SourceBuffer const& source);
-		std::vector<Token>&& GetTokens() { return std::move(tokens); }
+		//Once the end of the source is reached, every following token is eof
+		void Lex(Token& token);
 
 	private:
+		FrontendContext* context;
 		Diagnostics& diagnostics;
+		SourceBuffer const& source;
 		Char const* buf_ptr = nullptr;
 		Char const* cur_ptr = nullptr;
+		Bool lexing_prefix = false;
+		Bool failed = false;
 
+		SourceLocation start_loc;
 		SourceLocation loc;
-		std::vector<Token> tokens;
 	private:
 
+		void SetBuffer(Char const* buffer, Bool is_prefix);
 		Bool LexToken(Token&);
 		Bool LexNumber(Token&);
 		Bool LexIdentifier(Token&);
 		Bool LexChar(Token&);
 		Bool LexString(Token&);
 		Bool LexEndOfFile(Token&);
-		Bool LexNewLine(Token&);
-		Bool LexComment(Token&);
 		Bool LexPunctuator(Token&);
 
-		void UpdatePointersAndLocation()
+		//Prepended text has no range in the location space, its tokens are attributed to the start of the file
+		void UpdateLocation()
 		{
-			loc.NewChars(static_cast<Int32>(cur_ptr - buf_ptr));
-			buf_ptr = cur_ptr;
+			loc = lexing_prefix ? start_loc : start_loc + static_cast<Int32>(cur_ptr - buf_ptr);
 		}
 
 		void FillToken(Token& t, TokenKind type, Char const* end)
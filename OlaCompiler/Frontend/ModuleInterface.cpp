@@ -0,0 +1,594 @@
+#include <bit>
+#include <cstring>
+#include "ModuleInterface.h"
+#include "Diagnostics.h"
+#include "FrontendContext.h"
+#include "AST/AST.h"
+#include "AST/Decl.h"
+#include "AST/Expr.h"
+#include "AST/Type.h"
+#include "Utility/ByteStream.h"
+#include "Utility/Hash.h"
+
+namespace ola
+{
+	namespace
+	{
+		constexpr Char ModuleInterfaceMagic[] = { 'O', 'L', 'A', 'M' };
+		constexpr Uint32 ModuleInterfaceVersion = 1;
+
+		enum class ClassRefKind : Uint8
+		{
+			Module,
+			Named
+		};
+
+		enum class FieldInitKind : Uint8
+		{
+			None,
+			Int,
+			Float
+		};
+
+		Uint64 ComputeInterfaceHash(Uint64 source_hash, std::vector<ModuleImport> const& imports)
+		{
+			HashState hash;
+			hash.Combine(source_hash);
+			for (ModuleImport const& import : imports) hash.Combine(import.interface_hash);
+			return hash;
+		}
+
+		//Builtin declarations and declarations imported from other modules have no location
+		Bool IsExported(Decl const* decl)
+		{
+			if (!decl->GetLocation().IsValid()) return false;
+			switch (decl->GetDeclKind())
+			{
+			case DeclKind::Function:
+			case DeclKind::Var:
+				return decl->IsPublic() || decl->IsExtern();
+			case DeclKind::Enum:
+			case DeclKind::Alias:
+			case DeclKind::Class:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		class ModuleInterfaceEncoder
+		{
+		public:
+			explicit ModuleInterfaceEncoder(AST const* ast)
+			{
+				for (auto const& decl : ast->translation_unit->GetDecls())
+				{
+					if (!IsExported(decl)) continue;
+					decl_indices[decl] = static_cast<Uint32>(exported_decls.size());
+					exported_decls.push_back(decl);
+				}
+			}
+
+			void Encode(ByteWriter& writer, Uint64 source_hash, std::vector<ModuleImport> const& imports)
+			{
+				ByteWriter decl_records;
+				std::vector<Uint64> decl_offsets;
+				for (Decl const* decl : exported_decls)
+				{
+					decl_offsets.push_back(decl_records.GetSize());
+					WriteDecl(decl_records, decl);
+				}
+
+				for (Char c : ModuleInterfaceMagic) writer.WriteByte(static_cast<Uint8>(c));
+				writer.WriteVarint(ModuleInterfaceVersion);
+				writer.WriteFixed64(source_hash);
+				writer.WriteVarint(imports.size());
+				for (ModuleImport const& import : imports)
+				{
+					writer.WriteString(import.path);
+					writer.WriteFixed64(import.interface_hash);
+				}
+
+				writer.WriteVarint(type_offsets.size());
+				for (Uint64 offset : type_offsets) writer.WriteVarint(offset);
+				writer.WriteVarint(decl_offsets.size());
+				for (Uint64 offset : decl_offsets) writer.WriteVarint(type_records.GetSize() + offset);
+				WriteNameIndex(writer, false);
+				WriteNameIndex(writer, true);
+
+				for (Uint8 byte : type_records.GetBytes()) writer.WriteByte(byte);
+				for (Uint8 byte : decl_records.GetBytes()) writer.WriteByte(byte);
+			}
+
+		private:
+			std::vector<Decl const*> exported_decls;
+			std::unordered_map<Decl const*, Uint32> decl_indices;
+			ByteWriter type_records;
+			std::vector<Uint64> type_offsets;
+			std::unordered_map<Type const*, Uint32> type_indices;
+
+		private:
+			void WriteNameIndex(ByteWriter& writer, Bool tags)
+			{
+				std::vector<std::pair<std::string_view, Uint32>> names;
+				for (Uint32 i = 0; i < exported_decls.size(); ++i)
+				{
+					Decl const* decl = exported_decls[i];
+					if (decl->IsTag())
+					{
+						if (tags && !decl->GetName().empty()) names.emplace_back(decl->GetName(), i);
+						if (!tags && isa<EnumDecl>(decl))
+						{
+							for (auto const& enum_member : cast<EnumDecl>(decl)->GetEnumMembers()) names.emplace_back(enum_member->GetName(), i);
+						}
+					}
+					else if (!tags) names.emplace_back(decl->GetName(), i);
+				}
+				writer.WriteVarint(names.size());
+				for (auto const& [name, index] : names)
+				{
+					writer.WriteString(name);
+					writer.WriteVarint(index);
+				}
+			}
+
+			void WriteQualType(ByteWriter& writer, QualType const& type)
+			{
+				writer.WriteVarint(GetTypeIndex(type.GetTypePtr()));
+				writer.WriteByte(type.IsConst() ? Qualifier_Const : Qualifier_None);
+			}
+
+			Uint32 GetTypeIndex(Type const* type)
+			{
+				OLA_ASSERT(type);
+				if (auto it = type_indices.find(type); it != type_indices.end()) return it->second;
+
+				ByteWriter record;
+				record.WriteByte(static_cast<Uint8>(type->GetKind()));
+				switch (type->GetKind())
+				{
+				case TypeKind::Array:
+				{
+					ArrayType const* array_type = cast<ArrayType>(type);
+					WriteQualType(record, array_type->GetElementType());
+					record.WriteVarint(array_type->GetArraySize());
+				}
+				break;
+				case TypeKind::Ref:
+					WriteQualType(record, cast<RefType>(type)->GetReferredType());
+					break;
+				case TypeKind::Function:
+				{
+					FuncType const* func_type = cast<FuncType>(type);
+					WriteQualType(record, func_type->GetReturnType());
+					record.WriteVarint(func_type->GetParamCount());
+					for (QualType const& param_type : func_type->GetParams()) WriteQualType(record, param_type);
+				}
+				break;
+				case TypeKind::Class:
+				{
+					ClassDecl const* class_decl = cast<ClassType>(type)->GetClassDecl();
+					if (auto it = decl_indices.find(class_decl); it != decl_indices.end())
+					{
+						record.WriteByte(static_cast<Uint8>(ClassRefKind::Module));
+						record.WriteVarint(it->second);
+					}
+					else
+					{
+						record.WriteByte(static_cast<Uint8>(ClassRefKind::Named));
+						record.WriteString(class_decl->GetName());
+					}
+				}
+				break;
+				default:
+					//builtin types are identified by their kind alone
+					break;
+				}
+
+				Uint32 const index = static_cast<Uint32>(type_offsets.size());
+				type_offsets.push_back(type_records.GetSize());
+				for (Uint8 byte : record.GetBytes()) type_records.WriteByte(byte);
+				type_indices[type] = index;
+				return index;
+			}
+
+			void WriteDecl(ByteWriter& writer, Decl const* decl)
+			{
+				writer.WriteByte(static_cast<Uint8>(decl->GetDeclKind()));
+				writer.WriteString(decl->GetName());
+				switch (decl->GetDeclKind())
+				{
+				case DeclKind::Function:
+					WriteFunction(writer, cast<FunctionDecl>(decl));
+					break;
+				case DeclKind::Var:
+				case DeclKind::Alias:
+					WriteQualType(writer, decl->GetType());
+					break;
+				case DeclKind::Enum:
+				{
+					ASTSpan<EnumMemberDecl> enum_members = cast<EnumDecl>(decl)->GetEnumMembers();
+					writer.WriteVarint(enum_members.size());
+					for (auto const& enum_member : enum_members)
+					{
+						writer.WriteString(enum_member->GetName());
+						writer.WriteSignedVarint(enum_member->GetValue());
+					}
+				}
+				break;
+				case DeclKind::Class:
+					WriteClass(writer, cast<ClassDecl>(decl));
+					break;
+				default:
+					OLA_UNREACHABLE();
+				}
+			}
+
+			void WriteFunction(ByteWriter& writer, FunctionDecl const* function_decl)
+			{
+				WriteQualType(writer, function_decl->GetType());
+				writer.WriteVarint(function_decl->GetParamDecls().size());
+				for (auto const& param_decl : function_decl->GetParamDecls()) writer.WriteString(param_decl->GetName());
+				writer.WriteByte(function_decl->GetFuncAttributes());
+			}
+
+			void WriteClass(ByteWriter& writer, ClassDecl const* class_decl)
+			{
+				ClassDecl const* base_class = class_decl->GetBaseClass();
+				writer.WriteByte(base_class != nullptr);
+				if (base_class) WriteQualType(writer, base_class->GetType());
+				writer.WriteByte(class_decl->IsFinal());
+
+				writer.WriteVarint(class_decl->GetFields().size());
+				for (auto const& field : class_decl->GetFields())
+				{
+					writer.WriteString(field->GetName());
+					WriteQualType(writer, field->GetType());
+					writer.WriteByte(static_cast<Uint8>(field->GetVisibility()));
+					WriteFieldInit(writer, field->GetInitExpr());
+				}
+
+				writer.WriteVarint(class_decl->GetMethods().size());
+				for (auto const& method : class_decl->GetMethods())
+				{
+					writer.WriteByte(static_cast<Uint8>(method->GetDeclKind()));
+					writer.WriteString(method->GetName());
+					WriteFunction(writer, method);
+					writer.WriteByte(static_cast<Uint8>(method->GetVisibility()));
+					writer.WriteByte(method->GetMethodAttributes());
+				}
+			}
+
+			//Field initializers are constants, they are stored as values and read back as literals of the field's type
+			static void WriteFieldInit(ByteWriter& writer, Expr const* init_expr)
+			{
+				while (ImplicitCastExpr const* cast_expr = dyn_cast<ImplicitCastExpr>(init_expr)) init_expr = cast_expr->GetOperand();
+
+				if (FloatLiteral const* float_literal = dyn_cast<FloatLiteral>(init_expr))
+				{
+					writer.WriteByte(static_cast<Uint8>(FieldInitKind::Float));
+					writer.WriteFixed64(std::bit_cast<Uint64>(float_literal->GetValue()));
+				}
+				else if (BoolLiteral const* bool_literal = dyn_cast<BoolLiteral>(init_expr))
+				{
+					writer.WriteByte(static_cast<Uint8>(FieldInitKind::Int));
+					writer.WriteSignedVarint(bool_literal->GetValue());
+				}
+				else if (init_expr && init_expr->IsConstexpr() && !isa<StringLiteral>(init_expr))
+				{
+					writer.WriteByte(static_cast<Uint8>(FieldInitKind::Int));
+					writer.WriteSignedVarint(init_expr->EvaluateConstexpr());
+				}
+				else writer.WriteByte(static_cast<Uint8>(FieldInitKind::None));
+			}
+		};
+	}
+
+	std::vector<Uint8> ModuleInterface::Write(AST const* ast, Uint64 source_hash, std::vector<ModuleImport> const& imports)
+	{
+		ByteWriter writer;
+		ModuleInterfaceEncoder encoder(ast);
+		encoder.Encode(writer, source_hash, imports);
+		return writer.GetBytes();
+	}
+
+	std::shared_ptr<ModuleInterface const> ModuleInterface::Read(std::vector<Uint8>&& buffer)
+	{
+		if (buffer.size() < sizeof(ModuleInterfaceMagic) || std::memcmp(buffer.data(), ModuleInterfaceMagic, sizeof(ModuleInterfaceMagic)) != 0) return nullptr;
+
+		std::shared_ptr<ModuleInterface> module(new ModuleInterface());
+		module->buffer = std::move(buffer);
+		ByteReader reader(module->buffer.data() + sizeof(ModuleInterfaceMagic), module->buffer.size() - sizeof(ModuleInterfaceMagic));
+		if (reader.ReadVarint() != ModuleInterfaceVersion) return nullptr;
+
+		module->source_hash = reader.ReadFixed64();
+		Uint64 const import_count = reader.ReadVarint();
+		for (Uint64 i = 0; i < import_count && !reader.HasError(); ++i)
+		{
+			std::string path(reader.ReadString());
+			module->imports.push_back(ModuleImport{ .path = std::move(path), .interface_hash = reader.ReadFixed64() });
+		}
+		module->interface_hash = ComputeInterfaceHash(module->source_hash, module->imports);
+
+		auto ReadOffsets = [&reader](std::vector<Uint32>& offsets)
+			{
+				Uint64 const count = reader.ReadVarint();
+				for (Uint64 i = 0; i < count && !reader.HasError(); ++i) offsets.push_back(static_cast<Uint32>(reader.ReadVarint()));
+			};
+		ReadOffsets(module->type_offsets);
+		ReadOffsets(module->decl_offsets);
+
+		auto ReadNameIndex = [&reader, &module](NameIndex& name_index)
+			{
+				Uint64 const count = reader.ReadVarint();
+				for (Uint64 i = 0; i < count && !reader.HasError(); ++i)
+				{
+					std::string name(reader.ReadString());
+					Uint64 const index = reader.ReadVarint();
+					if (index >= module->decl_offsets.size()) return;
+					name_index[std::move(name)].push_back(static_cast<Uint32>(index));
+				}
+			};
+		ReadNameIndex(module->decl_names);
+		ReadNameIndex(module->tag_names);
+		if (reader.HasError()) return nullptr;
+
+		Uint64 const records_offset = reader.GetPosition() - module->buffer.data();
+		for (Uint32& offset : module->type_offsets) offset += static_cast<Uint32>(records_offset);
+		for (Uint32& offset : module->decl_offsets) offset += static_cast<Uint32>(records_offset);
+		return module;
+	}
+
+	ModuleInterfaceReader::ModuleInterfaceReader(FrontendContext* ctx, ASTContext* ast_ctx, Diagnostics& diagnostics, std::shared_ptr<ModuleInterface const> const& module,
+		SymbolTable<Decl>& decl_sym_table, SymbolTable<TagDecl>& tag_sym_table, DeclPtrList& imported_decls)
+		: ctx(ctx), ast_ctx(ast_ctx), diagnostics(diagnostics), module(module), decl_sym_table(decl_sym_table), tag_sym_table(tag_sym_table), imported_decls(imported_decls),
+		  decls(module->decl_offsets.size(), nullptr), types(module->type_offsets.size(), nullptr)
+	{
+	}
+
+	void ModuleInterfaceReader::LoadDecls(std::string_view name)
+	{
+		auto it = module->decl_names.find(name);
+		if (it == module->decl_names.end()) return;
+		for (Uint32 index : it->second) LoadDecl(index);
+	}
+
+	void ModuleInterfaceReader::LoadTags(std::string_view name)
+	{
+		auto it = module->tag_names.find(name);
+		if (it == module->tag_names.end()) return;
+		for (Uint32 index : it->second) LoadDecl(index);
+	}
+
+	Decl* ModuleInterfaceReader::LoadDecl(Uint32 index)
+	{
+		if (decls[index]) return decls[index];
+
+		std::vector<Uint8> const& buffer = module->buffer;
+		Uint32 const offset = module->decl_offsets[index];
+		ByteReader reader(buffer.data() + offset, buffer.size() - offset);
+		auto ReadQualType = [this, &reader]()
+			{
+				Uint32 const type_index = static_cast<Uint32>(reader.ReadVarint());
+				Qualifiers const qualifiers = reader.ReadByte();
+				return QualType(type_index < types.size() ? LoadType(type_index) : nullptr, qualifiers);
+			};
+		auto ReadParamDecls = [this, &reader](FuncType const* func_type)
+			{
+				ParamVarDeclPtrList param_decls;
+				Uint64 const param_count = reader.ReadVarint();
+				for (Uint64 i = 0; i < param_count && i < func_type->GetParamCount(); ++i)
+				{
+					ParamVarDecl* param_decl = ast_ctx->New<ParamVarDecl>(ctx->GetIdentifier(reader.ReadString()), SourceLocation{});
+					param_decl->SetGlobal(false);
+					param_decl->SetVisibility(DeclVisibility::None);
+					param_decl->SetType(func_type->GetParams()[i]);
+					param_decls.push_back(param_decl);
+				}
+				return param_decls;
+			};
+
+		DeclKind const decl_kind = static_cast<DeclKind>(reader.ReadByte());
+		std::string_view const name = reader.ReadString();
+		switch (decl_kind)
+		{
+		case DeclKind::Function:
+		{
+			QualType const type = ReadQualType();
+			FunctionDecl* function_decl = ast_ctx->New<FunctionDecl>(ctx->GetIdentifier(name), SourceLocation{});
+			function_decl->SetType(type);
+			function_decl->SetParamDecls(ast_ctx->NewArray(ReadParamDecls(function_decl->GetFuncType())));
+			function_decl->SetFuncAttributes(reader.ReadByte());
+			function_decl->SetVisibility(DeclVisibility::Extern);
+			decl_sym_table.InsertGlobal_Overload(function_decl);
+			decls[index] = function_decl;
+			imported_decls.push_back(function_decl);
+		}
+		break;
+		case DeclKind::Var:
+		{
+			VarDecl* var_decl = ast_ctx->New<VarDecl>(ctx->GetIdentifier(name), SourceLocation{});
+			var_decl->SetType(ReadQualType());
+			var_decl->SetGlobal(true);
+			var_decl->SetVisibility(DeclVisibility::Extern);
+			decl_sym_table.InsertGlobal(var_decl);
+			decls[index] = var_decl;
+			imported_decls.push_back(var_decl);
+		}
+		break;
+		case DeclKind::Enum:
+		{
+			EnumDecl* enum_decl = ast_ctx->New<EnumDecl>(ctx->GetIdentifier(name), SourceLocation{});
+			EnumMemberDeclPtrList enum_members;
+			Uint64 const member_count = reader.ReadVarint();
+			for (Uint64 i = 0; i < member_count && !reader.HasError(); ++i)
+			{
+				EnumMemberDecl* enum_member = ast_ctx->New<EnumMemberDecl>(ctx->GetIdentifier(reader.ReadString()), SourceLocation{});
+				enum_member->SetType(IntType::Get(ctx));
+				enum_member->SetValue(reader.ReadSignedVarint());
+				decl_sym_table.InsertGlobal(enum_member);
+				enum_members.push_back(enum_member);
+			}
+			enum_decl->SetEnumMembers(ast_ctx->NewArray(enum_members));
+			if (!name.empty()) tag_sym_table.InsertGlobal(enum_decl);
+			decls[index] = enum_decl;
+			imported_decls.push_back(enum_decl);
+		}
+		break;
+		case DeclKind::Alias:
+		{
+			AliasDecl* alias_decl = ast_ctx->New<AliasDecl>(ctx->GetIdentifier(name), SourceLocation{}, ReadQualType());
+			tag_sym_table.InsertGlobal(alias_decl);
+			decls[index] = alias_decl;
+			imported_decls.push_back(alias_decl);
+		}
+		break;
+		case DeclKind::Class:
+		{
+			//The class is registered before its members are read since they can refer to it
+			ClassDecl* class_decl = ast_ctx->New<ClassDecl>(ctx->GetIdentifier(name), SourceLocation{});
+			decls[index] = class_decl;
+			class_decl->SetType(ClassType::Get(ctx, class_decl));
+			if (reader.ReadByte())
+			{
+				QualType const base_type = ReadQualType();
+				if (ClassType const* base_class_type = dyn_cast<ClassType>(base_type.GetTypePtr())) class_decl->SetBaseClass(base_class_type->GetClassDecl());
+			}
+			class_decl->SetFinal(reader.ReadByte());
+
+			FieldDeclPtrList fields;
+			Uint64 const field_count = reader.ReadVarint();
+			for (Uint64 i = 0; i < field_count && !reader.HasError(); ++i)
+			{
+				FieldDecl* field = ast_ctx->New<FieldDecl>(ctx->GetIdentifier(reader.ReadString()), SourceLocation{});
+				QualType const field_type = ReadQualType();
+				field->SetType(field_type);
+				field->SetGlobal(false);
+				field->SetVisibility(static_cast<DeclVisibility>(reader.ReadByte()));
+
+				FieldInitKind const init_kind = static_cast<FieldInitKind>(reader.ReadByte());
+				if (init_kind != FieldInitKind::None && !field_type.IsNull())
+				{
+					Float64 const float_value = init_kind == FieldInitKind::Float ? std::bit_cast<Float64>(reader.ReadFixed64()) : 0.0;
+					Int64 const int_value = init_kind == FieldInitKind::Int ? reader.ReadSignedVarint() : static_cast<Int64>(float_value);
+
+					Expr* init_expr = nullptr;
+					if (isa<FloatType>(field_type))
+					{
+						init_expr = ast_ctx->New<FloatLiteral>(init_kind == FieldInitKind::Float ? float_value : static_cast<Float64>(int_value), SourceLocation{});
+						init_expr->SetType(FloatType::Get(ctx));
+					}
+					else if (isa<BoolType>(field_type))
+					{
+						init_expr = ast_ctx->New<BoolLiteral>(int_value != 0, SourceLocation{});
+						init_expr->SetType(BoolType::Get(ctx));
+					}
+					else if (isa<CharType>(field_type))
+					{
+						init_expr = ast_ctx->New<CharLiteral>(static_cast<Char>(int_value), SourceLocation{});
+						init_expr->SetType(CharType::Get(ctx));
+					}
+					else
+					{
+						init_expr = ast_ctx->New<IntLiteral>(int_value, SourceLocation{});
+						init_expr->SetType(IntType::Get(ctx));
+					}
+					field->SetInitExpr(init_expr);
+				}
+				fields.push_back(field);
+			}
+			class_decl->SetFields(ast_ctx->NewArray(fields));
+
+			MethodDeclPtrList methods;
+			Uint64 const method_count = reader.ReadVarint();
+			for (Uint64 i = 0; i < method_count && !reader.HasError(); ++i)
+			{
+				DeclKind const method_kind = static_cast<DeclKind>(reader.ReadByte());
+				std::string_view const method_name = reader.ReadString();
+				MethodDecl* method = nullptr;
+				if (method_kind == DeclKind::Constructor) method = ast_ctx->New<ConstructorDecl>(ctx->GetIdentifier(method_name), SourceLocation{});
+				else method = ast_ctx->New<MethodDecl>(ctx->GetIdentifier(method_name), SourceLocation{});
+
+				method->SetType(ReadQualType());
+				method->SetParamDecls(ast_ctx->NewArray(ReadParamDecls(method->GetFuncType())));
+				method->SetFuncAttributes(reader.ReadByte());
+				method->SetVisibility(static_cast<DeclVisibility>(reader.ReadByte()));
+				method->SetMethodAttributes(reader.ReadByte());
+				methods.push_back(method);
+			}
+			class_decl->SetMethods(ast_ctx->NewArray(methods));
+
+			MethodDecl const* error_decl = nullptr;
+			class_decl->BuildVTable(ast_ctx, error_decl);
+			tag_sym_table.InsertGlobal(class_decl);
+			imported_decls.push_back(class_decl);
+		}
+		break;
+		default:
+			OLA_UNREACHABLE();
+		}
+		return decls[index];
+	}
+
+	Type const* ModuleInterfaceReader::LoadType(Uint32 index)
+	{
+		if (types[index]) return types[index];
+
+		std::vector<Uint8> const& buffer = module->buffer;
+		Uint32 const offset = module->type_offsets[index];
+		ByteReader reader(buffer.data() + offset, buffer.size() - offset);
+		auto ReadQualType = [this, &reader]()
+			{
+				Uint32 const type_index = static_cast<Uint32>(reader.ReadVarint());
+				Qualifiers const qualifiers = reader.ReadByte();
+				return QualType(type_index < types.size() ? LoadType(type_index) : nullptr, qualifiers);
+			};
+
+		Type const* type = nullptr;
+		switch (static_cast<TypeKind>(reader.ReadByte()))
+		{
+		case TypeKind::Void:  type = VoidType::Get(ctx);  break;
+		case TypeKind::Bool:  type = BoolType::Get(ctx);  break;
+		case TypeKind::Char:  type = CharType::Get(ctx);  break;
+		case TypeKind::Int:   type = IntType::Get(ctx);   break;
+		case TypeKind::Float: type = FloatType::Get(ctx); break;
+		case TypeKind::Ref:   type = RefType::Get(ctx, ReadQualType()); break;
+		case TypeKind::Array:
+		{
+			QualType const element_type = ReadQualType();
+			type = ArrayType::Get(ctx, element_type, static_cast<Uint32>(reader.ReadVarint()));
+		}
+		break;
+		case TypeKind::Function:
+		{
+			QualType const return_type = ReadQualType();
+			std::vector<QualType> param_types(reader.ReadVarint());
+			for (QualType& param_type : param_types) param_type = ReadQualType();
+			type = FuncType::Get(ctx, return_type, param_types);
+		}
+		break;
+		case TypeKind::Class:
+		{
+			ClassDecl const* class_decl = nullptr;
+			if (static_cast<ClassRefKind>(reader.ReadByte()) == ClassRefKind::Module)
+			{
+				Uint64 const decl_index = reader.ReadVarint();
+				if (decl_index < decls.size()) class_decl = dyn_cast<ClassDecl>(LoadDecl(static_cast<Uint32>(decl_index)));
+			}
+			else
+			{
+				//Classes of other modules are resolved by name in the importing translation unit
+				std::string_view const class_name = reader.ReadString();
+				class_decl = dyn_cast<ClassDecl>(tag_sym_table.LookUp(ctx->GetIdentifier(class_name)));
+				if (!class_decl) diagnostics.Report(SourceLocation{}, undeclared_identifier, class_name);
+			}
+			if (class_decl) type = ClassType::Get(ctx, class_decl);
+		}
+		break;
+		default:
+			break;
+		}
+		types[index] = type;
+		return type;
+	}
+}
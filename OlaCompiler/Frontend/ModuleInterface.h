@@ -0,0 +1,84 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Scope.h"
+#include "AST/Decl.h"
+
+namespace ola
+{
+	class FrontendContext;
+	class Diagnostics;
+	struct AST;
+
+	struct ModuleImport
+	{
+		std::string path;
+		Uint64 interface_hash;
+	};
+
+	//Binary interface of an imported module, stored in a .olam file in the interface directory. It holds the declarations the module exports:
+	//public and extern functions and variables, which importers see as extern declarations, and enums, aliases and classes.
+	//Records are only decoded when an importer looks their name up, see ModuleInterfaceReader.
+	class ModuleInterface
+	{
+		friend class ModuleInterfaceReader;
+
+		struct StringHash
+		{
+			using is_transparent = void;
+			Uint64 operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+		};
+		using NameIndex = std::unordered_map<std::string, std::vector<Uint32>, StringHash, std::equal_to<>>;
+
+	public:
+		static std::vector<Uint8> Write(AST const* ast, Uint64 source_hash, std::vector<ModuleImport> const& imports);
+		static std::shared_ptr<ModuleInterface const> Read(std::vector<Uint8>&& buffer);
+
+		Uint64 GetSourceHash() const { return source_hash; }
+		//Combines the source hash with the interfaces of the module's imports, whose types the exported declarations can refer to
+		Uint64 GetHash() const { return interface_hash; }
+		std::vector<ModuleImport> const& GetImports() const { return imports; }
+
+	private:
+		std::vector<Uint8> buffer;
+		Uint64 source_hash = 0;
+		Uint64 interface_hash = 0;
+		std::vector<ModuleImport> imports;
+		std::vector<Uint32> type_offsets;
+		std::vector<Uint32> decl_offsets;
+		NameIndex decl_names;
+		NameIndex tag_names;
+
+	private:
+		ModuleInterface() = default;
+	};
+
+	//Declares the records of a module interface in a translation unit the first time their name is looked up. Declarations are inserted
+	//into the global scope and appended to imported_decls, which the parser moves into the translation unit ahead of their first use.
+	class ModuleInterfaceReader
+	{
+	public:
+		ModuleInterfaceReader(FrontendContext* ctx, ASTContext* ast_ctx, Diagnostics& diagnostics, std::shared_ptr<ModuleInterface const> const& module,
+			SymbolTable<Decl>& decl_sym_table, SymbolTable<TagDecl>& tag_sym_table, DeclPtrList& imported_decls);
+
+		void LoadDecls(std::string_view name);
+		void LoadTags(std::string_view name);
+
+	private:
+		FrontendContext* ctx;
+		ASTContext* ast_ctx;
+		Diagnostics& diagnostics;
+		std::shared_ptr<ModuleInterface const> module;
+		SymbolTable<Decl>& decl_sym_table;
+		SymbolTable<TagDecl>& tag_sym_table;
+		DeclPtrList& imported_decls;
+		std::vector<Decl*> decls;
+		std::vector<Type const*> types;
+
+	private:
+		Decl* LoadDecl(Uint32 index);
+		Type const* LoadType(Uint32 index);
+	};
+}
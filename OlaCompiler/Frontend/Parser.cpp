@@ -1,5 +1,6 @@
 #include "Parser.h"
 #include "Diagnostics.h"
+#include "FrontendContext.h"
 #include "AST/AST.h"
 #include "Sema.h"
 
@@ -9,43 +10,45 @@ namespace ola
 	Parser::Parser(FrontendContext* context, Diagnostics& diagnostics) : context(context), diagnostics(diagnostics) {}
 	Parser::~Parser() = default;
 
-	void Parser::Parse(std::vector<Token>&& _tokens)
+	void Parser::Parse(TokenStream& _tokens, std::vector<std::shared_ptr<ModuleInterface const>> const& imported_modules)
 	{
-		tokens = std::move(_tokens);
-		current_token = tokens.begin();
-		sema = MakeUnique<Sema>(context, diagnostics);
-		ast = MakeUnique<AST>();
-		AddBuiltinDecls(ast->translation_unit);
-		ParseTranslationUnit();
-	}
-
-	void Parser::ParseImported(std::vector<Token> const& _tokens)
-	{
-		tokens = _tokens;
-		current_token = tokens.begin();
-		sema = MakeUnique<Sema>(context, diagnostics);
-		ast = MakeUnique<AST>();
+		tokens = &_tokens;
+		current_token = tokens->Begin();
+		ast = std::make_unique<AST>();
+		sema = std::make_unique<Sema>(context, &ast->context, diagnostics);
+		sema->ImportModules(imported_modules);
+		AddBuiltinDecls(ast->translation_unit.get());
 		ParseTranslationUnit();
 	}
 
 	void Parser::ParseTranslationUnit()
 	{
+		//Declarations and statements are the points where the parser holds no iterator to earlier tokens
 		while (current_token->IsNot(TokenKind::eof))
 		{
-			UniqueDeclPtrList decls = ParseGlobalDeclaration();
-			for(auto&& decl : decls) ast->translation_unit->AddDecl(std::move(decl));
+			tokens->Release(current_token);
+			DeclPtrList decls = ParseGlobalDeclaration();
+			AddImportedDecls();
+			for(auto&& decl : decls) ast->translation_unit->AddDecl(decl);
 		}
 	}
 
-	void Parser::AddBuiltinDecls(UniqueTranslationUnitPtr& TU)
+	//Declarations of imported modules are added when they are first looked up, ahead of the declaration that uses them
+	void Parser::AddImportedDecls()
+	{
+		for (auto&& decl : sema->imported_decls) ast->translation_unit->AddDecl(decl);
+		sema->imported_decls.clear();
+	}
+
+	void Parser::AddBuiltinDecls(TranslationUnit* TU)
 	{
-		UniqueAliasDeclPtr string_alias = sema->ActOnAliasDecl("string", SourceLocation{}, ArrayType::Get(context, CharType::Get(context), 0));
-		TU->AddDecl(std::move(string_alias));
+		AliasDecl* string_alias = sema->ActOnAliasDecl(context->GetIdentifier("string"), SourceLocation{}, ArrayType::Get(context, CharType::Get(context), 0));
+		TU->AddDecl(string_alias);
 	}
 
-	UniqueDeclPtrList Parser::ParseGlobalDeclaration()
+	DeclPtrList Parser::ParseGlobalDeclaration()
 	{
-		UniqueDeclPtrList global_decl_list;
+		DeclPtrList global_decl_list;
 		while (Consume(TokenKind::semicolon)) Diag(empty_statement);
 		if (Consume(TokenKind::KW_extern))
 		{
@@ -78,8 +81,8 @@ namespace ola
 				}
 				else
 				{
-					UniqueVarDeclPtrList variable_decls = ParseVariableDeclaration(visibility);
-					for (auto& variable_decl : variable_decls) global_decl_list.push_back(std::move(variable_decl));
+					VarDeclPtrList variable_decls = ParseVariableDeclaration(visibility);
+					for (auto& variable_decl : variable_decls) global_decl_list.push_back(variable_decl);
 				}
 			}
 			global_decl_list.back()->SetVisibility(visibility);
@@ -88,12 +91,12 @@ namespace ola
 		return global_decl_list;
 	}
 
-	UniqueFunctionDeclPtr Parser::ParseFunctionDeclaration()
+	FunctionDecl* Parser::ParseFunctionDeclaration()
 	{
 		SourceLocation const& loc = current_token->GetLocation();
-		std::string_view name = "";
+		Identifier name{};
 		QualType function_type{};
-		UniqueParamVarDeclPtrList param_decls;
+		ParamVarDeclPtrList param_decls;
 		FuncAttributes attrs = FuncAttribute_None;
 		{
 			SYM_TABLE_GUARD(sema->sema_ctx.decl_sym_table);
@@ -103,7 +106,7 @@ namespace ola
 			ParseTypeSpecifier(return_type);
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 
-			name = current_token->GetData(); ++current_token;
+			name = current_token->GetIdentifier(); ++current_token;
 			Expect(TokenKind::left_round);
 
 			std::vector<QualType> param_types{};
@@ -111,9 +114,9 @@ namespace ola
 			{
 				if (!param_types.empty() && !Consume(TokenKind::comma)) Diag(function_params_missing_coma);
 
-				UniqueParamVarDeclPtr param_decl = ParseParamVariableDeclaration();
+				ParamVarDecl* param_decl = ParseParamVariableDeclaration();
 				param_types.emplace_back(param_decl->GetType());
-				param_decls.push_back(std::move(param_decl));
+				param_decls.push_back(param_decl);
 			}
 			function_type.SetType(FuncType::Get(context, return_type, param_types));
 			Expect(TokenKind::semicolon, function_def_cannot_be_extern);
@@ -121,15 +124,15 @@ namespace ola
 		return sema->ActOnFunctionDecl(name, loc, function_type, std::move(param_decls), DeclVisibility::Extern, attrs);
 	}
 
-	UniqueFunctionDeclPtr Parser::ParseFunctionDefinition(DeclVisibility visibility)
+	FunctionDecl* Parser::ParseFunctionDefinition(DeclVisibility visibility)
 	{
 		SourceLocation const& loc = current_token->GetLocation();
-		std::string_view name = "";
+		Identifier name{};
 		QualType function_type{};
-		UniqueParamVarDeclPtrList param_decls;
-		UniqueCompoundStmtPtr function_body;
+		ParamVarDeclPtrList param_decls;
+		CompoundStmt* function_body;
 		FuncAttributes attrs = FuncAttribute_None;
-		UniqueFunctionDeclPtr func_decl = nullptr;
+		FunctionDecl* func_decl = nullptr;
 		{
 			SYM_TABLE_GUARD(sema->sema_ctx.decl_sym_table);
 			ParseFunctionAttributes(attrs);
@@ -139,7 +142,7 @@ namespace ola
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 
 			SourceLocation const& loc = current_token->GetLocation();
-			name = current_token->GetData(); ++current_token;
+			name = current_token->GetIdentifier(); ++current_token;
 			Expect(TokenKind::left_round);
 
 			std::vector<QualType> param_types{};
@@ -147,9 +150,9 @@ namespace ola
 			{
 				if (!param_types.empty() && !Consume(TokenKind::comma)) Diag(function_params_missing_coma);
 
-				UniqueParamVarDeclPtr param_decl = ParseParamVariableDeclaration();
+				ParamVarDecl* param_decl = ParseParamVariableDeclaration();
 				param_types.emplace_back(param_decl->GetType());
-				param_decls.push_back(std::move(param_decl));
+				param_decls.push_back(param_decl);
 			}
 			function_type.SetType(FuncType::Get(context, return_type, param_types));
 			func_decl = sema->ActOnFunctionDecl(name, loc, function_type, std::move(param_decls), visibility, attrs);
@@ -162,20 +165,20 @@ namespace ola
 			function_body = ParseCompoundStatement();
 			sema->sema_ctx.current_func = nullptr;
 		}
-		return sema->ActOnFunctionDefinition(loc, std::move(func_decl), std::move(function_body));
+		return sema->ActOnFunctionDefinition(loc, func_decl, function_body);
 	}
 
-	UniqueMethodDeclPtr Parser::ParseMethodDefinition(Bool first_pass)
+	MethodDecl* Parser::ParseMethodDefinition(Bool first_pass)
 	{
 		DeclVisibility visibility = DeclVisibility::Private;
 		if (Consume(TokenKind::KW_public)) visibility = DeclVisibility::Public;
 		else if (Consume(TokenKind::KW_private)) visibility = DeclVisibility::Private;
 
 		SourceLocation const& loc = current_token->GetLocation();
-		std::string_view name = "";
+		Identifier name{};
 		QualType function_type{};
-		UniqueParamVarDeclPtrList param_decls;
-		UniqueCompoundStmtPtr function_body;
+		ParamVarDeclPtrList param_decls;
+		CompoundStmt* function_body;
 		FuncAttributes func_attrs = FuncAttribute_None;
 		MethodAttributes method_attrs = MethodAttribute_None;
 		{
@@ -187,16 +190,16 @@ namespace ola
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 
 			SourceLocation const& loc = current_token->GetLocation();
-			name = current_token->GetData(); ++current_token;
+			name = current_token->GetIdentifier(); ++current_token;
 			Expect(TokenKind::left_round);
 			std::vector<QualType> param_types{};
 			while (!Consume(TokenKind::right_round))
 			{
 				if (!param_types.empty() && !Consume(TokenKind::comma)) Diag(function_params_missing_coma);
 
-				UniqueParamVarDeclPtr param_decl = ParseParamVariableDeclaration();
+				ParamVarDecl* param_decl = ParseParamVariableDeclaration();
 				param_types.emplace_back(param_decl->GetType());
-				param_decls.push_back(std::move(param_decl));
+				param_decls.push_back(param_decl);
 			}
 			function_type.SetType(FuncType::Get(context, return_type, param_types));
 			ParseMethodAttributes(method_attrs);
@@ -225,30 +228,30 @@ namespace ola
 				}
 			}
 		}
-		return first_pass ? nullptr : sema->ActOnMethodDecl(name, loc, function_type, std::move(param_decls), std::move(function_body), visibility, func_attrs, method_attrs);
+		return first_pass ? nullptr : sema->ActOnMethodDecl(name, loc, function_type, std::move(param_decls), function_body, visibility, func_attrs, method_attrs);
 	}
 
-	UniqueConstructorDeclPtr Parser::ParseConstructorDefinition(Bool first_pass)
+	ConstructorDecl* Parser::ParseConstructorDefinition(Bool first_pass)
 	{
 		SourceLocation const& loc = current_token->GetLocation();
-		std::string_view name = "";
+		Identifier name{};
 		QualType function_type{};
-		UniqueParamVarDeclPtrList param_decls;
-		UniqueCompoundStmtPtr constructor_body;
+		ParamVarDeclPtrList param_decls;
+		CompoundStmt* constructor_body;
 		{
 			SYM_TABLE_GUARD(sema->sema_ctx.decl_sym_table);
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 			SourceLocation const& loc = current_token->GetLocation();
-			name = current_token->GetData(); ++current_token;
+			name = current_token->GetIdentifier(); ++current_token;
 			Expect(TokenKind::left_round);
 			std::vector<QualType> param_types{};
 			while (!Consume(TokenKind::right_round))
 			{
 				if (!param_types.empty() && !Consume(TokenKind::comma)) Diag(function_params_missing_coma);
 
-				UniqueParamVarDeclPtr param_decl = ParseParamVariableDeclaration();
+				ParamVarDecl* param_decl = ParseParamVariableDeclaration();
 				param_types.emplace_back(param_decl->GetType());
-				param_decls.push_back(std::move(param_decl));
+				param_decls.push_back(param_decl);
 			}
 			function_type.SetType(FuncType::Get(context, VoidType::Get(context), param_types));
 			if (first_pass)
@@ -276,29 +279,29 @@ namespace ola
 				}
 			}
 		}
-		return first_pass ? nullptr : sema->ActOnConstructorDecl(name, loc, function_type, std::move(param_decls), std::move(constructor_body));
+		return first_pass ? nullptr : sema->ActOnConstructorDecl(name, loc, function_type, std::move(param_decls), constructor_body);
 	}
 
-	UniqueParamVarDeclPtr Parser::ParseParamVariableDeclaration()
+	ParamVarDecl* Parser::ParseParamVariableDeclaration()
 	{
 		QualType variable_type{};
 		ParseTypeQualifier(variable_type);
 		ParseTypeSpecifier(variable_type);
 
 		SourceLocation const& loc = current_token->GetLocation();
-		std::string_view name = "";
+		Identifier name{};
 		if (current_token->Is(TokenKind::identifier))
 		{
-			name = current_token->GetData(); 
+			name = current_token->GetIdentifier(); 
 			++current_token;
 		}
 
 		return sema->ActOnParamVariableDecl(name, loc, variable_type);
 	}
 
-	UniqueVarDeclPtrList Parser::ParseVariableDeclaration(DeclVisibility visibility)
+	VarDeclPtrList Parser::ParseVariableDeclaration(DeclVisibility visibility)
 	{
-		UniqueVarDeclPtrList var_decl_list;
+		VarDeclPtrList var_decl_list;
 		QualType variable_type{};
 		ParseTypeQualifier(variable_type);
 		ParseTypeSpecifier(variable_type);
@@ -307,9 +310,9 @@ namespace ola
 			if (!var_decl_list.empty()) Expect(TokenKind::comma);
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 			SourceLocation const& loc = current_token->GetLocation();
-			std::string_view name = current_token->GetData(); ++current_token;
+			Identifier name = current_token->GetIdentifier(); ++current_token;
 
-			UniqueExprPtr init_expr = nullptr;
+			Expr* init_expr = nullptr;
 			if (Consume(TokenKind::equal))
 			{
 				if (current_token->Is(TokenKind::left_brace)) init_expr = ParseInitializerListExpression();
@@ -317,13 +320,13 @@ namespace ola
 			}
 			else if (Consume(TokenKind::left_round))
 			{
-				UniqueExprPtrList args;
+				ExprPtrList args;
 				if (!Consume(TokenKind::right_round))
 				{
 					while (true)
 					{
-						UniqueExprPtr arg_expr = ParseAssignmentExpression();
-						args.push_back(std::move(arg_expr));
+						Expr* arg_expr = ParseAssignmentExpression();
+						args.push_back(arg_expr);
 						if (Consume(TokenKind::right_round)) break;
 						Expect(TokenKind::comma);
 					}
@@ -331,21 +334,21 @@ namespace ola
 				init_expr = sema->ActOnConstructorExpr(loc, variable_type, std::move(args));
 			}
 
-			UniqueVarDeclPtr var_decl = sema->ActOnVariableDecl(name, loc, variable_type, std::move(init_expr), visibility);
-			var_decl_list.push_back(std::move(var_decl));
+			VarDecl* var_decl = sema->ActOnVariableDecl(name, loc, variable_type, init_expr, visibility);
+			var_decl_list.push_back(var_decl);
 
 		} while (!Consume(TokenKind::semicolon));
 
 		return var_decl_list;
 	}
 
-	UniqueFieldDeclPtrList Parser::ParseFieldDeclaration(Bool first_pass)
+	FieldDeclPtrList Parser::ParseFieldDeclaration(Bool first_pass)
 	{
 		DeclVisibility visibility = DeclVisibility::Private;
 		if (Consume(TokenKind::KW_public)) visibility = DeclVisibility::Public;
 		else if (Consume(TokenKind::KW_private)) visibility = DeclVisibility::Private;
 
-		UniqueFieldDeclPtrList member_var_decl_list;
+		FieldDeclPtrList member_var_decl_list;
 		QualType variable_type{};
 		ParseTypeQualifier(variable_type);
 		ParseTypeSpecifier(variable_type);
@@ -354,9 +357,9 @@ namespace ola
 			if (!member_var_decl_list.empty()) Expect(TokenKind::comma);
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 			SourceLocation const& loc = current_token->GetLocation();
-			std::string_view name = current_token->GetData(); ++current_token;
+			Identifier name = current_token->GetIdentifier(); ++current_token;
 
-			UniqueExprPtr init_expr = nullptr;
+			Expr* init_expr = nullptr;
 			if (Consume(TokenKind::equal))
 			{
 				if (current_token->Is(TokenKind::left_brace)) init_expr = ParseInitializerListExpression();
@@ -364,17 +367,17 @@ namespace ola
 			}
 			if (first_pass)
 			{
-				UniqueFieldDeclPtr var_decl = sema->ActOnFieldDecl(name, loc, variable_type, std::move(init_expr), visibility);
-				member_var_decl_list.push_back(std::move(var_decl));
+				FieldDecl* var_decl = sema->ActOnFieldDecl(name, loc, variable_type, init_expr, visibility);
+				member_var_decl_list.push_back(var_decl);
 			}
 		} while (!Consume(TokenKind::semicolon));
 
 		return member_var_decl_list;
 	}
 
-	UniqueDeclPtrList Parser::ParseExternVariableDeclaration()
+	DeclPtrList Parser::ParseExternVariableDeclaration()
 	{
-		UniqueDeclPtrList var_decl_list;
+		DeclPtrList var_decl_list;
 		QualType variable_type{};
 		ParseTypeQualifier(variable_type);
 		ParseTypeSpecifier(variable_type);
@@ -383,40 +386,40 @@ namespace ola
 			if (!var_decl_list.empty()) Expect(TokenKind::comma);
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 			SourceLocation const& loc = current_token->GetLocation();
-			std::string_view name = current_token->GetData(); ++current_token;
+			Identifier name = current_token->GetIdentifier(); ++current_token;
 
-			UniqueVarDeclPtr var_decl = sema->ActOnVariableDecl(name, loc, variable_type, nullptr, DeclVisibility::Extern);
-			var_decl_list.push_back(std::move(var_decl));
+			VarDecl* var_decl = sema->ActOnVariableDecl(name, loc, variable_type, nullptr, DeclVisibility::Extern);
+			var_decl_list.push_back(var_decl);
 
 		} while (!Consume(TokenKind::semicolon));
 
 		return var_decl_list;
 	}
 
-	UniqueEnumDeclPtr Parser::ParseEnumDeclaration()
+	EnumDecl* Parser::ParseEnumDeclaration()
 	{
-		std::string enum_tag = "";
+		Identifier enum_tag{};
 		SourceLocation loc = current_token->GetLocation();
 		if (current_token->Is(TokenKind::identifier))
 		{
-			enum_tag = current_token->GetData();
+			enum_tag = current_token->GetIdentifier();
 			++current_token;
 		}
 
-		UniqueEnumMemberDeclPtrList enum_members;
+		EnumMemberDeclPtrList enum_members;
 		Expect(TokenKind::left_brace);
 		Int64 val = 0;
 		while (true)
 		{
-			std::string enum_value_name;
+			Identifier enum_value_name{};
 			if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
 			SourceLocation loc = current_token->GetLocation();
-			enum_value_name = current_token->GetData(); ++current_token;
+			enum_value_name = current_token->GetIdentifier(); ++current_token;
 
 			if (Consume(TokenKind::equal))
 			{
-				UniqueExprPtr enum_value_expr = ParseAssignmentExpression();
-				enum_members.push_back(sema->ActOnEnumMemberDecl(enum_value_name, loc, std::move(enum_value_expr)));
+				Expr* enum_value_expr = ParseAssignmentExpression();
+				enum_members.push_back(sema->ActOnEnumMemberDecl(enum_value_name, loc, enum_value_expr));
 				val = enum_members.back()->GetValue() + 1;
 			}
 			else
@@ -432,12 +435,12 @@ namespace ola
 		return sema->ActOnEnumDecl(enum_tag, loc, std::move(enum_members));
 	}
 
-	UniqueAliasDeclPtr Parser::ParseAliasDeclaration()
+	AliasDecl* Parser::ParseAliasDeclaration()
 	{
-		std::string alias_name = "";
+		Identifier alias_name{};
 		SourceLocation loc = current_token->GetLocation();
 		if (current_token->IsNot(TokenKind::identifier)) Diag(expected_identifier);
-		alias_name = current_token->GetData();
+		alias_name = current_token->GetIdentifier();
 		++current_token;
 
 		Expect(TokenKind::equal);
@@ -450,13 +453,13 @@ namespace ola
 		return sema->ActOnAliasDecl(alias_name, loc, aliased_type);
 	}
 
-	UniqueClassDeclPtr Parser::ParseClassDeclaration()
+	ClassDecl* Parser::ParseClassDeclaration()
 	{
-		std::string class_name = "";
+		Identifier class_name{};
 		SourceLocation loc = current_token->GetLocation();
 		if (current_token->Is(TokenKind::identifier))
 		{
-			class_name = current_token->GetData();
+			class_name = current_token->GetIdentifier();
 			++current_token;
 		}
 		else Expect(TokenKind::identifier);
@@ -465,11 +468,11 @@ namespace ola
 		ClassDecl const* base_class = nullptr;
 		if (Consume(TokenKind::colon))
 		{
-			std::string base_class_name = "";
+			Identifier base_class_name{};
 			if (current_token->Is(TokenKind::identifier))
 			{
-				base_class_name = current_token->GetData();
-				if (base_class_name.empty())
+				base_class_name = current_token->GetIdentifier();
+				if (base_class_name.IsEmpty())
 				{
 					Diag(expected_base_class_name);
 					return nullptr;
@@ -484,8 +487,8 @@ namespace ola
 			base_class = sema->ActOnBaseClassSpecifier(base_class_name, current_token->GetLocation());
 		}
 
-		UniqueFieldDeclPtrList member_variables;
-		UniqueMethodDeclPtrList member_functions;
+		FieldDeclPtrList member_variables;
+		MethodDeclPtrList member_functions;
 		{
 			SYM_TABLE_GUARD(sema->sema_ctx.decl_sym_table);
 			SYM_TABLE_GUARD(sema->sema_ctx.tag_sym_table);
@@ -500,21 +503,21 @@ namespace ola
 						{
 							if (current_token->Is(TokenKind::identifier))
 							{
-								UniqueConstructorDeclPtr constructor = ParseConstructorDefinition(first_pass);
-								if (!first_pass) member_functions.push_back(std::move(constructor));
+								ConstructorDecl* constructor = ParseConstructorDefinition(first_pass);
+								if (!first_pass) member_functions.push_back(constructor);
 								continue;
 							}
 
 							Bool is_function_declaration = IsFunctionDeclaration();
 							if (is_function_declaration)
 							{
-								UniqueMethodDeclPtr member_function = ParseMethodDefinition(first_pass);
-								if (!first_pass) member_functions.push_back(std::move(member_function));
+								MethodDecl* member_function = ParseMethodDefinition(first_pass);
+								if (!first_pass) member_functions.push_back(member_function);
 							}
 							else
 							{
-								UniqueFieldDeclPtrList var_decls = ParseFieldDeclaration(first_pass);
-								if (first_pass) for (auto& var_decl : var_decls) member_variables.push_back(std::move(var_decl));
+								FieldDeclPtrList var_decls = ParseFieldDeclaration(first_pass);
+								if (first_pass) for (auto& var_decl : var_decls) member_variables.push_back(var_decl);
 							}
 						}
 						Expect(TokenKind::semicolon);
@@ -525,13 +528,13 @@ namespace ola
 				current_token = start_token;
 				ParseClassMembers(false);
 			}
-			sema->sema_ctx.current_class_name = "";
+			sema->sema_ctx.current_class_name = Identifier{};
 			sema->sema_ctx.current_base_class = nullptr;
 		}
 		return sema->ActOnClassDecl(class_name, base_class, loc, std::move(member_variables), std::move(member_functions), final);
 	}
 
-	UniqueStmtPtr Parser::ParseStatement()
+	Stmt* Parser::ParseStatement()
 	{
 		switch (current_token->GetKind())
 		{
@@ -557,69 +560,70 @@ namespace ola
 		return nullptr;
 	}
 
-	UniqueCompoundStmtPtr Parser::ParseCompoundStatement()
+	CompoundStmt* Parser::ParseCompoundStatement()
 	{
 		SYM_TABLE_GUARD(sema->sema_ctx.decl_sym_table);
 		SYM_TABLE_GUARD(sema->sema_ctx.tag_sym_table);
 		Expect(TokenKind::left_brace);
-		UniqueStmtPtrList stmts;
+		StmtPtrList stmts;
 		while (current_token->IsNot(TokenKind::right_brace))
 		{
+			tokens->Release(current_token);
 			if (IsCurrentTokenTypename())
 			{
 				if (Consume(TokenKind::KW_enum))
 				{
-					UniqueEnumDeclPtr enum_decl = ParseEnumDeclaration();
-					stmts.push_back(sema->ActOnDeclStmt(std::move(enum_decl)));
+					EnumDecl* enum_decl = ParseEnumDeclaration();
+					stmts.push_back(sema->ActOnDeclStmt(enum_decl));
 				}
 				else if (Consume(TokenKind::KW_alias))
 				{
-					UniqueAliasDeclPtr alias_decl = ParseAliasDeclaration();
-					stmts.push_back(sema->ActOnDeclStmt(std::move(alias_decl)));
+					AliasDecl* alias_decl = ParseAliasDeclaration();
+					stmts.push_back(sema->ActOnDeclStmt(alias_decl));
 				}
 				else
 				{
-					UniqueVarDeclPtrList variable_decls = ParseVariableDeclaration(DeclVisibility::None);
-					for (auto& variable_decl : variable_decls) stmts.push_back(sema->ActOnDeclStmt(std::move(variable_decl)));
+					VarDeclPtrList variable_decls = ParseVariableDeclaration(DeclVisibility::None);
+					for (auto& variable_decl : variable_decls) stmts.push_back(sema->ActOnDeclStmt(variable_decl));
 				}
 			}
 			else
 			{
-				UniqueStmtPtr stmt = ParseStatement();
-				stmts.push_back(std::move(stmt));
+				Stmt* stmt = ParseStatement();
+				stmts.push_back(stmt);
 			}
 		}
 		Expect(TokenKind::right_brace);
 		return sema->ActOnCompoundStmt(std::move(stmts));
 	}
 
-	UniqueExprStmtPtr Parser::ParseExpressionStatement()
+	ExprStmt* Parser::ParseExpressionStatement()
 	{
-		if (Consume(TokenKind::semicolon)) return MakeUnique<NullStmt>();
-		UniqueExprPtr expr = ParseExpression();
+		if (Consume(TokenKind::semicolon)) return ast->context.New<NullStmt>();
+		Expr* expr = ParseExpression();
 		Expect(TokenKind::semicolon);
-		return sema->ActOnExprStmt(std::move(expr));
+		return sema->ActOnExprStmt(expr);
 	}
 
-	UniqueReturnStmtPtr Parser::ParseReturnStatement()
+	ReturnStmt* Parser::ParseReturnStatement()
 	{
 		Expect(TokenKind::KW_return);
-		UniqueExprStmtPtr ret_expr_stmt = ParseExpressionStatement();
-		return sema->ActOnReturnStmt(std::move(ret_expr_stmt));
+		ExprStmt* ret_expr_stmt = ParseExpressionStatement();
+		return sema->ActOnReturnStmt(ret_expr_stmt);
 	}
 
-	UniqueIfStmtPtr Parser::ParseIfStatement()
+	IfStmt* Parser::ParseIfStatement()
 	{
 		Expect(TokenKind::KW_if);
-		UniqueExprPtr cond_expr = ParseParenthesizedExpression();
-		UniqueStmtPtr then_stmt = ParseStatement();
-		UniqueStmtPtr else_stmt = nullptr;
+		Expr* cond_expr = ParseParenthesizedExpression();
+		Stmt* then_stmt = ParseStatement();
+		Stmt* else_stmt = nullptr;
 		if (Consume(TokenKind::KW_else)) else_stmt = ParseStatement();
 		
-		return sema->ActOnIfStmt(std::move(cond_expr), std::move(then_stmt), std::move(else_stmt));
+		return sema->ActOnIfStmt(cond_expr, then_stmt, else_stmt);
 	}
 
-	UniqueBreakStmtPtr Parser::ParseBreakStatement()
+	BreakStmt* Parser::ParseBreakStatement()
 	{
 		SourceLocation loc = current_token->GetLocation();
 		Expect(TokenKind::KW_break);
@@ -627,7 +631,7 @@ namespace ola
 		return sema->ActOnBreakStmt(loc);
 	}
 
-	UniqueContinueStmtPtr Parser::ParseContinueStatement()
+	ContinueStmt* Parser::ParseContinueStatement()
 	{
 		SourceLocation loc = current_token->GetLocation();
 		Expect(TokenKind::KW_continue);
@@ -635,30 +639,30 @@ namespace ola
 		return sema->ActOnContinueStmt(loc);
 	}
 
-	UniqueForStmtPtr Parser::ParseForStatement()
+	ForStmt* Parser::ParseForStatement()
 	{
 		Expect(TokenKind::KW_for);
 		Expect(TokenKind::left_round);
 
 		SYM_TABLE_GUARD(sema->sema_ctx.decl_sym_table);
-		UniqueStmtPtr init_stmt = nullptr;
+		Stmt* init_stmt = nullptr;
 		if (current_token->IsTypename())
 		{
-			UniqueVarDeclPtrList variable_decls = ParseVariableDeclaration(DeclVisibility::None);
-			UniqueDeclPtrList decl_list; decl_list.reserve(variable_decls.size());
-			for (auto& variable_decl : variable_decls) decl_list.push_back(std::move(variable_decl));
-			init_stmt = MakeUnique<DeclStmt>(std::move(decl_list));
+			VarDeclPtrList variable_decls = ParseVariableDeclaration(DeclVisibility::None);
+			DeclPtrList decl_list; decl_list.reserve(variable_decls.size());
+			for (auto& variable_decl : variable_decls) decl_list.push_back(variable_decl);
+			init_stmt = sema->ActOnDeclStmt(std::move(decl_list));
 		}
 		else init_stmt = ParseExpressionStatement();
 
-		UniqueExprPtr cond_expr = nullptr;
+		Expr* cond_expr = nullptr;
 		if (!Consume(TokenKind::semicolon))
 		{
 			cond_expr = ParseExpression();
 			Expect(TokenKind::semicolon);
 		}
 
-		UniqueExprPtr iter_expr = nullptr;
+		Expr* iter_expr = nullptr;
 		if (!Consume(TokenKind::right_round))
 		{
 			iter_expr = ParseExpression();
@@ -667,100 +671,100 @@ namespace ola
 
 		sema->sema_ctx.stmts_using_break_count++;
 		sema->sema_ctx.stmts_using_continue_count++;
-		UniqueStmtPtr body_stmt = ParseStatement();
+		Stmt* body_stmt = ParseStatement();
 		sema->sema_ctx.stmts_using_continue_count--;
 		sema->sema_ctx.stmts_using_break_count--;
 
-		return sema->ActOnForStmt(std::move(init_stmt), std::move(cond_expr), std::move(iter_expr), std::move(body_stmt));
+		return sema->ActOnForStmt(init_stmt, cond_expr, iter_expr, body_stmt);
 	}
 
-	UniqueForStmtPtr Parser::ParseForeachStatement()
+	ForStmt* Parser::ParseForeachStatement()
 	{
 		Expect(TokenKind::KW_foreach);
 		Expect(TokenKind::left_round);
 		SYM_TABLE_GUARD(sema->sema_ctx.decl_sym_table);
 		SourceLocation loc = current_token->GetLocation();
 
-		UniqueVarDeclPtr var_decl;
+		VarDecl* var_decl;
 		{
 			QualType variable_type{};
 			ParseTypeQualifier(variable_type);
 			ParseTypeSpecifier(variable_type);
 			SourceLocation const& loc = current_token->GetLocation();
-			std::string_view name = "";
+			Identifier name{};
 			if (current_token->Is(TokenKind::identifier))
 			{
-				name = current_token->GetData();
+				name = current_token->GetIdentifier();
 				++current_token;
 			}
 			else Diag(expected_identifier);
 			var_decl = sema->ActOnVariableDecl(name, loc, variable_type, nullptr, DeclVisibility::None);
 		}
 		Expect(TokenKind::colon);
-		UniqueExprPtr array_expr = ParseIdentifier();
+		Expr* array_expr = ParseIdentifier();
 		Expect(TokenKind::right_round);
 		
 		sema->sema_ctx.stmts_using_break_count++;
 		sema->sema_ctx.stmts_using_continue_count++;
-		UniqueStmtPtr body_stmt = ParseStatement();
+		Stmt* body_stmt = ParseStatement();
 		sema->sema_ctx.stmts_using_continue_count--;
 		sema->sema_ctx.stmts_using_break_count--;
 		
-		return sema->ActOnForeachStmt(loc, std::move(var_decl), std::move(array_expr), std::move(body_stmt));
+		return sema->ActOnForeachStmt(loc, var_decl, array_expr, body_stmt);
 		return nullptr;
 	}
 
-	UniqueWhileStmtPtr Parser::ParseWhileStatement()
+	WhileStmt* Parser::ParseWhileStatement()
 	{
 		Expect(TokenKind::KW_while);
-		UniqueExprPtr cond_expr = ParseParenthesizedExpression();
+		Expr* cond_expr = ParseParenthesizedExpression();
 		sema->sema_ctx.stmts_using_break_count++;
 		sema->sema_ctx.stmts_using_continue_count++;
-		UniqueStmtPtr body_stmt = ParseStatement();
+		Stmt* body_stmt = ParseStatement();
 		sema->sema_ctx.stmts_using_continue_count--;
 		sema->sema_ctx.stmts_using_break_count--;
-		return sema->ActOnWhileStmt(std::move(cond_expr), std::move(body_stmt));
+		return sema->ActOnWhileStmt(cond_expr, body_stmt);
 	}
 
-	UniqueDoWhileStmtPtr Parser::ParseDoWhileStatement()
+	DoWhileStmt* Parser::ParseDoWhileStatement()
 	{
 		Expect(TokenKind::KW_do);
 		sema->sema_ctx.stmts_using_break_count++;
 		sema->sema_ctx.stmts_using_continue_count++;
-		UniqueStmtPtr body_stmt = ParseStatement();
+		Stmt* body_stmt = ParseStatement();
 		sema->sema_ctx.stmts_using_continue_count--;
 		sema->sema_ctx.stmts_using_break_count--;
 		Expect(TokenKind::KW_while);
-		UniqueExprPtr cond_expr = ParseParenthesizedExpression();
+		Expr* cond_expr = ParseParenthesizedExpression();
 		Expect(TokenKind::semicolon);
-		return sema->ActOnDoWhileStmt(std::move(cond_expr), std::move(body_stmt));
+		return sema->ActOnDoWhileStmt(cond_expr, body_stmt);
 	}
 
-	UniqueCaseStmtPtr Parser::ParseCaseStatement()
+	CaseStmt* Parser::ParseCaseStatement()
 	{
 		SourceLocation loc = current_token->GetLocation();
-		UniqueExprPtr case_value = nullptr;
+		Expr* case_value = nullptr;
 		if (Consume(TokenKind::KW_case)) case_value = ParseExpression();
 		else Expect(TokenKind::KW_default);
 		Expect(TokenKind::colon);
-		return sema->ActOnCaseStmt(loc, std::move(case_value));
+		return sema->ActOnCaseStmt(loc, case_value);
 	}
 
-	UniqueSwitchStmtPtr Parser::ParseSwitchStatement()
+	SwitchStmt* Parser::ParseSwitchStatement()
 	{
 		SourceLocation loc = current_token->GetLocation();
 		Expect(TokenKind::KW_switch);
-		UniqueExprPtr case_expr = ParseParenthesizedExpression();
+		Expr* case_expr = ParseParenthesizedExpression();
 		std::vector<CaseStmt*> case_stmts{};
 		sema->sema_ctx.case_callback_stack.push_back([&](CaseStmt* case_stmt) {case_stmts.push_back(case_stmt); });
 		sema->sema_ctx.stmts_using_break_count++;
-		UniqueStmtPtr body_stmt = ParseStatement();
+		Stmt* body_stmt = ParseStatement();
 		sema->sema_ctx.stmts_using_break_count--;
 		sema->sema_ctx.case_callback_stack.pop_back();
-		return sema->ActOnSwitchStmt(loc, std::move(case_expr), std::move(body_stmt), std::move(case_stmts));
+		return sema->ActOnSwitchStmt(loc, case_expr, body_stmt, std::move(case_stmts));
 	}
 
-	UniqueGotoStmtPtr Parser::ParseGotoStatement()
+	GotoStmt* Parser::ParseGotoStatement()
 	{
 		SourceLocation loc = current_token->GetLocation();
 		Expect(TokenKind::KW_goto);
@@ -770,7 +774,7 @@ namespace ola
 		return sema->ActOnGotoStmt(loc, label_name);
 	}
 
-	UniqueLabelStmtPtr Parser::ParseLabelStatement()
+	LabelStmt* Parser::ParseLabelStatement()
 	{
 		SourceLocation loc = current_token->GetLocation();
 		std::string_view label_name = current_token->GetData();
@@ -780,37 +784,37 @@ namespace ola
 	}
 
 	template<ExprParseFn ParseFn, TokenKind token_kind, BinaryExprKind op_kind>
-	UniqueExprPtr Parser::ParseBinaryExpression()
+	Expr* Parser::ParseBinaryExpression()
 	{
-		UniqueExprPtr lhs = (this->*ParseFn)();
+		Expr* lhs = (this->*ParseFn)();
 		while (Consume(token_kind))
 		{
 			SourceLocation loc = current_token->GetLocation();
-			UniqueExprPtr rhs = (this->*ParseFn)();
+			Expr* rhs = (this->*ParseFn)();
 
-			UniqueBinaryExprPtr parent = sema->ActOnBinaryExpr(op_kind, loc, std::move(lhs), std::move(rhs)); 
-			lhs = std::move(parent);
+			BinaryExpr* parent = sema->ActOnBinaryExpr(op_kind, loc, lhs, rhs); 
+			lhs = parent;
 		}
 		return lhs;
 	}
 
-	UniqueExprPtr Parser::ParseExpression()
+	Expr* Parser::ParseExpression()
 	{
 		return ParseBinaryExpression<&Parser::ParseAssignmentExpression, TokenKind::comma, BinaryExprKind::Comma>();
 	}
 
-	UniqueExprPtr Parser::ParseParenthesizedExpression()
+	Expr* Parser::ParseParenthesizedExpression()
 	{
 		Expect(TokenKind::left_round);
-		UniqueExprPtr expr = ParseExpression();
+		Expr* expr = ParseExpression();
 		Expect(TokenKind::right_round);
 		return expr;
 	}
 
-	UniqueExprPtr Parser::ParseAssignmentExpression()
+	Expr* Parser::ParseAssignmentExpression()
 	{
 		TokenPtr current_token_copy = current_token;
-		UniqueExprPtr lhs = ParseConditionalExpression();
+		Expr* lhs = ParseConditionalExpression();
 		BinaryExprKind arith_op_kind = BinaryExprKind::Assign;
 		SourceLocation loc = current_token->GetLocation();
 		switch (current_token->GetKind())
@@ -830,66 +834,66 @@ namespace ola
 			return lhs;
 		}
 		++current_token;
-		UniqueExprPtr rhs = ParseAssignmentExpression();
+		Expr* rhs = ParseAssignmentExpression();
 		if (arith_op_kind != BinaryExprKind::Assign)
 		{
 			TokenPtr current_token_copy2 = current_token;
 			current_token = current_token_copy;
-			UniqueExprPtr lhs_copy = ParseConditionalExpression();
+			Expr* lhs_copy = ParseConditionalExpression();
 			current_token = current_token_copy2;
 
-			UniqueBinaryExprPtr tmp = sema->ActOnBinaryExpr(arith_op_kind, loc, std::move(lhs_copy), std::move(rhs)); 
-			UniqueBinaryExprPtr parent = sema->ActOnBinaryExpr(BinaryExprKind::Assign, loc, std::move(lhs), std::move(tmp));
+			BinaryExpr* tmp = sema->ActOnBinaryExpr(arith_op_kind, loc, lhs_copy, rhs); 
+			BinaryExpr* parent = sema->ActOnBinaryExpr(BinaryExprKind::Assign, loc, lhs, tmp);
 			return parent;
 		}
 		else
 		{
-			return sema->ActOnBinaryExpr(arith_op_kind, loc, std::move(lhs), std::move(rhs));
+			return sema->ActOnBinaryExpr(arith_op_kind, loc, lhs, rhs);
 		}
 	}
 
-	UniqueExprPtr Parser::ParseConditionalExpression()
+	Expr* Parser::ParseConditionalExpression()
 	{
 		SourceLocation loc = current_token->GetLocation();
-		UniqueExprPtr cond = ParseLogicalOrExpression();
+		Expr* cond = ParseLogicalOrExpression();
 		if (Consume(TokenKind::question))
 		{
-			UniqueExprPtr true_expr = ParseExpression();
+			Expr* true_expr = ParseExpression();
 			Expect(TokenKind::colon);
-			UniqueExprPtr false_expr = ParseConditionalExpression();
-			return sema->ActOnTernaryExpr(loc, std::move(cond), std::move(true_expr), std::move(false_expr));
+			Expr* false_expr = ParseConditionalExpression();
+			return sema->ActOnTernaryExpr(loc, cond, true_expr, false_expr);
 		}
 		return cond;
 	}
 
-	UniqueExprPtr Parser::ParseLogicalOrExpression()
+	Expr* Parser::ParseLogicalOrExpression()
 	{
 		return ParseBinaryExpression<&Parser::ParseLogicalAndExpression, TokenKind::pipe_pipe, BinaryExprKind::LogicalOr>();
 	}
 
-	UniqueExprPtr Parser::ParseLogicalAndExpression()
+	Expr* Parser::ParseLogicalAndExpression()
 	{
 		return ParseBinaryExpression<&Parser::ParseInclusiveOrExpression, TokenKind::amp_amp, BinaryExprKind::LogicalAnd>();
 	}
 
-	UniqueExprPtr Parser::ParseInclusiveOrExpression()
+	Expr* Parser::ParseInclusiveOrExpression()
 	{
 		return ParseBinaryExpression<&Parser::ParseExclusiveOrExpression, TokenKind::pipe, BinaryExprKind::BitOr>();
 	}
 
-	UniqueExprPtr Parser::ParseExclusiveOrExpression()
+	Expr* Parser::ParseExclusiveOrExpression()
 	{
 		return ParseBinaryExpression<&Parser::ParseAndExpression, TokenKind::caret, BinaryExprKind::BitXor>();
 	}
 
-	UniqueExprPtr Parser::ParseAndExpression()
+	Expr* Parser::ParseAndExpression()
 	{
 		return ParseBinaryExpression<&Parser::ParseEqualityExpression, TokenKind::amp, BinaryExprKind::BitAnd>();
 	}
 
-	UniqueExprPtr Parser::ParseEqualityExpression()
+	Expr* Parser::ParseEqualityExpression()
 	{
-		UniqueExprPtr lhs = ParseRelationalExpression();
+		Expr* lhs = ParseRelationalExpression();
 		while (true)
 		{
 			BinaryExprKind op_kind = BinaryExprKind::Invalid;
@@ -902,15 +906,15 @@ namespace ola
 				return lhs;
 			}
 			++current_token;
-			UniqueExprPtr rhs = ParseRelationalExpression();
-			UniqueBinaryExprPtr parent = sema->ActOnBinaryExpr(op_kind, loc, std::move(lhs), std::move(rhs));
-			lhs = std::move(parent);
+			Expr* rhs = ParseRelationalExpression();
+			BinaryExpr* parent = sema->ActOnBinaryExpr(op_kind, loc, lhs, rhs);
+			lhs = parent;
 		}
 	}
 
-	UniqueExprPtr Parser::ParseRelationalExpression()
+	Expr* Parser::ParseRelationalExpression()
 	{
-		UniqueExprPtr lhs = ParseShiftExpression();
+		Expr* lhs = ParseShiftExpression();
 		while (true)
 		{
 			BinaryExprKind op_kind = BinaryExprKind::Invalid;
@@ -925,15 +929,15 @@ namespace ola
 				return lhs;
 			}
 			++current_token;
-			UniqueExprPtr rhs = ParseShiftExpression();
-			UniqueBinaryExprPtr parent = sema->ActOnBinaryExpr(op_kind, loc, std::move(lhs), std::move(rhs));
-			lhs = std::move(parent);
+			Expr* rhs = ParseShiftExpression();
+			BinaryExpr* parent = sema->ActOnBinaryExpr(op_kind, loc, lhs, rhs);
+			lhs = parent;
 		}
 	}
 
-	UniqueExprPtr Parser::ParseShiftExpression()
+	Expr* Parser::ParseShiftExpression()
 	{
-		UniqueExprPtr lhs = ParseAdditiveExpression();
+		Expr* lhs = ParseAdditiveExpression();
 		while (true)
 		{
 			BinaryExprKind op_kind = BinaryExprKind::Invalid;
@@ -946,15 +950,15 @@ namespace ola
 				return lhs;
 			}
 			++current_token;
-			UniqueExprPtr rhs = ParseAdditiveExpression();
-			UniqueBinaryExprPtr parent = sema->ActOnBinaryExpr(op_kind, loc, std::move(lhs), std::move(rhs));
-			lhs = std::move(parent);
+			Expr* rhs = ParseAdditiveExpression();
+			BinaryExpr* parent = sema->ActOnBinaryExpr(op_kind, loc, lhs, rhs);
+			lhs = parent;
 		}
 	}
 
-	UniqueExprPtr Parser::ParseAdditiveExpression()
+	Expr* Parser::ParseAdditiveExpression()
 	{
-		UniqueExprPtr lhs = ParseMultiplicativeExpression();
+		Expr* lhs = ParseMultiplicativeExpression();
 		while (true)
 		{
 			BinaryExprKind op_kind = BinaryExprKind::Invalid;
@@ -967,15 +971,15 @@ namespace ola
 				return lhs;
 			}
 			++current_token;
-			UniqueExprPtr rhs = ParseMultiplicativeExpression();
-			UniqueBinaryExprPtr parent = sema->ActOnBinaryExpr(op_kind, loc, std::move(lhs), std::move(rhs));
-			lhs = std::move(parent);
+			Expr* rhs = ParseMultiplicativeExpression();
+			BinaryExpr* parent = sema->ActOnBinaryExpr(op_kind, loc, lhs, rhs);
+			lhs = parent;
 		}
 	}
 
-	UniqueExprPtr Parser::ParseMultiplicativeExpression()
+	Expr* Parser::ParseMultiplicativeExpression()
 	{
-		UniqueExprPtr lhs = ParseUnaryExpression();
+		Expr* lhs = ParseUnaryExpression();
 		while (true)
 		{
 			BinaryExprKind op_kind = BinaryExprKind::Invalid;
@@ -989,15 +993,15 @@ namespace ola
 				return lhs;
 			}
 			++current_token;
-			UniqueExprPtr rhs = ParseUnaryExpression();
-			UniqueBinaryExprPtr parent = sema->ActOnBinaryExpr(op_kind, loc, std::move(lhs), std::move(rhs));
-			lhs = std::move(parent);
+			Expr* rhs = ParseUnaryExpression();
+			BinaryExpr* parent = sema->ActOnBinaryExpr(op_kind, loc, lhs, rhs);
+			lhs = parent;
 		}
 	}
 
-	UniqueExprPtr Parser::ParseUnaryExpression()
+	Expr* Parser::ParseUnaryExpression()
 	{
-		UniqueUnaryExprPtr unary_expr;
+		UnaryExpr* unary_expr;
 		SourceLocation loc = current_token->GetLocation();
 		UnaryExprKind unary_kind = UnaryExprKind::Plus;
 		switch (current_token->GetKind())
@@ -1026,13 +1030,13 @@ namespace ola
 			return ParsePostFixExpression();
 		}
 		++current_token;
-		UniqueExprPtr operand = ParseUnaryExpression();
-		return sema->ActOnUnaryExpr(unary_kind, loc, std::move(operand));
+		Expr* operand = ParseUnaryExpression();
+		return sema->ActOnUnaryExpr(unary_kind, loc, operand);
 	}
 
-	UniqueExprPtr Parser::ParsePostFixExpression()
+	Expr* Parser::ParsePostFixExpression()
 	{
-		UniqueExprPtr expr = ParsePrimaryExpression();
+		Expr* expr = ParsePrimaryExpression();
 		SourceLocation loc = current_token->GetLocation();
 
 		while (true)
@@ -1042,65 +1046,65 @@ namespace ola
 			case TokenKind::left_round: 
 			{
 				++current_token;
-				UniqueExprPtrList args;
+				ExprPtrList args;
 				if (!Consume(TokenKind::right_round))
 				{
 					while (true)
 					{
-						UniqueExprPtr arg_expr = ParseAssignmentExpression();
-						args.push_back(std::move(arg_expr));
+						Expr* arg_expr = ParseAssignmentExpression();
+						args.push_back(arg_expr);
 						if (Consume(TokenKind::right_round)) break;
 						Expect(TokenKind::comma);
 					}
 				}
-				expr = sema->ActOnCallExpr(loc, std::move(expr), std::move(args));
+				expr = sema->ActOnCallExpr(loc, expr, std::move(args));
 			}
 			break;
 			case TokenKind::plus_plus:
 			{
 				++current_token;
-				expr = sema->ActOnUnaryExpr(UnaryExprKind::PostIncrement, loc, std::move(expr));
+				expr = sema->ActOnUnaryExpr(UnaryExprKind::PostIncrement, loc, expr);
 			}
 			break;
 			case TokenKind::minus_minus:
 			{
 				++current_token;
-				expr = sema->ActOnUnaryExpr(UnaryExprKind::PostDecrement, loc, std::move(expr));
+				expr = sema->ActOnUnaryExpr(UnaryExprKind::PostDecrement, loc, expr);
 			}
 			break;
 			case TokenKind::left_square:
 			{
 				++current_token;
-				UniqueExprPtr index_expr = ParseExpression();
+				Expr* index_expr = ParseExpression();
 				Expect(TokenKind::right_square);
-				expr = sema->ActOnArrayAccessExpr(loc, std::move(expr), std::move(index_expr));
+				expr = sema->ActOnArrayAccessExpr(loc, expr, index_expr);
 			}
 			break;
 			case TokenKind::period:
 			{
 				++current_token;
-				sema->sema_ctx.current_class_expr_stack.push_back(expr.get());
-				UniqueIdentifierExprPtr member_identifier = ParseMemberIdentifier();
+				sema->sema_ctx.current_class_expr_stack.push_back(expr);
+				IdentifierExpr* member_identifier = ParseMemberIdentifier();
 				sema->sema_ctx.current_class_expr_stack.pop_back();
 				if (current_token->Is(TokenKind::left_round))
 				{
 					++current_token;
-					UniqueExprPtrList args;
+					ExprPtrList args;
 					if (!Consume(TokenKind::right_round))
 					{
 						while (true)
 						{
-							UniqueExprPtr arg_expr = ParseAssignmentExpression();
-							args.push_back(std::move(arg_expr));
+							Expr* arg_expr = ParseAssignmentExpression();
+							args.push_back(arg_expr);
 							if (Consume(TokenKind::right_round)) break;
 							Expect(TokenKind::comma);
 						}
 					}
-					expr = sema->ActOnMethodCall(loc, std::move(expr), std::move(member_identifier), std::move(args));
+					expr = sema->ActOnMethodCall(loc, expr, member_identifier, std::move(args));
 				}
 				else
 				{
-					expr = sema->ActOnFieldAccess(loc, std::move(expr), std::move(member_identifier));
+					expr = sema->ActOnFieldAccess(loc, expr, member_identifier);
 				}
 			}
 			break;
@@ -1112,7 +1116,7 @@ namespace ola
 		return expr;
 	}
 
-	UniqueExprPtr Parser::ParsePrimaryExpression()
+	Expr* Parser::ParsePrimaryExpression()
 	{
 		switch (current_token->GetKind())
 		{
@@ -1133,14 +1137,14 @@ namespace ola
 		return nullptr;
 	}
 
-	UniqueIntLiteralPtr Parser::ParseSizeofExpression()
+	IntLiteral* Parser::ParseSizeofExpression()
 	{
 		Expect(TokenKind::KW_sizeof);
 		Expect(TokenKind::left_round);
 
 		SourceLocation loc = current_token->GetLocation();
 		QualType type{};
-		std::string_view identifier = current_token->GetData();
+		Identifier identifier = current_token->GetIdentifier();
 		if (current_token->IsTypename() && current_token->IsNot(TokenKind::KW_auto)
 		|| (current_token->Is(TokenKind::identifier) && sema->sema_ctx.tag_sym_table.LookUp(identifier) != nullptr))
 		{
@@ -1149,35 +1153,35 @@ namespace ola
 		}
 		else
 		{
-			UniqueExprPtr sizeof_expr = ParseUnaryExpression();
+			Expr* sizeof_expr = ParseUnaryExpression();
 			type = sizeof_expr->GetType();
 		}
 		Expect(TokenKind::right_round);
 		return sema->ActOnIntLiteral(type->GetSize(), loc);
 	}
 
-	UniqueIntLiteralPtr Parser::ParseLengthExpression()
+	IntLiteral* Parser::ParseLengthExpression()
 	{
 		Expect(TokenKind::KW_length);
 		Expect(TokenKind::left_round);
 		SourceLocation loc = current_token->GetLocation();
-		UniqueExprPtr length_expr = ParseUnaryExpression();
+		Expr* length_expr = ParseUnaryExpression();
 		QualType const& type = length_expr->GetType();
 		Expect(TokenKind::right_round);
 		return sema->ActOnLengthOperator(type, loc);
 	}
 
-	UniqueIntLiteralPtr Parser::ParseConstantInt()
+	IntLiteral* Parser::ParseConstantInt()
 	{
 		OLA_ASSERT(current_token->Is(TokenKind::int_number));
 		std::string_view string_number = current_token->GetData();
-		Int64 value = std::stoll(current_token->GetData().data(), nullptr, 0);
+		Int64 value = std::stoll(std::string(string_number), nullptr, 0);
 		SourceLocation loc = current_token->GetLocation();
 		++current_token;
 		return sema->ActOnIntLiteral(value, loc);
 	}
 
-	UniqueCharLiteralPtr Parser::ParseConstantChar()
+	CharLiteral* Parser::ParseConstantChar()
 	{
 		OLA_ASSERT(current_token->Is(TokenKind::char_literal));
 		std::string_view char_string = current_token->GetData();
@@ -1186,7 +1190,7 @@ namespace ola
 		return sema->ActOnCharLiteral(char_string, loc);
 	}
 
-	UniqueStringLiteralPtr Parser::ParseConstantString()
+	StringLiteral* Parser::ParseConstantString()
 	{
 		OLA_ASSERT(current_token->Is(TokenKind::string_literal));
 		std::string_view str = current_token->GetData();
@@ -1195,7 +1199,7 @@ namespace ola
 		return sema->ActOnStringLiteral(str, loc);
 	}
 
-	UniqueBoolLiteralPtr Parser::ParseConstantBool()
+	BoolLiteral* Parser::ParseConstantBool()
 	{
 		OLA_ASSERT(current_token->IsOneOf(TokenKind::KW_true, TokenKind::KW_false));
 		Bool value = false;
@@ -1206,26 +1210,26 @@ namespace ola
 		return sema->ActOnBoolLiteral(value, loc);
 	}
 
-	UniqueFloatLiteralPtr Parser::ParseConstantFloat()
+	FloatLiteral* Parser::ParseConstantFloat()
 	{
 		OLA_ASSERT(current_token->Is(TokenKind::float_number));
 		std::string_view string_number = current_token->GetData();
-		Float64 value = std::stod(current_token->GetData().data(), nullptr);
+		Float64 value = std::stod(std::string(string_number), nullptr);
 		SourceLocation loc = current_token->GetLocation();
 		++current_token;
 		return sema->ActOnFloatLiteral(value, loc);
 	}
 
-	UniqueExprPtr Parser::ParseIdentifier()
+	Expr* Parser::ParseIdentifier()
 	{
 		OLA_ASSERT(current_token->Is(TokenKind::identifier));
-		std::string_view name = current_token->GetData();
+		Identifier name = current_token->GetIdentifier();
 		SourceLocation loc = current_token->GetLocation();
 		++current_token;
 		return sema->ActOnIdentifier(name, loc, current_token->Is(TokenKind::left_round));
 	}
 
-	UniqueThisExprPtr Parser::ParseThisExpression()
+	ThisExpr* Parser::ParseThisExpression()
 	{
 		OLA_ASSERT(current_token->Is(TokenKind::KW_this));
 		SourceLocation loc = current_token->GetLocation();
@@ -1233,7 +1237,7 @@ namespace ola
 		return sema->ActOnThisExpr(loc, false);
 	}
 
-	UniqueSuperExprPtr Parser::ParseSuperExpression()
+	SuperExpr* Parser::ParseSuperExpression()
 	{
 		OLA_ASSERT(current_token->Is(TokenKind::KW_super));
 		SourceLocation loc = current_token->GetLocation();
@@ -1241,19 +1245,19 @@ namespace ola
 		return sema->ActOnSuperExpr(loc, false);
 	}
 
-	UniqueIdentifierExprPtr Parser::ParseMemberIdentifier()
+	IdentifierExpr* Parser::ParseMemberIdentifier()
 	{
-		std::string_view name = current_token->GetData();
+		Identifier name = current_token->GetIdentifier();
 		SourceLocation loc = current_token->GetLocation();
 		Expect(TokenKind::identifier);
 		return sema->ActOnMemberIdentifier(name, loc, current_token->Is(TokenKind::left_round));
 	}
 
-	UniqueInitializerListExprPtr Parser::ParseInitializerListExpression()
+	InitializerListExpr* Parser::ParseInitializerListExpression()
 	{
 		SourceLocation loc = current_token->GetLocation();
 		Expect(TokenKind::left_brace);
-		UniqueExprPtrList expr_list;
+		ExprPtrList expr_list;
 		if (!Consume(TokenKind::right_brace))
 		{
 			while (true)
@@ -1319,6 +1323,18 @@ namespace ola
 					return;
 				}
 			}
+			else if (Consume(TokenKind::KW_constexpr))
+			{
+				if (!HasAttribute(attrs, FuncAttribute_ConstExpr))
+				{
+					attrs |= FuncAttribute_ConstExpr;
+				}
+				else
+				{
+					Diag(function_attribute_repetition);
+					return;
+				}
+			}
 		}
 	}
 
@@ -1397,7 +1413,7 @@ namespace ola
 		case TokenKind::KW_float: type.SetType(FloatType::Get(context)); break;
 		case TokenKind::identifier:
 		{
-			std::string_view identifier = current_token->GetData();
+			Identifier identifier = current_token->GetIdentifier();
 			if (TagDecl* tag_decl = sema->sema_ctx.tag_sym_table.LookUp(identifier))
 			{
 				if (isa<EnumDecl>(tag_decl))
@@ -1449,20 +1465,20 @@ namespace ola
 				}
 				else
 				{
-					UniqueExprPtr array_size_expr = ParseConditionalExpression();
-					if (!array_size_expr->IsConstexpr())
+					Expr* array_size_expr = ParseConditionalExpression();
+					std::optional<Int64> array_size = sema->EvaluateIntegralConstant(array_size_expr);
+					if (!array_size)
 					{
 						Diag(array_size_not_constexpr);
 						return;
 					}
-					Int64 array_size = array_size_expr->EvaluateConstexpr();
-					if (array_size <= 0)
+					if (*array_size <= 0)
 					{
 						Diag(array_size_not_positive);
 						return;
 					}
 					Expect(TokenKind::right_square);
-					type.SetType(ArrayType::Get(context, type, array_size));
+					type.SetType(ArrayType::Get(context, type, *array_size));
 					type.RemoveConst();
 				}
 			}
@@ -1501,6 +1517,11 @@ namespace ola
 			current_token = token;
 			return true;
 		}
+		if (Consume(TokenKind::KW_constexpr))
+		{
+			current_token = token;
+			return true;
+		}
 
 		QualType tmp{};
 		ParseTypeQualifier(tmp);
@@ -1514,7 +1535,7 @@ namespace ola
 
 	Bool Parser::IsCurrentTokenTypename()
 	{
-		return current_token->IsTypename() || sema->sema_ctx.tag_sym_table.LookUp(current_token->GetData()) != nullptr;
+		return current_token->IsTypename() || sema->sema_ctx.tag_sym_table.LookUp(current_token->GetIdentifier()) != nullptr;
 	}
 
 	Bool Parser::Consume(TokenKind k)
@@ -1,7 +1,8 @@
 #pragma once
 #include <vector>
 #include <memory>
-#include "Token.h"
+#include "TokenStream.h"
+#include "ModuleInterface.h"
 #include "AST/ASTAliases.h"
 
 namespace ola
@@ -15,24 +16,23 @@ namespace ola
 	enum DiagCode : Uint32;
 	enum class BinaryExprKind : Uint8;
 	enum class DeclVisibility : Uint8;
-	using ExprParseFn = UniqueExprPtr(Parser::*)();
+	using ExprParseFn = Expr*(Parser::*)();
 
 	class Parser
 	{
-		using TokenPtr = std::vector<Token>::iterator;
+		using TokenPtr = TokenStream::Iterator;
 	public:
 
 		Parser(FrontendContext* context, Diagnostics& diagnostics);
 		~Parser();
 
-		void Parse(std::vector<Token>&& tokens);
-		void ParseImported(std::vector<Token> const& tokens);
+		void Parse(TokenStream& tokens, std::vector<std::shared_ptr<ModuleInterface const>> const& imported_modules = {});
 		AST const* GetAST() const { return ast.get(); }
 
 	private:
 		FrontendContext* context;
 		Diagnostics& diagnostics;
-		std::vector<Token> tokens;
+		TokenStream* tokens = nullptr;
 		TokenPtr current_token;
 
 		std::unique_ptr<Sema> sema;
@@ -51,68 +51,69 @@ namespace ola
 		void Diag(DiagCode code, Ts&&... args);
 
 		void ParseTranslationUnit();
-		void AddBuiltinDecls(UniqueTranslationUnitPtr& TU);
+		void AddImportedDecls();
+		void AddBuiltinDecls(TranslationUnit* TU);
 
-		OLA_NODISCARD UniqueDeclPtrList ParseGlobalDeclaration();
-		OLA_NODISCARD UniqueFunctionDeclPtr ParseFunctionDeclaration();
-		OLA_NODISCARD UniqueFunctionDeclPtr ParseFunctionDefinition(DeclVisibility visibility);
-		OLA_NODISCARD UniqueMethodDeclPtr ParseMethodDefinition(Bool first_pass);
-		OLA_NODISCARD UniqueConstructorDeclPtr ParseConstructorDefinition(Bool first_pass);
-		OLA_NODISCARD UniqueParamVarDeclPtr ParseParamVariableDeclaration();
-		OLA_NODISCARD UniqueVarDeclPtrList ParseVariableDeclaration(DeclVisibility visibility);
-		OLA_NODISCARD UniqueFieldDeclPtrList ParseFieldDeclaration(Bool first_pass);
-		OLA_NODISCARD UniqueDeclPtrList ParseExternVariableDeclaration();
-		OLA_NODISCARD UniqueEnumDeclPtr ParseEnumDeclaration();
-		OLA_NODISCARD UniqueAliasDeclPtr ParseAliasDeclaration();
-		OLA_NODISCARD UniqueClassDeclPtr ParseClassDeclaration();
+		OLA_NODISCARD DeclPtrList ParseGlobalDeclaration();
+		OLA_NODISCARD FunctionDecl* ParseFunctionDeclaration();
+		OLA_NODISCARD FunctionDecl* ParseFunctionDefinition(DeclVisibility visibility);
+		OLA_NODISCARD MethodDecl* ParseMethodDefinition(Bool first_pass);
+		OLA_NODISCARD ConstructorDecl* ParseConstructorDefinition(Bool first_pass);
+		OLA_NODISCARD ParamVarDecl* ParseParamVariableDeclaration();
+		OLA_NODISCARD VarDeclPtrList ParseVariableDeclaration(DeclVisibility visibility);
+		OLA_NODISCARD FieldDeclPtrList ParseFieldDeclaration(Bool first_pass);
+		OLA_NODISCARD DeclPtrList ParseExternVariableDeclaration();
+		OLA_NODISCARD EnumDecl* ParseEnumDeclaration();
+		OLA_NODISCARD AliasDecl* ParseAliasDeclaration();
+		OLA_NODISCARD ClassDecl* ParseClassDeclaration();
 
-		OLA_NODISCARD UniqueStmtPtr ParseStatement();
-		OLA_NODISCARD UniqueCompoundStmtPtr ParseCompoundStatement();
-		OLA_NODISCARD UniqueExprStmtPtr ParseExpressionStatement();
-		OLA_NODISCARD UniqueReturnStmtPtr ParseReturnStatement();
-		OLA_NODISCARD UniqueIfStmtPtr ParseIfStatement();
-		OLA_NODISCARD UniqueBreakStmtPtr ParseBreakStatement();
-		OLA_NODISCARD UniqueContinueStmtPtr ParseContinueStatement();
-		OLA_NODISCARD UniqueForStmtPtr ParseForStatement();
-		OLA_NODISCARD UniqueForStmtPtr ParseForeachStatement();
-		OLA_NODISCARD UniqueWhileStmtPtr ParseWhileStatement();
-		OLA_NODISCARD UniqueDoWhileStmtPtr ParseDoWhileStatement();
-		OLA_NODISCARD UniqueCaseStmtPtr ParseCaseStatement();
-		OLA_NODISCARD UniqueSwitchStmtPtr ParseSwitchStatement();
-		OLA_NODISCARD UniqueGotoStmtPtr ParseGotoStatement();
-		OLA_NODISCARD UniqueLabelStmtPtr ParseLabelStatement();
+		OLA_NODISCARD Stmt* ParseStatement();
+		OLA_NODISCARD CompoundStmt* ParseCompoundStatement();
+		OLA_NODISCARD ExprStmt* ParseExpressionStatement();
+		OLA_NODISCARD ReturnStmt* ParseReturnStatement();
+		OLA_NODISCARD IfStmt* ParseIfStatement();
+		OLA_NODISCARD BreakStmt* ParseBreakStatement();
+		OLA_NODISCARD ContinueStmt* ParseContinueStatement();
+		OLA_NODISCARD ForStmt* ParseForStatement();
+		OLA_NODISCARD ForStmt* ParseForeachStatement();
+		OLA_NODISCARD WhileStmt* ParseWhileStatement();
+		OLA_NODISCARD DoWhileStmt* ParseDoWhileStatement();
+		OLA_NODISCARD CaseStmt* ParseCaseStatement();
+		OLA_NODISCARD SwitchStmt* ParseSwitchStatement();
+		OLA_NODISCARD GotoStmt* ParseGotoStatement();
+		OLA_NODISCARD LabelStmt* ParseLabelStatement();
 
 		template<ExprParseFn ParseFn, TokenKind token_kind, BinaryExprKind op_kind>
-		OLA_NODISCARD UniqueExprPtr ParseBinaryExpression();
-		OLA_NODISCARD UniqueExprPtr ParseExpression();
-		OLA_NODISCARD UniqueExprPtr ParseParenthesizedExpression();
-		OLA_NODISCARD UniqueExprPtr ParseAssignmentExpression();
-		OLA_NODISCARD UniqueExprPtr ParseConditionalExpression();
-		OLA_NODISCARD UniqueExprPtr ParseLogicalOrExpression();
-		OLA_NODISCARD UniqueExprPtr ParseLogicalAndExpression();
-		OLA_NODISCARD UniqueExprPtr ParseInclusiveOrExpression();
-		OLA_NODISCARD UniqueExprPtr ParseExclusiveOrExpression();
-		OLA_NODISCARD UniqueExprPtr ParseAndExpression();
-		OLA_NODISCARD UniqueExprPtr ParseEqualityExpression();
-		OLA_NODISCARD UniqueExprPtr ParseRelationalExpression();
-		OLA_NODISCARD UniqueExprPtr ParseShiftExpression();
-		OLA_NODISCARD UniqueExprPtr ParseAdditiveExpression();
-		OLA_NODISCARD UniqueExprPtr ParseMultiplicativeExpression();
-		OLA_NODISCARD UniqueExprPtr ParseUnaryExpression();
-		OLA_NODISCARD UniqueExprPtr ParsePostFixExpression();
-		OLA_NODISCARD UniqueExprPtr ParsePrimaryExpression();
-		OLA_NODISCARD UniqueIntLiteralPtr ParseSizeofExpression();
-		OLA_NODISCARD UniqueIntLiteralPtr ParseLengthExpression();
-		OLA_NODISCARD UniqueIntLiteralPtr ParseConstantInt();
-		OLA_NODISCARD UniqueCharLiteralPtr ParseConstantChar();
-		OLA_NODISCARD UniqueStringLiteralPtr ParseConstantString();
-		OLA_NODISCARD UniqueBoolLiteralPtr ParseConstantBool();
-		OLA_NODISCARD UniqueFloatLiteralPtr ParseConstantFloat();
-		OLA_NODISCARD UniqueExprPtr ParseIdentifier();
-		OLA_NODISCARD UniqueThisExprPtr ParseThisExpression();
-		OLA_NODISCARD UniqueSuperExprPtr ParseSuperExpression();
-		OLA_NODISCARD UniqueIdentifierExprPtr ParseMemberIdentifier();
-		OLA_NODISCARD UniqueInitializerListExprPtr ParseInitializerListExpression();
+		OLA_NODISCARD Expr* ParseBinaryExpression();
+		OLA_NODISCARD Expr* ParseExpression();
+		OLA_NODISCARD Expr* ParseParenthesizedExpression();
+		OLA_NODISCARD Expr* ParseAssignmentExpression();
+		OLA_NODISCARD Expr* ParseConditionalExpression();
+		OLA_NODISCARD Expr* ParseLogicalOrExpression();
+		OLA_NODISCARD Expr* ParseLogicalAndExpression();
+		OLA_NODISCARD Expr* ParseInclusiveOrExpression();
+		OLA_NODISCARD Expr* ParseExclusiveOrExpression();
+		OLA_NODISCARD Expr* ParseAndExpression();
+		OLA_NODISCARD Expr* ParseEqualityExpression();
+		OLA_NODISCARD Expr* ParseRelationalExpression();
+		OLA_NODISCARD Expr* ParseShiftExpression();
+		OLA_NODISCARD Expr* ParseAdditiveExpression();
+		OLA_NODISCARD Expr* ParseMultiplicativeExpression();
+		OLA_NODISCARD Expr* ParseUnaryExpression();
+		OLA_NODISCARD Expr* ParsePostFixExpression();
+		OLA_NODISCARD Expr* ParsePrimaryExpression();
+		OLA_NODISCARD IntLiteral* ParseSizeofExpression();
+		OLA_NODISCARD IntLiteral* ParseLengthExpression();
+		OLA_NODISCARD IntLiteral* ParseConstantInt();
+		OLA_NODISCARD CharLiteral* ParseConstantChar();
+		OLA_NODISCARD StringLiteral* ParseConstantString();
+		OLA_NODISCARD BoolLiteral* ParseConstantBool();
+		OLA_NODISCARD FloatLiteral* ParseConstantFloat();
+		OLA_NODISCARD Expr* ParseIdentifier();
+		OLA_NODISCARD ThisExpr* ParseThisExpression();
+		OLA_NODISCARD SuperExpr* ParseSuperExpression();
+		OLA_NODISCARD IdentifierExpr* ParseMemberIdentifier();
+		OLA_NODISCARD InitializerListExpr* ParseInitializerListExpression();
 
 		void ParseFunctionAttributes(Uint8& attrs);
 		void ParseMethodAttributes(Uint8& attrs);
@@ -1,69 +1,37 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <concepts>
+#include <functional>
+#include "Identifier.h"
 
 namespace ola
 {
 	template<typename S>
 	concept Symbol = requires(S* s)
 	{
-		{s->GetName()} -> std::convertible_to<std::string_view>;
+		{s->GetIdentifier()} -> std::convertible_to<Identifier>;
 	};
 
+	//Symbols are bound to the id of their interned name. Every id has a stack of bindings, one for each open scope declaring it,
+	//so a lookup indexes the stack of the id instead of hashing the name in every enclosing scope. Each scope remembers the ids
+	//it bound and pops their bindings when it is exited
 	template<typename T> requires Symbol<T>
-	class SymbolScope
+	class SymbolTable 
 	{
 	public:
 		using SymType = T;
-	public:
-		SymbolScope() {}
-		
-		Bool Insert(SymType* symbol)
-		{
-			std::string name_key(symbol->GetName());
-			if (sym_map.contains(name_key)) return false;
-			if (overload_sym_map.contains(name_key)) return false;
-			sym_map[name_key] = symbol;
-			return true;
-		}
-		Bool Insert_Overload(SymType* symbol)
-		{
-			std::string name_key(symbol->GetName());
-			if (sym_map.contains(name_key)) return false;
-			overload_sym_map[name_key].push_back(symbol);
-			return true;
-		}
-		SymType* LookUp(std::string_view sym_name)
-		{
-			std::string name_key(sym_name);
-			if (sym_map.contains(name_key))
-			{
-				return sym_map[name_key];
-			}
-			else if (overload_sym_map.contains(name_key) && !overload_sym_map[name_key].empty())
-			{
-				return overload_sym_map[name_key][0];
-			}
-			else return nullptr;
-		}
-		std::vector<SymType*>& LookUp_Overload(std::string_view sym_name)
-		{
-			std::string name_key(sym_name);
-			return overload_sym_map[name_key];
-		}
+		using ExternalLookup = std::function<void(std::string_view)>;
 
 	private:
-		std::unordered_map<std::string, SymType*> sym_map;
-		std::unordered_map<std::string, std::vector<SymType*>> overload_sym_map;
-	};
+		struct SymbolBinding
+		{
+			Uint32 scope;
+			Bool overloaded;
+			std::vector<SymType*> symbols;
+		};
+		using BindingStack = std::vector<SymbolBinding>;
 
-	template<typename T> requires Symbol<T>
-	class SymbolTable 
-	{
-	public:
-		using SymType = T;
 	public:
 		SymbolTable()
 		{
@@ -76,71 +44,132 @@ namespace ola
 		}
 		void ExitScope()
 		{
+			for (Uint32 id : scopes.back()) bindings[id].pop_back();
 			scopes.pop_back();
 		}
 
 		Bool Insert(SymType* symbol)
 		{
-			return scopes.back().Insert(symbol);
+			return Insert(symbol, GetCurrentScope(), false);
 		}
 		Bool Insert_Overload(SymType* symbol)
 		{
-			return scopes.back().Insert_Overload(symbol);
+			return Insert(symbol, GetCurrentScope(), true);
+		}
+		Bool InsertGlobal(SymType* symbol)
+		{
+			return Insert(symbol, 0, false);
+		}
+		Bool InsertGlobal_Overload(SymType* symbol)
+		{
+			return Insert(symbol, 0, true);
 		}
 
-		SymType* LookUp(std::string const& sym_name)
+		//Called with every name looked up in the global scope so that symbols can be declared on demand
+		void SetExternalLookup(ExternalLookup&& lookup)
 		{
-			return LookUp(sym_name);
+			external_lookup = std::move(lookup);
 		}
-		SymType* LookUp(std::string_view sym_name)
+
+		SymType* LookUp(Identifier sym_name)
 		{
-			for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
-			{
-				if (SymType* sym = scope->LookUp(sym_name)) return sym;
-			}
-			return nullptr;
+			BindingStack& stack = GetBindings(sym_name);
+			if (!stack.empty() && stack.back().scope != 0) return stack.back().symbols.front();
+			LookUpExternal(sym_name);
+			BindingStack& global_stack = GetBindings(sym_name);
+			return !global_stack.empty() ? global_stack.back().symbols.front() : nullptr;
 		}
-		SymType* LookUpMember(std::string_view sym_name)
+		SymType* LookUpMember(Identifier sym_name)
 		{
-			for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
+			BindingStack& stack = GetBindings(sym_name);
+			for (auto binding = stack.rbegin(); binding != stack.rend(); ++binding)
 			{
-				SymType* sym = scope->LookUp(sym_name);
-				if (sym && sym->IsMember()) return sym;
+				SymType* sym = binding->symbols.front();
+				if (sym->IsMember()) return sym;
 			}
 			return nullptr;
 		}
-		SymType* LookUpCurrentScope(std::string_view sym_name)
+		SymType* LookUpCurrentScope(Identifier sym_name)
 		{
-			if (SymType* sym = scopes.back().LookUp(sym_name)) return sym;
+			if (IsGlobal()) LookUpExternal(sym_name);
+			BindingStack& stack = GetBindings(sym_name);
+			if (!stack.empty() && stack.back().scope == GetCurrentScope()) return stack.back().symbols.front();
 			return nullptr;
 		}
 
-		std::vector<SymType*>& LookUpMember_Overload(std::string_view sym_name)
+		std::vector<SymType*> const& LookUpMember_Overload(Identifier sym_name)
 		{
-			for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
+			BindingStack& stack = GetBindings(sym_name);
+			for (auto binding = stack.rbegin(); binding != stack.rend(); ++binding)
 			{
-				std::vector<SymType*>& syms = scope->LookUp_Overload(sym_name);
-				for (SymType* sym : syms) if (sym->IsMember()) return syms;
+				if (!binding->overloaded) continue;
+				for (SymType* sym : binding->symbols) if (sym->IsMember()) return binding->symbols;
 			}
-			return scopes.back().LookUp_Overload(sym_name);
+			return no_symbols;
 		}
-		std::vector<SymType*>& LookUp_Overload(std::string_view sym_name)
+		std::vector<SymType*> const& LookUp_Overload(Identifier sym_name)
 		{
-			for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
+			BindingStack& stack = GetBindings(sym_name);
+			for (auto binding = stack.rbegin(); binding != stack.rend() && binding->scope != 0; ++binding)
 			{
-				if (std::vector<SymType*>& syms = scope->LookUp_Overload(sym_name); !syms.empty()) return syms;
+				if (binding->overloaded) return binding->symbols;
 			}
-			return scopes.back().LookUp_Overload(sym_name);
+			LookUpExternal(sym_name);
+			BindingStack& global_stack = GetBindings(sym_name);
+			if (!global_stack.empty() && global_stack.front().scope == 0 && global_stack.front().overloaded) return global_stack.front().symbols;
+			return no_symbols;
 		}
-		std::vector<SymType*>& LookUpCurrentScope_Overload(std::string_view sym_name)
+		std::vector<SymType*> const& LookUpCurrentScope_Overload(Identifier sym_name)
 		{
-			return scopes.back().LookUp_Overload(sym_name);
+			if (IsGlobal()) LookUpExternal(sym_name);
+			BindingStack& stack = GetBindings(sym_name);
+			if (!stack.empty() && stack.back().scope == GetCurrentScope() && stack.back().overloaded) return stack.back().symbols;
+			return no_symbols;
 		}
 
 		Bool IsGlobal() const { return scopes.size() == 1; }
 
 	private:
-		std::vector<SymbolScope<SymType>> scopes;
+		std::vector<BindingStack> bindings;
+		std::vector<std::vector<Uint32>> scopes;
+		static inline std::vector<SymType*> const no_symbols{};
+		ExternalLookup external_lookup;
+
+	private:
+		Uint32 GetCurrentScope() const { return static_cast<Uint32>(scopes.size() - 1); }
+
+		BindingStack& GetBindings(Identifier sym_name)
+		{
+			if (sym_name.GetId() >= bindings.size()) bindings.resize(sym_name.GetId() + 1);
+			return bindings[sym_name.GetId()];
+		}
+
+		Bool Insert(SymType* symbol, Uint32 scope, Bool overloaded)
+		{
+			Identifier const sym_name = symbol->GetIdentifier();
+			OLA_ASSERT_MSG(!sym_name.IsEmpty(), "Symbols need a name!");
+			BindingStack& stack = GetBindings(sym_name);
+			//Global symbols can be declared while other scopes are open, their binding is always at the bottom of the stack
+			auto binding = stack.end();
+			if (!stack.empty())
+			{
+				binding = scope == 0 ? stack.begin() : std::prev(stack.end());
+				if (binding->scope != scope) binding = stack.end();
+			}
+			if (binding == stack.end())
+			{
+				binding = stack.insert(scope == 0 ? stack.begin() : stack.end(), SymbolBinding{ .scope = scope, .overloaded = overloaded });
+				scopes[scope].push_back(sym_name.GetId());
+			}
+			else if (!overloaded || !binding->overloaded) return false;
+			binding->symbols.push_back(symbol);
+			return true;
+		}
+
+		void LookUpExternal(Identifier sym_name)
+		{
+			if (external_lookup) external_lookup(sym_name);
+		}
 	};
 
 	template<typename T>
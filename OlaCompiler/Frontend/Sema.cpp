@@ -1,23 +1,41 @@
 #include "Sema.h"
 #include "Diagnostics.h"
+#include "FrontendContext.h"
 #include "AST/Type.h"
 
 namespace ola
 {
-	Sema::Sema(FrontendContext* context, Diagnostics& diagnostics) : ctx(context), diagnostics(diagnostics) {}
+	Sema::Sema(FrontendContext* context, ASTContext* ast_ctx, Diagnostics& diagnostics) : ctx(context), ast_ctx(ast_ctx), diagnostics(diagnostics) {}
 	Sema::~Sema() = default;
 
-	UniqueVarDeclPtr Sema::ActOnVariableDecl(std::string_view name, SourceLocation const& loc, QualType const& type,
-		UniqueExprPtr&& init_expr, DeclVisibility visibility)
+	void Sema::ImportModules(std::vector<std::shared_ptr<ModuleInterface const>> const& modules)
 	{
-		return ActOnVariableDeclCommon<VarDecl>(name, loc, type, std::move(init_expr), visibility);
+		if (modules.empty()) return;
+		for (auto const& module : modules)
+		{
+			module_readers.emplace_back(ctx, ast_ctx, diagnostics, module, sema_ctx.decl_sym_table, sema_ctx.tag_sym_table, imported_decls);
+		}
+		sema_ctx.decl_sym_table.SetExternalLookup([this](std::string_view name)
+			{
+				for (ModuleInterfaceReader& reader : module_readers) reader.LoadDecls(name);
+			});
+		sema_ctx.tag_sym_table.SetExternalLookup([this](std::string_view name)
+			{
+				for (ModuleInterfaceReader& reader : module_readers) reader.LoadTags(name);
+			});
 	}
 
-	UniqueParamVarDeclPtr Sema::ActOnParamVariableDecl(std::string_view name, SourceLocation const& loc, QualType const& type)
+	VarDecl* Sema::ActOnVariableDecl(Identifier name, SourceLocation const& loc, QualType const& type,
+		Expr* init_expr, DeclVisibility visibility)
 	{
-		if (!name.empty() && sema_ctx.decl_sym_table.LookUpCurrentScope(name))
+		return ActOnVariableDeclCommon<VarDecl>(name, loc, type, init_expr, visibility);
+	}
+
+	ParamVarDecl* Sema::ActOnParamVariableDecl(Identifier name, SourceLocation const& loc, QualType const& type)
+	{
+		if (!name.IsEmpty() && sema_ctx.decl_sym_table.LookUpCurrentScope(name))
 		{
-			diagnostics.Report(loc, redefinition_of_identifier, name);
+			diagnostics.Report(loc, redefinition_of_identifier, name.GetName());
 			return nullptr;
 		}
 		if (type.IsNull())
@@ -55,25 +73,25 @@ namespace ola
 			}
 		}
 
-		UniqueParamVarDeclPtr param_decl = MakeUnique<ParamVarDecl>(name, loc);
+		ParamVarDecl* param_decl = ast_ctx->New<ParamVarDecl>(name, loc);
 		param_decl->SetGlobal(false);
 		param_decl->SetVisibility(DeclVisibility::None);
 		param_decl->SetType(type);
-		if (!name.empty()) sema_ctx.decl_sym_table.Insert(param_decl.get());
+		if (!name.IsEmpty()) sema_ctx.decl_sym_table.Insert(param_decl);
 		return param_decl;
 	}
 
-	UniqueFieldDeclPtr Sema::ActOnFieldDecl(std::string_view name, SourceLocation const& loc, QualType const& type, UniqueExprPtr&& init_expr, DeclVisibility visibility)
+	FieldDecl* Sema::ActOnFieldDecl(Identifier name, SourceLocation const& loc, QualType const& type, Expr* init_expr, DeclVisibility visibility)
 	{
-		return ActOnVariableDeclCommon<FieldDecl>(name, loc, type, std::move(init_expr), visibility);
+		return ActOnVariableDeclCommon<FieldDecl>(name, loc, type, init_expr, visibility);
 	}
 
-	UniqueFunctionDeclPtr Sema::ActOnFunctionDecl(std::string_view name, SourceLocation const& loc, QualType const& type,
-		UniqueParamVarDeclPtrList&& param_decls, DeclVisibility visibility, FuncAttributes attributes)
+	FunctionDecl* Sema::ActOnFunctionDecl(Identifier name, SourceLocation const& loc, QualType const& type,
+		ParamVarDeclPtrList&& param_decls, DeclVisibility visibility, FuncAttributes attributes)
 	{
 		FuncType const* func_type = dyn_cast<FuncType>(type);
 		OLA_ASSERT(func_type);
-		if (name == "main")
+		if (name.GetName() == "main")
 		{
 			if (!isa<IntType>(func_type->GetReturnType()) || !func_type->GetParams().empty())
 			{
@@ -86,22 +104,32 @@ namespace ola
 			diagnostics.Report(loc, incompatible_function_attributes);
 			return nullptr;
 		}
+		if (HasAttribute(attributes, FuncAttribute_ConstExpr))
+		{
+			Bool valid_signature = isoneof<BoolType, CharType, IntType, FloatType>(func_type->GetReturnType());
+			for (QualType const& param_type : func_type->GetParams()) valid_signature &= isoneof<BoolType, CharType, IntType, FloatType>(param_type);
+			if (!valid_signature)
+			{
+				diagnostics.Report(loc, constexpr_function_invalid_signature, name.GetName());
+				return nullptr;
+			}
+		}
 
-		UniqueFunctionDeclPtr function_decl = MakeUnique<FunctionDecl>(name, loc);
+		FunctionDecl* function_decl = ast_ctx->New<FunctionDecl>(name, loc);
 		function_decl->SetFuncAttributes(attributes);
 		function_decl->SetType(type);
 		function_decl->SetVisibility(visibility);
-		function_decl->SetParamDecls(std::move(param_decls));
+		function_decl->SetParamDecls(ast_ctx->NewArray(param_decls));
 		
-		Bool result = sema_ctx.decl_sym_table.Insert_Overload(function_decl.get());
+		Bool result = sema_ctx.decl_sym_table.Insert_Overload(function_decl);
 		OLA_ASSERT(result);
 		return function_decl;
 	}
 
-	UniqueFunctionDeclPtr Sema::ActOnFunctionDefinition(SourceLocation const& loc, UniqueFunctionDeclPtr&& function_decl, UniqueCompoundStmtPtr&& body_stmt)
+	FunctionDecl* Sema::ActOnFunctionDefinition(SourceLocation const& loc, FunctionDecl* function_decl, CompoundStmt* body_stmt)
 	{
 		OLA_ASSERT(body_stmt);
-		function_decl->SetBodyStmt(std::move(body_stmt));
+		function_decl->SetBodyStmt(body_stmt);
 		for (std::string const& goto_label : sema_ctx.gotos)
 		{
 			if (!sema_ctx.labels.contains(goto_label))
@@ -122,13 +150,13 @@ namespace ola
 			diagnostics.Report(loc, no_return_statement_found_in_non_void_function);
 		}
 		sema_ctx.return_stmt_encountered = false;
-		Bool result = sema_ctx.decl_sym_table.Insert_Overload(function_decl.get());
+		Bool result = sema_ctx.decl_sym_table.Insert_Overload(function_decl);
 		OLA_ASSERT(result);
 		return function_decl;
 	}
 
-	UniqueMethodDeclPtr Sema::ActOnMethodDecl(std::string_view name, SourceLocation const& loc, QualType const& type,
-		UniqueParamVarDeclPtrList&& param_decls, UniqueCompoundStmtPtr&& body_stmt,
+	MethodDecl* Sema::ActOnMethodDecl(Identifier name, SourceLocation const& loc, QualType const& type,
+		ParamVarDeclPtrList&& param_decls, CompoundStmt* body_stmt,
 		DeclVisibility visibility, FuncAttributes func_attrs, MethodAttributes method_attrs)
 	{
 		if (name == sema_ctx.current_class_name)
@@ -156,6 +184,11 @@ namespace ola
 			diagnostics.Report(loc, method_cannot_be_nomangle);
 			return nullptr;
 		}
+		if (HasAttribute(func_attrs, FuncAttribute_ConstExpr))
+		{
+			diagnostics.Report(loc, method_cannot_be_constexpr);
+			return nullptr;
+		}
 		if (HasAttribute(method_attrs, MethodAttribute_Final))
 		{
 			if (!HasAttribute(method_attrs, MethodAttribute_Virtual))
@@ -183,15 +216,15 @@ namespace ola
 			}
 		}
 
-		UniqueMethodDeclPtr member_function_decl = MakeUnique<MethodDecl>(name, loc);
+		MethodDecl* member_function_decl = ast_ctx->New<MethodDecl>(name, loc);
 		member_function_decl->SetType(type);
 		member_function_decl->SetVisibility(visibility);
 		member_function_decl->SetFuncAttributes(func_attrs);
 		member_function_decl->SetMethodAttributes(method_attrs);
-		member_function_decl->SetParamDecls(std::move(param_decls));
+		member_function_decl->SetParamDecls(ast_ctx->NewArray(param_decls));
 		if (body_stmt)
 		{
-			member_function_decl->SetBodyStmt(std::move(body_stmt));
+			member_function_decl->SetBodyStmt(body_stmt);
 			for (std::string const& goto_label : sema_ctx.gotos)
 			{
 				if (!sema_ctx.labels.contains(goto_label))
@@ -216,11 +249,11 @@ namespace ola
 			return nullptr;
 		}
 
-		Bool result = sema_ctx.decl_sym_table.Insert_Overload(member_function_decl.get());
+		Bool result = sema_ctx.decl_sym_table.Insert_Overload(member_function_decl);
 		return member_function_decl;
 	}
 
-	UniqueConstructorDeclPtr Sema::ActOnConstructorDecl(std::string_view name, SourceLocation const& loc, QualType const& type, UniqueParamVarDeclPtrList&& param_decls, UniqueCompoundStmtPtr&& body_stmt)
+	ConstructorDecl* Sema::ActOnConstructorDecl(Identifier name, SourceLocation const& loc, QualType const& type, ParamVarDeclPtrList&& param_decls, CompoundStmt* body_stmt)
 	{
 		if (name != sema_ctx.current_class_name)
 		{
@@ -231,13 +264,13 @@ namespace ola
 		FuncType const* func_type = dyn_cast<FuncType>(type);
 		OLA_ASSERT(func_type);
 
-		UniqueConstructorDeclPtr constructor_decl = MakeUnique<ConstructorDecl>(name, loc);
+		ConstructorDecl* constructor_decl = ast_ctx->New<ConstructorDecl>(name, loc);
 		constructor_decl->SetType(type);
 		constructor_decl->SetVisibility(DeclVisibility::Public);
-		constructor_decl->SetParamDecls(std::move(param_decls));
+		constructor_decl->SetParamDecls(ast_ctx->NewArray(param_decls));
 		if (body_stmt)
 		{
-			constructor_decl->SetBodyStmt(std::move(body_stmt));
+			constructor_decl->SetBodyStmt(body_stmt);
 			for (std::string const& goto_label : sema_ctx.gotos)
 			{
 				if (!sema_ctx.labels.contains(goto_label))
@@ -250,57 +283,58 @@ namespace ola
 			sema_ctx.labels.clear();
 		}
 
-		Bool result = sema_ctx.decl_sym_table.Insert_Overload(constructor_decl.get());
+		Bool result = sema_ctx.decl_sym_table.Insert_Overload(constructor_decl);
 		return constructor_decl;
 	}
 
-	UniqueEnumDeclPtr Sema::ActOnEnumDecl(std::string_view name, SourceLocation const& loc, UniqueEnumMemberDeclPtrList&& enum_members)
+	EnumDecl* Sema::ActOnEnumDecl(Identifier name, SourceLocation const& loc, EnumMemberDeclPtrList&& enum_members)
 	{
-		if (!name.empty() && sema_ctx.tag_sym_table.LookUpCurrentScope(name))
+		if (!name.IsEmpty() && sema_ctx.tag_sym_table.LookUpCurrentScope(name))
 		{
-			diagnostics.Report(loc, redefinition_of_identifier, name);
+			diagnostics.Report(loc, redefinition_of_identifier, name.GetName());
 			return nullptr;
 		}
-		UniqueEnumDeclPtr enum_decl = MakeUnique<EnumDecl>(name, loc);
-		enum_decl->SetEnumMembers(std::move(enum_members));
-		if (!name.empty()) sema_ctx.tag_sym_table.Insert(enum_decl.get());
+		EnumDecl* enum_decl = ast_ctx->New<EnumDecl>(name, loc);
+		enum_decl->SetEnumMembers(ast_ctx->NewArray(enum_members));
+		if (!name.IsEmpty()) sema_ctx.tag_sym_table.Insert(enum_decl);
 		return enum_decl;
 	}
 
-	UniqueEnumMemberDeclPtr Sema::ActOnEnumMemberDecl(std::string_view name, SourceLocation const& loc, UniqueExprPtr&& enum_value_expr)
+	EnumMemberDecl* Sema::ActOnEnumMemberDecl(Identifier name, SourceLocation const& loc, Expr* enum_value_expr)
 	{
-		if (!enum_value_expr->IsConstexpr())
+		std::optional<Int64> enum_value = EvaluateIntegralConstant(enum_value_expr);
+		if (!enum_value)
 		{
-			diagnostics.Report(loc, enumerator_value_not_constexpr, name);
+			diagnostics.Report(loc, enumerator_value_not_constexpr, name.GetName());
 			return nullptr;
 		}
-		return ActOnEnumMemberDecl(name, loc, enum_value_expr->EvaluateConstexpr());
+		return ActOnEnumMemberDecl(name, loc, *enum_value);
 	}
 
-	UniqueEnumMemberDeclPtr Sema::ActOnEnumMemberDecl(std::string_view name, SourceLocation const& loc, Int64 enum_value)
+	EnumMemberDecl* Sema::ActOnEnumMemberDecl(Identifier name, SourceLocation const& loc, Int64 enum_value)
 	{
-		if (name.empty())
+		if (name.IsEmpty())
 		{
 			diagnostics.Report(loc, expected_identifier);
 			return nullptr;
 		}
 		if (sema_ctx.decl_sym_table.LookUpCurrentScope(name))
 		{
-			diagnostics.Report(loc, redefinition_of_identifier, name);
+			diagnostics.Report(loc, redefinition_of_identifier, name.GetName());
 			return nullptr;
 		}
-		UniqueEnumMemberDeclPtr enum_member = MakeUnique<EnumMemberDecl>(name, loc);
+		EnumMemberDecl* enum_member = ast_ctx->New<EnumMemberDecl>(name, loc);
 		enum_member->SetType(IntType::Get(ctx));
 		enum_member->SetValue(enum_value);
-		sema_ctx.decl_sym_table.Insert(enum_member.get());
+		sema_ctx.decl_sym_table.Insert(enum_member);
 		return enum_member;
 	}
 
-	UniqueAliasDeclPtr Sema::ActOnAliasDecl(std::string_view name, SourceLocation const& loc, QualType const& type)
+	AliasDecl* Sema::ActOnAliasDecl(Identifier name, SourceLocation const& loc, QualType const& type)
 	{
 		if (sema_ctx.tag_sym_table.LookUpCurrentScope(name))
 		{
-			diagnostics.Report(loc, redefinition_of_identifier, name);
+			diagnostics.Report(loc, redefinition_of_identifier, name.GetName());
 			return nullptr;
 		}
 		if (type.IsNull())
@@ -308,15 +342,15 @@ namespace ola
 			diagnostics.Report(loc, aliasing_var_forbidden);
 			return nullptr;
 		}
-		UniqueAliasDeclPtr alias_decl = MakeUnique<AliasDecl>(name, loc, type);
+		AliasDecl* alias_decl = ast_ctx->New<AliasDecl>(name, loc, type);
 
-		sema_ctx.tag_sym_table.Insert(alias_decl.get());
+		sema_ctx.tag_sym_table.Insert(alias_decl);
 		return alias_decl;
 	}
 
-	ClassDecl const* Sema::ActOnBaseClassSpecifier(std::string_view base_name, SourceLocation const& loc)
+	ClassDecl const* Sema::ActOnBaseClassSpecifier(Identifier base_name, SourceLocation const& loc)
 	{
-		if (!base_name.empty())
+		if (!base_name.IsEmpty())
 		{
 			if (TagDecl* base_tag_decl = sema_ctx.tag_sym_table.LookUpCurrentScope(base_name))
 			{
@@ -337,60 +371,60 @@ namespace ola
 			}
 			else
 			{
-				diagnostics.Report(loc, undeclared_identifier, base_name);
+				diagnostics.Report(loc, undeclared_identifier, base_name.GetName());
 				return nullptr;
 			}
 		}
 		return nullptr;
 	}
 
-	UniqueClassDeclPtr Sema::ActOnClassDecl(std::string_view name, ClassDecl const* base_class, SourceLocation const& loc, UniqueFieldDeclPtrList&& member_variables, UniqueMethodDeclPtrList&& member_functions, Bool final)
+	ClassDecl* Sema::ActOnClassDecl(Identifier name, ClassDecl const* base_class, SourceLocation const& loc, FieldDeclPtrList&& member_variables, MethodDeclPtrList&& member_functions, Bool final)
 	{
 		if (sema_ctx.tag_sym_table.LookUpCurrentScope(name))
 		{
-			diagnostics.Report(loc, redefinition_of_identifier, name);
+			diagnostics.Report(loc, redefinition_of_identifier, name.GetName());
 			return nullptr;
 		}
 
-		UniqueClassDeclPtr class_decl = MakeUnique<ClassDecl>(name, loc);
-		class_decl->SetType(ClassType::Get(ctx, class_decl.get()));
+		ClassDecl* class_decl = ast_ctx->New<ClassDecl>(name, loc);
+		class_decl->SetType(ClassType::Get(ctx, class_decl));
 		class_decl->SetBaseClass(base_class);
-		class_decl->SetFields(std::move(member_variables));
-		class_decl->SetMethods(std::move(member_functions));
+		class_decl->SetFields(ast_ctx->NewArray(member_variables));
+		class_decl->SetMethods(ast_ctx->NewArray(member_functions));
 		class_decl->SetFinal(final);
 
 		MethodDecl const* error_decl = nullptr;
-		BuildVTableResult build_result = class_decl->BuildVTable(error_decl);
+		BuildVTableResult build_result = class_decl->BuildVTable(ast_ctx, error_decl);
 		if (build_result == BuildVTableResult::Error_OverrideFinal)
 		{
 			diagnostics.Report(error_decl->GetLocation(), cannot_override_final_function, error_decl->GetName());
 			return nullptr;
 		}
-		sema_ctx.tag_sym_table.Insert(class_decl.get());
+		sema_ctx.tag_sym_table.Insert(class_decl);
 		return class_decl;
 	}
 
-	UniqueCompoundStmtPtr Sema::ActOnCompoundStmt(UniqueStmtPtrList&& stmts)
+	CompoundStmt* Sema::ActOnCompoundStmt(StmtPtrList&& stmts)
 	{
-		return MakeUnique<CompoundStmt>(std::move(stmts));
+		return ast_ctx->New<CompoundStmt>(ast_ctx->NewArray(stmts));
 	}
 
-	UniqueExprStmtPtr Sema::ActOnExprStmt(UniqueExprPtr&& expr)
+	ExprStmt* Sema::ActOnExprStmt(Expr* expr)
 	{
-		return MakeUnique<ExprStmt>(std::move(expr));
+		return ast_ctx->New<ExprStmt>(expr);
 	}
 
-	UniqueDeclStmtPtr Sema::ActOnDeclStmt(UniqueDeclPtr&& decl)
+	DeclStmt* Sema::ActOnDeclStmt(Decl* decl)
 	{
-		return MakeUnique<DeclStmt>(std::move(decl));
+		return ast_ctx->New<DeclStmt>(ast_ctx->NewArray(DeclPtrList{ decl }));
 	}
 
-	UniqueDeclStmtPtr Sema::ActOnDeclStmt(UniqueDeclPtrList&& decls)
+	DeclStmt* Sema::ActOnDeclStmt(DeclPtrList&& decls)
 	{
-		return MakeUnique<DeclStmt>(std::move(decls));
+		return ast_ctx->New<DeclStmt>(ast_ctx->NewArray(decls));
 	}
 
-	UniqueReturnStmtPtr Sema::ActOnReturnStmt(UniqueExprStmtPtr&& expr_stmt)
+	ReturnStmt* Sema::ActOnReturnStmt(ExprStmt* expr_stmt)
 	{
 		OLA_ASSERT(sema_ctx.current_func);
 		sema_ctx.return_stmt_encountered = true;
@@ -408,23 +442,21 @@ namespace ola
 		}
 		else if (return_type.GetTypePtr() != ret_expr_type.GetTypePtr())
 		{
-			UniqueExprPtr casted_ret_expr(expr_stmt->ReleaseExpr());
-			casted_ret_expr = ActOnImplicitCastExpr(loc, return_type, std::move(casted_ret_expr));
-			expr_stmt.reset(new ExprStmt(std::move(casted_ret_expr)));
+			expr_stmt = ast_ctx->New<ExprStmt>(ActOnImplicitCastExpr(loc, return_type, expr_stmt->GetExpr()));
 		}
-		return MakeUnique<ReturnStmt>(std::move(expr_stmt));
+		return ast_ctx->New<ReturnStmt>(expr_stmt);
 	}
 
-	UniqueIfStmtPtr Sema::ActOnIfStmt(UniqueExprPtr&& cond_expr, UniqueStmtPtr&& then_stmt, UniqueStmtPtr&& else_stmt)
+	IfStmt* Sema::ActOnIfStmt(Expr* cond_expr, Stmt* then_stmt, Stmt* else_stmt)
 	{
-		UniqueIfStmtPtr if_stmt = MakeUnique<IfStmt>();
-		if_stmt->SetConditionExpr(std::move(cond_expr));
-		if_stmt->SetThenStmt(std::move(then_stmt));
-		if_stmt->SetElseStmt(std::move(else_stmt));
+		IfStmt* if_stmt = ast_ctx->New<IfStmt>();
+		if_stmt->SetConditionExpr(cond_expr);
+		if_stmt->SetThenStmt(then_stmt);
+		if_stmt->SetElseStmt(else_stmt);
 		return if_stmt;
 	}
 
-	UniqueBreakStmtPtr Sema::ActOnBreakStmt(SourceLocation const& loc)
+	BreakStmt* Sema::ActOnBreakStmt(SourceLocation const& loc)
 	{
 		if (sema_ctx.stmts_using_break_count == 0)
 		{
@@ -432,11 +464,11 @@ namespace ola
 			return nullptr;
 		}
 
-		UniqueBreakStmtPtr break_stmt = MakeUnique<BreakStmt>();
+		BreakStmt* break_stmt = ast_ctx->New<BreakStmt>();
 		return break_stmt;
 	}
 
-	UniqueContinueStmtPtr Sema::ActOnContinueStmt(SourceLocation const& loc)
+	ContinueStmt* Sema::ActOnContinueStmt(SourceLocation const& loc)
 	{
 		if (sema_ctx.stmts_using_continue_count == 0)
 		{
@@ -444,21 +476,21 @@ namespace ola
 			return nullptr;
 		}
 
-		UniqueContinueStmtPtr continue_stmt = MakeUnique<ContinueStmt>();
+		ContinueStmt* continue_stmt = ast_ctx->New<ContinueStmt>();
 		return continue_stmt;
 	}
 
-	UniqueForStmtPtr Sema::ActOnForStmt(UniqueStmtPtr&& init_stmt, UniqueExprPtr&& cond_expr, UniqueExprPtr&& iter_expr, UniqueStmtPtr&& body_stmt)
+	ForStmt* Sema::ActOnForStmt(Stmt* init_stmt, Expr* cond_expr, Expr* iter_expr, Stmt* body_stmt)
 	{
-		UniqueForStmtPtr for_stmt = MakeUnique<ForStmt>();
-		for_stmt->SetInitStmt(std::move(init_stmt));
-		for_stmt->SetCondExpr(std::move(cond_expr));
-		for_stmt->SetIterExpr(std::move(iter_expr));
-		for_stmt->SetBodyStmt(std::move(body_stmt));
+		ForStmt* for_stmt = ast_ctx->New<ForStmt>();
+		for_stmt->SetInitStmt(init_stmt);
+		for_stmt->SetCondExpr(cond_expr);
+		for_stmt->SetIterExpr(iter_expr);
+		for_stmt->SetBodyStmt(body_stmt);
 		return for_stmt;
 	}
 
-	UniqueForStmtPtr Sema::ActOnForeachStmt(SourceLocation const& loc, UniqueVarDeclPtr&& var_decl, UniqueExprPtr&& array_identifier, UniqueStmtPtr&& body_stmt)
+	ForStmt* Sema::ActOnForeachStmt(SourceLocation const& loc, VarDecl* var_decl, Expr* array_identifier, Stmt* body_stmt)
 	{
 		QualType arr_type = array_identifier->GetType();
 		ArrayType const* array_type = dyn_cast<ArrayType>(arr_type);
@@ -468,15 +500,14 @@ namespace ola
 			return nullptr;
 		}
 
-		static Uint64 foreach_id = 0;
 		std::string foreach_index_name = "__foreach_index" + std::to_string(foreach_id++);
-		UniqueVarDeclPtr foreach_index_decl = ActOnVariableDecl(foreach_index_name, loc, IntType::Get(ctx), ActOnIntLiteral(0, loc), DeclVisibility::None);
+		VarDecl* foreach_index_decl = ActOnVariableDecl(ctx->GetIdentifier(foreach_index_name), loc, IntType::Get(ctx), ActOnIntLiteral(0, loc), DeclVisibility::None);
 
-		UniqueIdentifierExprPtr foreach_index_identifier = MakeUnique<DeclRefExpr>(foreach_index_decl.get(), loc);
-		UniqueExprPtr cond_expr = ActOnBinaryExpr(BinaryExprKind::Less, loc, std::move(foreach_index_identifier), ActOnIntLiteral(array_type->GetArraySize(), loc));
-		foreach_index_identifier = MakeUnique<DeclRefExpr>(foreach_index_decl.get(), loc);
-		UniqueExprPtr iter_expr = ActOnUnaryExpr(UnaryExprKind::PostIncrement, loc, std::move(foreach_index_identifier));
-		foreach_index_identifier = MakeUnique<DeclRefExpr>(foreach_index_decl.get(), loc);
+		IdentifierExpr* foreach_index_identifier = ast_ctx->New<DeclRefExpr>(foreach_index_decl, loc);
+		Expr* cond_expr = ActOnBinaryExpr(BinaryExprKind::Less, loc, foreach_index_identifier, ActOnIntLiteral(array_type->GetArraySize(), loc));
+		foreach_index_identifier = ast_ctx->New<DeclRefExpr>(foreach_index_decl, loc);
+		Expr* iter_expr = ActOnUnaryExpr(UnaryExprKind::PostIncrement, loc, foreach_index_identifier);
+		foreach_index_identifier = ast_ctx->New<DeclRefExpr>(foreach_index_decl, loc);
 
 		QualType var_type = var_decl->GetType();
 		if (!var_type.IsNull())
@@ -488,65 +519,68 @@ namespace ola
 			}
 		}
 		else var_decl->SetType(array_type->GetElementType());
-		var_decl->SetInitExpr(ActOnArrayAccessExpr(loc, std::move(array_identifier), MakeUnique<DeclRefExpr>(foreach_index_decl.get(), loc)));
+		var_decl->SetInitExpr(ActOnArrayAccessExpr(loc, array_identifier, ast_ctx->New<DeclRefExpr>(foreach_index_decl, loc)));
 
-		UniqueStmtPtr init_stmt = MakeUnique<DeclStmt>(std::move(foreach_index_decl));
-		UniqueStmtPtr array_access_stmt = MakeUnique<DeclStmt>(std::move(var_decl));
-		if (CompoundStmt* compound_stmt = dyn_cast<CompoundStmt>(body_stmt.get()))
+		Stmt* init_stmt = ActOnDeclStmt(foreach_index_decl);
+		Stmt* array_access_stmt = ActOnDeclStmt(var_decl);
+		if (CompoundStmt* compound_stmt = dyn_cast<CompoundStmt>(body_stmt))
 		{
-			compound_stmt->AddBeginStmt(std::move(array_access_stmt));
+			StmtPtrList stmts{ array_access_stmt };
+			stmts.insert(stmts.end(), compound_stmt->GetStmts().begin(), compound_stmt->GetStmts().end());
+			compound_stmt->SetStmts(ast_ctx->NewArray(stmts));
 		}
 		else
 		{
-			UniqueStmtPtrList stmts{};
-			stmts.push_back(std::move(array_access_stmt));
-			stmts.push_back(std::move(body_stmt));
+			StmtPtrList stmts{};
+			stmts.push_back(array_access_stmt);
+			stmts.push_back(body_stmt);
 			body_stmt = ActOnCompoundStmt(std::move(stmts));
 		}
 
-		UniqueForStmtPtr foreach_stmt = MakeUnique<ForStmt>();
-		foreach_stmt->SetInitStmt(std::move(init_stmt));
-		foreach_stmt->SetCondExpr(std::move(cond_expr));
-		foreach_stmt->SetIterExpr(std::move(iter_expr));
-		foreach_stmt->SetBodyStmt(std::move(body_stmt));
+		ForStmt* foreach_stmt = ast_ctx->New<ForStmt>();
+		foreach_stmt->SetInitStmt(init_stmt);
+		foreach_stmt->SetCondExpr(cond_expr);
+		foreach_stmt->SetIterExpr(iter_expr);
+		foreach_stmt->SetBodyStmt(body_stmt);
 		return foreach_stmt;
 	}
 
-	UniqueWhileStmtPtr Sema::ActOnWhileStmt(UniqueExprPtr&& cond_expr, UniqueStmtPtr&& body_stmt)
+	WhileStmt* Sema::ActOnWhileStmt(Expr* cond_expr, Stmt* body_stmt)
 	{
-		UniqueWhileStmtPtr while_stmt = MakeUnique<WhileStmt>();
-		while_stmt->SetCondExpr(std::move(cond_expr));
-		while_stmt->SetBodyStmt(std::move(body_stmt));
+		WhileStmt* while_stmt = ast_ctx->New<WhileStmt>();
+		while_stmt->SetCondExpr(cond_expr);
+		while_stmt->SetBodyStmt(body_stmt);
 		return while_stmt;
 	}
 
-	UniqueDoWhileStmtPtr Sema::ActOnDoWhileStmt(UniqueExprPtr&& cond_expr, UniqueStmtPtr&& body_stmt)
+	DoWhileStmt* Sema::ActOnDoWhileStmt(Expr* cond_expr, Stmt* body_stmt)
 	{
-		UniqueDoWhileStmtPtr do_while_stmt = MakeUnique<DoWhileStmt>();
-		do_while_stmt->SetCondExpr(std::move(cond_expr));
-		do_while_stmt->SetBodyStmt(std::move(body_stmt));
+		DoWhileStmt* do_while_stmt = ast_ctx->New<DoWhileStmt>();
+		do_while_stmt->SetCondExpr(cond_expr);
+		do_while_stmt->SetBodyStmt(body_stmt);
 		return do_while_stmt;
 	}
 
-	UniqueCaseStmtPtr Sema::ActOnCaseStmt(SourceLocation const& loc, UniqueExprPtr&& case_expr)
+	CaseStmt* Sema::ActOnCaseStmt(SourceLocation const& loc, Expr* case_expr)
 	{
 		if (sema_ctx.case_callback_stack.empty()) diagnostics.Report(loc, case_stmt_outside_switch);
 
-		UniqueCaseStmtPtr case_stmt = nullptr;
+		CaseStmt* case_stmt = nullptr;
 		if (!case_expr)
 		{
-			case_stmt = MakeUnique<CaseStmt>();
+			case_stmt = ast_ctx->New<CaseStmt>();
 		}
 		else
 		{
-			if (!case_expr->IsConstexpr()) diagnostics.Report(case_value_not_constexpr);
-			case_stmt = MakeUnique<CaseStmt>(case_expr->EvaluateConstexpr());
+			std::optional<Int64> case_value = EvaluateIntegralConstant(case_expr);
+			if (!case_value) diagnostics.Report(case_value_not_constexpr);
+			case_stmt = ast_ctx->New<CaseStmt>(case_value.value_or(0));
 		}
-		sema_ctx.case_callback_stack.back()(case_stmt.get());
+		sema_ctx.case_callback_stack.back()(case_stmt);
 		return case_stmt;
 	}
 
-	UniqueSwitchStmtPtr Sema::ActOnSwitchStmt(SourceLocation const& loc, UniqueExprPtr&& cond_expr, UniqueStmtPtr body_stmt, std::vector<CaseStmt*>&& case_stmts)
+	SwitchStmt* Sema::ActOnSwitchStmt(SourceLocation const& loc, Expr* cond_expr, Stmt* body_stmt, std::vector<CaseStmt*>&& case_stmts)
 	{
 		Bool default_found = false;
 		std::unordered_map<Int64, Bool> case_value_found;
@@ -573,20 +607,20 @@ namespace ola
 			}
 		}
 
-		UniqueSwitchStmtPtr switch_stmt = MakeUnique<SwitchStmt>();
-		switch_stmt->SetCondExpr(std::move(cond_expr));
-		switch_stmt->SetBodyStmt(std::move(body_stmt));
+		SwitchStmt* switch_stmt = ast_ctx->New<SwitchStmt>();
+		switch_stmt->SetCondExpr(cond_expr);
+		switch_stmt->SetBodyStmt(body_stmt);
 
 		return switch_stmt;
 	}
 
-	UniqueGotoStmtPtr Sema::ActOnGotoStmt(SourceLocation const& loc, std::string_view label_name)
+	GotoStmt* Sema::ActOnGotoStmt(SourceLocation const& loc, std::string_view label_name)
 	{
 		sema_ctx.gotos.push_back(std::string(label_name));
-		return MakeUnique<GotoStmt>(label_name);
+		return ast_ctx->New<GotoStmt>(ast_ctx->NewString(label_name));
 	}
 
-	UniqueLabelStmtPtr Sema::ActOnLabelStmt(SourceLocation const& loc, std::string_view label_name)
+	LabelStmt* Sema::ActOnLabelStmt(SourceLocation const& loc, std::string_view label_name)
 	{
 		std::string label(label_name);
 		if (sema_ctx.labels.contains(label))
@@ -595,10 +629,10 @@ namespace ola
 			return nullptr;
 		}
 		sema_ctx.labels.insert(label);
-		return MakeUnique<LabelStmt>(label_name);
+		return ast_ctx->New<LabelStmt>(ast_ctx->NewString(label_name));
 	}
 
-	UniqueUnaryExprPtr Sema::ActOnUnaryExpr(UnaryExprKind op, SourceLocation const& loc, UniqueExprPtr&& operand)
+	UnaryExpr* Sema::ActOnUnaryExpr(UnaryExprKind op, SourceLocation const& loc, Expr* operand)
 	{
 		switch (op)
 		{
@@ -634,20 +668,20 @@ namespace ola
 		case UnaryExprKind::LogicalNot:
 			if (!isa<BoolType>(operand->GetType()))
 			{
-				operand = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), std::move(operand));
+				operand = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), operand);
 			}
 			break;
 		default:
 			break;
 		}
-		UniqueUnaryExprPtr unary_expr = MakeUnique<UnaryExpr>(op, loc);
+		UnaryExpr* unary_expr = ast_ctx->New<UnaryExpr>(op, loc);
 		unary_expr->SetType(operand->GetType());
-		unary_expr->SetOperand(std::move(operand));
+		unary_expr->SetOperand(operand);
 
 		return unary_expr;
 	}
 
-	UniqueBinaryExprPtr Sema::ActOnBinaryExpr(BinaryExprKind op, SourceLocation const& loc, UniqueExprPtr&& lhs, UniqueExprPtr&& rhs)
+	BinaryExpr* Sema::ActOnBinaryExpr(BinaryExprKind op, SourceLocation const& loc, Expr* lhs, Expr* rhs)
 	{
 		QualType type{};
 		QualType const& lhs_type = lhs->GetType();
@@ -677,7 +711,7 @@ namespace ola
 			}
 			else if (lhs_type.GetTypePtr() != rhs_type.GetTypePtr())
 			{
-				rhs = ActOnImplicitCastExpr(loc, lhs_type, std::move(rhs));
+				rhs = ActOnImplicitCastExpr(loc, lhs_type, rhs);
 			}
 			type = lhs_type;
 		}
@@ -703,12 +737,12 @@ namespace ola
 			else if (lhs_type_kind > rhs_type_kind)
 			{
 				type = lhs_type;
-				rhs = ActOnImplicitCastExpr(loc, type, std::move(rhs));
+				rhs = ActOnImplicitCastExpr(loc, type, rhs);
 			}
 			else
 			{
 				type = rhs_type;
-				lhs = ActOnImplicitCastExpr(loc, type, std::move(lhs));
+				lhs = ActOnImplicitCastExpr(loc, type, lhs);
 			}
 		}
 		break;
@@ -721,11 +755,11 @@ namespace ola
 			}
 			if (!isa<IntType>(lhs_type))
 			{
-				lhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), std::move(lhs));
+				lhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), lhs);
 			}
 			if (!isa<IntType>(rhs_type))
 			{
-				rhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), std::move(rhs));
+				rhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), rhs);
 			}
 			type = IntType::Get(ctx);
 		}
@@ -740,11 +774,11 @@ namespace ola
 			}
 			if (!isa<IntType>(lhs_type))
 			{
-				lhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), std::move(lhs));
+				lhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), lhs);
 			}
 			if (!isa<IntType>(rhs_type))
 			{
-				rhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), std::move(rhs));
+				rhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), rhs);
 			}
 			type = IntType::Get(ctx);
 		}
@@ -760,11 +794,11 @@ namespace ola
 			}
 			if (!isa<IntType>(lhs_type))
 			{
-				lhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), std::move(lhs));
+				lhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), lhs);
 			}
 			if (!isa<IntType>(rhs_type))
 			{
-				rhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), std::move(rhs));
+				rhs = ActOnImplicitCastExpr(loc, IntType::Get(ctx), rhs);
 			}
 			type = IntType::Get(ctx);
 		}
@@ -774,11 +808,11 @@ namespace ola
 		{
 			if (!isa<BoolType>(lhs_type))
 			{
-				lhs = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), std::move(lhs));
+				lhs = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), lhs);
 			}
 			if (!isa<BoolType>(rhs_type))
 			{
-				rhs = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), std::move(rhs));
+				rhs = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), rhs);
 			}
 			type = BoolType::Get(ctx);
 		}
@@ -802,12 +836,12 @@ namespace ola
 			if (lhs_type_kind > rhs_type_kind)
 			{
 				type = lhs_type;
-				rhs = ActOnImplicitCastExpr(loc, type, std::move(rhs));
+				rhs = ActOnImplicitCastExpr(loc, type, rhs);
 			}
 			else if (lhs_type_kind < rhs_type_kind)
 			{
 				type = rhs_type;
-				lhs = ActOnImplicitCastExpr(loc, type, std::move(lhs));
+				lhs = ActOnImplicitCastExpr(loc, type, lhs);
 			}
 
 			type = BoolType::Get(ctx);
@@ -823,14 +857,14 @@ namespace ola
 			OLA_ASSERT(false);
 		}
 
-		UniqueBinaryExprPtr binary_expr = MakeUnique<BinaryExpr>(op, loc);
+		BinaryExpr* binary_expr = ast_ctx->New<BinaryExpr>(op, loc);
 		binary_expr->SetType(type);
-		binary_expr->SetLHS(std::move(lhs));
-		binary_expr->SetRHS(std::move(rhs));
+		binary_expr->SetLHS(lhs);
+		binary_expr->SetRHS(rhs);
 		return binary_expr;
 	}
 
-	UniqueTernaryExprPtr Sema::ActOnTernaryExpr(SourceLocation const& loc, UniqueExprPtr&& cond_expr, UniqueExprPtr&& true_expr, UniqueExprPtr&& false_expr)
+	TernaryExpr* Sema::ActOnTernaryExpr(SourceLocation const& loc, Expr* cond_expr, Expr* true_expr, Expr* false_expr)
 	{
 		QualType const& true_type = true_expr->GetType();
 		QualType const& false_type = false_expr->GetType();
@@ -842,27 +876,27 @@ namespace ola
 		}
 		else if (cond_expr->GetType().GetTypePtr() != BoolType::Get(ctx))
 		{
-			cond_expr = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), std::move(cond_expr));
+			cond_expr = ActOnImplicitCastExpr(loc, BoolType::Get(ctx), cond_expr);
 		}
 
 		QualType expr_type{};
 		if (true_type.GetTypePtr() == false_type.GetTypePtr()) expr_type = true_type;
 		else diagnostics.Report(loc, ternary_expr_types_incompatible);
 
-		UniqueTernaryExprPtr ternary_expr = MakeUnique<TernaryExpr>(loc);
+		TernaryExpr* ternary_expr = ast_ctx->New<TernaryExpr>(loc);
 		ternary_expr->SetType(expr_type);
-		ternary_expr->SetCondExpr(std::move(cond_expr));
-		ternary_expr->SetTrueExpr(std::move(true_expr));
-		ternary_expr->SetFalseExpr(std::move(false_expr));
+		ternary_expr->SetCondExpr(cond_expr);
+		ternary_expr->SetTrueExpr(true_expr);
+		ternary_expr->SetFalseExpr(false_expr);
 		return ternary_expr;
 	}
 
-	UniqueCallExprPtr Sema::ActOnCallExpr(SourceLocation const& loc, UniqueExprPtr&& func_expr, UniqueExprPtrList&& args)
+	CallExpr* Sema::ActOnCallExpr(SourceLocation const& loc, Expr* func_expr, ExprPtrList&& args)
 	{
-		if (isa<IdentifierExpr>(func_expr.get()))
+		if (isa<IdentifierExpr>(func_expr))
 		{
-			IdentifierExpr const* func_identifier = cast<IdentifierExpr>(func_expr.get());
-			std::vector<Decl*>& found_decls = sema_ctx.decl_sym_table.LookUp_Overload(func_identifier->GetName());
+			IdentifierExpr const* func_identifier = cast<IdentifierExpr>(func_expr);
+			std::vector<Decl*> const& found_decls = sema_ctx.decl_sym_table.LookUp_Overload(func_identifier->GetIdentifier());
 			std::vector<FunctionDecl const*> candidate_decls{};
 			for (Decl* decl : found_decls)
 			{
@@ -887,46 +921,46 @@ namespace ola
 			std::span<QualType const> param_types = match_func_type->GetParams();
 			for (Uint64 i = 0; i < param_types.size(); ++i)
 			{
-				UniqueExprPtr& arg = args[i];
+				Expr*& arg = args[i];
 				QualType const& func_param_type = param_types[i];
 				if (func_param_type.GetTypePtr() != arg->GetType().GetTypePtr())
 				{
-					arg = ActOnImplicitCastExpr(loc, func_param_type, std::move(arg));
+					arg = ActOnImplicitCastExpr(loc, func_param_type, arg);
 				}
 			}
 
 			if (isa<MethodDecl>(match_decl))
 			{
-				UniqueMemberExprPtr member_expr = MakeUnique<MemberExpr>(loc);
+				MemberExpr* member_expr = ast_ctx->New<MemberExpr>(loc);
 				member_expr->SetClassExpr(ActOnThisExpr(loc, true));
 				member_expr->SetMemberDecl(cast<MethodDecl>(match_decl));
 				member_expr->SetType(match_func_type);
 
-				UniqueMethodCallExprPtr method_call_expr = MakeUnique<MethodCallExpr>(loc, cast<MethodDecl>(match_decl));
+				MethodCallExpr* method_call_expr = ast_ctx->New<MethodCallExpr>(loc, cast<MethodDecl>(match_decl));
 				method_call_expr->SetType(match_func_type->GetReturnType());
-				method_call_expr->SetArgs(std::move(args));
-				method_call_expr->SetCallee(std::move(member_expr));
+				method_call_expr->SetArgs(ast_ctx->NewArray(args));
+				method_call_expr->SetCallee(member_expr);
 				if (isa<RefType>(method_call_expr->GetType())) method_call_expr->SetLValue();
 				return method_call_expr;
 			}
 			else
 			{
-				UniqueCallExprPtr func_call_expr = MakeUnique<CallExpr>(loc, match_decl);
+				CallExpr* func_call_expr = ast_ctx->New<CallExpr>(loc, match_decl);
 				func_call_expr->SetType(match_func_type->GetReturnType());
-				func_call_expr->SetArgs(std::move(args));
-				func_call_expr->SetCallee(MakeUnique<DeclRefExpr>(match_decl, loc));
+				func_call_expr->SetArgs(ast_ctx->NewArray(args));
+				func_call_expr->SetCallee(ast_ctx->New<DeclRefExpr>(match_decl, loc));
 				if (isa<RefType>(func_call_expr->GetType())) func_call_expr->SetLValue();
 				return func_call_expr;
 			}
 		}
-		else if (isa<ThisExpr>(func_expr.get()))
+		else if (isa<ThisExpr>(func_expr))
 		{
 			if (!sema_ctx.is_constructor)
 			{
 				diagnostics.Report(loc, ctor_call_outside_ctor);
 				return nullptr;
 			}
-			if (sema_ctx.current_class_name.empty())
+			if (sema_ctx.current_class_name.IsEmpty())
 			{
 				diagnostics.Report(loc, ctor_call_without_class);
 				return nullptr;
@@ -954,27 +988,27 @@ namespace ola
 			std::span<QualType const> param_types = match_func_type->GetParams();
 			for (Uint64 i = 0; i < param_types.size(); ++i)
 			{
-				UniqueExprPtr& arg = args[i];
+				Expr*& arg = args[i];
 				QualType const& func_param_type = param_types[i];
 				if (func_param_type.GetTypePtr() != arg->GetType().GetTypePtr())
 				{
-					arg = ActOnImplicitCastExpr(loc, func_param_type, std::move(arg));
+					arg = ActOnImplicitCastExpr(loc, func_param_type, arg);
 				}
 			}
 
-			UniqueMemberExprPtr member_expr = MakeUnique<MemberExpr>(loc);
-			member_expr->SetClassExpr(std::move(func_expr));
+			MemberExpr* member_expr = ast_ctx->New<MemberExpr>(loc);
+			member_expr->SetClassExpr(func_expr);
 			member_expr->SetMemberDecl(match_decl);
 			member_expr->SetType(match_func_type);
 
-			UniqueMethodCallExprPtr method_call_expr = MakeUnique<MethodCallExpr>(loc, match_decl);
+			MethodCallExpr* method_call_expr = ast_ctx->New<MethodCallExpr>(loc, match_decl);
 			method_call_expr->SetType(match_func_type->GetReturnType());
-			method_call_expr->SetArgs(std::move(args));
-			method_call_expr->SetCallee(std::move(member_expr));
+			method_call_expr->SetArgs(ast_ctx->NewArray(args));
+			method_call_expr->SetCallee(member_expr);
 			if (isa<RefType>(method_call_expr->GetType())) method_call_expr->SetLValue();
 			return method_call_expr;
 		}
-		else if (isa<SuperExpr>(func_expr.get()))
+		else if (isa<SuperExpr>(func_expr))
 		{
 			if (!sema_ctx.is_constructor)
 			{
@@ -1006,23 +1040,23 @@ namespace ola
 			std::span<QualType const> param_types = match_func_type->GetParams();
 			for (Uint64 i = 0; i < param_types.size(); ++i)
 			{
-				UniqueExprPtr& arg = args[i];
+				Expr*& arg = args[i];
 				QualType const& func_param_type = param_types[i];
 				if (func_param_type.GetTypePtr() != arg->GetType().GetTypePtr())
 				{
-					arg = ActOnImplicitCastExpr(loc, func_param_type, std::move(arg));
+					arg = ActOnImplicitCastExpr(loc, func_param_type, arg);
 				}
 			}
 
-			UniqueMemberExprPtr member_expr = MakeUnique<MemberExpr>(loc);
-			member_expr->SetClassExpr(std::move(func_expr));
+			MemberExpr* member_expr = ast_ctx->New<MemberExpr>(loc);
+			member_expr->SetClassExpr(func_expr);
 			member_expr->SetMemberDecl(match_decl);
 			member_expr->SetType(match_func_type);
 
-			UniqueMethodCallExprPtr method_call_expr = MakeUnique<MethodCallExpr>(loc, match_decl);
+			MethodCallExpr* method_call_expr = ast_ctx->New<MethodCallExpr>(loc, match_decl);
 			method_call_expr->SetType(match_func_type->GetReturnType());
-			method_call_expr->SetArgs(std::move(args));
-			method_call_expr->SetCallee(std::move(member_expr));
+			method_call_expr->SetArgs(ast_ctx->NewArray(args));
+			method_call_expr->SetCallee(member_expr);
 			if (isa<RefType>(method_call_expr->GetType())) method_call_expr->SetLValue();
 			return method_call_expr;
 		}
@@ -1030,14 +1064,14 @@ namespace ola
 		return nullptr;
 	}
 
-	UniqueIntLiteralPtr Sema::ActOnIntLiteral(Int64 value, SourceLocation const& loc)
+	IntLiteral* Sema::ActOnIntLiteral(Int64 value, SourceLocation const& loc)
 	{
-		UniqueIntLiteralPtr int_literal = MakeUnique<IntLiteral>(value, loc);
+		IntLiteral* int_literal = ast_ctx->New<IntLiteral>(value, loc);
 		int_literal->SetType(IntType::Get(ctx));
 		return int_literal;
 	}
 
-	UniqueIntLiteralPtr Sema::ActOnLengthOperator(QualType const& type, SourceLocation const& loc)
+	IntLiteral* Sema::ActOnLengthOperator(QualType const& type, SourceLocation const& loc)
 	{
 		if (!isa<ArrayType>(type))
 		{
@@ -1053,74 +1087,74 @@ namespace ola
 		return ActOnIntLiteral(array_type->GetArraySize(), loc);
 	}
 
-	UniqueCharLiteralPtr Sema::ActOnCharLiteral(std::string_view str, SourceLocation const& loc)
+	CharLiteral* Sema::ActOnCharLiteral(std::string_view str, SourceLocation const& loc)
 	{
 		if (str.size() != 1)
 		{
 			diagnostics.Report(loc, invalid_char_literal);
 			return nullptr;
 		}
-		UniqueCharLiteralPtr char_literal = MakeUnique<CharLiteral>(str[0], loc);
+		CharLiteral* char_literal = ast_ctx->New<CharLiteral>(str[0], loc);
 		char_literal->SetType(CharType::Get(ctx));
 		return char_literal;
 	}
 
-	UniqueStringLiteralPtr Sema::ActOnStringLiteral(std::string_view str, SourceLocation const& loc)
+	StringLiteral* Sema::ActOnStringLiteral(std::string_view str, SourceLocation const& loc)
 	{
-		UniqueStringLiteralPtr string_literal = MakeUnique<StringLiteral>(str, loc);
+		StringLiteral* string_literal = ast_ctx->New<StringLiteral>(ast_ctx->NewString(str), loc);
 		string_literal->SetType(ArrayType::Get(ctx, QualType(CharType::Get(ctx), Qualifier_Const), str.size() + 1));
 		return string_literal;
 	}
 
-	UniqueBoolLiteralPtr Sema::ActOnBoolLiteral(Bool value, SourceLocation const& loc)
+	BoolLiteral* Sema::ActOnBoolLiteral(Bool value, SourceLocation const& loc)
 	{
-		UniqueBoolLiteralPtr bool_literal = MakeUnique<BoolLiteral>(value, loc);
+		BoolLiteral* bool_literal = ast_ctx->New<BoolLiteral>(value, loc);
 		bool_literal->SetType(BoolType::Get(ctx));
 		return bool_literal;
 	}
 
-	UniqueFloatLiteralPtr Sema::ActOnFloatLiteral(Float64 value, SourceLocation const& loc)
+	FloatLiteral* Sema::ActOnFloatLiteral(Float64 value, SourceLocation const& loc)
 	{
-		UniqueFloatLiteralPtr float_literal = MakeUnique<FloatLiteral>(value, loc);
+		FloatLiteral* float_literal = ast_ctx->New<FloatLiteral>(value, loc);
 		float_literal->SetType(FloatType::Get(ctx));
 		return float_literal;
 	}
 
-	UniqueExprPtr Sema::ActOnIdentifier(std::string_view name, SourceLocation const& loc, Bool overloaded_symbol)
+	Expr* Sema::ActOnIdentifier(Identifier name, SourceLocation const& loc, Bool overloaded_symbol)
 	{
 		if (overloaded_symbol)
 		{
-			std::vector<Decl*>& decls = sema_ctx.decl_sym_table.LookUp_Overload(name);
-			if (!decls.empty()) return MakeUnique<IdentifierExpr>(name, loc);
+			std::vector<Decl*> const& decls = sema_ctx.decl_sym_table.LookUp_Overload(name);
+			if (!decls.empty()) return ast_ctx->New<IdentifierExpr>(name, loc);
 
 			if (ClassDecl const* base_class_decl = sema_ctx.current_base_class)
 			{
 				std::vector<MethodDecl const*> method_decls = base_class_decl->FindMethodDecls(name);
-				if (!method_decls.empty()) return MakeUnique<IdentifierExpr>(name, loc);
+				if (!method_decls.empty()) return ast_ctx->New<IdentifierExpr>(name, loc);
 			}
 		}
 		else
 		{
 			if (Decl* decl = sema_ctx.decl_sym_table.LookUp(name))
 			{
-				UniqueDeclRefExprPtr decl_ref = MakeUnique<DeclRefExpr>(decl, loc);
-				if (decl->IsMember()) return ActOnFieldAccess(loc, ActOnThisExpr(loc, true), std::move(decl_ref));
+				DeclRefExpr* decl_ref = ast_ctx->New<DeclRefExpr>(decl, loc);
+				if (decl->IsMember()) return ActOnFieldAccess(loc, ActOnThisExpr(loc, true), decl_ref);
 				else return decl_ref;
 			}
 			else if (ClassDecl const* base_class_decl = sema_ctx.current_base_class)
 			{
 				if (Decl* class_member_decl = base_class_decl->FindFieldDecl(name))
 				{
-					UniqueDeclRefExprPtr decl_ref = MakeUnique<DeclRefExpr>(class_member_decl, loc);
-					return ActOnFieldAccess(loc, ActOnSuperExpr(loc, true), std::move(decl_ref));
+					DeclRefExpr* decl_ref = ast_ctx->New<DeclRefExpr>(class_member_decl, loc);
+					return ActOnFieldAccess(loc, ActOnSuperExpr(loc, true), decl_ref);
 				}
 			}
 		}
-		diagnostics.Report(loc, undeclared_identifier, name);
+		diagnostics.Report(loc, undeclared_identifier, name.GetName());
 		return nullptr;
 	}
 
-	UniqueIdentifierExprPtr Sema::ActOnMemberIdentifier(std::string_view name, SourceLocation const& loc, Bool overloaded_symbol)
+	IdentifierExpr* Sema::ActOnMemberIdentifier(Identifier name, SourceLocation const& loc, Bool overloaded_symbol)
 	{
 		if (!sema_ctx.current_class_expr_stack.empty())
 		{
@@ -1151,13 +1185,13 @@ namespace ola
 				if (overloaded_symbol)
 				{
 					std::vector<MethodDecl const*> method_decls = class_decl->FindMethodDecls(name);
-					if (!method_decls.empty()) return MakeUnique<IdentifierExpr>(name, loc);
+					if (!method_decls.empty()) return ast_ctx->New<IdentifierExpr>(name, loc);
 				}
 				else
 				{
 					if (FieldDecl* class_member_decl = class_decl->FindFieldDecl(name))
 					{
-						UniqueDeclRefExprPtr decl_ref = MakeUnique<DeclRefExpr>(class_member_decl, loc);
+						DeclRefExpr* decl_ref = ast_ctx->New<DeclRefExpr>(class_member_decl, loc);
 						return decl_ref;
 					}
 				}
@@ -1167,12 +1201,12 @@ namespace ola
 				if (overloaded_symbol)
 				{
 					std::vector<Decl*> decls = sema_ctx.decl_sym_table.LookUpMember_Overload(name);
-					if (!decls.empty()) return MakeUnique<IdentifierExpr>(name, loc);
+					if (!decls.empty()) return ast_ctx->New<IdentifierExpr>(name, loc);
 				}
 				else
 				{
 					Decl* decl = sema_ctx.decl_sym_table.LookUpMember(name);
-					return MakeUnique<DeclRefExpr>(decl, loc);
+					return ast_ctx->New<DeclRefExpr>(decl, loc);
 				}
 			}
 			else if (isa<SuperExpr>(current_class_expr))
@@ -1183,23 +1217,23 @@ namespace ola
 				if (overloaded_symbol)
 				{
 					std::vector<MethodDecl const*> decls = base_class_decl->FindMethodDecls(name);
-					if (!decls.empty()) return MakeUnique<IdentifierExpr>(name, loc);
+					if (!decls.empty()) return ast_ctx->New<IdentifierExpr>(name, loc);
 				}
 				else
 				{
 					if (Decl* class_member_decl = base_class_decl->FindFieldDecl(name))
 					{
-						UniqueDeclRefExprPtr decl_ref = MakeUnique<DeclRefExpr>(class_member_decl, loc);
+						DeclRefExpr* decl_ref = ast_ctx->New<DeclRefExpr>(class_member_decl, loc);
 						return decl_ref;
 					}
 				}
 			}
 		}
-		diagnostics.Report(loc, undeclared_identifier, name);
+		diagnostics.Report(loc, undeclared_identifier, name.GetName());
 		return nullptr;
 	}
 
-	UniqueInitializerListExprPtr Sema::ActOnInitializerListExpr(SourceLocation const& loc, UniqueExprPtrList&& expr_list)
+	InitializerListExpr* Sema::ActOnInitializerListExpr(SourceLocation const& loc, ExprPtrList&& expr_list)
 	{
 		QualType expr_type{};
 		expr_type = expr_list.front()->GetType();
@@ -1213,13 +1247,13 @@ namespace ola
 			}
 		}
 		QualType base_type(expr_type);
-		UniqueInitializerListExprPtr init_list_expr = MakeUnique<InitializerListExpr>(loc);
+		InitializerListExpr* init_list_expr = ast_ctx->New<InitializerListExpr>(loc);
 		init_list_expr->SetType(ArrayType::Get(ctx, base_type, expr_list.size()));
-		init_list_expr->SetInitList(std::move(expr_list));
+		init_list_expr->SetInitList(ast_ctx->NewArray(expr_list));
 		return init_list_expr;
 	}
 
-	UniqueArrayAccessExprPtr Sema::ActOnArrayAccessExpr(SourceLocation const& loc, UniqueExprPtr&& array_expr, UniqueExprPtr&& index_expr)
+	ArrayAccessExpr* Sema::ActOnArrayAccessExpr(SourceLocation const& loc, Expr* array_expr, Expr* index_expr)
 	{
 		if (!isa<ArrayType>(array_expr->GetType()))
 		{
@@ -1233,9 +1267,9 @@ namespace ola
 		}
 
 		ArrayType const* array_type = cast<ArrayType>(array_expr->GetType());
-		if (index_expr->IsConstexpr())
+		if (std::optional<Int64> index_value = EvaluateIntegralConstant(index_expr))
 		{
-			Int64 bracket_value = index_expr->EvaluateConstexpr();
+			Int64 bracket_value = *index_value;
 			if (array_type->GetArraySize() > 0 && (bracket_value < 0 || bracket_value >= array_type->GetArraySize()))
 			{
 				diagnostics.Report(loc, array_index_outside_of_bounds, bracket_value);
@@ -1243,14 +1277,14 @@ namespace ola
 			}
 		}
 
-		UniqueArrayAccessExprPtr array_access_expr = MakeUnique<ArrayAccessExpr>(loc);
-		array_access_expr->SetArrayExpr(std::move(array_expr));
-		array_access_expr->SetIndexExpr(std::move(index_expr));
+		ArrayAccessExpr* array_access_expr = ast_ctx->New<ArrayAccessExpr>(loc);
+		array_access_expr->SetArrayExpr(array_expr);
+		array_access_expr->SetIndexExpr(index_expr);
 		array_access_expr->SetType(array_type->GetElementType());
 		return array_access_expr;
 	}
 
-	UniqueMemberExprPtr Sema::ActOnFieldAccess(SourceLocation const& loc, UniqueExprPtr&& class_expr, UniqueIdentifierExprPtr&& field_name)
+	MemberExpr* Sema::ActOnFieldAccess(SourceLocation const& loc, Expr* class_expr, IdentifierExpr* field_name)
 	{
 		QualType const& class_expr_type = class_expr->GetType();
 		if (!isa<ClassType>(class_expr_type))
@@ -1269,11 +1303,11 @@ namespace ola
 			}
 		}
 
-		OLA_ASSERT(isa<DeclRefExpr>(field_name.get()));
-		DeclRefExpr const* member_decl_ref = cast<DeclRefExpr>(field_name.get());
+		OLA_ASSERT(isa<DeclRefExpr>(field_name));
+		DeclRefExpr const* member_decl_ref = cast<DeclRefExpr>(field_name);
 		Decl const* member_decl = member_decl_ref->GetDecl();
 
-		if (!isoneof<ThisExpr, SuperExpr>(class_expr.get()) && member_decl->IsPrivate())
+		if (!isoneof<ThisExpr, SuperExpr>(class_expr) && member_decl->IsPrivate())
 		{
 			diagnostics.Report(loc, private_member_access);
 			return nullptr;
@@ -1283,14 +1317,14 @@ namespace ola
 		QualType expr_type = field_name->GetType();
 		if (class_type_is_const) expr_type.AddConst();
 
-		UniqueMemberExprPtr member_expr = MakeUnique<MemberExpr>(loc);
-		member_expr->SetClassExpr(std::move(class_expr));
+		MemberExpr* member_expr = ast_ctx->New<MemberExpr>(loc);
+		member_expr->SetClassExpr(class_expr);
 		member_expr->SetMemberDecl(member_decl);
 		member_expr->SetType(expr_type);
 		return member_expr;
 	}
 
-	UniqueMethodCallExprPtr Sema::ActOnMethodCall(SourceLocation const& loc, UniqueExprPtr&& class_expr, UniqueIdentifierExprPtr&& member_identifier, UniqueExprPtrList&& args)
+	MethodCallExpr* Sema::ActOnMethodCall(SourceLocation const& loc, Expr* class_expr, IdentifierExpr* member_identifier, ExprPtrList&& args)
 	{
 		QualType const& class_expr_type = class_expr->GetType();
 		ClassDecl const* class_decl = nullptr;
@@ -1319,7 +1353,7 @@ namespace ola
 		}
 		OLA_ASSERT(class_decl);
 
-		std::vector<MethodDecl const*> candidate_decls = class_decl->FindMethodDecls(member_identifier->GetName());
+		std::vector<MethodDecl const*> candidate_decls = class_decl->FindMethodDecls(member_identifier->GetIdentifier());
 		std::vector<MethodDecl const*> match_decls = ResolveCall(candidate_decls, args);
 		if (match_decls.empty())
 		{
@@ -1334,7 +1368,7 @@ namespace ola
 
 		MethodDecl const* match_decl = match_decls[0];
 		FuncType const* match_decl_type = match_decl->GetFuncType();
-		if (!isoneof<ThisExpr, SuperExpr>(class_expr.get()) && match_decl->IsPrivate())
+		if (!isoneof<ThisExpr, SuperExpr>(class_expr) && match_decl->IsPrivate())
 		{
 			diagnostics.Report(loc, private_member_access);
 			return nullptr;
@@ -1343,11 +1377,11 @@ namespace ola
 		std::span<QualType const> param_types = match_decl_type->GetParams();
 		for (Uint64 i = 0; i < param_types.size(); ++i)
 		{
-			UniqueExprPtr& arg = args[i];
+			Expr*& arg = args[i];
 			QualType const& func_param_type = param_types[i];
 			if (func_param_type.GetTypePtr() != arg->GetType().GetTypePtr())
 			{
-				arg = ActOnImplicitCastExpr(loc, func_param_type, std::move(arg));
+				arg = ActOnImplicitCastExpr(loc, func_param_type, arg);
 			}
 		}
 
@@ -1361,43 +1395,43 @@ namespace ola
 			}
 		}
 
-		UniqueMemberExprPtr member_expr = MakeUnique<MemberExpr>(loc);
-		member_expr->SetClassExpr(std::move(class_expr));
+		MemberExpr* member_expr = ast_ctx->New<MemberExpr>(loc);
+		member_expr->SetClassExpr(class_expr);
 		member_expr->SetMemberDecl(match_decl);
 		member_expr->SetType(match_decl_type);
 
-		UniqueMethodCallExprPtr method_call_expr = MakeUnique<MethodCallExpr>(loc, match_decl);
+		MethodCallExpr* method_call_expr = ast_ctx->New<MethodCallExpr>(loc, match_decl);
 		method_call_expr->SetType(match_decl_type->GetReturnType());
-		method_call_expr->SetArgs(std::move(args));
-		method_call_expr->SetCallee(std::move(member_expr));
+		method_call_expr->SetArgs(ast_ctx->NewArray(args));
+		method_call_expr->SetCallee(member_expr);
 		if (isa<RefType>(method_call_expr->GetType())) method_call_expr->SetLValue();
 		return method_call_expr;
 	}
 
-	UniqueThisExprPtr Sema::ActOnThisExpr(SourceLocation const& loc, Bool implicit)
+	ThisExpr* Sema::ActOnThisExpr(SourceLocation const& loc, Bool implicit)
 	{
-		UniqueThisExprPtr this_expr = MakeUnique<ThisExpr>(loc);
+		ThisExpr* this_expr = ast_ctx->New<ThisExpr>(loc);
 		this_expr->SetImplicit(implicit);
 		QualType this_type(ClassType::Get(ctx, nullptr), sema_ctx.is_method_const ? Qualifier_Const : Qualifier_None);
 		this_expr->SetType(this_type);
 		return this_expr;
 	}
 
-	UniqueSuperExprPtr Sema::ActOnSuperExpr(SourceLocation const& loc, Bool implicit)
+	SuperExpr* Sema::ActOnSuperExpr(SourceLocation const& loc, Bool implicit)
 	{
 		if (!sema_ctx.current_base_class)
 		{
 			diagnostics.Report(loc, super_used_in_wrong_context);
 			return nullptr;
 		}
-		UniqueSuperExprPtr super_expr = MakeUnique<SuperExpr>(loc);
+		SuperExpr* super_expr = ast_ctx->New<SuperExpr>(loc);
 		super_expr->SetImplicit(implicit);
 		QualType super_type(ClassType::Get(ctx, sema_ctx.current_base_class), sema_ctx.is_method_const ? Qualifier_Const : Qualifier_None);
 		super_expr->SetType(super_type);
 		return super_expr;
 	}
 
-	UniqueConstructorExprPtr Sema::ActOnConstructorExpr(SourceLocation const& loc, QualType const& type, UniqueExprPtrList&& args)
+	ConstructorExpr* Sema::ActOnConstructorExpr(SourceLocation const& loc, QualType const& type, ExprPtrList&& args)
 	{
 		if (!isa<ClassType>(type))
 		{
@@ -1422,20 +1456,20 @@ namespace ola
 		std::span<QualType const> param_types = match_ctor->GetFuncType()->GetParams();
 		for (Uint64 i = 0; i < param_types.size(); ++i)
 		{
-			UniqueExprPtr& arg = args[i];
+			Expr*& arg = args[i];
 			QualType const& func_param_type = param_types[i];
 			if (func_param_type.GetTypePtr() != arg->GetType().GetTypePtr())
 			{
-				arg = ActOnImplicitCastExpr(loc, func_param_type, std::move(arg));
+				arg = ActOnImplicitCastExpr(loc, func_param_type, arg);
 			}
 		}
-		UniqueConstructorExprPtr ctor_expr = MakeUnique<ConstructorExpr>(loc, match_ctor);
+		ConstructorExpr* ctor_expr = ast_ctx->New<ConstructorExpr>(loc, match_ctor);
 		ctor_expr->SetType(type);
-		ctor_expr->SetArgs(std::move(args));
+		ctor_expr->SetArgs(ast_ctx->NewArray(args));
 		return ctor_expr;
 	}
 
-	UniqueExprPtr Sema::ActOnImplicitCastExpr(SourceLocation const& loc, QualType const& type, UniqueExprPtr&& expr)
+	Expr* Sema::ActOnImplicitCastExpr(SourceLocation const& loc, QualType const& type, Expr* expr)
 	{
 		QualType const& cast_type = type;
 		QualType const& operand_type = expr->GetType();
@@ -1455,14 +1489,50 @@ namespace ola
 			return nullptr;
 		}
 
-		UniqueImplicitCastExprPtr cast_expr = MakeUnique<ImplicitCastExpr>(loc, type);
+		ImplicitCastExpr* cast_expr = ast_ctx->New<ImplicitCastExpr>(loc, type);
 		cast_expr->SetLValue(expr->IsLValue());
-		cast_expr->SetOperand(std::move(expr));
+		cast_expr->SetOperand(expr);
 		return cast_expr;
 	}
 
+	Expr* Sema::FoldConstantExpr(Expr* expr)
+	{
+		if (isoneof<IntLiteral, CharLiteral, BoolLiteral, FloatLiteral, StringLiteral>(expr)) return expr;
+		if (InitializerListExpr* init_list_expr = dyn_cast<InitializerListExpr>(expr))
+		{
+			ExprPtrList folded_init_list;
+			for (Expr* init_elem : init_list_expr->GetInitList()) folded_init_list.push_back(FoldConstantExpr(init_elem));
+			init_list_expr->SetInitList(ast_ctx->NewArray(folded_init_list));
+			return init_list_expr;
+		}
+
+		std::optional<ConstantValue> value = constant_evaluator.Evaluate(expr);
+		if (!value) return expr;
+
+		SourceLocation const& loc = expr->GetLocation();
+		switch (value->kind)
+		{
+		case TypeKind::Bool:	return ActOnBoolLiteral(value->int_value != 0, loc);
+		case TypeKind::Int:		return ActOnIntLiteral(value->int_value, loc);
+		case TypeKind::Float:	return ActOnFloatLiteral(value->float_value, loc);
+		case TypeKind::Char:
+		{
+			CharLiteral* char_literal = ast_ctx->New<CharLiteral>(static_cast<Char>(value->int_value), loc);
+			char_literal->SetType(CharType::Get(ctx));
+			return char_literal;
+		}
+		default:
+			return expr;
+		}
+	}
+
+	std::optional<Int64> Sema::EvaluateIntegralConstant(Expr const* expr)
+	{
+		return constant_evaluator.EvaluateIntegral(expr);
+	}
+
 	template<typename DeclType> requires std::is_base_of_v<VarDecl, DeclType>
-	UniquePtr<DeclType> Sema::ActOnVariableDeclCommon(std::string_view name, SourceLocation const& loc, QualType const& type, UniqueExprPtr&& init_expr, DeclVisibility visibility)
+	DeclType* Sema::ActOnVariableDeclCommon(Identifier name, SourceLocation const& loc, QualType const& type, Expr* init_expr, DeclVisibility visibility)
 	{
 		Bool const has_init = (init_expr != nullptr);
 		Bool has_type_specifier = !type.IsNull();
@@ -1472,12 +1542,12 @@ namespace ola
 			RefType const* ref_type = cast<RefType>(type);
 			has_type_specifier = !ref_type->GetReferredType().IsNull();
 		}
-		Bool const init_expr_is_decl_ref = has_init && isa<DeclRefExpr>(init_expr.get());
+		Bool const init_expr_is_decl_ref = has_init && isa<DeclRefExpr>(init_expr);
 		Bool const init_expr_const_ref = has_init && isa<RefType>(init_expr->GetType()) && init_expr->GetType().IsConst();
 
 		if (sema_ctx.decl_sym_table.LookUpCurrentScope(name))
 		{
-			diagnostics.Report(loc, redefinition_of_identifier, name);
+			diagnostics.Report(loc, redefinition_of_identifier, name.GetName());
 			return nullptr;
 		}
 
@@ -1490,7 +1560,7 @@ namespace ola
 			}
 			else if (type.GetTypePtr() != init_expr->GetType().GetTypePtr())
 			{
-				init_expr = ActOnImplicitCastExpr(loc, type, std::move(init_expr));
+				init_expr = ActOnImplicitCastExpr(loc, type, init_expr);
 			}
 		}
 		else if (!has_init && !has_type_specifier)
@@ -1501,7 +1571,7 @@ namespace ola
 
 		if (sema_ctx.decl_sym_table.LookUpCurrentScope(name))
 		{
-			diagnostics.Report(loc, redefinition_of_identifier, name);
+			diagnostics.Report(loc, redefinition_of_identifier, name.GetName());
 			return nullptr;
 		}
 		if (has_type_specifier && isa<VoidType>(type))
@@ -1510,7 +1580,7 @@ namespace ola
 			return nullptr;
 		}
 
-		UniquePtr<DeclType> var_decl = MakeUnique<DeclType>(name, loc);
+		DeclType* var_decl = ast_ctx->New<DeclType>(name, loc);
 		var_decl->SetGlobal(sema_ctx.decl_sym_table.IsGlobal());
 		var_decl->SetVisibility(visibility);
 		OLA_ASSERT(var_decl->IsGlobal() || !var_decl->IsExtern());
@@ -1521,9 +1591,10 @@ namespace ola
 			return nullptr;
 		}
 
+		if ((var_decl->IsGlobal() || isa<FieldDecl>(var_decl)) && init_expr) init_expr = FoldConstantExpr(init_expr);
 		if (var_decl->IsGlobal() && init_expr && !init_expr->IsConstexpr())
 		{
-			diagnostics.Report(loc, global_variable_initializer_not_constexpr, name);
+			diagnostics.Report(loc, global_variable_initializer_not_constexpr, name.GetName());
 			return nullptr;
 		}
 
@@ -1535,7 +1606,7 @@ namespace ola
 				diagnostics.Report(loc, arrays_cannot_be_refs);
 				return nullptr;
 			}
-			if (Expr* array_init_expr = init_expr.get())
+			if (Expr* array_init_expr = init_expr)
 			{
 				ArrayType const* init_expr_type = cast<ArrayType>(array_init_expr->GetType());
 
@@ -1550,7 +1621,7 @@ namespace ola
 					ArrayType const* decl_type = cast<ArrayType>(type);
 					if (!decl_type->GetElementType().IsConst() && init_expr_type->GetElementType().IsConst())
 					{
-						diagnostics.Report(loc, assigning_const_array_to_non_const_array, name);
+						diagnostics.Report(loc, assigning_const_array_to_non_const_array, name.GetName());
 						return nullptr;
 					}
 				}
@@ -1612,7 +1683,7 @@ namespace ola
 		{
 			var_decl->SetType(type);
 		}
-		var_decl->SetInitExpr(std::move(init_expr));
+		var_decl->SetInitExpr(init_expr);
 
 		QualType const& var_type = var_decl->GetType();
 		if (isa<RefType>(var_type))
@@ -1643,12 +1714,12 @@ namespace ola
 			}
 		}
 
-		sema_ctx.decl_sym_table.Insert(var_decl.get());
+		sema_ctx.decl_sym_table.Insert(var_decl);
 		return var_decl;
 	}
 
 	template<typename DeclType> requires std::is_base_of_v<FunctionDecl, DeclType>
-	std::vector<DeclType const*> Sema::ResolveCall(std::vector<DeclType const*> const& candidate_decls, UniqueExprPtrList& args)
+	std::vector<DeclType const*> Sema::ResolveCall(std::vector<DeclType const*> const& candidate_decls, ExprPtrList& args)
 	{
 		std::vector<DeclType const*> match_decls{};
 		Uint32 match_conversions_needed = UINT32_MAX;
@@ -1661,7 +1732,7 @@ namespace ola
 			Bool incompatible_arg = false;
 			for (Uint64 i = 0; i < param_types.size(); ++i)
 			{
-				UniqueExprPtr& arg = args[i];
+				Expr*& arg = args[i];
 				QualType const& func_param_type = param_types[i];
 				if (isa<RefType>(func_param_type) && !arg->IsLValue())
 				{
@@ -1679,7 +1750,7 @@ namespace ola
 			Uint32 current_conversions_needed = 0;
 			for (Uint64 i = 0; i < param_types.size(); ++i)
 			{
-				UniqueExprPtr& arg = args[i];
+				Expr*& arg = args[i];
 				QualType const& func_param_type = param_types[i];
 				if (func_param_type.GetTypePtr() != arg->GetType().GetTypePtr())
 				{
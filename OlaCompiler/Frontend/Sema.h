@@ -2,6 +2,8 @@
 #include <functional>
 #include <unordered_set>
 #include "Scope.h"
+#include "ModuleInterface.h"
+#include "ConstantEvaluator.h"
 #include "AST/AST.h"
 #include "AST/Decl.h"
 #include "AST/Stmt.h"
@@ -39,7 +41,7 @@ namespace ola
 			Bool is_method_const = false;
 			Bool is_constructor = false;
 			ClassDecl const* current_base_class = nullptr;
-			std::string current_class_name;
+			Identifier current_class_name;
 
 			class QualType const* current_func  = nullptr;
 			Bool return_stmt_encountered = false;
@@ -53,85 +55,96 @@ namespace ola
 		};
 
 	public:
-		Sema(FrontendContext* context, Diagnostics& diagnostics);
+		Sema(FrontendContext* context, ASTContext* ast_ctx, Diagnostics& diagnostics);
 		OLA_NONCOPYABLE(Sema)
 		OLA_DEFAULT_MOVABLE(Sema)
 		~Sema();
 
 	private:
 
-		UniqueVarDeclPtr		ActOnVariableDecl(std::string_view name, SourceLocation const& loc, QualType const& type, UniqueExprPtr&& init_expr, DeclVisibility visibility);
-		UniqueFieldDeclPtr		ActOnFieldDecl(std::string_view name, SourceLocation const& loc, QualType const& type, UniqueExprPtr&& init_expr, DeclVisibility visibility);
-		UniqueParamVarDeclPtr	ActOnParamVariableDecl(std::string_view name, SourceLocation const& loc, QualType const& type);
+		VarDecl*		ActOnVariableDecl(Identifier name, SourceLocation const& loc, QualType const& type, Expr* init_expr, DeclVisibility visibility);
+		FieldDecl*		ActOnFieldDecl(Identifier name, SourceLocation const& loc, QualType const& type, Expr* init_expr, DeclVisibility visibility);
+		ParamVarDecl*	ActOnParamVariableDecl(Identifier name, SourceLocation const& loc, QualType const& type);
 
-		UniqueFunctionDeclPtr ActOnFunctionDecl(std::string_view name, SourceLocation const& loc, QualType const& type, 
-												UniqueParamVarDeclPtrList&& param_decls, DeclVisibility visibility, FuncAttributes attributes);
-		UniqueFunctionDeclPtr				  ActOnFunctionDefinition(SourceLocation const& loc, UniqueFunctionDeclPtr&& func_decl, UniqueCompoundStmtPtr&& body_stmt);
+		FunctionDecl* ActOnFunctionDecl(Identifier name, SourceLocation const& loc, QualType const& type, 
+												ParamVarDeclPtrList&& param_decls, DeclVisibility visibility, FuncAttributes attributes);
+		FunctionDecl*				  ActOnFunctionDefinition(SourceLocation const& loc, FunctionDecl* func_decl, CompoundStmt* body_stmt);
 
-		UniqueMethodDeclPtr ActOnMethodDecl(std::string_view name, SourceLocation const& loc, QualType const& type,
-												UniqueParamVarDeclPtrList&& param_decls, UniqueCompoundStmtPtr&& body_stmt,
+		MethodDecl* ActOnMethodDecl(Identifier name, SourceLocation const& loc, QualType const& type,
+												ParamVarDeclPtrList&& param_decls, CompoundStmt* body_stmt,
 												DeclVisibility visibility, FuncAttributes func_attrs, MethodAttributes method_attrs);
-		UniqueConstructorDeclPtr ActOnConstructorDecl(std::string_view name, SourceLocation const& loc, QualType const& type,
-													  UniqueParamVarDeclPtrList&& param_decls, UniqueCompoundStmtPtr&& body_stmt);
-		UniqueEnumDeclPtr ActOnEnumDecl(std::string_view name, SourceLocation const& loc, UniqueEnumMemberDeclPtrList&& enum_members);
-		UniqueEnumMemberDeclPtr ActOnEnumMemberDecl(std::string_view name, SourceLocation const& loc, UniqueExprPtr&& enum_value_expr);
-		UniqueEnumMemberDeclPtr ActOnEnumMemberDecl(std::string_view name, SourceLocation const& loc, Int64 enum_value);
-		UniqueAliasDeclPtr ActOnAliasDecl(std::string_view name, SourceLocation const& loc, QualType const& type);
-
-		ClassDecl const* ActOnBaseClassSpecifier(std::string_view base_name, SourceLocation const& loc);
-		UniqueClassDeclPtr ActOnClassDecl(std::string_view name, ClassDecl const* base_class, SourceLocation const& loc,
-										  UniqueFieldDeclPtrList&& member_variables, UniqueMethodDeclPtrList&& member_functions, Bool final);
-
-		UniqueCompoundStmtPtr ActOnCompoundStmt(UniqueStmtPtrList&& stmts);
-		UniqueExprStmtPtr ActOnExprStmt(UniqueExprPtr&& expr);
-		UniqueDeclStmtPtr ActOnDeclStmt(UniqueDeclPtr&& decl);
-		UniqueDeclStmtPtr ActOnDeclStmt(UniqueDeclPtrList&& decls);
-		UniqueReturnStmtPtr ActOnReturnStmt(UniqueExprStmtPtr&& expr_stmt);
-		UniqueIfStmtPtr ActOnIfStmt(UniqueExprPtr&& cond_expr, UniqueStmtPtr&& then_stmt, UniqueStmtPtr&& else_stmt);
-		UniqueBreakStmtPtr ActOnBreakStmt(SourceLocation const& loc);
-		UniqueContinueStmtPtr ActOnContinueStmt(SourceLocation const& loc);
-		UniqueForStmtPtr ActOnForStmt(UniqueStmtPtr&& init_stmt, UniqueExprPtr&& cond_expr, UniqueExprPtr&& iter_expr, UniqueStmtPtr&& body_stmt);
-		UniqueForStmtPtr ActOnForeachStmt(SourceLocation const& loc, UniqueVarDeclPtr&& var_decl, UniqueExprPtr&& array_identifier, UniqueStmtPtr&& body_stmt);
-		UniqueWhileStmtPtr ActOnWhileStmt(UniqueExprPtr&& cond_expr, UniqueStmtPtr&& body_stmt);
-		UniqueDoWhileStmtPtr ActOnDoWhileStmt(UniqueExprPtr&& cond_expr, UniqueStmtPtr&& body_stmt);
-		UniqueCaseStmtPtr ActOnCaseStmt(SourceLocation const& loc, UniqueExprPtr&& case_expr = nullptr);
-		UniqueSwitchStmtPtr ActOnSwitchStmt(SourceLocation const& loc, UniqueExprPtr&& cond_expr, UniqueStmtPtr body_stmt, std::vector<CaseStmt*>&& case_stmts);
-		UniqueGotoStmtPtr ActOnGotoStmt(SourceLocation const& loc, std::string_view label_name);
-		UniqueLabelStmtPtr ActOnLabelStmt(SourceLocation const& loc, std::string_view label_name);
-
-		UniqueUnaryExprPtr ActOnUnaryExpr(UnaryExprKind op, SourceLocation const& loc, UniqueExprPtr&& operand);
-		UniqueBinaryExprPtr ActOnBinaryExpr(BinaryExprKind op, SourceLocation const& loc, UniqueExprPtr&& lhs, UniqueExprPtr&& rhs);
-		UniqueTernaryExprPtr ActOnTernaryExpr(SourceLocation const& loc, UniqueExprPtr&& cond_expr, UniqueExprPtr&& true_expr, UniqueExprPtr&& false_expr);
-		UniqueCallExprPtr ActOnCallExpr(SourceLocation const& loc, UniqueExprPtr&& func_expr, UniqueExprPtrList&& args);
-		UniqueIntLiteralPtr ActOnIntLiteral(Int64 value, SourceLocation const& loc);
-		UniqueIntLiteralPtr ActOnLengthOperator(QualType const& type, SourceLocation const& loc);
-		UniqueCharLiteralPtr ActOnCharLiteral(std::string_view str, SourceLocation const& loc);
-		UniqueStringLiteralPtr ActOnStringLiteral(std::string_view str, SourceLocation const& loc);
-		UniqueBoolLiteralPtr ActOnBoolLiteral(Bool value, SourceLocation const& loc);
-		UniqueFloatLiteralPtr ActOnFloatLiteral(Float64 value, SourceLocation const& loc);
-		UniqueExprPtr ActOnIdentifier(std::string_view name, SourceLocation const& loc, Bool overloaded_symbol);
-		UniqueIdentifierExprPtr ActOnMemberIdentifier(std::string_view name, SourceLocation const& loc, Bool overloaded_symbol);
-		UniqueInitializerListExprPtr ActOnInitializerListExpr(SourceLocation const& loc, UniqueExprPtrList&& expr_list);
-		UniqueArrayAccessExprPtr ActOnArrayAccessExpr(SourceLocation const& loc, UniqueExprPtr&& array_expr, UniqueExprPtr&& index_expr);
-		UniqueMemberExprPtr ActOnFieldAccess(SourceLocation const& loc, UniqueExprPtr&& class_expr, UniqueIdentifierExprPtr&& field_name);
-		UniqueMethodCallExprPtr ActOnMethodCall(SourceLocation const& loc, UniqueExprPtr&& class_expr, UniqueIdentifierExprPtr&& method_name, UniqueExprPtrList&& args);
-		UniqueThisExprPtr ActOnThisExpr(SourceLocation const& loc, Bool implicit);
-		UniqueSuperExprPtr ActOnSuperExpr(SourceLocation const& loc, Bool implicit);
-		UniqueConstructorExprPtr ActOnConstructorExpr(SourceLocation const& loc, QualType const& type, UniqueExprPtrList&& args);
+		ConstructorDecl* ActOnConstructorDecl(Identifier name, SourceLocation const& loc, QualType const& type,
+													  ParamVarDeclPtrList&& param_decls, CompoundStmt* body_stmt);
+		EnumDecl* ActOnEnumDecl(Identifier name, SourceLocation const& loc, EnumMemberDeclPtrList&& enum_members);
+		EnumMemberDecl* ActOnEnumMemberDecl(Identifier name, SourceLocation const& loc, Expr* enum_value_expr);
+		EnumMemberDecl* ActOnEnumMemberDecl(Identifier name, SourceLocation const& loc, Int64 enum_value);
+		AliasDecl* ActOnAliasDecl(Identifier name, SourceLocation const& loc, QualType const& type);
+
+		ClassDecl const* ActOnBaseClassSpecifier(Identifier base_name, SourceLocation const& loc);
+		ClassDecl* ActOnClassDecl(Identifier name, ClassDecl const* base_class, SourceLocation const& loc,
+										  FieldDeclPtrList&& member_variables, MethodDeclPtrList&& member_functions, Bool final);
+
+		CompoundStmt* ActOnCompoundStmt(StmtPtrList&& stmts);
+		ExprStmt* ActOnExprStmt(Expr* expr);
+		DeclStmt* ActOnDeclStmt(Decl* decl);
+		DeclStmt* ActOnDeclStmt(DeclPtrList&& decls);
+		ReturnStmt* ActOnReturnStmt(ExprStmt* expr_stmt);
+		IfStmt* ActOnIfStmt(Expr* cond_expr, Stmt* then_stmt, Stmt* else_stmt);
+		BreakStmt* ActOnBreakStmt(SourceLocation const& loc);
+		ContinueStmt* ActOnContinueStmt(SourceLocation const& loc);
+		ForStmt* ActOnForStmt(Stmt* init_stmt, Expr* cond_expr, Expr* iter_expr, Stmt* body_stmt);
+		ForStmt* ActOnForeachStmt(SourceLocation const& loc, VarDecl* var_decl, Expr* array_identifier, Stmt* body_stmt);
+		WhileStmt* ActOnWhileStmt(Expr* cond_expr, Stmt* body_stmt);
+		DoWhileStmt* ActOnDoWhileStmt(Expr* cond_expr, Stmt* body_stmt);
+		CaseStmt* ActOnCaseStmt(SourceLocation const& loc, Expr* case_expr = nullptr);
+		SwitchStmt* ActOnSwitchStmt(SourceLocation const& loc, Expr* cond_expr, Stmt* body_stmt, std::vector<CaseStmt*>&& case_stmts);
+		GotoStmt* ActOnGotoStmt(SourceLocation const& loc, std::string_view label_name);
+		LabelStmt* ActOnLabelStmt(SourceLocation const& loc, std::string_view label_name);
+
+		UnaryExpr* ActOnUnaryExpr(UnaryExprKind op, SourceLocation const& loc, Expr* operand);
+		BinaryExpr* ActOnBinaryExpr(BinaryExprKind op, SourceLocation const& loc, Expr* lhs, Expr* rhs);
+		TernaryExpr* ActOnTernaryExpr(SourceLocation const& loc, Expr* cond_expr, Expr* true_expr, Expr* false_expr);
+		CallExpr* ActOnCallExpr(SourceLocation const& loc, Expr* func_expr, ExprPtrList&& args);
+		IntLiteral* ActOnIntLiteral(Int64 value, SourceLocation const& loc);
+		IntLiteral* ActOnLengthOperator(QualType const& type, SourceLocation const& loc);
+		CharLiteral* ActOnCharLiteral(std::string_view str, SourceLocation const& loc);
+		StringLiteral* ActOnStringLiteral(std::string_view str, SourceLocation const& loc);
+		BoolLiteral* ActOnBoolLiteral(Bool value, SourceLocation const& loc);
+		FloatLiteral* ActOnFloatLiteral(Float64 value, SourceLocation const& loc);
+		Expr* ActOnIdentifier(Identifier name, SourceLocation const& loc, Bool overloaded_symbol);
+		IdentifierExpr* ActOnMemberIdentifier(Identifier name, SourceLocation const& loc, Bool overloaded_symbol);
+		InitializerListExpr* ActOnInitializerListExpr(SourceLocation const& loc, ExprPtrList&& expr_list);
+		ArrayAccessExpr* ActOnArrayAccessExpr(SourceLocation const& loc, Expr* array_expr, Expr* index_expr);
+		MemberExpr* ActOnFieldAccess(SourceLocation const& loc, Expr* class_expr, IdentifierExpr* field_name);
+		MethodCallExpr* ActOnMethodCall(SourceLocation const& loc, Expr* class_expr, IdentifierExpr* method_name, ExprPtrList&& args);
+		ThisExpr* ActOnThisExpr(SourceLocation const& loc, Bool implicit);
+		SuperExpr* ActOnSuperExpr(SourceLocation const& loc, Bool implicit);
+		ConstructorExpr* ActOnConstructorExpr(SourceLocation const& loc, QualType const& type, ExprPtrList&& args);
+
+		void ImportModules(std::vector<std::shared_ptr<ModuleInterface const>> const& modules);
 
 	private:
 		FrontendContext* ctx;
+		ASTContext* ast_ctx;
 		Diagnostics& diagnostics;
 		SemaContext sema_ctx;
+		Uint64 foreach_id = 0;
+		std::vector<ModuleInterfaceReader> module_readers;
+		DeclPtrList imported_decls;
+		ConstantEvaluator constant_evaluator;
 
 	private:
-		UniqueExprPtr ActOnImplicitCastExpr(SourceLocation const& loc, QualType const& type, UniqueExprPtr&& expr);
+		Expr* ActOnImplicitCastExpr(SourceLocation const& loc, QualType const& type, Expr* expr);
+
+		//Replaces an expression that evaluates to a constant with a literal holding its value
+		Expr* FoldConstantExpr(Expr* expr);
+		std::optional<Int64> EvaluateIntegralConstant(Expr const* expr);
 
 		template<typename DeclT> requires std::is_base_of_v<VarDecl, DeclT>
-		UniquePtr<DeclT> ActOnVariableDeclCommon(std::string_view name, SourceLocation const& loc, QualType const& type, UniqueExprPtr&& init_expr, DeclVisibility visibility);
+		DeclT* ActOnVariableDeclCommon(Identifier name, SourceLocation const& loc, QualType const& type, Expr* init_expr, DeclVisibility visibility);
 
 		template<typename DeclT> requires std::is_base_of_v<FunctionDecl, DeclT>
-		std::vector<DeclT const*> ResolveCall(std::vector<DeclT const*> const& candidate_decls, UniqueExprPtrList& args);
+		std::vector<DeclT const*> ResolveCall(std::vector<DeclT const*> const& candidate_decls, ExprPtrList& args);
 	};
 
 
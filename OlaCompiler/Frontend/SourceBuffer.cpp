@@ -1,29 +1,136 @@
 #include "SourceBuffer.h"
+#include "SourceManager.h"
 #include <fstream>
-#include <sstream>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace ola
 {
+	namespace
+	{
+		Uint64 GetPageSize()
+		{
+#if defined(_WIN32)
+			SYSTEM_INFO system_info{};
+			GetSystemInfo(&system_info);
+			return system_info.dwPageSize;
+#else
+			return static_cast<Uint64>(sysconf(_SC_PAGESIZE));
+#endif
+		}
+	}
+
 	SourceBuffer::SourceBuffer(std::string_view source_file)
 		: ref_name(source_file)
 	{
 		std::string path(source_file);
-		std::ifstream input_stream(path);
-		auto good = input_stream.good();
-		std::ostringstream buf;
-		buf << input_stream.rdbuf();
-		data_buffer = buf.str();
-		data_buffer.push_back('\0');
+		if (!MapFile(path)) ReadFile(path);
+		start_loc = SourceManager::Get().AddFile(ref_name, buffer_start, buffer_size);
 	}
 
 	SourceBuffer::SourceBuffer(Char const* buffer_start, Uint64 buffer_size, std::string_view refname)
 		: ref_name(refname), data_buffer(buffer_start, buffer_size)
-	{}
+	{
+		data_buffer.resize(buffer_size + TailPadding, '\0');
+		this->buffer_start = data_buffer.c_str();
+		this->buffer_size = buffer_size;
+		start_loc = SourceManager::Get().AddFile(ref_name, this->buffer_start, this->buffer_size);
+	}
+
+	SourceBuffer::~SourceBuffer()
+	{
+		SourceManager::Get().RemoveFile(start_loc);
+		if (!mapping) return;
+#if defined(_WIN32)
+		UnmapViewOfFile(mapping);
+#else
+		munmap(mapping, mapping_size);
+#endif
+	}
 
 	void SourceBuffer::Prepend(Char const* str)
 	{
-		data_buffer = str + data_buffer;
+		if (prefix.empty()) prefix.assign(TailPadding, '\0');
+		prefix.insert(0, str);
 	}
 
-}
+	//The bytes between the end of the file and the end of its last page are zero,
+	//which gives the lexer its sentinel and tail padding without copying the file
+	Bool SourceBuffer::MapFile(std::string const& path)
+	{
+		Uint64 const page_size = GetPageSize();
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER file_size{};
+		//A file that leaves less than the tail padding free in its last page is read instead
+		if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 ||
+			OLA_ALIGN_UP(static_cast<Uint64>(file_size.QuadPart), page_size) - static_cast<Uint64>(file_size.QuadPart) < TailPadding)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE file_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!file_mapping) return false;
+
+		mapping = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(file_mapping);
+		if (!mapping) return false;
+		buffer_size = static_cast<Uint64>(file_size.QuadPart);
+		mapping_size = OLA_ALIGN_UP(buffer_size, page_size);
+#else
+		Int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) return false;
 
+		struct stat file_stat{};
+		if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+		{
+			close(fd);
+			return false;
+		}
+		buffer_size = static_cast<Uint64>(file_stat.st_size);
+
+		//Reserve the tail padding past the file so that a file filling its last page is followed by a zero page
+		mapping_size = OLA_ALIGN_UP(buffer_size + TailPadding, page_size);
+		void* reserved = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (reserved == MAP_FAILED)
+		{
+			close(fd);
+			return false;
+		}
+		void* file_view = mmap(reserved, buffer_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+		close(fd);
+		if (file_view == MAP_FAILED)
+		{
+			munmap(reserved, mapping_size);
+			return false;
+		}
+		mapping = reserved;
+#endif
+		buffer_start = static_cast<Char const*>(mapping);
+		return true;
+	}
+
+	void SourceBuffer::ReadFile(std::string const& path)
+	{
+		std::ifstream input_stream(path, std::ios::binary | std::ios::ate);
+		if (input_stream.good())
+		{
+			data_buffer.resize(static_cast<Uint64>(input_stream.tellg()));
+			input_stream.seekg(0);
+			input_stream.read(data_buffer.data(), data_buffer.size());
+		}
+		buffer_size = data_buffer.size();
+		data_buffer.resize(buffer_size + TailPadding, '\0');
+		buffer_start = data_buffer.c_str();
+	}
+}
@@ -1,34 +1,57 @@
 #pragma once
 #include <string>
+#include "SourceLocation.h"
 
 namespace ola
 {
+	//Files are memory mapped so the lexer reads straight from the page cache,
+	//the buffer is always followed by a '\0' sentinel and TailPadding readable zero bytes in total
 	class SourceBuffer
 	{
 	public:
+		//Lets the lexer load a whole SIMD block at any position up to the sentinel
+		static constexpr Uint64 TailPadding = 32;
 
 		explicit SourceBuffer(std::string_view source_file);
 		SourceBuffer(Char const* buffer_start, Uint64 buffer_size, std::string_view refname = "");
-		OLA_NONCOPYABLE(SourceBuffer)
-		OLA_DEFAULT_MOVABLE(SourceBuffer)
-		~SourceBuffer() = default;
+		OLA_NONCOPYABLE_NONMOVABLE(SourceBuffer)
+		~SourceBuffer();
 
+		//The prefix is kept apart from the buffer and lexed before it, it carries its own tail padding
 		void Prepend(Char const* str);
 
-		Char const* GetBufferStart() const { return data_buffer.c_str(); }
-		Char const* GetBufferEnd() const { return GetBufferStart() + data_buffer.size(); }
-		Uint64		GetBufferSize() const {	return data_buffer.size(); }
+		Char const* GetBufferStart() const { return buffer_start; }
+		Char const* GetBufferEnd() const { return buffer_start + buffer_size; }
+		Uint64		GetBufferSize() const {	return buffer_size; }
 		std::string_view GetBuffer() const
 		{
-			return std::string_view{ data_buffer };
+			return std::string_view{ buffer_start, buffer_size };
+		}
+		std::string_view GetPrefix() const
+		{
+			return prefix.empty() ? std::string_view{} : std::string_view{ prefix.data(), prefix.size() - TailPadding };
 		}
 		std::string_view GetRefName() const
 		{
 			return ref_name;
 		}
+		SourceLocation GetStartLocation() const
+		{
+			return start_loc;
+		}
 
 	private:
-		std::string data_buffer;
 		std::string ref_name;
+		std::string prefix;
+		std::string data_buffer;
+		Char const* buffer_start = nullptr;
+		Uint64 buffer_size = 0;
+		void* mapping = nullptr;
+		Uint64 mapping_size = 0;
+		SourceLocation start_loc;
+
+	private:
+		Bool MapFile(std::string const& path);
+		void ReadFile(std::string const& path);
 	};
 }
\ No newline at end of file
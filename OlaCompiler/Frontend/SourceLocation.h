@@ -4,34 +4,24 @@
 
 namespace ola
 {
+	//Encoded position in the location space of the SourceManager, 0 is an invalid location
 	struct SourceLocation
 	{
-		std::string filename = "";
-		Uint32 line = 1;
-		Uint32 column = 1;
+		Uint32 offset = 0;
 
-		SourceLocation operator+(Int32 i)
-		{
-			return SourceLocation
-			{
-				.filename = filename,
-				.line = line,
-				.column = column + i
-			};
-		}
+		Bool IsValid() const { return offset != 0; }
 
-		void NewChar()
-		{
-			++column;
-		}
-		void NewChars(Int32 i)
+		SourceLocation operator+(Int32 i) const
 		{
-			column += i;
-		}
-		void NewLine()
-		{
-			++line;
-			column = 1;
+			return SourceLocation{ .offset = offset + i };
 		}
 	};
+	static_assert(sizeof(SourceLocation) == sizeof(Uint32));
+
+	struct PresumedLocation
+	{
+		std::string filename = "";
+		Uint32 line = 1;
+		Uint32 column = 1;
+	};
 }
\ No newline at end of file
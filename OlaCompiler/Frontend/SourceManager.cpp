@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cstring>
+#include "SourceManager.h"
+
+namespace ola
+{
+	//Each file owns one location more than its size so the end of file sentinel has a location too
+	SourceLocation SourceManager::AddFile(std::string_view filename, Char const* buffer, Uint64 size)
+	{
+		std::lock_guard lock(mutex);
+		Uint64 const base = files.empty() ? 1 : Uint64(files.back().base) + files.back().size + 1;
+		OLA_ASSERT_MSG(base + size < UINT32_MAX, "Source location space exhausted!");
+		files.push_back(FileEntry{ .filename = std::string(filename), .base = static_cast<Uint32>(base), .size = static_cast<Uint32>(size), .buffer = buffer, .line_offsets = {} });
+		return SourceLocation{ .offset = static_cast<Uint32>(base) };
+	}
+
+	//Ranges are handed out in increasing order and the space after the last live file is reused, locations of a removed file must not be presumed anymore
+	void SourceManager::RemoveFile(SourceLocation start_loc)
+	{
+		std::lock_guard lock(mutex);
+		std::erase_if(files, [start_loc](FileEntry const& file) { return file.base == start_loc.offset; });
+	}
+
+	PresumedLocation SourceManager::GetPresumedLocation(SourceLocation loc)
+	{
+		if (!loc.IsValid()) return PresumedLocation{};
+
+		std::lock_guard lock(mutex);
+		auto it = std::upper_bound(files.begin(), files.end(), loc.offset, [](Uint32 offset, FileEntry const& file) { return offset < file.base; });
+		if (it == files.begin()) return PresumedLocation{};
+		FileEntry& file = *(--it);
+		Uint32 const file_offset = loc.offset - file.base;
+		if (file_offset > file.size) return PresumedLocation{};
+
+		if (file.line_offsets.empty())
+		{
+			file.line_offsets.push_back(0);
+			Char const* line_start = file.buffer;
+			Char const* buffer_end = file.buffer + file.size;
+			while (Char const* new_line = static_cast<Char const*>(std::memchr(line_start, '\n', buffer_end - line_start)))
+			{
+				line_start = new_line + 1;
+				file.line_offsets.push_back(static_cast<Uint32>(line_start - file.buffer));
+			}
+		}
+		auto line_it = std::upper_bound(file.line_offsets.begin(), file.line_offsets.end(), file_offset);
+		Uint32 const line = static_cast<Uint32>(line_it - file.line_offsets.begin());
+		return PresumedLocation
+		{
+			.filename = file.filename,
+			.line = line,
+			.column = file_offset - *(line_it - 1) + 1
+		};
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <mutex>
+#include "SourceLocation.h"
+
+namespace ola
+{
+	//Every live source buffer owns a range of the 32-bit location space, a SourceLocation is the start of that range plus a byte offset.
+	//Line and column are only computed, from a per-file table of line starts, when a location is presumed for printing.
+	class SourceManager
+	{
+		struct FileEntry
+		{
+			std::string filename;
+			Uint32 base;
+			Uint32 size;
+			Char const* buffer;
+			std::vector<Uint32> line_offsets;
+		};
+
+	public:
+		static SourceManager& Get()
+		{
+			static SourceManager instance;
+			return instance;
+		}
+
+		SourceLocation AddFile(std::string_view filename, Char const* buffer, Uint64 size);
+		void RemoveFile(SourceLocation start_loc);
+		PresumedLocation GetPresumedLocation(SourceLocation loc);
+
+	private:
+		std::mutex mutex;
+		std::vector<FileEntry> files;
+
+	private:
+		SourceManager() = default;
+	};
+}
\ No newline at end of file
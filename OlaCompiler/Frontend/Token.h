@@ -1,7 +1,9 @@
 #pragma once
 #include <string_view>
+#include <type_traits>
 #include "TokenKind.h"
 #include "SourceLocation.h"
+#include "Identifier.h"
 #include "Utility/EnumOperators.h"
 
 namespace ola
@@ -21,18 +23,20 @@ namespace ola
 	};
 	using TokenFlags = Uint32;
 
+	//Token data and location filename are views into the SourceBuffer the token was lexed from, the buffer has to outlive the token
 	class Token
 	{
 	public:
-		Token() : kind(TokenKind::unknown), flags(TokenFlag_None), loc{}, data{} {}
-		Token(TokenKind kind) : kind(kind), flags(TokenFlag_None), loc{}, data{} {}
+		Token() : kind(TokenKind::unknown), flags(TokenFlag_None), loc{}, identifier_id(0), data{} {}
+		Token(TokenKind kind) : kind(kind), flags(TokenFlag_None), loc{}, identifier_id(0), data{} {}
 		
 		void Reset()
 		{
 			kind = TokenKind::unknown;
 			flags = TokenFlag_None;
 			loc = {};
-			data.clear();
+			identifier_id = 0;
+			data = {};
 		}
 
 		TokenKind GetKind() const { return kind; }
@@ -71,7 +75,7 @@ namespace ola
 		}
 		Bool IsFunctionAttribute() const
 		{
-			return IsOneOf(TokenKind::KW_inline, TokenKind::KW_noinline, TokenKind::KW_nomangle, TokenKind::KW_noopt);
+			return IsOneOf(TokenKind::KW_inline, TokenKind::KW_noinline, TokenKind::KW_nomangle, TokenKind::KW_noopt, TokenKind::KW_constexpr);
 		}
 		Bool IsMethodAttribute() const
 		{
@@ -101,31 +105,44 @@ namespace ola
 		
 		void SetData(Char const* p_data, Uint64 count)
 		{
-			data = std::string(p_data, count);
+			data = std::string_view(p_data, count);
 		}
 		void SetData(Char const* start, Char const* end)
 		{
-			data = std::string(start, end - start);
+			data = std::string_view(start, end - start);
 		}
 		void SetData(std::string_view identifier)
 		{
-			data = std::string(identifier);
+			data = identifier;
 		}
 		std::string_view GetData() const
 		{
 			return data;
 		}
 
+		//Identifier tokens refer to the interned spelling instead of the source buffer
+		void SetIdentifier(Identifier identifier)
+		{
+			data = identifier.GetName();
+			identifier_id = identifier.GetId();
+		}
+		Identifier GetIdentifier() const
+		{
+			return Identifier(data, identifier_id);
+		}
+
 		void SetLocation(SourceLocation const& _loc)
 		{
 			loc = _loc;
 		}
-		SourceLocation const& GetLocation() const { return loc; }
+		SourceLocation GetLocation() const { return loc; }
 
 	private:
 		TokenKind kind;
 		TokenFlags flags;
 		SourceLocation loc;
-		std::string data;
+		Uint32 identifier_id;
+		std::string_view data;
 	};
+	static_assert(std::is_trivially_copyable_v<Token>);
 }
\ No newline at end of file
@@ -1,7 +1,5 @@
+#include <iterator>
 #include "TokenKind.h"
-#include <string>
-#include <unordered_set>
-#include <unordered_map>
 
 namespace ola
 {
@@ -12,16 +10,61 @@ namespace ola
 		#include "Tokens.def"
 		};
 
-		std::unordered_set<std::string_view> const keywords =
+		struct KeywordEntry
 		{
-			#define KEYWORD(X) #X,
-			#include "Tokens.def"
+			std::string_view name;
+			TokenKind kind;
 		};
-		std::unordered_map<std::string_view, TokenKind> keywords_map =
+		constexpr KeywordEntry keywords[] =
 		{
-			#define KEYWORD(X) {#X, TokenKind::KW_##X},
+			#define KEYWORD(X) { #X, TokenKind::KW_##X },
 			#include "Tokens.def"
 		};
+
+		//Keywords are looked up in a table indexed by a perfect hash whose seed is searched for at compile time
+		constexpr Uint32 KeywordTableSize = 256;
+		static_assert(std::size(keywords) < KeywordTableSize / 4, "Keyword table is too small for a perfect hash to be found quickly");
+
+		constexpr Uint32 HashKeyword(std::string_view identifier, Uint32 seed)
+		{
+			Uint32 hash = 2166136261u ^ seed;
+			for (Char c : identifier)
+			{
+				hash ^= static_cast<Uint8>(c);
+				hash *= 16777619u;
+			}
+			return hash & (KeywordTableSize - 1);
+		}
+
+		constexpr Uint32 FindKeywordSeed()
+		{
+			for (Uint32 seed = 0;; ++seed)
+			{
+				Bool used_slots[KeywordTableSize]{};
+				Bool collision = false;
+				for (KeywordEntry const& keyword : keywords)
+				{
+					Uint32 const slot = HashKeyword(keyword.name, seed);
+					collision = used_slots[slot];
+					if (collision) break;
+					used_slots[slot] = true;
+				}
+				if (!collision) return seed;
+			}
+		}
+		constexpr Uint32 KeywordSeed = FindKeywordSeed();
+
+		struct KeywordTable
+		{
+			KeywordEntry entries[KeywordTableSize];
+		};
+		constexpr KeywordTable keyword_table = []()
+			{
+				KeywordTable table{};
+				for (KeywordEntry& entry : table.entries) entry.kind = TokenKind::unknown;
+				for (KeywordEntry const& keyword : keywords) table.entries[HashKeyword(keyword.name, KeywordSeed)] = keyword;
+				return table;
+			}();
 	}
 
 	std::string_view GetTokenName(TokenKind t)
@@ -31,11 +74,11 @@ namespace ola
 
 	Bool IsKeyword(std::string_view identifer)
 	{
-		return keywords.contains(identifer);
+		return GetKeywordType(identifer) != TokenKind::unknown;
 	}
 	TokenKind GetKeywordType(std::string_view identifer)
 	{
-		return keywords_map[std::string(identifer)];
+		KeywordEntry const& entry = keyword_table.entries[HashKeyword(identifer, KeywordSeed)];
+		return entry.name == identifer ? entry.kind : TokenKind::unknown;
 	}
 }
-
@@ -0,0 +1,22 @@
+#include "TokenStream.h"
+#include "Lexer.h"
+
+namespace ola
+{
+	void TokenStream::Release(Iterator it)
+	{
+		OLA_ASSERT(it.stream == this);
+		released_index = it.index;
+		while (!buffer.empty() && buffer_index + 1 < it.index)
+		{
+			buffer.pop_front();
+			++buffer_index;
+		}
+	}
+
+	void TokenStream::LexNext()
+	{
+		Token& token = buffer.emplace_back();
+		lexer.Lex(token);
+	}
+}
\ No newline at end of file
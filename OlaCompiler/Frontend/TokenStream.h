@@ -0,0 +1,74 @@
+#pragma once
+#include <deque>
+#include "Token.h"
+
+namespace ola
+{
+	class Lexer;
+
+	//Tokens are lexed on demand as the import processor and the parser advance through them. Tokens before the
+	//released position are dropped, so only the tokens of the declaration or statement being parsed are kept in memory
+	class TokenStream
+	{
+	public:
+		class Iterator
+		{
+			friend class TokenStream;
+		public:
+			Iterator() = default;
+
+			Token const& operator*() const { return stream->Get(index); }
+			Token const* operator->() const { return &stream->Get(index); }
+			Iterator& operator++()
+			{
+				++index;
+				return *this;
+			}
+			Iterator operator++(Int)
+			{
+				Iterator tmp = *this;
+				++index;
+				return tmp;
+			}
+			Iterator& operator--()
+			{
+				--index;
+				return *this;
+			}
+			Iterator operator+(Int64 offset) const { return Iterator(stream, index + offset); }
+
+		private:
+			TokenStream* stream = nullptr;
+			Int64 index = 0;
+
+		private:
+			Iterator(TokenStream* stream, Int64 index) : stream(stream), index(index) {}
+		};
+
+	public:
+		explicit TokenStream(Lexer& lexer) : lexer(lexer) {}
+		OLA_NONCOPYABLE_NONMOVABLE(TokenStream)
+		~TokenStream() = default;
+
+		Iterator Begin() { return Iterator(this, released_index); }
+		//No iterator before it may be dereferenced after this, except for the token right before it which diagnostics are reported at
+		void Release(Iterator it);
+
+	private:
+		Lexer& lexer;
+		std::deque<Token> buffer;
+		Int64 buffer_index = 0;
+		Int64 released_index = 0;
+
+	private:
+		Token const& Get(Int64 index)
+		{
+			OLA_ASSERT_MSG(index >= buffer_index || index < 0, "Token was already released!");
+			//Diagnostics reported before the first token fall back to it
+			Uint64 const offset = index > buffer_index ? static_cast<Uint64>(index - buffer_index) : 0;
+			while (offset >= buffer.size()) LexNext();
+			return buffer[offset];
+		}
+		void LexNext();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+#include <string_view>
+#include <vector>
+
+namespace ola
+{
+	//Little endian byte streams with LEB128 varints, shared by the binary formats of the compiler
+	class ByteWriter
+	{
+	public:
+		void WriteByte(Uint8 value)
+		{
+			bytes.push_back(value);
+		}
+		void WriteVarint(Uint64 value)
+		{
+			while (value >= 0x80)
+			{
+				bytes.push_back(static_cast<Uint8>(value | 0x80));
+				value >>= 7;
+			}
+			bytes.push_back(static_cast<Uint8>(value));
+		}
+		void WriteSignedVarint(Int64 value)
+		{
+			WriteVarint((static_cast<Uint64>(value) << 1) ^ static_cast<Uint64>(value >> 63));
+		}
+		void WriteFixed64(Uint64 value)
+		{
+			for (Uint32 i = 0; i < sizeof(Uint64); ++i) bytes.push_back(static_cast<Uint8>(value >> (8 * i)));
+		}
+		void WriteString(std::string_view str)
+		{
+			WriteVarint(str.size());
+			bytes.insert(bytes.end(), str.begin(), str.end());
+		}
+
+		std::vector<Uint8> const& GetBytes() const { return bytes; }
+		Uint64 GetSize() const { return bytes.size(); }
+
+	private:
+		std::vector<Uint8> bytes;
+	};
+
+	class ByteReader
+	{
+	public:
+		ByteReader(Uint8 const* data, Uint64 size) : current(data), end(data + size) {}
+
+		Uint8 ReadByte()
+		{
+			if (current == end)
+			{
+				error = true;
+				return 0;
+			}
+			return *current++;
+		}
+		Uint64 ReadVarint()
+		{
+			Uint64 value = 0;
+			for (Uint32 shift = 0; shift < 64; shift += 7)
+			{
+				Uint8 const byte = ReadByte();
+				value |= static_cast<Uint64>(byte & 0x7f) << shift;
+				if (!(byte & 0x80)) return value;
+			}
+			error = true;
+			return 0;
+		}
+		Int64 ReadSignedVarint()
+		{
+			Uint64 const value = ReadVarint();
+			return static_cast<Int64>(value >> 1) ^ -static_cast<Int64>(value & 1);
+		}
+		Uint64 ReadFixed64()
+		{
+			Uint64 value = 0;
+			for (Uint32 i = 0; i < sizeof(Uint64); ++i) value |= static_cast<Uint64>(ReadByte()) << (8 * i);
+			return value;
+		}
+		std::string_view ReadString()
+		{
+			Uint64 const size = ReadVarint();
+			if (size > static_cast<Uint64>(end - current))
+			{
+				error = true;
+				return {};
+			}
+			std::string_view str(reinterpret_cast<Char const*>(current), size);
+			current += size;
+			return str;
+		}
+
+		Uint8 const* GetPosition() const { return current; }
+		Bool HasError() const { return error; }
+
+	private:
+		Uint8 const* current;
+		Uint8 const* end;
+		Bool error = false;
+	};
+}
\ No newline at end of file
@@ -1,10 +1,19 @@
 #include <cstdlib>
+#include <cstdio>
+#include <cerrno>
 #if _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <tlhelp32.h>
 #include <chrono>
 #include <thread>
+#else
+#include <spawn.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+extern char** environ;
 #endif
 #include "Command.h"
 #include "Core/Log.h"
@@ -14,6 +23,31 @@ namespace ola
 {
 	namespace
 	{
+		thread_local ChildProcessUsage thread_child_usage;
+
+#if !_WIN32
+		//Commands are run through the shell like std::system, but the child is waited for with wait4 so that
+		//its own resource usage can be attributed to the thread that ran it. Its peak resident set isn't, ru_maxrss
+		//of a spawned child already holds the compiler's own peak from before the exec.
+		Int SpawnShell(Char const* cmd, posix_spawn_file_actions_t const* file_actions, pid_t& pid)
+		{
+			Char const* argv[] = { "sh", "-c", cmd, nullptr };
+			return posix_spawn(&pid, "/bin/sh", file_actions, nullptr, const_cast<Char* const*>(argv), environ);
+		}
+
+		Int WaitForChild(pid_t pid)
+		{
+			Int status = 0;
+			rusage usage{};
+			while (wait4(pid, &status, 0, &usage) < 0)
+			{
+				if (errno != EINTR) return -1;
+			}
+			thread_child_usage.cpu_time += usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+			return status;
+		}
+#endif
+
 #if _WIN32
 		void KillProcessAndChildren(DWORD pid)
 		{
@@ -50,7 +84,59 @@ namespace ola
 
 	Int ExecuteCommand(Char const* cmd)
 	{
+#if _WIN32
 		return std::system(cmd);
+#else
+		pid_t pid;
+		if (SpawnShell(cmd, nullptr, pid) != 0) return -1;
+		Int status = WaitForChild(pid);
+		return WIFEXITED(status) ? WEXITSTATUS(status) : status;
+#endif
+	}
+
+	Int ExecuteCommand(Char const* cmd, std::string_view input)
+	{
+#if _WIN32
+		FILE* pipe = _popen(cmd, "wb");
+		if (!pipe)
+		{
+			OLA_ERROR("Failed to open a pipe to: {}", cmd);
+			return -1;
+		}
+		std::fwrite(input.data(), sizeof(Char), input.size(), pipe);
+		return _pclose(pipe);
+#else
+		Int pipe_fds[2];
+		if (pipe(pipe_fds) != 0)
+		{
+			OLA_ERROR("Failed to open a pipe to: {}", cmd);
+			return -1;
+		}
+		//commands spawned concurrently by other threads must not inherit the pipe, the reader would never see the end of the input
+		fcntl(pipe_fds[0], F_SETFD, FD_CLOEXEC);
+		fcntl(pipe_fds[1], F_SETFD, FD_CLOEXEC);
+		posix_spawn_file_actions_t file_actions;
+		posix_spawn_file_actions_init(&file_actions);
+		posix_spawn_file_actions_adddup2(&file_actions, pipe_fds[0], STDIN_FILENO);
+		posix_spawn_file_actions_addclose(&file_actions, pipe_fds[0]);
+		posix_spawn_file_actions_addclose(&file_actions, pipe_fds[1]);
+		pid_t pid;
+		Int const spawn_result = SpawnShell(cmd, &file_actions, pid);
+		posix_spawn_file_actions_destroy(&file_actions);
+		close(pipe_fds[0]);
+		if (spawn_result != 0)
+		{
+			close(pipe_fds[1]);
+			OLA_ERROR("Failed to open a pipe to: {}", cmd);
+			return -1;
+		}
+
+		FILE* pipe = fdopen(pipe_fds[1], "w");
+		std::fwrite(input.data(), sizeof(Char), input.size(), pipe);
+		std::fclose(pipe);
+		Int status = WaitForChild(pid);
+		return WIFEXITED(status) ? WEXITSTATUS(status) : status;
+#endif
 	}
 
 	Int ExecuteCommand_NonBlocking(Char const* cmd, Float timeout)
@@ -106,5 +192,9 @@ namespace ola
 		return ExecuteCommand(cmd);
 #endif
 	}
-}
 
+	ChildProcessUsage& GetThreadChildProcessUsage()
+	{
+		return thread_child_usage;
+	}
+}
@@ -1,8 +1,18 @@
 #pragma once
-
+#include <string_view>
 
 namespace ola
 {
+	struct ChildProcessUsage
+	{
+		Float64 cpu_time = 0.0;
+	};
+
 	Int ExecuteCommand(Char const* cmd);
+	Int ExecuteCommand(Char const* cmd, std::string_view input);
 	Int ExecuteCommand_NonBlocking(Char const* cmd, Float timeout);
+
+	//Resource usage of the commands executed on the calling thread, cpu_time accumulates over all of them.
+	//Time report scopes take the difference to attribute the usage to their stage. Always empty on Windows.
+	ChildProcessUsage& GetThreadChildProcessUsage();
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <algorithm>
+
+namespace ola
+{
+	class ThreadPool
+	{
+	public:
+		explicit ThreadPool(Uint32 thread_count)
+		{
+			if (thread_count == 0) thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+			workers.reserve(thread_count);
+			for (Uint32 i = 0; i < thread_count; ++i)
+			{
+				workers.emplace_back([this] { WorkerLoop(); });
+			}
+		}
+		OLA_NONCOPYABLE_NONMOVABLE(ThreadPool)
+		~ThreadPool()
+		{
+			{
+				std::lock_guard lock(queue_mutex);
+				stop = true;
+			}
+			queue_cv.notify_all();
+			for (std::thread& worker : workers) worker.join();
+		}
+
+		template<typename F>
+		auto Submit(F&& task) -> std::future<std::invoke_result_t<F>>
+		{
+			using ResultT = std::invoke_result_t<F>;
+			auto packaged_task = std::make_shared<std::packaged_task<ResultT()>>(std::forward<F>(task));
+			std::future<ResultT> result = packaged_task->get_future();
+			{
+				std::lock_guard lock(queue_mutex);
+				tasks.emplace([packaged_task] { (*packaged_task)(); });
+			}
+			queue_cv.notify_one();
+			return result;
+		}
+
+		Uint32 GetThreadCount() const { return static_cast<Uint32>(workers.size()); }
+
+	private:
+		std::vector<std::thread> workers;
+		std::queue<std::function<void()>> tasks;
+		std::mutex queue_mutex;
+		std::condition_variable queue_cv;
+		Bool stop = false;
+
+	private:
+		void WorkerLoop()
+		{
+			while (true)
+			{
+				std::function<void()> task;
+				{
+					std::unique_lock lock(queue_mutex);
+					queue_cv.wait(lock, [this] { return stop || !tasks.empty(); });
+					if (stop && tasks.empty()) return;
+					task = std::move(tasks.front());
+					tasks.pop();
+				}
+				task();
+			}
+		}
+	};
+}
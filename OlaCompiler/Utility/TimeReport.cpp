@@ -0,0 +1,154 @@
+#include <ostream>
+#include <format>
+#include <algorithm>
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <ctime>
+#include <sys/resource.h>
+#endif
+#include "TimeReport.h"
+#include "Command.h"
+
+namespace ola
+{
+	namespace
+	{
+		Float64 GetThreadCPUTime()
+		{
+#if _WIN32
+			FILETIME creation_time, exit_time, kernel_time, user_time;
+			if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time)) return 0.0;
+			auto ToSeconds = [](FILETIME const& ft)
+				{
+					ULARGE_INTEGER value{};
+					value.LowPart = ft.dwLowDateTime;
+					value.HighPart = ft.dwHighDateTime;
+					return value.QuadPart * 1e-7;
+				};
+			return ToSeconds(kernel_time) + ToSeconds(user_time);
+#else
+			timespec ts{};
+			clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+			return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+		}
+
+		//A single syscall, unlike reading /proc/self/statm, and the peak can't be missed between two samples
+		Uint64 GetPeakRSS()
+		{
+#if _WIN32
+			PROCESS_MEMORY_COUNTERS counters{};
+			if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+			return counters.PeakWorkingSetSize;
+#else
+			rusage usage{};
+			if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+			return static_cast<Uint64>(usage.ru_maxrss);
+#else
+			return static_cast<Uint64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+		}
+
+		std::string EscapeJSON(std::string_view str)
+		{
+			std::string escaped;
+			escaped.reserve(str.size());
+			for (Char c : str)
+			{
+				switch (c)
+				{
+				case '"':  escaped += "\\\""; break;
+				case '\\': escaped += "\\\\"; break;
+				case '\n': escaped += "\\n"; break;
+				case '\t': escaped += "\\t"; break;
+				default:   escaped += c;
+				}
+			}
+			return escaped;
+		}
+	}
+
+	void TimeReport::Record(std::string_view stage, Float64 wall_time, Float64 cpu_time, Uint64 peak_rss, Uint64 peak_rss_growth)
+	{
+		std::lock_guard lock(stage_mutex);
+		std::string key(stage);
+		auto it = stage_index_map.find(key);
+		if (it == stage_index_map.end())
+		{
+			it = stage_index_map.emplace(key, stages.size()).first;
+			stages.push_back(TimeReportStage{ .name = std::move(key) });
+		}
+		TimeReportStage& entry = stages[it->second];
+		++entry.count;
+		entry.wall_time += wall_time;
+		entry.cpu_time += cpu_time;
+		entry.peak_rss = std::max(entry.peak_rss, peak_rss);
+		entry.peak_rss_growth = std::max(entry.peak_rss_growth, peak_rss_growth);
+	}
+
+	void TimeReport::Print(std::ostream& os, TimeReportFormat format) const
+	{
+		std::lock_guard lock(stage_mutex);
+		switch (format)
+		{
+		case TimeReportFormat::Text: PrintText(os); break;
+		case TimeReportFormat::JSON: PrintJSON(os); break;
+		}
+	}
+
+	std::vector<TimeReportStage> TimeReport::GetStages() const
+	{
+		std::lock_guard lock(stage_mutex);
+		return stages;
+	}
+
+	void TimeReport::PrintText(std::ostream& os) const
+	{
+		Uint64 name_width = 5;
+		for (TimeReportStage const& stage : stages) name_width = std::max<Uint64>(name_width, stage.name.size());
+
+		os << "===== Time Report =====\n";
+		os << std::format("{:<{}}  {:>8}  {:>12}  {:>12}  {:>13}  {:>16}\n", "Stage", name_width, "Count", "Wall (ms)", "CPU (ms)", "Peak RSS (MB)", "Peak Growth (MB)");
+		for (TimeReportStage const& stage : stages)
+		{
+			os << std::format("{:<{}}  {:>8}  {:>12.3f}  {:>12.3f}  {:>13.2f}  {:>16.2f}\n", stage.name, name_width, stage.count,
+				stage.wall_time * 1000.0, stage.cpu_time * 1000.0, stage.peak_rss / (1024.0 * 1024.0), stage.peak_rss_growth / (1024.0 * 1024.0));
+		}
+	}
+
+	void TimeReport::PrintJSON(std::ostream& os) const
+	{
+		os << "{\n  \"stages\": [";
+		for (Uint64 i = 0; i < stages.size(); ++i)
+		{
+			TimeReportStage const& stage = stages[i];
+			os << (i == 0 ? "\n" : ",\n");
+			os << std::format("    {{ \"name\": \"{}\", \"count\": {}, \"wall_ms\": {:.3f}, \"cpu_ms\": {:.3f}, \"peak_rss_bytes\": {}, \"peak_rss_growth_bytes\": {} }}",
+				EscapeJSON(stage.name), stage.count, stage.wall_time * 1000.0, stage.cpu_time * 1000.0, stage.peak_rss, stage.peak_rss_growth);
+		}
+		os << "\n  ]\n}\n";
+	}
+
+	TimeReportScope::TimeReportScope(std::string_view stage, TimeReportScopeKind kind) : stage(stage), enabled(g_TimeReport.IsEnabled()), kind(kind)
+	{
+		if (!enabled) return;
+		if (kind == TimeReportScopeKind::Stage) peak_rss_start = GetPeakRSS();
+		wall_start = std::chrono::steady_clock::now();
+		//only the commands waited for by this thread count, so concurrent translation units don't see each other's children
+		cpu_start = kind == TimeReportScopeKind::Command ? GetThreadChildProcessUsage().cpu_time : GetThreadCPUTime();
+	}
+
+	TimeReportScope::~TimeReportScope()
+	{
+		if (!enabled) return;
+		Float64 const cpu_time = (kind == TimeReportScopeKind::Command ? GetThreadChildProcessUsage().cpu_time : GetThreadCPUTime()) - cpu_start;
+		Float64 const wall_time = std::chrono::duration<Float64>(std::chrono::steady_clock::now() - wall_start).count();
+		Uint64 const peak_rss = kind == TimeReportScopeKind::Stage ? GetPeakRSS() : 0;
+		g_TimeReport.Record(stage, wall_time, cpu_time, peak_rss, peak_rss - peak_rss_start);
+	}
+}
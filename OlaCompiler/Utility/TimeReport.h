@@ -0,0 +1,90 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+
+namespace ola
+{
+	enum class TimeReportFormat : Uint8
+	{
+		Text,
+		JSON
+	};
+
+	//cpu_time is the time of the thread that ran the stage, or of the child processes it waited for.
+	//peak_rss is the peak resident set of the compiler once the stage finished, peak_rss_growth is the most a single
+	//run of the stage raised it. Other threads allocate at the same time under -j, so the growth is only exact for
+	//single threaded compilations. Both stay zero for fine grained and command stages.
+	struct TimeReportStage
+	{
+		std::string name;
+		Uint64 count = 0;
+		Float64 wall_time = 0.0;
+		Float64 cpu_time = 0.0;
+		Uint64 peak_rss = 0;
+		Uint64 peak_rss_growth = 0;
+	};
+
+	class TimeReport
+	{
+	public:
+		static TimeReport& Get()
+		{
+			static TimeReport instance;
+			return instance;
+		}
+
+		void Enable() { enabled.store(true, std::memory_order_relaxed); }
+		Bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+		void Record(std::string_view stage, Float64 wall_time, Float64 cpu_time, Uint64 peak_rss, Uint64 peak_rss_growth);
+		void Print(std::ostream& os, TimeReportFormat format) const;
+		std::vector<TimeReportStage> GetStages() const;
+
+	private:
+		std::atomic<Bool> enabled = false;
+		mutable std::mutex stage_mutex;
+		std::vector<TimeReportStage> stages;
+		std::unordered_map<std::string, Uint64> stage_index_map;
+
+	private:
+		TimeReport() = default;
+		void PrintText(std::ostream& os) const;
+		void PrintJSON(std::ostream& os) const;
+	};
+	#define g_TimeReport ola::TimeReport::Get()
+
+	//Stage scopes also sample the peak resident set, outside of the timed interval. Fine scopes are for the passes
+	//and per function stages that run too often for that. Command scopes time the child processes waited for in the scope.
+	enum class TimeReportScopeKind : Uint8
+	{
+		Stage,
+		Fine,
+		Command
+	};
+
+	class TimeReportScope
+	{
+	public:
+		explicit TimeReportScope(std::string_view stage, TimeReportScopeKind kind = TimeReportScopeKind::Stage);
+		~TimeReportScope();
+		OLA_NONCOPYABLE_NONMOVABLE(TimeReportScope)
+
+	private:
+		std::string_view stage;
+		Bool enabled;
+		TimeReportScopeKind kind;
+		std::chrono::steady_clock::time_point wall_start;
+		Float64 cpu_start = 0.0;
+		Uint64 peak_rss_start = 0;
+	};
+}
+
+#define OLA_TIME_REPORT_SCOPE(stage) ola::TimeReportScope OLA_CONCAT(_time_report_scope, __COUNTER__)(g_TimeReport.IsEnabled() ? (stage) : std::string_view{})
+#define OLA_TIME_REPORT_FINE_SCOPE(stage) ola::TimeReportScope OLA_CONCAT(_time_report_scope, __COUNTER__)(g_TimeReport.IsEnabled() ? (stage) : std::string_view{}, ola::TimeReportScopeKind::Fine)
+#define OLA_TIME_REPORT_COMMAND_SCOPE(stage) ola::TimeReportScope OLA_CONCAT(_time_report_scope, __COUNTER__)(stage, ola::TimeReportScopeKind::Command)
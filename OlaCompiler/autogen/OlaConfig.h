@@ -0,0 +1,5 @@
+#define OLA_COMPILER_PATH 		"/root/repo/OlaCompiler/"
+#define OLA_LIB_PATH 			"/root/repo/OlaLib/"
+#define OLA_TESTS_PATH    		"/root/repo/OlaTests/"
+#define OLA_PLAYGROUND_PATH    	"/root/repo/OlaPlayground/"
+#define OLA_BINARY_PATH    		"/root/repo/_gate_build/bin/"
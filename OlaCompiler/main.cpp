@@ -1,5 +1,6 @@
 #include "Core/Log.h"
 #include "Compiler/CompileRequest.h"
+#include "Compiler/CompileServer.h"
 #include "Compiler/Compiler.h"
 
 int main(int argc, char** argv)
@@ -8,8 +9,14 @@ int main(int argc, char** argv)
 	ola::CompileRequest compile_request{};
 	if (compile_request.Parse(argc, argv))
 	{
+		switch (compile_request.GetMode())
+		{
+		case ola::CompilerMode::Serve:		return ola::RunCompileServer(compile_request.GetSocketPath());
+		case ola::CompilerMode::Connect:	return ola::RunCompileClient(compile_request.GetSocketPath(), argc, argv);
+		default: break;
+		}
 		ola::Int compile_result = ola::Compile(compile_request);
 		return compile_result;
 	}
 	return 0;
-}
+}
\ No newline at end of file
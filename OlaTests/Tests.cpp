@@ -127,6 +127,11 @@ TEST(Function, Returns)
 	EXPECT_EQ(OLA_TEST(-i test_returns), 0);
 }
 
+TEST(Function, Constexpr)
+{
+	EXPECT_EQ(OLA_TEST(-i test_constexpr), 0);
+}
+
 TEST(Misc, Strings)
 {
 	EXPECT_EQ(OLA_TEST(-i test_string), 0);
@@ -152,6 +157,26 @@ TEST(Classes, Constructors)
 	EXPECT_EQ(OLA_TEST(-i test_constructors), 0);
 }
 
+TEST(Codegen, Liveness)
+{
+	EXPECT_EQ(OLA_TEST(--nollvm -i test_liveness), 0);
+}
+
+//Runs on the custom backend since that is where spilled operands have to be legalized
+TEST(Codegen, Spills)
+{
+	EXPECT_EQ(OLA_TEST(--nollvm -i test_spills), 0);
+}
+
+//With --lto every translation unit is written in the binary IR format and read back before linking
+TEST(IR, BinaryRoundTrip)
+{
+	EXPECT_EQ(OLA_TEST(--lto -i test_switch), 0);
+	EXPECT_EQ(OLA_TEST(--lto -i test_floats), 0);
+	EXPECT_EQ(OLA_TEST(--lto -i test_string), 0);
+	EXPECT_EQ(OLA_TEST(--lto -i test_polymorphism), 0);
+}
+
 
 
 